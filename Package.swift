@@ -1,6 +1,52 @@
 // swift-tools-version:5.9
+import Foundation
 import PackageDescription
 
+/// Build-time specialized deflate for services that use a single configuration, e.g.
+/// `SWIFTZLIB_SPECIALIZED_DEFLATE="level=1,windowBits=-15,memLevel=8" swift build`.
+/// Any non-empty value enables it; omitted keys default to level 1, a 32K window and
+/// memLevel 8. Streams with other parameters keep using the generic code paths.
+let specializedDeflateSettings: [CSetting] = {
+    guard let value = ProcessInfo.processInfo.environment["SWIFTZLIB_SPECIALIZED_DEFLATE"], !value.isEmpty else {
+        return []
+    }
+    let defines = ["level": "Z_DEFLATE_SPEC_LEVEL", "windowBits": "Z_DEFLATE_SPEC_WBITS", "memLevel": "Z_DEFLATE_SPEC_MEMLEVEL"]
+    var settings: [CSetting] = [.define("Z_DEFLATE_SPECIALIZE")]
+    for pair in value.split(separator: ",") {
+        let parts = pair.split(separator: "=", maxSplits: 1).map { $0.trimmingCharacters(in: .whitespaces) }
+        guard parts.count == 2, let name = defines[parts[0]], let number = Int(parts[1]) else {
+            continue
+        }
+        // Raw (-15) and gzip (31) window bits name the same 32K window as 15
+        let setting = name == "Z_DEFLATE_SPEC_WBITS" ? (number < 0 ? -number : number & 15) : number
+        settings.append(.define(name, to: String(setting)))
+    }
+    return settings
+}()
+
+/// Build against the vendored CZLib core only, e.g. `SWIFTZLIB_VENDORED_ZLIB=1 swift build`, so the
+/// optimized sources run on every platform instead of whatever libz the host provides.
+/// `ZLib.backend` reports which implementation and kernels are in use.
+let usesVendoredZlibOnly: Bool = {
+    let value = ProcessInfo.processInfo.environment["SWIFTZLIB_VENDORED_ZLIB"] ?? ""
+    return !value.isEmpty && value != "0"
+}()
+
+let vendoredZlibSettings: [CSetting] = usesVendoredZlibOnly ? [.define("SWIFTZLIB_VENDORED_ZLIB")] : []
+
+/// Count the calls and bytes of zlib's default allocator for the benchmark reports, e.g.
+/// `SWIFTZLIB_ALLOC_STATS=1 swift run -c release SwiftZlibBenchmarks`. Off by default, so other
+/// builds do not pay for the counters on every zlib allocation.
+let allocatorStatsSettings: [CSetting] = {
+    let value = ProcessInfo.processInfo.environment["SWIFTZLIB_ALLOC_STATS"] ?? ""
+    return !value.isEmpty && value != "0" ? [.define("Z_ALLOC_STATS")] : []
+}()
+
+let systemZlibLinkerSettings: [LinkerSetting] = usesVendoredZlibOnly ? [] : [
+    // Only link zlib on non-Windows platforms since we use our own implementation on Windows
+    .linkedLibrary("z", .when(platforms: [.macOS, .iOS, .tvOS, .watchOS, .visionOS, .linux])),
+]
+
 let package = Package(
     name: "SwiftZlib",
     platforms: [
@@ -12,6 +58,7 @@ let package = Package(
     products: [
         .library(name: "SwiftZlib", targets: ["SwiftZlib"]),
         .executable(name: "SwiftZlibCLI", targets: ["SwiftZlibCLI"]),
+        .executable(name: "SwiftZlibBenchmarks", targets: ["SwiftZlibBenchmarks"]),
     ],
     targets: [
         // ① thin shim so SwiftPM can find the headers
@@ -35,6 +82,10 @@ let package = Package(
                 "trees.c",
                 "uncompr.c",
                 "zutil.c",
+                "zlib_zran.c",
+                "zlib_pinflate.c",
+                "zlib_metrics.c",
+                "zlib_backend.c",
             ],
             cSettings: [
                 .headerSearchPath("include"),
@@ -85,11 +136,8 @@ let package = Package(
                 .define("_NO_CRT_WCSTOMBS_S_INLINE"),
                 .define("_NO_CRT_MBSRTOWCS_S_INLINE"),
                 .define("_NO_CRT_WCSRTOMBS_S_INLINE"),
-            ],
-            linkerSettings: [
-                // Only link zlib on non-Windows platforms since we use our own implementation on Windows
-                .linkedLibrary("z", .when(platforms: [.macOS, .iOS, .tvOS, .watchOS, .visionOS, .linux])),
-            ]
+            ] + specializedDeflateSettings + vendoredZlibSettings + allocatorStatsSettings,
+            linkerSettings: systemZlibLinkerSettings
         ),
 
         // ② your Swift façade with optional verbose logging
@@ -111,5 +159,11 @@ let package = Package(
             dependencies: ["SwiftZlib"]
             // Note: CLI is not built for iOS/tvOS/watchOS/visionOS (command-line executables not supported)
         ),
+
+        // ③ release-mode benchmark runner with JSON reports (swift run -c release SwiftZlibBenchmarks)
+        .executableTarget(
+            name: "SwiftZlibBenchmarks",
+            dependencies: ["SwiftZlib", "CZLib"]
+        ),
     ]
 )
@@ -58,7 +58,8 @@
 #endif
 
 /* ========================================================================= */
-uLong ZEXPORT adler32_z(uLong adler, const Bytef *buf, z_size_t len) {
+uLong ZLIB_INTERNAL adler32_portable(uLong adler, const Bytef *buf,
+                                     z_size_t len) {
     unsigned long sum2;
     unsigned n;
 
@@ -124,6 +125,208 @@ uLong ZEXPORT adler32_z(uLong adler, const Bytef *buf, z_size_t len) {
     return adler | (sum2 << 16);
 }
 
+/* =========================================================================
+ * Vector kernels, adapted from Chromium's adler32_simd.c. Input is processed
+ * in 32-byte blocks: s1 gets the plain byte sums and s2 gets the bytes
+ * weighted by [32, 31, ..., 1] plus 32 times the running s1 per block. At
+ * most NMAX bytes are summed before reducing modulo BASE, as in the portable
+ * code. Short inputs and the tail go through adler32_portable().
+ */
+#define ADLER_SIMD_MIN 64
+#define ADLER_BLOCK 32
+
+#ifdef Z_X86_SIMD
+#include <immintrin.h>
+
+__attribute__((target("ssse3")))
+uLong ZLIB_INTERNAL adler32_ssse3(uLong adler, const Bytef *buf,
+                                  z_size_t len) {
+    unsigned long s1 = adler & 0xffff;
+    unsigned long s2 = (adler >> 16) & 0xffff;
+    z_size_t blocks;
+
+    if (buf == Z_NULL || len < ADLER_SIMD_MIN)
+        return adler32_portable(adler, buf, len);
+
+    blocks = len / ADLER_BLOCK;
+    len -= blocks * ADLER_BLOCK;
+    while (blocks) {
+        const __m128i tap1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,
+                                           24, 23, 22, 21, 20, 19, 18, 17);
+        const __m128i tap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9,
+                                           8, 7, 6, 5, 4, 3, 2, 1);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i ones = _mm_set1_epi16(1);
+        unsigned n = NMAX / ADLER_BLOCK;
+        __m128i v_ps, v_s1, v_s2;
+
+        if (n > blocks)
+            n = (unsigned)blocks;
+        blocks -= n;
+
+        v_ps = _mm_set_epi32(0, 0, 0, (int)(s1 * n));
+        v_s2 = _mm_set_epi32(0, 0, 0, (int)s2);
+        v_s1 = _mm_setzero_si128();
+        do {
+            const __m128i bytes1 = _mm_loadu_si128((const __m128i *)buf);
+            const __m128i bytes2 = _mm_loadu_si128((const __m128i *)(buf + 16));
+
+            /* s2 gets 32 times the byte sum of each earlier block */
+            v_ps = _mm_add_epi32(v_ps, v_s1);
+
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes1, zero));
+            v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(
+                                 _mm_maddubs_epi16(bytes1, tap1), ones));
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes2, zero));
+            v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(
+                                 _mm_maddubs_epi16(bytes2, tap2), ones));
+            buf += ADLER_BLOCK;
+        } while (--n);
+        v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 5));
+
+        /* horizontal sums */
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(1, 0, 3, 2)));
+        s1 += (unsigned)_mm_cvtsi128_si32(v_s1);
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(2, 3, 0, 1)));
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(1, 0, 3, 2)));
+        s2 = (unsigned)_mm_cvtsi128_si32(v_s2);
+
+        MOD(s1);
+        MOD(s2);
+    }
+    return adler32_portable(s1 | (s2 << 16), buf, len);
+}
+
+__attribute__((target("avx2")))
+uLong ZLIB_INTERNAL adler32_avx2(uLong adler, const Bytef *buf,
+                                 z_size_t len) {
+    unsigned long s1 = adler & 0xffff;
+    unsigned long s2 = (adler >> 16) & 0xffff;
+    z_size_t blocks;
+
+    if (buf == Z_NULL || len < ADLER_SIMD_MIN)
+        return adler32_portable(adler, buf, len);
+
+    blocks = len / ADLER_BLOCK;
+    len -= blocks * ADLER_BLOCK;
+    while (blocks) {
+        const __m256i tap = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,
+                                             24, 23, 22, 21, 20, 19, 18, 17,
+                                             16, 15, 14, 13, 12, 11, 10, 9,
+                                             8, 7, 6, 5, 4, 3, 2, 1);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i ones = _mm256_set1_epi16(1);
+        unsigned n = NMAX / ADLER_BLOCK;
+        __m256i v_ps, v_s1, v_s2;
+        __m128i h1, h2;
+
+        if (n > blocks)
+            n = (unsigned)blocks;
+        blocks -= n;
+
+        v_ps = _mm256_setr_epi32((int)(s1 * n), 0, 0, 0, 0, 0, 0, 0);
+        v_s2 = _mm256_setr_epi32((int)s2, 0, 0, 0, 0, 0, 0, 0);
+        v_s1 = _mm256_setzero_si256();
+        do {
+            const __m256i bytes = _mm256_loadu_si256((const __m256i *)buf);
+
+            v_ps = _mm256_add_epi32(v_ps, v_s1);
+            v_s1 = _mm256_add_epi32(v_s1, _mm256_sad_epu8(bytes, zero));
+            v_s2 = _mm256_add_epi32(v_s2, _mm256_madd_epi16(
+                                    _mm256_maddubs_epi16(bytes, tap), ones));
+            buf += ADLER_BLOCK;
+        } while (--n);
+        v_s2 = _mm256_add_epi32(v_s2, _mm256_slli_epi32(v_ps, 5));
+
+        /* horizontal sums */
+        h1 = _mm_add_epi32(_mm256_castsi256_si128(v_s1),
+                           _mm256_extracti128_si256(v_s1, 1));
+        h1 = _mm_add_epi32(h1, _mm_shuffle_epi32(h1, _MM_SHUFFLE(1, 0, 3, 2)));
+        s1 += (unsigned)_mm_cvtsi128_si32(h1);
+        h2 = _mm_add_epi32(_mm256_castsi256_si128(v_s2),
+                           _mm256_extracti128_si256(v_s2, 1));
+        h2 = _mm_add_epi32(h2, _mm_shuffle_epi32(h2, _MM_SHUFFLE(2, 3, 0, 1)));
+        h2 = _mm_add_epi32(h2, _mm_shuffle_epi32(h2, _MM_SHUFFLE(1, 0, 3, 2)));
+        s2 = (unsigned)_mm_cvtsi128_si32(h2);
+
+        MOD(s1);
+        MOD(s2);
+    }
+    return adler32_portable(s1 | (s2 << 16), buf, len);
+}
+#elif defined(Z_NEON_SIMD)
+#include <arm_neon.h>
+
+uLong ZLIB_INTERNAL adler32_neon(uLong adler, const Bytef *buf,
+                                 z_size_t len) {
+    unsigned long s1 = adler & 0xffff;
+    unsigned long s2 = (adler >> 16) & 0xffff;
+    z_size_t blocks;
+
+    if (buf == Z_NULL || len < ADLER_SIMD_MIN)
+        return adler32_portable(adler, buf, len);
+
+    blocks = len / ADLER_BLOCK;
+    len -= blocks * ADLER_BLOCK;
+    while (blocks) {
+        static const uint16_t taps[32] = {
+            32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+            16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1
+        };
+        unsigned n = NMAX / ADLER_BLOCK;
+        uint32x4_t v_s1 = vdupq_n_u32(0);
+        uint32x4_t v_s2;
+        uint16x8_t col1 = vdupq_n_u16(0), col2 = vdupq_n_u16(0);
+        uint16x8_t col3 = vdupq_n_u16(0), col4 = vdupq_n_u16(0);
+        uint32x2_t sum1, sum2, s1s2;
+
+        if (n > blocks)
+            n = (unsigned)blocks;
+        blocks -= n;
+
+        v_s2 = vsetq_lane_u32((uint32_t)(s1 * n), vdupq_n_u32(0), 3);
+        do {
+            const uint8x16_t bytes1 = vld1q_u8(buf);
+            const uint8x16_t bytes2 = vld1q_u8(buf + 16);
+
+            v_s2 = vaddq_u32(v_s2, v_s1);
+            v_s1 = vpadalq_u16(v_s1, vpadalq_u8(vpaddlq_u8(bytes1), bytes2));
+            /* per-column byte sums, weighted after the loop */
+            col1 = vaddw_u8(col1, vget_low_u8(bytes1));
+            col2 = vaddw_u8(col2, vget_high_u8(bytes1));
+            col3 = vaddw_u8(col3, vget_low_u8(bytes2));
+            col4 = vaddw_u8(col4, vget_high_u8(bytes2));
+            buf += ADLER_BLOCK;
+        } while (--n);
+        v_s2 = vshlq_n_u32(v_s2, 5);
+
+        v_s2 = vmlal_u16(v_s2, vget_low_u16(col1), vld1_u16(taps + 0));
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(col1), vld1_u16(taps + 4));
+        v_s2 = vmlal_u16(v_s2, vget_low_u16(col2), vld1_u16(taps + 8));
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(col2), vld1_u16(taps + 12));
+        v_s2 = vmlal_u16(v_s2, vget_low_u16(col3), vld1_u16(taps + 16));
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(col3), vld1_u16(taps + 20));
+        v_s2 = vmlal_u16(v_s2, vget_low_u16(col4), vld1_u16(taps + 24));
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(col4), vld1_u16(taps + 28));
+
+        sum1 = vpadd_u32(vget_low_u32(v_s1), vget_high_u32(v_s1));
+        sum2 = vpadd_u32(vget_low_u32(v_s2), vget_high_u32(v_s2));
+        s1s2 = vpadd_u32(sum1, sum2);
+        s1 += vget_lane_u32(s1s2, 0);
+        s2 += vget_lane_u32(s1s2, 1);
+
+        MOD(s1);
+        MOD(s2);
+    }
+    return adler32_portable(s1 | (s2 << 16), buf, len);
+}
+#endif
+
+/* ========================================================================= */
+uLong ZEXPORT adler32_z(uLong adler, const Bytef *buf, z_size_t len) {
+    return z_functable()->adler32(adler, buf, len);
+}
+
 /* ========================================================================= */
 uLong ZEXPORT adler32(uLong adler, const Bytef *buf, uInt len) {
     return adler32_z(adler, buf, len);
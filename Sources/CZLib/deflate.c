@@ -51,6 +51,40 @@
 
 #include "deflate.h"
 
+#ifdef Z_X86_SIMD
+#  include <immintrin.h>
+#elif defined(Z_NEON_SIMD)
+#  include <arm_neon.h>
+#endif
+
+/* Compare match candidates a word or a vector at a time instead of one byte
+ * at a time. This only changes how the length of a match is measured, not
+ * which match is chosen, so the output is identical to the byte loop.
+ */
+#if !defined(Z_NO_SIMD) && !defined(UNALIGNED_OK) && \
+    (defined(__GNUC__) || defined(__clang__)) && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#  define Z_WIDE_MATCH
+#endif
+
+/* Optional CRC32-instruction hash (Chromium style). This spreads the keys
+ * better than the rolling shift/xor hash, but it changes which matches are
+ * found, so the output is NOT bit-identical to stock zlib. It is therefore
+ * opt-in: build with -DZ_DEFLATE_CRC_HASH on a target compiled with SSE4.2
+ * (-msse4.2) or the ARMv8 CRC extension.
+ */
+#if defined(Z_DEFLATE_CRC_HASH) && !defined(Z_NO_SIMD)
+#  if defined(__SSE4_2__)
+#    include <nmmintrin.h>
+#    define Z_CRC_HASH
+#    define hash_crc32c(v) _mm_crc32_u32(0, (v))
+#  elif defined(__ARM_FEATURE_CRC32)
+#    include <arm_acle.h>
+#    define Z_CRC_HASH
+#    define hash_crc32c(v) __crc32cw(0, (v))
+#  endif
+#endif
+
 const char deflate_copyright[] =
    " deflate 1.3.1 Copyright 1995-2024 Jean-loup Gailly and Mark Adler ";
 /*
@@ -72,11 +106,15 @@ typedef block_state (*compress_func)(deflate_state *s, int flush);
 
 local block_state deflate_stored(deflate_state *s, int flush);
 local block_state deflate_fast(deflate_state *s, int flush);
+#if defined(Z_DEFLATE_SPECIALIZE) && !defined(FASTEST)
+local block_state deflate_fast_spec(deflate_state *s, int flush);
+#endif
 #ifndef FASTEST
 local block_state deflate_slow(deflate_state *s, int flush);
 #endif
 local block_state deflate_rle(deflate_state *s, int flush);
 local block_state deflate_huff(deflate_state *s, int flush);
+local block_state deflate_quick(deflate_state *s, int flush);
 
 /* ===========================================================================
  * Local data
@@ -151,7 +189,27 @@ local const config configuration_table[10] = {
  *    characters and the first MIN_MATCH bytes of str are valid (except for
  *    the last MIN_MATCH-1 bytes of the input file).
  */
+#ifdef Z_CRC_HASH
+/* Hash the MIN_MATCH bytes at str directly. The rolling UPDATE_HASH() calls
+ * that only prime ins_h are then harmless, since it is recomputed here before
+ * use. Code that fills head[] and prev[] itself must use UPDATE_INS_H().
+ */
+#define CRC_HASH(s, str) \
+   (hash_crc32c((unsigned)s->window[(str)] | \
+                ((unsigned)s->window[(str) + 1] << 8) | \
+                ((unsigned)s->window[(str) + 2] << 16)) & s->hash_mask)
 #ifdef FASTEST
+#define INSERT_STRING(s, str, match_head) \
+   (s->ins_h = CRC_HASH(s, str), \
+    match_head = s->head[s->ins_h], \
+    s->head[s->ins_h] = (Pos)(str))
+#else
+#define INSERT_STRING(s, str, match_head) \
+   (s->ins_h = CRC_HASH(s, str), \
+    match_head = s->prev[(str) & s->w_mask] = s->head[s->ins_h], \
+    s->head[s->ins_h] = (Pos)(str))
+#endif
+#elif defined(FASTEST)
 #define INSERT_STRING(s, str, match_head) \
    (UPDATE_HASH(s, s->ins_h, s->window[(str) + (MIN_MATCH-1)]), \
     match_head = s->head[s->ins_h], \
@@ -163,6 +221,17 @@ local const config configuration_table[10] = {
     s->head[s->ins_h] = (Pos)(str))
 #endif
 
+/* ===========================================================================
+ * Set ins_h to the hash key of the string at str, the same way INSERT_STRING()
+ * does, for the loops that insert strings into head[] and prev[] directly.
+ * IN  assertion: as for INSERT_STRING().
+ */
+#ifdef Z_CRC_HASH
+#define UPDATE_INS_H(s, str) (s->ins_h = CRC_HASH(s, str))
+#else
+#define UPDATE_INS_H(s, str) UPDATE_HASH(s, s->ins_h, s->window[(str) + (MIN_MATCH-1)])
+#endif
+
 /* ===========================================================================
  * Initialize the hash table (avoiding 64K overflow for 16 bit systems).
  * prev[] will be initialized on the fly.
@@ -181,30 +250,88 @@ local const config configuration_table[10] = {
  */
 #if defined(__has_feature)
 #  if __has_feature(memory_sanitizer)
-     __attribute__((no_sanitize("memory")))
+#    define NO_SANITIZE_MEMORY __attribute__((no_sanitize("memory")))
 #  endif
 #endif
-local void slide_hash(deflate_state *s) {
-    unsigned n, m;
-    Posf *p;
-    uInt wsize = s->w_size;
+#ifndef NO_SANITIZE_MEMORY
+#  define NO_SANITIZE_MEMORY
+#endif
+
+/* Slide one table (head[] or prev[]) of n entries down by wsize. In prev[],
+ * entries that are not on any hash chain are garbage but their values will
+ * never be used.
+ */
+NO_SANITIZE_MEMORY
+local void slide_table(Posf *table, unsigned n, uInt wsize) {
+    unsigned m;
+    Posf *p = &table[n];
 
-    n = s->hash_size;
-    p = &s->head[n];
     do {
         m = *--p;
         *p = (Pos)(m >= wsize ? m - wsize : NIL);
     } while (--n);
-    n = wsize;
-#ifndef FASTEST
-    p = &s->prev[n];
+}
+
+/* Vector versions of slide_table(). A saturating 16-bit subtract computes
+ * m >= wsize ? m - wsize : 0 and NIL is 0, so the result is the same. The
+ * table sizes are powers of two of at least 256 entries, so n is always a
+ * multiple of the vector width.
+ */
+#ifdef Z_X86_SIMD
+NO_SANITIZE_MEMORY __attribute__((target("sse2")))
+local void slide_table_sse2(Posf *table, unsigned n, uInt wsize) {
+    const __m128i w = _mm_set1_epi16((short)wsize);
+
     do {
-        m = *--p;
-        *p = (Pos)(m >= wsize ? m - wsize : NIL);
-        /* If n is not on any hash chain, prev[n] is garbage but
-         * its value will never be used.
-         */
-    } while (--n);
+        __m128i v = _mm_loadu_si128((const __m128i *)table);
+        _mm_storeu_si128((__m128i *)table, _mm_subs_epu16(v, w));
+        table += 8;
+        n -= 8;
+    } while (n);
+}
+
+NO_SANITIZE_MEMORY __attribute__((target("avx2")))
+local void slide_table_avx2(Posf *table, unsigned n, uInt wsize) {
+    const __m256i w = _mm256_set1_epi16((short)wsize);
+
+    do {
+        __m256i v = _mm256_loadu_si256((const __m256i *)table);
+        _mm256_storeu_si256((__m256i *)table, _mm256_subs_epu16(v, w));
+        table += 16;
+        n -= 16;
+    } while (n);
+}
+#elif defined(Z_NEON_SIMD)
+NO_SANITIZE_MEMORY
+local void slide_table_neon(Posf *table, unsigned n, uInt wsize) {
+    const uint16x8_t w = vdupq_n_u16((uint16_t)wsize);
+
+    do {
+        vst1q_u16(table, vqsubq_u16(vld1q_u16(table), w));
+        table += 8;
+        n -= 8;
+    } while (n);
+}
+#endif
+
+local void slide_hash(deflate_state *s) {
+    void (*slide)(Posf *, unsigned, uInt) = slide_table;
+    uInt wsize = s->w_size;
+
+#ifdef Z_X86_SIMD
+    {
+        unsigned cpu = z_cpu_features();
+        if (cpu & Z_CPU_AVX2)
+            slide = slide_table_avx2;
+        else if (cpu & Z_CPU_SSE2)
+            slide = slide_table_sse2;
+    }
+#elif defined(Z_NEON_SIMD)
+    slide = slide_table_neon;
+#endif
+    slide(s->head, s->hash_size, wsize);
+#ifndef FASTEST
+    slide(s->prev, wsize, wsize);
 #endif
 }
 
@@ -312,7 +439,7 @@ local void fill_window(deflate_state *s) {
             Call UPDATE_HASH() MIN_MATCH-3 more times
 #endif
             while (s->insert) {
-                UPDATE_HASH(s, s->ins_h, s->window[str + MIN_MATCH-1]);
+                UPDATE_INS_H(s, str);
 #ifndef FASTEST
                 s->prev[str & s->w_mask] = s->head[s->ins_h];
 #endif
@@ -425,7 +552,7 @@ int ZEXPORT deflateInit2_(z_streamp strm, int level, int method,
 #endif
     if (memLevel < 1 || memLevel > MAX_MEM_LEVEL || method != Z_DEFLATED ||
         windowBits < 8 || windowBits > 15 || level < 0 || level > 9 ||
-        strategy < 0 || strategy > Z_FIXED || (windowBits == 8 && wrap != 1)) {
+        strategy < 0 || strategy > Z_QUICK || (windowBits == 8 && wrap != 1)) {
         return Z_STREAM_ERROR;
     }
     if (windowBits == 8) windowBits = 9;  /* until 256-byte window bug fixed */
@@ -589,7 +716,7 @@ int ZEXPORT deflateSetDictionary(z_streamp strm, const Bytef *dictionary,
         str = s->strstart;
         n = s->lookahead - (MIN_MATCH-1);
         do {
-            UPDATE_HASH(s, s->ins_h, s->window[str + MIN_MATCH-1]);
+            UPDATE_INS_H(s, str);
 #ifndef FASTEST
             s->prev[str & s->w_mask] = s->head[s->ins_h];
 #endif
@@ -761,7 +888,7 @@ int ZEXPORT deflateParams(z_streamp strm, int level, int strategy) {
 #else
     if (level == Z_DEFAULT_COMPRESSION) level = 6;
 #endif
-    if (level < 0 || level > 9 || strategy < 0 || strategy > Z_FIXED) {
+    if (level < 0 || level > 9 || strategy < 0 || strategy > Z_QUICK) {
         return Z_STREAM_ERROR;
     }
     func = configuration_table[s->level].func;
@@ -1182,6 +1309,10 @@ int ZEXPORT deflate(z_streamp strm, int flush) {
         bstate = s->level == 0 ? deflate_stored(s, flush) :
                  s->strategy == Z_HUFFMAN_ONLY ? deflate_huff(s, flush) :
                  s->strategy == Z_RLE ? deflate_rle(s, flush) :
+                 s->strategy == Z_QUICK ? deflate_quick(s, flush) :
+#if defined(Z_DEFLATE_SPECIALIZE) && !defined(FASTEST)
+                 DEFLATE_SPECIALIZED(s) ? deflate_fast_spec(s, flush) :
+#endif
                  (*(configuration_table[s->level].func))(s, flush);
 
         if (bstate == finish_started || bstate == finish_done) {
@@ -1335,6 +1466,130 @@ int ZEXPORT deflateCopy(z_streamp dest, z_streamp source) {
 #endif /* MAXSEG_64K */
 }
 
+#ifdef Z_WIDE_MATCH
+/* ===========================================================================
+ * Return the length of the match between scan and match, given that their
+ * first three bytes are already known to be equal. This is exactly what the
+ * byte loop in longest_match() computes: offsets 3..MAX_MATCH are compared,
+ * so no byte beyond scan[MAX_MATCH] or match[MAX_MATCH] is read.
+ */
+local unsigned match_len_word(const Bytef *scan, const Bytef *match) {
+    unsigned len = MIN_MATCH;
+
+    do {
+        unsigned long long a, b, diff;
+        zmemcpy(&a, scan + len, sizeof(a));
+        zmemcpy(&b, match + len, sizeof(b));
+        diff = a ^ b;
+        if (diff)
+            return len + ((unsigned)__builtin_ctzll(diff) >> 3);
+        len += 8;
+    } while (len <= MAX_MATCH);
+    return MAX_MATCH;
+}
+
+#ifdef Z_X86_SIMD
+__attribute__((target("sse2")))
+local unsigned match_len_sse2(const Bytef *scan, const Bytef *match) {
+    unsigned len = MIN_MATCH;
+
+    do {
+        __m128i a = _mm_loadu_si128((const __m128i *)(scan + len));
+        __m128i b = _mm_loadu_si128((const __m128i *)(match + len));
+        unsigned diff = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) ^
+                        0xffff;
+        if (diff)
+            return len + (unsigned)__builtin_ctz(diff);
+        len += 16;
+    } while (len <= MAX_MATCH);
+    return MAX_MATCH;
+}
+
+__attribute__((target("avx2")))
+local unsigned match_len_avx2(const Bytef *scan, const Bytef *match) {
+    unsigned len = MIN_MATCH;
+
+    do {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(scan + len));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(match + len));
+        unsigned diff = ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+        if (diff)
+            return len + (unsigned)__builtin_ctz(diff);
+        len += 32;
+    } while (len <= MAX_MATCH);
+    return MAX_MATCH;
+}
+#elif defined(Z_NEON_SIMD)
+local unsigned match_len_neon(const Bytef *scan, const Bytef *match) {
+    unsigned len = MIN_MATCH;
+
+    do {
+        uint8x16_t eq = vceqq_u8(vld1q_u8(scan + len), vld1q_u8(match + len));
+        /* narrow each byte lane to a nibble: 64 bits, 4 per byte */
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(
+            vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+        if (~mask)
+            return len + ((unsigned)__builtin_ctzll(~mask) >> 2);
+        len += 16;
+    } while (len <= MAX_MATCH);
+    return MAX_MATCH;
+}
+#endif
+
+typedef unsigned (*match_len_func)(const Bytef *scan, const Bytef *match);
+
+/* Select the match length kernel once per process */
+local match_len_func select_match_len(void) {
+    static match_len_func selected = NULL;
+    match_len_func func = selected;
+
+    if (func == NULL) {
+        func = match_len_word;
+#ifdef Z_X86_SIMD
+        {
+            unsigned cpu = z_cpu_features();
+            if (cpu & Z_CPU_AVX2)
+                func = match_len_avx2;
+            else if (cpu & Z_CPU_SSE2)
+                func = match_len_sse2;
+        }
+#elif defined(Z_NEON_SIMD)
+        func = match_len_neon;
+#endif
+        selected = func;
+    }
+    return func;
+}
+#endif /* Z_WIDE_MATCH */
+
+/* ===========================================================================
+ * Report the match length kernel and insert hash deflate uses, by name
+ */
+void ZLIB_INTERNAL deflate_kernels(const char **match_len, const char **hash) {
+#ifdef Z_WIDE_MATCH
+    match_len_func func = select_match_len();
+
+    *match_len = "word";
+#ifdef Z_X86_SIMD
+    if (func == match_len_avx2)
+        *match_len = "avx2";
+    else if (func == match_len_sse2)
+        *match_len = "sse2";
+#elif defined(Z_NEON_SIMD)
+    if (func == match_len_neon)
+        *match_len = "neon";
+#endif
+    (void)func;
+#else
+    *match_len = "bytewise";
+#endif
+#ifdef Z_CRC_HASH
+    *hash = "crc32c";
+#else
+    *hash = "rolling";
+#endif
+}
+
 #ifndef FASTEST
 /* ===========================================================================
  * Set match_start to the longest match starting at the given string and
@@ -1367,8 +1622,12 @@ local uInt longest_match(deflate_state *s, IPos cur_match) {
     register Bytef *strend = s->window + s->strstart + MAX_MATCH - 1;
     register ush scan_start = *(ushf*)scan;
     register ush scan_end   = *(ushf*)(scan + best_len - 1);
+#else
+#ifdef Z_WIDE_MATCH
+    match_len_func match_len = select_match_len();
 #else
     register Bytef *strend = s->window + s->strstart + MAX_MATCH;
+#endif
     register Byte scan_end1  = scan[best_len - 1];
     register Byte scan_end   = scan[best_len];
 #endif
@@ -1442,7 +1701,14 @@ local uInt longest_match(deflate_state *s, IPos cur_match) {
             match[best_len - 1] != scan_end1 ||
             *match              != *scan     ||
             *++match            != scan[1])      continue;
+#ifdef Z_CRC_HASH
+        /* The CRC hash does not imply scan[2] == match[2] */
+        if (match[1] != scan[2]) continue;
+#endif
 
+#ifdef Z_WIDE_MATCH
+        len = (int)match_len(scan, match - 1);
+#else
         /* The check at best_len - 1 can be removed because it will be made
          * again later. (This heuristic is not always a win.)
          * It is not necessary to compare scan[2] and match[2] since they
@@ -1467,6 +1733,7 @@ local uInt longest_match(deflate_state *s, IPos cur_match) {
 
         len = MAX_MATCH - (int)(strend - scan);
         scan = strend - MAX_MATCH;
+#endif /* Z_WIDE_MATCH */
 
 #endif /* UNALIGNED_OK */
 
@@ -1901,6 +2168,165 @@ local block_state deflate_fast(deflate_state *s, int flush) {
     return block_done;
 }
 
+#if defined(Z_DEFLATE_SPECIALIZE) && !defined(FASTEST)
+/* ===========================================================================
+ * Copies of longest_match() and deflate_fast() for the configuration fixed at
+ * build time by Z_DEFLATE_SPEC_LEVEL, Z_DEFLATE_SPEC_WBITS and
+ * Z_DEFLATE_SPEC_MEMLEVEL (see deflate.h). The window and hash masks, hash
+ * shift, match limits and chain length are constants here instead of loads
+ * from s, so the compiler can fold them, keep more in registers and unroll
+ * the short chain walk. deflate() only calls them while DEFLATE_SPECIALIZED(s)
+ * holds. They find the same matches as the generic functions, so the output
+ * is byte for byte the same.
+ */
+#define SPEC_UPDATE_HASH(h, c) \
+    (h = (((h) << Z_SPEC_HASH_SHIFT) ^ (c)) & Z_SPEC_HASH_MASK)
+
+#ifdef Z_CRC_HASH
+#define SPEC_INSERT_STRING(s, str, match_head) \
+   (s->ins_h = hash_crc32c((unsigned)s->window[(str)] | \
+                           ((unsigned)s->window[(str) + 1] << 8) | \
+                           ((unsigned)s->window[(str) + 2] << 16)) & \
+               Z_SPEC_HASH_MASK, \
+    match_head = s->prev[(str) & Z_SPEC_W_MASK] = s->head[s->ins_h], \
+    s->head[s->ins_h] = (Pos)(str))
+#else
+#define SPEC_INSERT_STRING(s, str, match_head) \
+   (SPEC_UPDATE_HASH(s->ins_h, s->window[(str) + (MIN_MATCH-1)]), \
+    match_head = s->prev[(str) & Z_SPEC_W_MASK] = s->head[s->ins_h], \
+    s->head[s->ins_h] = (Pos)(str))
+#endif
+
+local uInt longest_match_spec(deflate_state *s, IPos cur_match) {
+    unsigned chain_length = Z_SPEC_CHAIN;
+    Bytef *scan = s->window + s->strstart;
+    Bytef *match;
+    int len;
+    int best_len = (int)s->prev_length;
+    int nice_match = Z_SPEC_NICE;
+    IPos limit = s->strstart > (IPos)Z_SPEC_MAX_DIST ?
+        s->strstart - (IPos)Z_SPEC_MAX_DIST : NIL;
+    Posf *prev = s->prev;
+#ifdef Z_WIDE_MATCH
+    match_len_func match_len = select_match_len();
+#else
+    Bytef *strend = s->window + s->strstart + MAX_MATCH;
+#endif
+    Byte scan_end1 = scan[best_len - 1];
+    Byte scan_end = scan[best_len];
+
+    if (s->prev_length >= Z_SPEC_GOOD) {
+        chain_length >>= 2;
+    }
+    if ((uInt)nice_match > s->lookahead) nice_match = (int)s->lookahead;
+
+    Assert((ulg)s->strstart <= s->window_size - MIN_LOOKAHEAD,
+           "need lookahead");
+
+    do {
+        Assert(cur_match < s->strstart, "no future");
+        match = s->window + cur_match;
+
+        if (match[best_len]     != scan_end  ||
+            match[best_len - 1] != scan_end1 ||
+            *match              != *scan     ||
+            *++match            != scan[1])      continue;
+#ifdef Z_CRC_HASH
+        if (match[1] != scan[2]) continue;
+#endif
+
+#ifdef Z_WIDE_MATCH
+        len = (int)match_len(scan, match - 1);
+#else
+        scan += 2, match++;
+        do {
+        } while (*++scan == *++match && *++scan == *++match &&
+                 *++scan == *++match && *++scan == *++match &&
+                 *++scan == *++match && *++scan == *++match &&
+                 *++scan == *++match && *++scan == *++match &&
+                 scan < strend);
+
+        len = MAX_MATCH - (int)(strend - scan);
+        scan = strend - MAX_MATCH;
+#endif
+
+        if (len > best_len) {
+            s->match_start = cur_match;
+            best_len = len;
+            if (len >= nice_match) break;
+            scan_end1  = scan[best_len - 1];
+            scan_end   = scan[best_len];
+        }
+    } while ((cur_match = prev[cur_match & Z_SPEC_W_MASK]) > limit
+             && --chain_length != 0);
+
+    if ((uInt)best_len <= s->lookahead) return (uInt)best_len;
+    return s->lookahead;
+}
+
+local block_state deflate_fast_spec(deflate_state *s, int flush) {
+    IPos hash_head;       /* head of the hash chain */
+    int bflush;           /* set if current block must be flushed */
+
+    for (;;) {
+        if (s->lookahead < MIN_LOOKAHEAD) {
+            fill_window(s);
+            if (s->lookahead < MIN_LOOKAHEAD && flush == Z_NO_FLUSH) {
+                return need_more;
+            }
+            if (s->lookahead == 0) break; /* flush the current block */
+        }
+
+        hash_head = NIL;
+        if (s->lookahead >= MIN_MATCH) {
+            SPEC_INSERT_STRING(s, s->strstart, hash_head);
+        }
+
+        if (hash_head != NIL && s->strstart - hash_head <= Z_SPEC_MAX_DIST) {
+            s->match_length = longest_match_spec(s, hash_head);
+        }
+        if (s->match_length >= MIN_MATCH) {
+            check_match(s, s->strstart, s->match_start, s->match_length);
+
+            _tr_tally_dist(s, s->strstart - s->match_start,
+                           s->match_length - MIN_MATCH, bflush);
+
+            s->lookahead -= s->match_length;
+
+            if (s->match_length <= Z_SPEC_LAZY &&
+                s->lookahead >= MIN_MATCH) {
+                s->match_length--; /* string at strstart already in table */
+                do {
+                    s->strstart++;
+                    SPEC_INSERT_STRING(s, s->strstart, hash_head);
+                } while (--s->match_length != 0);
+                s->strstart++;
+            } else {
+                s->strstart += s->match_length;
+                s->match_length = 0;
+                s->ins_h = s->window[s->strstart];
+                SPEC_UPDATE_HASH(s->ins_h, s->window[s->strstart + 1]);
+            }
+        } else {
+            /* No match, output a literal byte */
+            Tracevv((stderr,"%c", s->window[s->strstart]));
+            _tr_tally_lit(s, s->window[s->strstart], bflush);
+            s->lookahead--;
+            s->strstart++;
+        }
+        if (bflush) FLUSH_BLOCK(s, 0);
+    }
+    s->insert = s->strstart < MIN_MATCH-1 ? s->strstart : MIN_MATCH-1;
+    if (flush == Z_FINISH) {
+        FLUSH_BLOCK(s, 1);
+        return finish_done;
+    }
+    if (s->sym_next)
+        FLUSH_BLOCK(s, 0);
+    return block_done;
+}
+#endif /* Z_DEFLATE_SPECIALIZE */
+
 #ifndef FASTEST
 /* ===========================================================================
  * Same as above, but achieves better compression. We use a lazy
@@ -2102,6 +2528,99 @@ local block_state deflate_rle(deflate_state *s, int flush) {
     return block_done;
 }
 
+/* ===========================================================================
+ * Length of the match at cur_match for Z_QUICK, or 0 if it is shorter than
+ * MIN_MATCH.  The bytes are compared explicitly, without relying on the hash.
+ */
+local uInt quick_match(deflate_state *s, IPos cur_match) {
+    Bytef *scan = s->window + s->strstart;
+    Bytef *match = s->window + cur_match;
+    uInt max = s->lookahead < MAX_MATCH ? s->lookahead : MAX_MATCH;
+    uInt len;
+
+    if (scan[0] != match[0] || scan[1] != match[1] || scan[2] != match[2])
+        return 0;
+    len = MIN_MATCH;
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    /* Compare eight bytes at a time while they are all in the lookahead */
+    while (len + 8 <= max) {
+        unsigned long long a, b;
+        zmemcpy(&a, scan + len, 8);
+        zmemcpy(&b, match + len, 8);
+        if (a != b) {
+            return len + ((uInt)__builtin_ctzll(a ^ b) >> 3);
+        }
+        len += 8;
+    }
+#endif
+    while (len < max && scan[len] == match[len])
+        len++;
+    return len;
+}
+
+/* ===========================================================================
+ * For Z_QUICK, same as deflate_fast() but probe only the head of the hash
+ * chain, and do not insert the strings of a match.  Blocks are always coded
+ * with the static trees or stored (see _tr_flush_block()).  The hash table
+ * and chains are maintained as usual, so deflateParams() may switch to and
+ * from this strategy at any time.
+ */
+local block_state deflate_quick(deflate_state *s, int flush) {
+    IPos hash_head;       /* head of the hash chain */
+    int bflush;           /* set if current block must be flushed */
+
+    for (;;) {
+        /* Same lookahead requirements as deflate_fast() */
+        if (s->lookahead < MIN_LOOKAHEAD) {
+            fill_window(s);
+            if (s->lookahead < MIN_LOOKAHEAD && flush == Z_NO_FLUSH) {
+                return need_more;
+            }
+            if (s->lookahead == 0) break; /* flush the current block */
+        }
+
+        hash_head = NIL;
+        if (s->lookahead >= MIN_MATCH) {
+            INSERT_STRING(s, s->strstart, hash_head);
+        }
+
+        s->match_length = 0;
+        if (hash_head != NIL && s->strstart - hash_head <= MAX_DIST(s))
+            s->match_length = quick_match(s, hash_head);
+        if (s->match_length >= MIN_MATCH) {
+            check_match(s, s->strstart, hash_head, s->match_length);
+
+            _tr_tally_dist(s, s->strstart - hash_head,
+                           s->match_length - MIN_MATCH, bflush);
+
+            s->lookahead -= s->match_length;
+            s->strstart += s->match_length;
+            s->match_length = 0;
+            s->ins_h = s->window[s->strstart];
+            UPDATE_HASH(s, s->ins_h, s->window[s->strstart + 1]);
+#if MIN_MATCH != 3
+            Call UPDATE_HASH() MIN_MATCH-3 more times
+#endif
+        } else {
+            /* No match, output a literal byte */
+            Tracevv((stderr,"%c", s->window[s->strstart]));
+            _tr_tally_lit(s, s->window[s->strstart], bflush);
+            s->lookahead--;
+            s->strstart++;
+        }
+        if (bflush) FLUSH_BLOCK(s, 0);
+    }
+    s->insert = s->strstart < MIN_MATCH-1 ? s->strstart : MIN_MATCH-1;
+    if (flush == Z_FINISH) {
+        FLUSH_BLOCK(s, 1);
+        return finish_done;
+    }
+    if (s->sym_next)
+        FLUSH_BLOCK(s, 0);
+    return block_done;
+}
+
 /* ===========================================================================
  * For Z_HUFFMAN_ONLY, do not look for matches.  Do not maintain a hash table.
  * (It will be regenerated if this run of deflate switches away from Huffman.)
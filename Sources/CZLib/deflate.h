@@ -301,6 +301,70 @@ typedef struct internal_state {
 /* Number of bytes after end of data in window to initialize in order to avoid
    memory checker errors from longest match routines */
 
+#if defined(Z_DEFLATE_SPECIALIZE) && !defined(FASTEST)
+/* Build-time specialization of deflate_fast() and longest_match() for one
+ * configuration, by default level 1 with a 32K window and memLevel 8 (raw,
+ * zlib or gzip framing alike). Streams with other parameters, or changed by
+ * deflateParams() or deflateTune(), keep using the generic functions.
+ */
+#  ifndef Z_DEFLATE_SPEC_LEVEL
+#    define Z_DEFLATE_SPEC_LEVEL 1
+#  endif
+#  ifndef Z_DEFLATE_SPEC_WBITS
+#    define Z_DEFLATE_SPEC_WBITS 15
+#  endif
+#  ifndef Z_DEFLATE_SPEC_MEMLEVEL
+#    define Z_DEFLATE_SPEC_MEMLEVEL 8
+#  endif
+
+/* Same values as the configuration_table entry in deflate.c */
+#  if Z_DEFLATE_SPEC_LEVEL == 1
+#    define Z_SPEC_GOOD   4
+#    define Z_SPEC_LAZY   4
+#    define Z_SPEC_NICE   8
+#    define Z_SPEC_CHAIN  4
+#  elif Z_DEFLATE_SPEC_LEVEL == 2
+#    define Z_SPEC_GOOD   4
+#    define Z_SPEC_LAZY   5
+#    define Z_SPEC_NICE   16
+#    define Z_SPEC_CHAIN  8
+#  elif Z_DEFLATE_SPEC_LEVEL == 3
+#    define Z_SPEC_GOOD   4
+#    define Z_SPEC_LAZY   6
+#    define Z_SPEC_NICE   32
+#    define Z_SPEC_CHAIN  32
+#  else
+#    error "Z_DEFLATE_SPEC_LEVEL must be 1, 2 or 3, the levels using deflate_fast()"
+#  endif
+#  if Z_DEFLATE_SPEC_WBITS < 9 || Z_DEFLATE_SPEC_WBITS > 15
+#    error "Z_DEFLATE_SPEC_WBITS must be between 9 and 15"
+#  endif
+#  if Z_DEFLATE_SPEC_MEMLEVEL < 1 || Z_DEFLATE_SPEC_MEMLEVEL > MAX_MEM_LEVEL
+#    error "Z_DEFLATE_SPEC_MEMLEVEL must be between 1 and MAX_MEM_LEVEL"
+#  endif
+
+#  define Z_SPEC_W_SIZE     (1U << Z_DEFLATE_SPEC_WBITS)
+#  define Z_SPEC_W_MASK     (Z_SPEC_W_SIZE - 1)
+#  define Z_SPEC_MAX_DIST   (Z_SPEC_W_SIZE - MIN_LOOKAHEAD)
+#  define Z_SPEC_HASH_BITS  (Z_DEFLATE_SPEC_MEMLEVEL + 7)
+#  define Z_SPEC_HASH_MASK  ((1U << Z_SPEC_HASH_BITS) - 1)
+#  define Z_SPEC_HASH_SHIFT ((Z_SPEC_HASH_BITS + MIN_MATCH - 1) / MIN_MATCH)
+
+/* Whether deflate() takes the specialized path for s. The strategies are the
+ * ones deflate_fast() serves; Z_FIXED only changes the block trees.
+ */
+#  define DEFLATE_SPECIALIZED(s) \
+    ((s)->level == Z_DEFLATE_SPEC_LEVEL && \
+     ((s)->strategy == Z_DEFAULT_STRATEGY || (s)->strategy == Z_FILTERED || \
+      (s)->strategy == Z_FIXED) && \
+     (s)->w_bits == Z_DEFLATE_SPEC_WBITS && \
+     (s)->hash_bits == Z_SPEC_HASH_BITS && \
+     (s)->max_chain_length == Z_SPEC_CHAIN && \
+     (s)->max_lazy_match == Z_SPEC_LAZY && \
+     (s)->good_match == Z_SPEC_GOOD && \
+     (s)->nice_match == Z_SPEC_NICE)
+#endif
+
         /* in trees.c */
 void ZLIB_INTERNAL _tr_init(deflate_state *s);
 int ZLIB_INTERNAL _tr_tally(deflate_state *s, unsigned dist, unsigned lc);
@@ -50,12 +50,17 @@
 #endif
 #endif
 
-#ifdef _WIN32
+// Windows, and builds that do not link the system libz (SWIFTZLIB_VENDORED_ZLIB in
+// Package.swift), compile against the vendored header
+#if defined(_WIN32) || defined(SWIFTZLIB_VENDORED_ZLIB)
 #include "../zlib.h"
 #else
 #include <zlib.h>
 #endif
 
+#include <stdint.h>
+#include <stdio.h>
+
 // Type definitions for callback functions
 typedef int (*swift_in_func)(void *, unsigned char **, int *);
 typedef int (*swift_out_func)(void *, unsigned char *, int);
@@ -93,6 +98,9 @@ int swift_inflateBack(z_streamp strm, in_func in, void *in_desc, out_func out, v
 int swift_inflateBackInit(z_streamp strm, int windowBits, unsigned char *window);
 int swift_inflateBackEnd(z_streamp strm);
 int swift_inflateBackWithCallbacks(z_streamp strm, swift_in_func in_func, void *in_desc, swift_out_func out_func, void *out_desc);
+// inflateBack over a contiguous buffer: out_func returns 0 to continue, non-zero to abort.
+// chunkSize caps each slice handed to inflateBack (0 = as large as possible).
+int swift_inflateBackBuffer(z_streamp strm, const unsigned char *input, size_t inputLength, size_t chunkSize, swift_out_func out_func, void *out_desc, size_t *consumed);
 
 // Advanced stream functions
 int swift_deflateParams(z_streamp strm, int level, int strategy);
@@ -126,6 +134,10 @@ int swift_inflatePending(z_streamp strm, unsigned *pending, int *bits);
 // Checksum combination functions
 uLong swift_adler32_combine(uLong adler1, uLong adler2, z_off_t len2);
 uLong swift_crc32_combine(uLong crc1, uLong crc2, z_off_t len2);
+uLong swift_adler32_combine64(uLong adler1, uLong adler2, int64_t len2);
+uLong swift_crc32_combine64(uLong crc1, uLong crc2, int64_t len2);
+uLong swift_crc32_combine_gen64(int64_t len2);
+uLong swift_crc32_combine_op(uLong crc1, uLong crc2, uLong op);
 
 // Compile flags
 uLong swift_zlibCompileFlags(void);
@@ -135,11 +147,15 @@ void* swift_gzopen(const char* path, const char* mode);
 int swift_gzclose(void* file);
 int swift_gzread(void* file, void* buf, unsigned int len);
 int swift_gzwrite(void* file, void* buf, unsigned int len);
+int swift_gzbuffer(void* file, unsigned size);
+size_t swift_gzfread(void* buf, size_t size, size_t nitems, void* file);
+size_t swift_gzfwrite(const void* buf, size_t size, size_t nitems, void* file);
 long swift_gzseek(void* file, long offset, int whence);
 long swift_gztell(void* file);
 int swift_gzflush(void* file, int flush);
 int swift_gzrewind(void* file);
 int swift_gzeof(void* file);
+int swift_gzdirect(void* file);
 int swift_gzsetparams(void* file, int level, int strategy);
 int swift_gzprintf(void* file, const char* format, ...);
 char* swift_gzgets(void* file, char* buf, int len);
@@ -157,8 +173,84 @@ int swift_inflateGetHeader(z_streamp strm, gz_headerp head);
 // Utility functions
 uLong swift_adler32(uLong adler, const Bytef *buf, uInt len);
 uLong swift_crc32(uLong crc, const Bytef *buf, uInt len);
+uLong swift_adler32_z(uLong adler, const Bytef *buf, size_t len);
+uLong swift_crc32_z(uLong crc, const Bytef *buf, size_t len);
 uLong swift_compressBound(uLong sourceLen);
 
+// Arena allocator for z_stream state (see zlib_shim.c)
+typedef struct swift_zarena swift_zarena_t;
+swift_zarena_t *swift_zarena_create(size_t capacity);
+void swift_zarena_destroy(swift_zarena_t *arena);
+void swift_zarena_attach(z_streamp strm, swift_zarena_t *arena);
+size_t swift_zarena_used(const swift_zarena_t *arena);
+size_t swift_zarena_peak(const swift_zarena_t *arena);
+size_t swift_zarena_capacity(const swift_zarena_t *arena);
+size_t swift_zarena_fallbacks(const swift_zarena_t *arena);
+size_t swift_zarena_deflate_size(int windowBits, int memLevel);
+size_t swift_zarena_inflate_size(int windowBits);
+
+// Cumulative calls/bytes of zlib's default allocator (zcalloc), for benchmarking.
+// Counted only when CZLib is built with Z_ALLOC_STATS; returns 0 (and zeros) otherwise.
+int swift_zalloc_stats(uint64_t *calls, uint64_t *bytes);
+
+// zlib implementation and kernels in use (see zlib_backend.c)
+typedef struct {
+    int vendored;                    // the linked zlib is the vendored CZLib copy
+    unsigned cpu_features;           // CPU features detected at run time, Z_CPU_* bits of zutil.h
+    const char *adler32_kernel;      // e.g. "avx2", "neon", "portable"
+    const char *crc32_kernel;        // e.g. "pclmul", "armv8-crc32", "braided"
+    const char *match_kernel;        // deflate match length: "avx2", "sse2", "neon", "word", "bytewise"
+    const char *insert_hash;         // deflate insert hash: "rolling" or "crc32c"
+    int inflate_wide;                // inflate_fast() uses the 64-bit bit buffer loop
+    int specialized_level;           // Z_DEFLATE_SPECIALIZE configuration, 0 when not built in
+    int specialized_window_bits;
+    int specialized_mem_level;
+} swift_zlib_backend_t;
+void swift_zlib_backend(swift_zlib_backend_t *info);
+
+// Bytes of state currently allocated by a deflate or inflate stream (see zlib_metrics.c)
+size_t swift_deflate_state_bytes(z_streamp strm);
+size_t swift_inflate_state_bytes(z_streamp strm);
+
+// Random-access index for deflate/zlib/gzip streams (see zlib_zran.c)
+typedef struct swift_zran_index swift_zran_index_t;
+int swift_zran_build_file(FILE *in, int64_t span, swift_zran_index_t **built);
+int swift_zran_build_buffer(const unsigned char *data, size_t size, int64_t span, swift_zran_index_t **built);
+int64_t swift_zran_extract_file(FILE *in, const swift_zran_index_t *index, int64_t offset, unsigned char *buf, size_t len);
+int64_t swift_zran_extract_buffer(const unsigned char *data, size_t size, const swift_zran_index_t *index, int64_t offset, unsigned char *buf, size_t len);
+int64_t swift_zran_restart(z_streamp strm, const unsigned char *data, size_t size, const swift_zran_index_t *index, int64_t offset, int64_t *in_offset);
+void swift_zran_free(swift_zran_index_t *index);
+int swift_zran_mode(const swift_zran_index_t *index);
+int swift_zran_count(const swift_zran_index_t *index);
+int64_t swift_zran_span(const swift_zran_index_t *index);
+int64_t swift_zran_length(const swift_zran_index_t *index);
+int64_t swift_zran_source_size(const swift_zran_index_t *index);
+int64_t swift_zran_stream_size(const swift_zran_index_t *index);
+int64_t swift_zran_source_mtime(const swift_zran_index_t *index);
+unsigned long swift_zran_source_check(const swift_zran_index_t *index);
+void swift_zran_set_source(swift_zran_index_t *index, int64_t mtime, unsigned long check);
+int64_t swift_zran_point_offset(const swift_zran_index_t *index, int64_t offset);
+int swift_zran_save(const swift_zran_index_t *index, FILE *out);
+int swift_zran_load(FILE *in, swift_zran_index_t **loaded);
+int64_t swift_zran_gzseek(void *file, const swift_zran_index_t *index, int64_t offset);
+
+// Speculative parallel inflate of one raw/zlib/gzip stream (see zlib_pinflate.c).
+// mode: 0 raw, 1 zlib, 2 gzip. A round is begun, its chunks decoded and then resolved
+// concurrently (one call per chunk), its outputs taken, and the round ended.
+typedef struct swift_pinflate swift_pinflate_t;
+swift_pinflate_t *swift_pinflate_create(const unsigned char *input, size_t length, int mode, size_t chunk_size, int chunk_count, size_t max_chunk_output, int *status);
+void swift_pinflate_free(swift_pinflate_t *p);
+int swift_pinflate_begin_round(swift_pinflate_t *p);
+void swift_pinflate_decode_chunk(swift_pinflate_t *p, int index);
+int swift_pinflate_stitch(swift_pinflate_t *p);
+int swift_pinflate_resolve_chunk(swift_pinflate_t *p, int index);
+int swift_pinflate_serial_round(swift_pinflate_t *p);
+unsigned char *swift_pinflate_take_output(swift_pinflate_t *p, int index, size_t *length);
+int swift_pinflate_end_round(swift_pinflate_t *p);
+int64_t swift_pinflate_finish(const swift_pinflate_t *p);
+int64_t swift_pinflate_speculative_chunks(const swift_pinflate_t *p);
+int64_t swift_pinflate_serial_rounds(const swift_pinflate_t *p);
+
 // Version and error functions
 const char* swift_zlibVersion(void);
 const char* swift_zError(int err);
@@ -12,6 +12,14 @@
 #  pragma message("Assembler code may have bugs -- use at your own risk")
 #else
 
+/* The wide bit buffer path needs a 64-bit unsigned long, little-endian byte
+   order for the 8-byte refill, and unaligned loads via memcpy() */
+#if !defined(Z_NO_SIMD) && !defined(INFLATE_NO_WIDE) && \
+    (defined(__GNUC__) || defined(__clang__)) && defined(__LP64__) && \
+    defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#  define INFLATE_WIDE
+#endif
+
 /*
    Decode literal, length, and distance codes and write out the resulting
    literal and match bytes until either not enough input or output is
@@ -47,6 +55,304 @@
       requires strm->avail_out >= 258 for each loop to avoid checking for
       output space.
  */
+#ifdef INFLATE_WIDE
+/*
+   Wide bit buffer variant of inflate_fast() for 64-bit little-endian targets.
+   Instead of adding input a byte at a time, each loop iteration refills the
+   64-bit hold with one unaligned 8-byte load, which leaves at least 56 bits:
+   enough for a complete length/distance pair (48 bits at most), so none of
+   the per-field refills are needed. Bytes already in hold above bits are
+   loaded again at the same position, so or-ing the new load in is exact.
+   After a literal there are still at least 41 bits, so a second literal is
+   decoded without going around the loop. Matches copied from the output
+   with a distance of at least eight bytes are copied eight bytes at a time.
+
+   inflate_fast() uses this when there is enough slack: WIDE_IN_SLACK bytes
+   of input so the 8-byte load never reads past next_in + avail_in, and
+   WIDE_OUT_SLACK bytes of output for a maximal match plus the overrun of the
+   last 8-byte chunk. The remaining tail goes through the byte-wise code.
+ */
+#define WIDE_IN_SLACK 8
+#define WIDE_OUT_SLACK (258 + 8)
+
+#define REFILL() \
+    do { \
+        unsigned long word; \
+        zmemcpy(&word, in, sizeof(word)); \
+        hold |= word << bits; \
+        in += (63 - bits) >> 3; \
+        bits |= 56; \
+    } while (0)
+
+#ifndef zmemset
+#  define zmemset memset
+#endif
+
+local void inflate_fast_wide(z_streamp strm, unsigned start) {
+    struct inflate_state FAR *state;
+    z_const unsigned char FAR *in;      /* local strm->next_in */
+    z_const unsigned char FAR *last;    /* have enough input while in < last */
+    unsigned char FAR *out;     /* local strm->next_out */
+    unsigned char FAR *beg;     /* inflate()'s initial strm->next_out */
+    unsigned char FAR *end;     /* while out < end, enough space available */
+#ifdef INFLATE_STRICT
+    unsigned dmax;              /* maximum distance from zlib header */
+#endif
+    unsigned wsize;             /* window size or zero if not using window */
+    unsigned whave;             /* valid bytes in the window */
+    unsigned wnext;             /* window write index */
+    unsigned char FAR *window;  /* allocated sliding window, if wsize != 0 */
+    unsigned long hold;         /* local strm->hold */
+    unsigned bits;              /* local strm->bits */
+    code const FAR *lcode;      /* local strm->lencode */
+    code const FAR *dcode;      /* local strm->distcode */
+    unsigned lmask;             /* mask for first level of length codes */
+    unsigned dmask;             /* mask for first level of distance codes */
+    code const *here;           /* retrieved table entry */
+    unsigned op;                /* code bits, operation, extra bits, or */
+                                /*  window position, window bytes to copy */
+    unsigned len;               /* match length, unused bytes */
+    unsigned dist;              /* match distance */
+    unsigned char FAR *from;    /* where to copy match from */
+
+    /* copy state to local variables */
+    state = (struct inflate_state FAR *)strm->state;
+    in = strm->next_in;
+    last = in + (strm->avail_in - (WIDE_IN_SLACK - 1));
+    out = strm->next_out;
+    beg = out - (start - strm->avail_out);
+    end = out + (strm->avail_out - (WIDE_OUT_SLACK - 1));
+#ifdef INFLATE_STRICT
+    dmax = state->dmax;
+#endif
+    wsize = state->wsize;
+    whave = state->whave;
+    wnext = state->wnext;
+    window = state->window;
+    hold = state->hold;
+    bits = state->bits;
+    lcode = state->lencode;
+    dcode = state->distcode;
+    lmask = (1U << state->lenbits) - 1;
+    dmask = (1U << state->distbits) - 1;
+
+    /* decode literals and length/distances until end-of-block or not enough
+       input data or output space */
+    do {
+        REFILL();
+        here = lcode + (hold & lmask);
+      dolen:
+        op = (unsigned)(here->bits);
+        hold >>= op;
+        bits -= op;
+        op = (unsigned)(here->op);
+        if (op == 0) {                          /* literal */
+            Tracevv((stderr, here->val >= 0x20 && here->val < 0x7f ?
+                    "inflate:         literal '%c'\n" :
+                    "inflate:         literal 0x%02x\n", here->val));
+            *out++ = (unsigned char)(here->val);
+            /* at least 41 bits are left, enough for any literal code */
+            here = lcode + (hold & lmask);
+            if (here->op == 0) {
+                hold >>= here->bits;
+                bits -= here->bits;
+                Tracevv((stderr, here->val >= 0x20 && here->val < 0x7f ?
+                        "inflate:         literal '%c'\n" :
+                        "inflate:         literal 0x%02x\n", here->val));
+                *out++ = (unsigned char)(here->val);
+            }
+        }
+        else if (op & 16) {                     /* length base */
+            len = (unsigned)(here->val);
+            op &= 15;                           /* number of extra bits */
+            if (op) {
+                len += (unsigned)hold & ((1U << op) - 1);
+                hold >>= op;
+                bits -= op;
+            }
+            Tracevv((stderr, "inflate:         length %u\n", len));
+            here = dcode + (hold & dmask);
+          dodist:
+            op = (unsigned)(here->bits);
+            hold >>= op;
+            bits -= op;
+            op = (unsigned)(here->op);
+            if (op & 16) {                      /* distance base */
+                dist = (unsigned)(here->val);
+                op &= 15;                       /* number of extra bits */
+                dist += (unsigned)hold & ((1U << op) - 1);
+#ifdef INFLATE_STRICT
+                if (dist > dmax) {
+                    strm->msg = (char *)"invalid distance too far back";
+                    state->mode = BAD;
+                    break;
+                }
+#endif
+                hold >>= op;
+                bits -= op;
+                Tracevv((stderr, "inflate:         distance %u\n", dist));
+                op = (unsigned)(out - beg);     /* max distance in output */
+                if (dist > op) {                /* see if copy from window */
+                    op = dist - op;             /* distance back in window */
+                    if (op > whave) {
+                        if (state->sane) {
+                            strm->msg =
+                                (char *)"invalid distance too far back";
+                            state->mode = BAD;
+                            break;
+                        }
+#ifdef INFLATE_ALLOW_INVALID_DISTANCE_TOOFAR_ARRR
+                        if (len <= op - whave) {
+                            do {
+                                *out++ = 0;
+                            } while (--len);
+                            continue;
+                        }
+                        len -= op - whave;
+                        do {
+                            *out++ = 0;
+                        } while (--op > whave);
+                        if (op == 0) {
+                            from = out - dist;
+                            do {
+                                *out++ = *from++;
+                            } while (--len);
+                            continue;
+                        }
+#endif
+                    }
+                    from = window;
+                    if (wnext == 0) {           /* very common case */
+                        from += wsize - op;
+                        if (op < len) {         /* some from window */
+                            len -= op;
+                            do {
+                                *out++ = *from++;
+                            } while (--op);
+                            from = out - dist;  /* rest from output */
+                        }
+                    }
+                    else if (wnext < op) {      /* wrap around window */
+                        from += wsize + wnext - op;
+                        op -= wnext;
+                        if (op < len) {         /* some from end of window */
+                            len -= op;
+                            do {
+                                *out++ = *from++;
+                            } while (--op);
+                            from = window;
+                            if (wnext < len) {  /* some from start of window */
+                                op = wnext;
+                                len -= op;
+                                do {
+                                    *out++ = *from++;
+                                } while (--op);
+                                from = out - dist;      /* rest from output */
+                            }
+                        }
+                    }
+                    else {                      /* contiguous in window */
+                        from += wnext - op;
+                        if (op < len) {         /* some from window */
+                            len -= op;
+                            do {
+                                *out++ = *from++;
+                            } while (--op);
+                            from = out - dist;  /* rest from output */
+                        }
+                    }
+                    while (len > 2) {
+                        *out++ = *from++;
+                        *out++ = *from++;
+                        *out++ = *from++;
+                        len -= 3;
+                    }
+                    if (len) {
+                        *out++ = *from++;
+                        if (len > 1)
+                            *out++ = *from++;
+                    }
+                }
+                else {
+                    from = out - dist;          /* copy direct from output */
+                    if (dist >= 8) {
+                        /* 8-byte chunks never overlap the bytes they read;
+                           the last chunk may write up to 7 bytes past the
+                           match, which WIDE_OUT_SLACK leaves room for */
+                        unsigned char FAR *stop = out + len;
+                        do {
+                            zmemcpy(out, from, 8);
+                            out += 8;
+                            from += 8;
+                        } while (out < stop);
+                        out = stop;
+                    }
+                    else if (dist == 1) {       /* run of one byte */
+                        zmemset(out, *from, len);
+                        out += len;
+                    }
+                    else {
+                        do {                    /* minimum length is three */
+                            *out++ = *from++;
+                            *out++ = *from++;
+                            *out++ = *from++;
+                            len -= 3;
+                        } while (len > 2);
+                        if (len) {
+                            *out++ = *from++;
+                            if (len > 1)
+                                *out++ = *from++;
+                        }
+                    }
+                }
+            }
+            else if ((op & 64) == 0) {          /* 2nd level distance code */
+                here = dcode + here->val + (hold & ((1U << op) - 1));
+                goto dodist;
+            }
+            else {
+                strm->msg = (char *)"invalid distance code";
+                state->mode = BAD;
+                break;
+            }
+        }
+        else if ((op & 64) == 0) {              /* 2nd level length code */
+            here = lcode + here->val + (hold & ((1U << op) - 1));
+            goto dolen;
+        }
+        else if (op & 32) {                     /* end-of-block */
+            Tracevv((stderr, "inflate:         end of block\n"));
+            state->mode = TYPE;
+            break;
+        }
+        else {
+            strm->msg = (char *)"invalid literal/length code";
+            state->mode = BAD;
+            break;
+        }
+    } while (in < last && out < end);
+
+    /* return unused bytes (all of them came from the last refill) */
+    len = bits >> 3;
+    in -= len;
+    bits -= len << 3;
+    hold &= (1UL << bits) - 1;
+
+    /* update state and return */
+    strm->next_in = in;
+    strm->next_out = out;
+    strm->avail_in = (unsigned)(in < last ? (WIDE_IN_SLACK - 1) + (last - in) :
+                                (WIDE_IN_SLACK - 1) - (in - last));
+    strm->avail_out = (unsigned)(out < end ?
+                                 (WIDE_OUT_SLACK - 1) + (end - out) :
+                                 (WIDE_OUT_SLACK - 1) - (out - end));
+    state->hold = hold;
+    state->bits = bits;
+    return;
+}
+
+#endif /* INFLATE_WIDE */
+
 void ZLIB_INTERNAL inflate_fast(z_streamp strm, unsigned start) {
     struct inflate_state FAR *state;
     z_const unsigned char FAR *in;      /* local strm->next_in */
@@ -74,6 +380,14 @@ void ZLIB_INTERNAL inflate_fast(z_streamp strm, unsigned start) {
     unsigned dist;              /* match distance */
     unsigned char FAR *from;    /* where to copy match from */
 
+#ifdef INFLATE_WIDE
+    if (strm->avail_in >= WIDE_IN_SLACK + 8 &&
+        strm->avail_out >= WIDE_OUT_SLACK + 258) {
+        inflate_fast_wide(strm, start);
+        return;
+    }
+#endif
+
     /* copy state to local variables */
     state = (struct inflate_state FAR *)strm->state;
     in = strm->next_in;
@@ -318,3 +632,12 @@ void ZLIB_INTERNAL inflate_fast(z_streamp strm, unsigned start) {
  */
 
 #endif /* !ASMINF */
+
+/* Whether inflate_fast() has the wide bit buffer loop (see INFLATE_WIDE) */
+int ZLIB_INTERNAL inflate_wide_enabled(void) {
+#if defined(INFLATE_WIDE) && !defined(ASMINF)
+    return 1;
+#else
+    return 0;
+#endif
+}
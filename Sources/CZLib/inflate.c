@@ -239,6 +239,38 @@ int ZEXPORT inflatePrime(z_streamp strm, int bits, int value) {
     return Z_OK;
 }
 
+/*
+   Turn a raw inflate stream, positioned with inflatePrime() and
+   inflateSetDictionary() at a deflate block boundary inside a zlib or gzip
+   stream, back into a wrapped stream.  check is the running Adler-32 or CRC-32
+   of the data before that point and total its length, so the trailer is
+   verified as if the stream had been decoded from its header.  Used by the
+   random-access index in zlib_zran.c.
+ */
+int ZLIB_INTERNAL inflate_resume(z_streamp strm, int windowBits,
+                                 unsigned long check, unsigned long total) {
+    struct inflate_state FAR *state;
+
+    if (inflateStateCheck(strm)) return Z_STREAM_ERROR;
+    state = (struct inflate_state FAR *)strm->state;
+    if (state->wrap != 0 || state->mode != HEAD) return Z_STREAM_ERROR;
+    if (windowBits == 15)
+        state->flags = 0;               /* zlib: Adler-32 trailer */
+#ifdef GUNZIP
+    else if (windowBits == 31)
+        state->flags = Z_DEFLATED;      /* gzip: nonzero flags select CRC-32 */
+#endif
+    else
+        return Z_STREAM_ERROR;
+    state->wrap = (windowBits >> 4) + 5;
+    state->head = Z_NULL;
+    state->check = check;
+    strm->adler = check;
+    state->total = total;
+    state->mode = TYPE;
+    return Z_OK;
+}
+
 /*
    Return state with length and distance decoding tables and index sizes set to
    fixed code decoding.  Normally this returns fixed tables from inffixed.h.
@@ -988,6 +988,23 @@ local int detect_data_type(deflate_state *s) {
     return Z_BINARY;
 }
 
+/* ===========================================================================
+ * Bit length of the current block coded with the static trees, excluding the
+ * block header, without building the dynamic trees.  Used for Z_QUICK.
+ */
+local ulg static_block_bits(deflate_state *s) {
+    ulg bits = 0;
+    int n;
+
+    for (n = 0; n < L_CODES; n++)
+        bits += (ulg)s->dyn_ltree[n].Freq * (static_ltree[n].Len +
+                (n > LITERALS ? extra_lbits[n - LITERALS - 1] : 0));
+    for (n = 0; n < D_CODES; n++)
+        bits += (ulg)s->dyn_dtree[n].Freq * (static_dtree[n].Len +
+                extra_dbits[n]);
+    return bits;
+}
+
 /* ===========================================================================
  * Determine the best encoding for the current block: dynamic trees, static
  * trees or store, and write out the encoded block.
@@ -1004,6 +1021,13 @@ void ZLIB_INTERNAL _tr_flush_block(deflate_state *s, charf *buf,
         if (s->strm->data_type == Z_UNKNOWN)
             s->strm->data_type = detect_data_type(s);
 
+        if (s->strategy == Z_QUICK) {
+            /* Static trees or store: only the static cost is needed */
+            s->static_len = static_block_bits(s);
+            opt_lenb = static_lenb = (s->static_len + 3 + 7) >> 3;
+            goto encode;
+        }
+
         /* Construct the literal and distance trees */
         build_tree(s, (tree_desc *)(&(s->l_desc)));
         Tracev((stderr, "\nlit data: dyn %ld, stat %ld", s->opt_len,
@@ -1039,6 +1063,8 @@ void ZLIB_INTERNAL _tr_flush_block(deflate_state *s, charf *buf,
         opt_lenb = static_lenb = stored_len + 5; /* force a stored block */
     }
 
+encode:
+
 #ifdef FORCE_STORED
     if (buf != (char*)0) { /* force stored block */
 #else
@@ -197,6 +197,7 @@ typedef gz_header FAR *gz_headerp;
 #define Z_HUFFMAN_ONLY        2
 #define Z_RLE                 3
 #define Z_FIXED               4
+#define Z_QUICK               5
 #define Z_DEFAULT_STRATEGY    0
 /* compression strategy; see deflateInit2() below for details */
 
@@ -598,7 +599,11 @@ ZEXTERN int ZEXPORT deflateInit2(z_streamp strm,
    strategy parameter only affects the compression ratio but not the
    correctness of the compressed output even if it is not set appropriately.
    Z_FIXED prevents the use of dynamic Huffman codes, allowing for a simpler
-   decoder for special applications.
+   decoder for special applications.  Z_QUICK, an extension in this copy of
+   zlib, probes the hash table once per position, does not insert the strings
+   of a match, and codes every block with the fixed Huffman codes or stores
+   it, trading compression for speed on transient data.  Its output is
+   ordinary deflate data.
 
      deflateInit2 returns Z_OK if success, Z_MEM_ERROR if there was not enough
    memory, Z_STREAM_ERROR if any parameter is invalid (such as an invalid
@@ -0,0 +1,39 @@
+/* zlib_backend.c -- which zlib a process runs, and with which kernels
+ *
+ * The vendored sources are compiled into CZLib on every platform, but unless
+ * the package is built with SWIFTZLIB_VENDORED_ZLIB the system libz is linked
+ * as well.  zlibCompileFlags() is resolved like every other zlib entry point,
+ * so the Z_VENDORED_FLAG bit that only the vendored copy sets tells which of
+ * the two the linker bound.  The kernel names are those the vendored code
+ * picks on this CPU; they are reported as "system" when it is not the one in
+ * use.
+ */
+
+#include "deflate.h"
+#include "zlib_shim.h"
+
+void swift_zlib_backend(swift_zlib_backend_t *info) {
+    const z_functable_t *table;
+
+    if (info == NULL)
+        return;
+    zmemzero(info, sizeof(*info));
+    info->vendored = (zlibCompileFlags() & Z_VENDORED_FLAG) != 0;
+    info->cpu_features = z_cpu_features();
+    if (!info->vendored) {
+        info->adler32_kernel = info->crc32_kernel = "system";
+        info->match_kernel = info->insert_hash = "system";
+        return;
+    }
+
+    table = z_functable();
+    info->adler32_kernel = table->adler32_name;
+    info->crc32_kernel = table->crc32_name;
+    deflate_kernels(&info->match_kernel, &info->insert_hash);
+    info->inflate_wide = inflate_wide_enabled();
+#if defined(Z_DEFLATE_SPECIALIZE) && !defined(FASTEST)
+    info->specialized_level = Z_DEFLATE_SPEC_LEVEL;
+    info->specialized_window_bits = Z_DEFLATE_SPEC_WBITS;
+    info->specialized_mem_level = Z_DEFLATE_SPEC_MEMLEVEL;
+#endif
+}
@@ -0,0 +1,36 @@
+/* zlib_metrics.c -- state memory of live deflate and inflate streams
+ *
+ * The sizes mirror the allocations made by deflateInit2()/deflateCopy() and
+ * inflateInit2()/inflate()/inflateCopy(), read from the stream's internal
+ * state, so they are exact whichever allocator the stream uses.  The inflate
+ * window is allocated lazily, by the first inflate() call that returns with
+ * output before the end of the stream, and is only counted once it exists.
+ */
+
+#include "deflate.h"
+#include "inftrees.h"
+#include "inflate.h"
+#include "zlib_shim.h"
+
+size_t swift_deflate_state_bytes(z_streamp strm) {
+    deflate_state *s;
+
+    if (strm == Z_NULL || strm->state == Z_NULL)
+        return 0;
+    s = (deflate_state *)strm->state;
+    return sizeof(deflate_state) +
+           (size_t)s->w_size * 2 * sizeof(Byte) +
+           (size_t)s->w_size * sizeof(Pos) +
+           (size_t)s->hash_size * sizeof(Pos) +
+           (size_t)s->lit_bufsize * LIT_BUFS;
+}
+
+size_t swift_inflate_state_bytes(z_streamp strm) {
+    struct inflate_state FAR *state;
+
+    if (strm == Z_NULL || strm->state == Z_NULL)
+        return 0;
+    state = (struct inflate_state FAR *)strm->state;
+    return sizeof(struct inflate_state) +
+           (state->window != Z_NULL ? (size_t)1 << state->wbits : 0);
+}
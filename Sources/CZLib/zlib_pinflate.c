@@ -0,0 +1,1057 @@
+/* zlib_pinflate.c -- speculative parallel inflate of a single deflate stream
+ *
+ * Modeled on pugz and rapidgzip.  The compressed input is cut into chunks of
+ * roughly equal size and decoded in rounds.  The first chunk of a round starts
+ * at a known block boundary; every other chunk searches forward from its
+ * guessed offset for a bit position where a dynamic Huffman block header
+ * parses and a whole block decodes.  The window preceding a speculative chunk
+ * is unknown, so symbols are decoded into 16-bit cells: values below 256 are
+ * literal bytes and values 256 + k stand for byte k of the 32 KB window just
+ * before the chunk.  Back-references are copied cell by cell, so a reference
+ * into the unknown window simply propagates the marker.
+ *
+ * Each chunk stops at the first block end at or past the next chunk's guessed
+ * offset.  Chunks are then stitched in order: a speculative chunk is accepted
+ * only if it starts exactly where its predecessor ended, and otherwise the
+ * predecessor keeps decoding across it.  Once the previous chunk's last 32 KB
+ * are known the markers are patched with real bytes and the check value is
+ * computed, one chunk per worker.  On any failure the round is redone
+ * serially with zlib from the last known boundary, using inflatePrime() and
+ * inflateSetDictionary() as zran does, so the output is always exactly what
+ * inflate() would produce.  The caller supplies the threads: decode and
+ * resolve calls for different chunks of a round may run concurrently.
+ */
+
+#include "zutil.h"
+#include "zlib_shim.h"
+
+#include <stdint.h>
+
+#define PI_WINSIZE 32768U       /* deflate window, and marker prefix length */
+#define PI_FASTBITS 10          /* bits resolved by one table lookup */
+#define PI_MAXBITS 15
+#define PI_NOSTOP UINT64_MAX
+
+#define PI_RAW 0
+#define PI_ZLIB 1
+#define PI_GZIP 2
+
+/* Internal status codes; the public entry points return zlib codes */
+#define PI_OK 0
+#define PI_DATA (-1)            /* invalid deflate data */
+#define PI_EOF (-2)             /* input ended inside a block */
+#define PI_MEM (-3)
+#define PI_LIMIT (-4)           /* chunk output cap reached */
+
+#define PI_CODES 0
+#define PI_LENS 1
+#define PI_DISTS 2
+
+/* Canonical Huffman code with a direct lookup table for short codes */
+typedef struct {
+    uint16_t count[PI_MAXBITS + 1];
+    uint16_t symbol[288];
+    uint16_t fast[1U << PI_FASTBITS];   /* symbol | length << 9; 0 = slow */
+    unsigned bits;                      /* lookup width, <= PI_FASTBITS */
+} pi_huffman;
+
+typedef struct {
+    const unsigned char *in;
+    size_t len;
+    size_t next;
+    uint64_t buf;
+    unsigned cnt;
+} pi_bits;
+
+typedef struct {
+    uint64_t search_bit;    /* guessed start (speculative chunks) */
+    uint64_t stop_bit;      /* decode to the first block end at or past this */
+    uint64_t start_bit;
+    uint64_t end_bit;
+    int status;
+    int final;              /* ended with the last block of the stream */
+    uint16_t *sym;          /* PI_WINSIZE marker cells, then output */
+    size_t have;
+    size_t size;
+    unsigned char *bytes;   /* resolved output */
+    size_t length;
+    unsigned long check;
+    unsigned wsize;         /* valid bytes at the end of window */
+    unsigned char window[PI_WINSIZE];
+} pi_chunk;
+
+struct swift_pinflate {
+    const unsigned char *input;     /* whole member, header included */
+    size_t input_length;
+    const unsigned char *data;      /* deflate data */
+    size_t length;
+    size_t header;
+    int mode;
+    size_t chunk_size;
+    int chunk_count;
+    size_t max_output;
+    pi_huffman fixed_lens;
+    pi_huffman fixed_dists;
+
+    uint64_t start_bit;             /* next round starts here */
+    int done;
+    unsigned long check;
+    uint64_t total;
+    unsigned wsize;
+    unsigned char window[PI_WINSIZE];
+
+    int round;                      /* chunks in the current round */
+    int accepted;                   /* chunks holding the round's output */
+    int *order;
+    unsigned next_wsize;
+    unsigned char next_window[PI_WINSIZE];
+    pi_chunk *chunks;
+
+    int64_t speculative;            /* chunks accepted from workers */
+    int64_t serial;                 /* rounds redone serially */
+};
+
+static const uint16_t pi_lbase[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t pi_lext[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t pi_dbase[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577};
+static const uint8_t pi_dext[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+/* ===========================================================================
+ * Bit input
+ */
+
+static void bits_seek(pi_bits *s, uint64_t bit) {
+    unsigned skip = (unsigned)(bit & 7);
+
+    s->next = (size_t)(bit >> 3);
+    s->buf = 0;
+    s->cnt = 0;
+    if (skip && s->next < s->len) {
+        s->buf = (uint64_t)(s->in[s->next++] >> skip);
+        s->cnt = 8 - skip;
+    }
+}
+
+static inline void bits_refill(pi_bits *s) {
+    if (s->len - s->next >= 8) {
+        uint64_t word;
+
+        memcpy(&word, s->in + s->next, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        word = __builtin_bswap64(word);
+#endif
+        s->buf |= word << s->cnt;
+        s->next += (63 - s->cnt) >> 3;
+        s->cnt |= 56;
+        return;
+    }
+    while (s->cnt <= 56 && s->next < s->len) {
+        s->buf |= (uint64_t)s->in[s->next++] << s->cnt;
+        s->cnt += 8;
+    }
+}
+
+static inline int bits_need(pi_bits *s, unsigned n) {
+    if (s->cnt < n) {
+        bits_refill(s);
+        if (s->cnt < n)
+            return PI_EOF;
+    }
+    return PI_OK;
+}
+
+/* Caller has made n <= 32 bits available */
+static inline unsigned bits_take(pi_bits *s, unsigned n) {
+    unsigned value = (unsigned)(s->buf & ((1ULL << n) - 1));
+
+    s->buf >>= n;
+    s->cnt -= n;
+    return value;
+}
+
+static inline uint64_t bits_tell(const pi_bits *s) {
+    return (uint64_t)s->next * 8 - s->cnt;
+}
+
+/* ===========================================================================
+ * Huffman codes
+ */
+
+/* Build a decoder from code lengths, accepting exactly the codes inflate()
+   accepts: no over-subscription, and an incomplete code only if it is a
+   single one-bit length or distance code */
+static int huffman_build(pi_huffman *h, const uint8_t *lengths, unsigned n,
+                         int kind) {
+    uint16_t offs[PI_MAXBITS + 2];
+    unsigned sym, len, max = 0, code, index;
+    int left = 1;
+
+    memset(h->count, 0, sizeof(h->count));
+    for (sym = 0; sym < n; sym++)
+        h->count[lengths[sym]]++;
+    if (h->count[0] == n) {
+        /* no codes: any lookup fails, which is only legal for distances */
+        h->bits = 1;
+        h->fast[0] = h->fast[1] = 0;
+        return kind == PI_DISTS ? PI_OK : PI_DATA;
+    }
+    for (len = 1; len <= PI_MAXBITS; len++) {
+        left <<= 1;
+        left -= h->count[len];
+        if (left < 0)
+            return PI_DATA;
+        if (h->count[len])
+            max = len;
+    }
+    if (left > 0 && (kind == PI_CODES || max != 1))
+        return PI_DATA;
+
+    offs[1] = 0;
+    for (len = 1; len <= PI_MAXBITS; len++)
+        offs[len + 1] = (uint16_t)(offs[len] + h->count[len]);
+    for (sym = 0; sym < n; sym++)
+        if (lengths[sym])
+            h->symbol[offs[lengths[sym]]++] = (uint16_t)sym;
+
+    h->bits = max < PI_FASTBITS ? max : PI_FASTBITS;
+    memset(h->fast, 0, sizeof(uint16_t) << h->bits);
+    code = 0;
+    index = 0;
+    for (len = 1; len <= h->bits; len++) {
+        unsigned i;
+
+        for (i = 0; i < h->count[len]; i++, index++, code++) {
+            unsigned reversed = 0, bit, j;
+
+            for (bit = 0; bit < len; bit++)
+                reversed |= ((code >> bit) & 1) << (len - 1 - bit);
+            for (j = reversed; j < (1U << h->bits); j += 1U << len)
+                h->fast[j] = (uint16_t)(h->symbol[index] | len << 9);
+        }
+        code <<= 1;
+    }
+    return PI_OK;
+}
+
+/* Bit-at-a-time canonical decode, as in puff.c */
+static int huffman_decode_slow(pi_bits *s, const pi_huffman *h) {
+    int code = 0, first = 0, index = 0;
+    unsigned len;
+
+    for (len = 1; len <= PI_MAXBITS; len++) {
+        int count;
+
+        if (bits_need(s, 1))
+            return PI_EOF;
+        code |= (int)bits_take(s, 1);
+        count = h->count[len];
+        if (code - count < first)
+            return h->symbol[index + (code - first)];
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+    return PI_DATA;
+}
+
+static inline int huffman_decode(pi_bits *s, const pi_huffman *h) {
+    if (s->cnt < h->bits)
+        bits_refill(s);
+    if (s->cnt >= h->bits) {
+        unsigned entry = h->fast[s->buf & ((1U << h->bits) - 1)];
+
+        if (entry) {
+            bits_take(s, entry >> 9);
+            return (int)(entry & 511);
+        }
+    }
+    return huffman_decode_slow(s, h);
+}
+
+/* ===========================================================================
+ * Block decoding into marker cells
+ */
+
+static void chunk_reset(pi_chunk *c) {
+    unsigned k;
+
+    for (k = 0; k < PI_WINSIZE; k++)
+        c->sym[k] = (uint16_t)(256 + k);
+    c->have = PI_WINSIZE;
+    c->final = 0;
+}
+
+static int chunk_open(pi_chunk *c) {
+    if (c->sym == NULL) {
+        c->size = 4 * PI_WINSIZE;
+        c->sym = (uint16_t *)malloc(c->size * sizeof(uint16_t));
+        if (c->sym == NULL)
+            return PI_MEM;
+    }
+    chunk_reset(c);
+    return PI_OK;
+}
+
+static int chunk_grow(pi_chunk *c, size_t need, size_t limit) {
+    size_t size = c->size;
+    uint16_t *sym;
+
+    if (c->have + need <= size)
+        return PI_OK;
+    if (c->have + need - PI_WINSIZE > limit)
+        return PI_LIMIT;
+    while (size < c->have + need)
+        size <<= 1;
+    sym = (uint16_t *)realloc(c->sym, size * sizeof(uint16_t));
+    if (sym == NULL)
+        return PI_MEM;
+    c->sym = sym;
+    c->size = size;
+    return PI_OK;
+}
+
+static int decode_codes(pi_chunk *c, pi_bits *s, const pi_huffman *lens,
+                        const pi_huffman *dists, size_t limit) {
+    for (;;) {
+        int sym = huffman_decode(s, lens);
+
+        if (sym < 0)
+            return sym;
+        if (c->size - c->have < 258) {
+            int ret = chunk_grow(c, 258, limit);
+            if (ret)
+                return ret;
+        }
+        if (sym < 256) {
+            c->sym[c->have++] = (uint16_t)sym;
+        } else if (sym == 256) {
+            return PI_OK;
+        } else {
+            unsigned len, dist, i;
+            uint16_t *to, *from;
+
+            sym -= 257;
+            if (sym >= 29)
+                return PI_DATA;
+            if (bits_need(s, pi_lext[sym]))
+                return PI_EOF;
+            len = pi_lbase[sym] + bits_take(s, pi_lext[sym]);
+            sym = huffman_decode(s, dists);
+            if (sym < 0)
+                return sym;
+            if (sym >= 30)
+                return PI_DATA;
+            if (bits_need(s, pi_dext[sym]))
+                return PI_EOF;
+            dist = pi_dbase[sym] + bits_take(s, pi_dext[sym]);
+            /* the marker prefix makes every distance up to 32 KB addressable */
+            to = c->sym + c->have;
+            from = to - dist;
+            if (dist >= len) {
+                memcpy(to, from, len * sizeof(uint16_t));
+            } else {
+                for (i = 0; i < len; i++)
+                    to[i] = from[i];
+            }
+            c->have += len;
+        }
+    }
+}
+
+static int decode_stored(pi_chunk *c, pi_bits *s, size_t limit) {
+    unsigned len, nlen;
+    int ret;
+
+    bits_take(s, s->cnt & 7);
+    if (bits_need(s, 32))
+        return PI_EOF;
+    len = bits_take(s, 16);
+    nlen = bits_take(s, 16);
+    if (len != (~nlen & 0xffff))
+        return PI_DATA;
+    ret = chunk_grow(c, len, limit);
+    if (ret)
+        return ret;
+    while (len--) {
+        if (bits_need(s, 8))
+            return PI_EOF;
+        c->sym[c->have++] = (uint16_t)bits_take(s, 8);
+    }
+    return PI_OK;
+}
+
+static int read_dynamic(pi_bits *s, pi_huffman *lens, pi_huffman *dists) {
+    static const uint8_t order[19] = {
+        16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+    uint8_t lengths[286 + 30];
+    unsigned nlen, ndist, ncode, index;
+
+    if (bits_need(s, 14))
+        return PI_EOF;
+    nlen = bits_take(s, 5) + 257;
+    ndist = bits_take(s, 5) + 1;
+    ncode = bits_take(s, 4) + 4;
+    if (nlen > 286 || ndist > 30)
+        return PI_DATA;
+    for (index = 0; index < 19; index++) {
+        if (index < ncode) {
+            if (bits_need(s, 3))
+                return PI_EOF;
+            lengths[order[index]] = (uint8_t)bits_take(s, 3);
+        } else {
+            lengths[order[index]] = 0;
+        }
+    }
+    if (huffman_build(lens, lengths, 19, PI_CODES))
+        return PI_DATA;
+
+    index = 0;
+    while (index < nlen + ndist) {
+        int sym = huffman_decode(s, lens);
+        unsigned repeat;
+        uint8_t len = 0;
+
+        if (sym < 0)
+            return sym;
+        if (sym < 16) {
+            lengths[index++] = (uint8_t)sym;
+            continue;
+        }
+        if (bits_need(s, sym == 16 ? 2 : sym == 17 ? 3 : 7))
+            return PI_EOF;
+        if (sym == 16) {
+            if (index == 0)
+                return PI_DATA;
+            len = lengths[index - 1];
+            repeat = 3 + bits_take(s, 2);
+        } else if (sym == 17) {
+            repeat = 3 + bits_take(s, 3);
+        } else {
+            repeat = 11 + bits_take(s, 7);
+        }
+        if (index + repeat > nlen + ndist)
+            return PI_DATA;
+        while (repeat--)
+            lengths[index++] = len;
+    }
+    if (lengths[256] == 0)
+        return PI_DATA;
+    if (huffman_build(lens, lengths, nlen, PI_LENS))
+        return PI_DATA;
+    if (huffman_build(dists, lengths + nlen, ndist, PI_DISTS))
+        return PI_DATA;
+    return PI_OK;
+}
+
+/* Decode one block whose 3-bit header has been consumed */
+static int decode_block(const swift_pinflate_t *p, pi_chunk *c, pi_bits *s,
+                        unsigned type) {
+    pi_huffman lens, dists;
+    int ret;
+
+    switch (type) {
+    case 0:
+        return decode_stored(c, s, p->max_output);
+    case 1:
+        return decode_codes(c, s, &p->fixed_lens, &p->fixed_dists,
+                            p->max_output);
+    case 2:
+        ret = read_dynamic(s, &lens, &dists);
+        if (ret)
+            return ret;
+        return decode_codes(c, s, &lens, &dists, p->max_output);
+    default:
+        return PI_DATA;
+    }
+}
+
+/* Decode blocks from the current position until the first block end at or
+   past stop, or the end of the last block */
+static int decode_blocks(const swift_pinflate_t *p, pi_chunk *c, pi_bits *s,
+                         uint64_t stop) {
+    for (;;) {
+        unsigned last, type;
+        int ret;
+
+        if (bits_need(s, 3))
+            return PI_EOF;
+        last = bits_take(s, 1);
+        type = bits_take(s, 2);
+        ret = decode_block(p, c, s, type);
+        if (ret)
+            return ret;
+        c->end_bit = bits_tell(s);
+        if (last) {
+            c->final = 1;
+            return PI_OK;
+        }
+        if (c->end_bit >= stop)
+            return PI_OK;
+    }
+}
+
+/* Continue a chunk from where it ended */
+static int chunk_extend(const swift_pinflate_t *p, pi_chunk *c,
+                        uint64_t stop) {
+    pi_bits s = {p->data, p->length, 0, 0, 0};
+
+    bits_seek(&s, c->end_bit);
+    return decode_blocks(p, c, &s, stop);
+}
+
+/* Cheap test of the 17 header bits at bit: not last, dynamic, HLIT and HDIST
+   in range */
+static int plausible_header(const swift_pinflate_t *p, uint64_t bit) {
+    size_t at = (size_t)(bit >> 3);
+    uint32_t v;
+
+    if (at + 3 > p->length)
+        return 0;
+    v = (uint32_t)p->data[at] | (uint32_t)p->data[at + 1] << 8 |
+        (uint32_t)p->data[at + 2] << 16;
+    v >>= bit & 7;
+    return (v & 7) == 4 && ((v >> 3) & 31) <= 29 && ((v >> 8) & 31) <= 29;
+}
+
+/* Find the first bit in [from, to) where a dynamic block decodes, then decode
+   on from there */
+static int chunk_search(const swift_pinflate_t *p, pi_chunk *c, uint64_t from,
+                        uint64_t to, uint64_t stop) {
+    pi_bits s = {p->data, p->length, 0, 0, 0};
+    uint64_t bit;
+
+    for (bit = from; bit < to; bit++) {
+        int ret;
+
+        if (!plausible_header(p, bit))
+            continue;
+        bits_seek(&s, bit + 3);
+        c->have = PI_WINSIZE;
+        c->final = 0;
+        ret = decode_block(p, c, &s, 2);
+        if (ret == PI_OK) {
+            c->start_bit = bit;
+            c->end_bit = bits_tell(&s);
+            if (c->end_bit >= stop)
+                return PI_OK;
+            ret = decode_blocks(p, c, &s, stop);
+            if (ret == PI_OK)
+                return PI_OK;
+        }
+        if (ret == PI_MEM || ret == PI_LIMIT)
+            return ret;
+    }
+    return PI_DATA;
+}
+
+/* ===========================================================================
+ * Resolution of marker cells
+ */
+
+static inline int resolve_cell(const pi_chunk *c, uint16_t v,
+                               unsigned char *out) {
+    unsigned k;
+
+    if (v < 256) {
+        *out = (unsigned char)v;
+        return PI_OK;
+    }
+    k = v - 256U;
+    if (k < PI_WINSIZE - c->wsize) {
+        /* reference before the start of the stream */
+        *out = 0;
+        return PI_DATA;
+    }
+    *out = c->window[k];
+    return PI_OK;
+}
+
+/* Window following chunk c: its last 32 KB of cells, which reach back into
+   c's own window when c is short */
+static void chunk_next_window(const pi_chunk *c, unsigned char *window,
+                              unsigned *wsize) {
+    const uint16_t *cells = c->sym + c->have - PI_WINSIZE;
+    size_t length = c->have - PI_WINSIZE;
+    unsigned k;
+
+    for (k = 0; k < PI_WINSIZE; k++)
+        resolve_cell(c, cells[k], window + k);
+    *wsize = length >= PI_WINSIZE - c->wsize ? PI_WINSIZE
+                                             : c->wsize + (unsigned)length;
+}
+
+static unsigned long check_update(int mode, unsigned long check,
+                                  const unsigned char *buf, size_t len) {
+    while (len) {
+        uInt n = len > 0x40000000U ? 0x40000000U : (uInt)len;
+
+        check = mode == PI_GZIP ? crc32(check, buf, n) : adler32(check, buf, n);
+        buf += n;
+        len -= n;
+    }
+    return check;
+}
+
+static void round_release(swift_pinflate_t *p) {
+    int i;
+
+    for (i = 0; i < p->chunk_count; i++) {
+        pi_chunk *c = &p->chunks[i];
+
+        free(c->sym);
+        free(c->bytes);
+        c->sym = NULL;
+        c->bytes = NULL;
+        c->size = c->have = c->length = 0;
+    }
+    p->round = 0;
+    p->accepted = 0;
+}
+
+/* ===========================================================================
+ * Member framing
+ */
+
+static int parse_header(swift_pinflate_t *p) {
+    const unsigned char *in = p->input;
+    size_t len = p->input_length, at;
+
+    if (p->mode == PI_RAW) {
+        p->header = 0;
+        return Z_OK;
+    }
+    if (p->mode == PI_ZLIB) {
+        if (len < 2 || (in[0] & 0xf) != 8 || (in[0] >> 4) > 7 ||
+                ((unsigned)in[0] << 8 | in[1]) % 31)
+            return Z_DATA_ERROR;
+        if (in[1] & 0x20)
+            return Z_NEED_DICT;
+        p->header = 2;
+        return Z_OK;
+    }
+    if (len < 10 || in[0] != 0x1f || in[1] != 0x8b || in[2] != 8 ||
+            (in[3] & 0xe0))
+        return Z_DATA_ERROR;
+    at = 10;
+    if (in[3] & 4) {
+        size_t extra;
+
+        if (at + 2 > len)
+            return Z_DATA_ERROR;
+        extra = (size_t)in[at] | (size_t)in[at + 1] << 8;
+        at += 2 + extra;
+    }
+    if (in[3] & 8) {
+        while (at < len && in[at])
+            at++;
+        at++;
+    }
+    if (in[3] & 16) {
+        while (at < len && in[at])
+            at++;
+        at++;
+    }
+    if (in[3] & 2) {
+        if (at + 2 > len)
+            return Z_DATA_ERROR;
+        if (((unsigned)in[at] | (unsigned)in[at + 1] << 8) !=
+                (crc32(0L, in, (uInt)at) & 0xffff))
+            return Z_DATA_ERROR;
+        at += 2;
+    }
+    if (at > len)
+        return Z_DATA_ERROR;
+    p->header = at;
+    return Z_OK;
+}
+
+static void build_fixed(swift_pinflate_t *p) {
+    uint8_t lengths[288];
+    unsigned sym;
+
+    for (sym = 0; sym < 144; sym++)
+        lengths[sym] = 8;
+    for (; sym < 256; sym++)
+        lengths[sym] = 9;
+    for (; sym < 280; sym++)
+        lengths[sym] = 7;
+    for (; sym < 288; sym++)
+        lengths[sym] = 8;
+    huffman_build(&p->fixed_lens, lengths, 288, PI_LENS);
+    /* 30 and 31 complete the code and are rejected when decoded */
+    for (sym = 0; sym < 32; sym++)
+        lengths[sym] = 5;
+    huffman_build(&p->fixed_dists, lengths, 32, PI_DISTS);
+}
+
+/* ===========================================================================
+ * Public interface
+ */
+
+swift_pinflate_t *swift_pinflate_create(const unsigned char *input,
+                                        size_t length, int mode,
+                                        size_t chunk_size, int chunk_count,
+                                        size_t max_chunk_output, int *status) {
+    swift_pinflate_t *p;
+    int ret;
+
+    if (mode < PI_RAW || mode > PI_GZIP || chunk_size < PI_WINSIZE ||
+            chunk_count < 1 || max_chunk_output < PI_WINSIZE) {
+        *status = Z_STREAM_ERROR;
+        return NULL;
+    }
+    p = (swift_pinflate_t *)calloc(1, sizeof(swift_pinflate_t));
+    if (p == NULL) {
+        *status = Z_MEM_ERROR;
+        return NULL;
+    }
+    p->input = input;
+    p->input_length = length;
+    p->mode = mode;
+    ret = parse_header(p);
+    if (ret != Z_OK) {
+        free(p);
+        *status = ret;
+        return NULL;
+    }
+    p->chunks = (pi_chunk *)calloc((size_t)chunk_count, sizeof(pi_chunk));
+    p->order = (int *)calloc((size_t)chunk_count, sizeof(int));
+    if (p->chunks == NULL || p->order == NULL) {
+        swift_pinflate_free(p);
+        *status = Z_MEM_ERROR;
+        return NULL;
+    }
+    p->data = input + p->header;
+    p->length = length - p->header;
+    p->chunk_size = chunk_size;
+    p->chunk_count = chunk_count;
+    /* keeps chunk lengths within what crc32_combine() can take */
+    p->max_output = max_chunk_output < 0x40000000U ? max_chunk_output
+                                                   : 0x40000000U;
+    p->check = mode == PI_GZIP ? crc32(0L, Z_NULL, 0) : adler32(0L, Z_NULL, 0);
+    build_fixed(p);
+    *status = Z_OK;
+    return p;
+}
+
+void swift_pinflate_free(swift_pinflate_t *p) {
+    if (p == NULL)
+        return;
+    if (p->chunks)
+        round_release(p);
+    free(p->chunks);
+    free(p->order);
+    free(p);
+}
+
+int swift_pinflate_begin_round(swift_pinflate_t *p) {
+    size_t start, remaining;
+    int n, i;
+
+    round_release(p);
+    if (p->done)
+        return 0;
+    start = (size_t)(p->start_bit >> 3);
+    remaining = start < p->length ? p->length - start : 0;
+    n = (int)((remaining + p->chunk_size - 1) / p->chunk_size);
+    if (n < 1)
+        n = 1;
+    if (n > p->chunk_count)
+        n = p->chunk_count;
+    for (i = 0; i < n; i++) {
+        pi_chunk *c = &p->chunks[i];
+        uint64_t next = (uint64_t)(start + (size_t)(i + 1) * p->chunk_size) * 8;
+
+        c->search_bit = (uint64_t)(start + (size_t)i * p->chunk_size) * 8;
+        c->stop_bit = i == n - 1 && next >= (uint64_t)p->length * 8 ? PI_NOSTOP
+                                                                     : next;
+        c->start_bit = c->end_bit = 0;
+        c->status = PI_DATA;
+        c->final = 0;
+        c->wsize = 0;
+    }
+    p->chunks[0].search_bit = p->start_bit;
+    p->round = n;
+    return n;
+}
+
+void swift_pinflate_decode_chunk(swift_pinflate_t *p, int index) {
+    pi_chunk *c = &p->chunks[index];
+    int ret = chunk_open(c);
+
+    if (ret == PI_OK) {
+        if (index == 0) {
+            pi_bits s = {p->data, p->length, 0, 0, 0};
+
+            c->start_bit = c->end_bit = p->start_bit;
+            bits_seek(&s, p->start_bit);
+            ret = decode_blocks(p, c, &s, c->stop_bit);
+        } else {
+            uint64_t to = c->stop_bit == PI_NOSTOP ? (uint64_t)p->length * 8
+                                                   : c->stop_bit;
+            ret = chunk_search(p, c, c->search_bit, to, c->stop_bit);
+        }
+    }
+    c->status = ret;
+}
+
+int swift_pinflate_stitch(swift_pinflate_t *p) {
+    pi_chunk *cur = &p->chunks[0];
+    const unsigned char *window = p->window;
+    unsigned wsize = p->wsize;
+    int i, k;
+
+    p->accepted = 0;
+    if (cur->status != PI_OK)
+        return Z_DATA_ERROR;
+    p->order[p->accepted++] = 0;
+    for (i = 1; i < p->round && !cur->final; i++) {
+        pi_chunk *c = &p->chunks[i];
+
+        if (c->status == PI_OK && c->start_bit > cur->end_bit &&
+                chunk_extend(p, cur, c->start_bit) != PI_OK)
+            return Z_DATA_ERROR;
+        if (c->status == PI_OK && !cur->final && c->start_bit == cur->end_bit) {
+            p->order[p->accepted++] = i;
+            p->speculative++;
+            cur = c;
+            continue;
+        }
+        if (!cur->final && cur->end_bit < c->stop_bit &&
+                chunk_extend(p, cur, c->stop_bit) != PI_OK)
+            return Z_DATA_ERROR;
+        free(c->sym);
+        c->sym = NULL;
+    }
+
+    /* windows are only known in order, but computing one touches 32 KB */
+    for (k = 0; k < p->accepted; k++) {
+        pi_chunk *c = &p->chunks[p->order[k]];
+
+        memcpy(c->window, window, PI_WINSIZE);
+        c->wsize = wsize;
+        chunk_next_window(c, p->next_window, &p->next_wsize);
+        window = p->next_window;
+        wsize = p->next_wsize;
+    }
+    return p->accepted;
+}
+
+int swift_pinflate_resolve_chunk(swift_pinflate_t *p, int index) {
+    pi_chunk *c = &p->chunks[p->order[index]];
+    const uint16_t *cells = c->sym + PI_WINSIZE;
+    size_t i, length = c->have - PI_WINSIZE;
+    unsigned char table[256 + PI_WINSIZE];
+    unsigned k;
+
+    c->bytes = (unsigned char *)malloc(length ? length : 1);
+    if (c->bytes == NULL)
+        return Z_MEM_ERROR;
+    if (c->wsize < PI_WINSIZE) {
+        int bad = 0;
+
+        for (i = 0; i < length; i++)
+            bad |= resolve_cell(c, cells[i], c->bytes + i);
+        if (bad)
+            return Z_DATA_ERROR;
+    } else {
+        /* every cell is below 256 + PI_WINSIZE, so one lookup patches it */
+        for (k = 0; k < 256; k++)
+            table[k] = (unsigned char)k;
+        memcpy(table + 256, c->window, PI_WINSIZE);
+        for (i = 0; i < length; i++)
+            c->bytes[i] = table[cells[i]];
+    }
+    c->length = length;
+    c->check = check_update(p->mode, p->mode == PI_GZIP ? crc32(0L, Z_NULL, 0)
+                                                        : adler32(0L, Z_NULL, 0),
+                            c->bytes, length);
+    free(c->sym);
+    c->sym = NULL;
+    return Z_OK;
+}
+
+int swift_pinflate_serial_round(swift_pinflate_t *p) {
+    pi_chunk *c;
+    z_stream strm;
+    uint64_t stop;
+    size_t pos, fed, produced = 0, capacity = 4 * PI_WINSIZE;
+    unsigned bits = (unsigned)(p->start_bit & 7);
+    int ret;
+
+    if (p->round < 1)
+        return Z_STREAM_ERROR;
+    stop = p->chunks[p->round - 1].stop_bit;
+    round_release(p);
+    p->round = 1;
+    p->serial++;
+    c = &p->chunks[0];
+    c->final = 0;
+    c->bytes = (unsigned char *)malloc(capacity);
+    if (c->bytes == NULL)
+        return Z_MEM_ERROR;
+
+    memset(&strm, 0, sizeof(strm));
+    ret = inflateInit2(&strm, -15);
+    if (ret != Z_OK)
+        return ret;
+    pos = (size_t)(p->start_bit >> 3);
+    if (bits) {
+        if (pos >= p->length) {
+            inflateEnd(&strm);
+            return Z_DATA_ERROR;
+        }
+        inflatePrime(&strm, (int)(8 - bits), p->data[pos] >> bits);
+        pos++;
+    }
+    if (p->wsize)
+        inflateSetDictionary(&strm, p->window + PI_WINSIZE - p->wsize,
+                             p->wsize);
+    fed = pos;
+    for (;;) {
+        if (strm.avail_in == 0 && fed < p->length) {
+            size_t n = p->length - fed;
+
+            strm.next_in = (z_const Bytef *)(p->data + fed);
+            strm.avail_in = n > 0x40000000U ? 0x40000000U : (uInt)n;
+            fed += strm.avail_in;
+        }
+        if (produced == capacity) {
+            unsigned char *bytes = (unsigned char *)realloc(c->bytes,
+                                                            capacity * 2);
+            if (bytes == NULL) {
+                inflateEnd(&strm);
+                return Z_MEM_ERROR;
+            }
+            c->bytes = bytes;
+            capacity *= 2;
+        }
+        strm.next_out = c->bytes + produced;
+        strm.avail_out = (uInt)(capacity - produced > 0x40000000U
+                                ? 0x40000000U : capacity - produced);
+        ret = inflate(&strm, Z_BLOCK);
+        produced = (size_t)(strm.next_out - c->bytes);
+        if (ret == Z_STREAM_END) {
+            c->final = 1;
+            c->end_bit = (uint64_t)(fed - strm.avail_in) * 8;
+            break;
+        }
+        if (ret == Z_BUF_ERROR && strm.avail_in == 0 && fed == p->length)
+            ret = Z_DATA_ERROR;
+        if (ret != Z_OK && ret != Z_BUF_ERROR) {
+            inflateEnd(&strm);
+            return ret == Z_MEM_ERROR ? ret : Z_DATA_ERROR;
+        }
+        if ((strm.data_type & 128) && !(strm.data_type & 64)) {
+            uint64_t bit = (uint64_t)(fed - strm.avail_in) * 8 -
+                           (unsigned)(strm.data_type & 7);
+
+            if (bit >= stop || produced >= p->max_output) {
+                c->end_bit = bit;
+                break;
+            }
+        }
+    }
+    inflateEnd(&strm);
+
+    c->length = produced;
+    c->check = check_update(p->mode, p->mode == PI_GZIP ? crc32(0L, Z_NULL, 0)
+                                                        : adler32(0L, Z_NULL, 0),
+                            c->bytes, produced);
+    if (produced >= PI_WINSIZE) {
+        memcpy(p->next_window, c->bytes + produced - PI_WINSIZE, PI_WINSIZE);
+        p->next_wsize = PI_WINSIZE;
+    } else {
+        memcpy(p->next_window, p->window + produced, PI_WINSIZE - produced);
+        memcpy(p->next_window + PI_WINSIZE - produced, c->bytes, produced);
+        p->next_wsize = p->wsize + (unsigned)produced > PI_WINSIZE
+                        ? PI_WINSIZE : p->wsize + (unsigned)produced;
+    }
+    p->order[0] = 0;
+    p->accepted = 1;
+    return Z_OK;
+}
+
+unsigned char *swift_pinflate_take_output(swift_pinflate_t *p, int index,
+                                          size_t *length) {
+    pi_chunk *c = &p->chunks[p->order[index]];
+    unsigned char *bytes = c->bytes;
+
+    *length = c->length;
+    c->bytes = NULL;
+    return bytes;
+}
+
+int swift_pinflate_end_round(swift_pinflate_t *p) {
+    pi_chunk *last;
+    int k;
+
+    if (p->accepted < 1)
+        return -1;
+    for (k = 0; k < p->accepted; k++) {
+        pi_chunk *c = &p->chunks[p->order[k]];
+
+        p->check = p->mode == PI_GZIP
+                   ? crc32_combine(p->check, c->check, (z_off_t)c->length)
+                   : adler32_combine(p->check, c->check, (z_off_t)c->length);
+        p->total += c->length;
+    }
+    last = &p->chunks[p->order[p->accepted - 1]];
+    p->start_bit = last->end_bit;
+    p->done = last->final;
+    memcpy(p->window, p->next_window, PI_WINSIZE);
+    p->wsize = p->next_wsize;
+    round_release(p);
+    return p->done;
+}
+
+int64_t swift_pinflate_finish(const swift_pinflate_t *p) {
+    size_t at = p->header + (size_t)((p->start_bit + 7) >> 3);
+    const unsigned char *t = p->input + at;
+
+    if (!p->done)
+        return Z_STREAM_ERROR;
+    if (p->mode == PI_GZIP) {
+        unsigned long crc, isize;
+
+        if (at + 8 > p->input_length)
+            return Z_DATA_ERROR;
+        crc = (unsigned long)t[0] | (unsigned long)t[1] << 8 |
+              (unsigned long)t[2] << 16 | (unsigned long)t[3] << 24;
+        isize = (unsigned long)t[4] | (unsigned long)t[5] << 8 |
+                (unsigned long)t[6] << 16 | (unsigned long)t[7] << 24;
+        if (crc != p->check || isize != (unsigned long)(p->total & 0xffffffffU))
+            return Z_DATA_ERROR;
+        return (int64_t)(at + 8);
+    }
+    if (p->mode == PI_ZLIB) {
+        unsigned long adler;
+
+        if (at + 4 > p->input_length)
+            return Z_DATA_ERROR;
+        adler = (unsigned long)t[0] << 24 | (unsigned long)t[1] << 16 |
+                (unsigned long)t[2] << 8 | (unsigned long)t[3];
+        if (adler != p->check)
+            return Z_DATA_ERROR;
+        return (int64_t)(at + 4);
+    }
+    return (int64_t)at;
+}
+
+int64_t swift_pinflate_speculative_chunks(const swift_pinflate_t *p) {
+    return p->speculative;
+}
+
+int64_t swift_pinflate_serial_rounds(const swift_pinflate_t *p) {
+    return p->serial;
+}
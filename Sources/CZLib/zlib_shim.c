@@ -334,23 +334,14 @@ __attribute__((used)) int swift_inflateBackWithCallbacks(z_streamp strm, swift_i
         return Z_STREAM_ERROR;
     }
 
-    // Allocate context structure
-    swift_inflateback_context_t* context = malloc(sizeof(swift_inflateback_context_t));
-    if (!context) {
-#if ZLIB_DEBUG
-        printf("[C] swift_inflateBackWithCallbacks: memory allocation failed\n");
-        fflush(stdout);
-#endif
-        return Z_MEM_ERROR;
-    }
-
-    // Initialize context with validation
-    context->swift_in_func = in_func;
-    context->swift_out_func = out_func;
-    context->swift_context = in_desc; // Use in_desc as context
+    // The context only lives for the duration of inflateBack(), so keep it on the stack
+    swift_inflateback_context_t context;
+    context.swift_in_func = in_func;
+    context.swift_out_func = out_func;
+    context.swift_context = in_desc; // Use in_desc as context
 
     // Call inflateBack with our debug wrapper functions
-    int result = inflateBack(strm, debug_in_wrapper, context, debug_out_wrapper, context);
+    int result = inflateBack(strm, debug_in_wrapper, &context, debug_out_wrapper, &context);
 
 #if ZLIB_DEBUG
     if (result != Z_OK && result != Z_STREAM_END) {
@@ -359,11 +350,54 @@ __attribute__((used)) int swift_inflateBackWithCallbacks(z_streamp strm, swift_i
     }
 #endif
 
-    // Clean up context with validation
-    if (context) {
-        free(context);
+    return result;
+}
+
+// Contiguous input source for swift_inflateBackBuffer
+typedef struct {
+    const unsigned char *next;
+    size_t left;
+    size_t chunk;
+    swift_out_func out_func;
+    void *out_desc;
+} swift_inflateback_buffer_t;
+
+static unsigned int buffer_in(void *desc, unsigned char **buf) {
+    swift_inflateback_buffer_t *source = (swift_inflateback_buffer_t *)desc;
+    size_t len = source->left < source->chunk ? source->left : source->chunk;
+    *buf = (unsigned char *)source->next;
+    source->next += len;
+    source->left -= len;
+    return (unsigned int)len;
+}
+
+static int buffer_out(void *desc, unsigned char *buf, unsigned len) {
+    swift_inflateback_buffer_t *source = (swift_inflateback_buffer_t *)desc;
+    return source->out_func(source->out_desc, buf, (int)len);
+}
+
+__attribute__((used)) int swift_inflateBackBuffer(z_streamp strm, const unsigned char *input, size_t inputLength, size_t chunkSize, swift_out_func out_func, void *out_desc, size_t *consumed) {
+    if (!strm || (!input && inputLength > 0) || !out_func) {
+        return Z_STREAM_ERROR;
     }
 
+    // Input never crosses back into Swift: in() hands out slices of the caller's buffer,
+    // and out() receives a pointer straight into the inflateBack window.
+    swift_inflateback_buffer_t source;
+    source.next = input;
+    source.left = inputLength;
+    source.chunk = chunkSize == 0 || chunkSize > 0xffffffffUL ? 0xffffffffUL : chunkSize;
+    source.out_func = out_func;
+    source.out_desc = out_desc;
+
+    strm->next_in = Z_NULL;
+    strm->avail_in = 0;
+    int result = inflateBack(strm, buffer_in, &source, buffer_out, &source);
+
+    if (consumed) {
+        // Whatever inflateBack did not use of the last slice is left in avail_in
+        *consumed = inputLength - source.left - (strm->next_in ? strm->avail_in : 0);
+    }
     return result;
 }
 
@@ -400,6 +434,20 @@ __attribute__((used)) uLong swift_crc32(uLong crc, const Bytef *buf, uInt len) {
     return crc32(crc, buf, len);
 }
 
+__attribute__((used)) uLong swift_adler32_z(uLong adler, const Bytef *buf, size_t len) {
+    if (!buf || len == 0) {
+        return adler;
+    }
+    return adler32_z(adler, buf, len);
+}
+
+__attribute__((used)) uLong swift_crc32_z(uLong crc, const Bytef *buf, size_t len) {
+    if (!buf || len == 0) {
+        return crc;
+    }
+    return crc32_z(crc, buf, len);
+}
+
 __attribute__((used)) uLong swift_compressBound(uLong sourceLen) {
     return compressBound(sourceLen);
 }
@@ -447,6 +495,27 @@ __attribute__((used)) uLong swift_crc32_combine(uLong crc1, uLong crc2, z_off_t
     return crc32_combine(crc1, crc2, len2);
 }
 
+// 64-bit lengths even where z_off_t is 32 bits (LLP64 Windows, 32-bit targets)
+ZEXTERN uLong ZEXPORT adler32_combine64(uLong, uLong, z_off64_t);
+ZEXTERN uLong ZEXPORT crc32_combine64(uLong, uLong, z_off64_t);
+ZEXTERN uLong ZEXPORT crc32_combine_gen64(z_off64_t);
+
+__attribute__((used)) uLong swift_adler32_combine64(uLong adler1, uLong adler2, int64_t len2) {
+    return adler32_combine64(adler1, adler2, (z_off64_t)len2);
+}
+
+__attribute__((used)) uLong swift_crc32_combine64(uLong crc1, uLong crc2, int64_t len2) {
+    return crc32_combine64(crc1, crc2, (z_off64_t)len2);
+}
+
+__attribute__((used)) uLong swift_crc32_combine_gen64(int64_t len2) {
+    return crc32_combine_gen64((z_off64_t)len2);
+}
+
+__attribute__((used)) uLong swift_crc32_combine_op(uLong crc1, uLong crc2, uLong op) {
+    return crc32_combine_op(crc1, crc2, op);
+}
+
 // Compile flags
 __attribute__((used)) uLong swift_zlibCompileFlags(void) {
     return zlibCompileFlags();
@@ -469,6 +538,18 @@ __attribute__((used)) int swift_gzwrite(void* file, void* buf, unsigned int len)
     return gzwrite((gzFile)file, buf, len);
 }
 
+__attribute__((used)) int swift_gzbuffer(void* file, unsigned size) {
+    return gzbuffer((gzFile)file, size);
+}
+
+__attribute__((used)) size_t swift_gzfread(void* buf, size_t size, size_t nitems, void* file) {
+    return gzfread(buf, (z_size_t)size, (z_size_t)nitems, (gzFile)file);
+}
+
+__attribute__((used)) size_t swift_gzfwrite(const void* buf, size_t size, size_t nitems, void* file) {
+    return gzfwrite(buf, (z_size_t)size, (z_size_t)nitems, (gzFile)file);
+}
+
 __attribute__((used)) long swift_gzseek(void* file, long offset, int whence) {
     return gzseek((gzFile)file, offset, whence);
 }
@@ -489,6 +570,10 @@ __attribute__((used)) int swift_gzeof(void* file) {
     return gzeof((gzFile)file);
 }
 
+__attribute__((used)) int swift_gzdirect(void* file) {
+    return gzdirect((gzFile)file);
+}
+
 __attribute__((used)) int swift_gzsetparams(void* file, int level, int strategy) {
     return gzsetparams((gzFile)file, level, strategy);
 }
@@ -552,3 +637,147 @@ __attribute__((used)) int swift_deflateSetHeader(z_streamp strm, gz_headerp head
 __attribute__((used)) int swift_inflateGetHeader(z_streamp strm, gz_headerp head) {
     return inflateGetHeader(strm, head);
 }
+
+// Arena allocator for z_stream state
+//
+// deflateInit2/inflateInit2 make a handful of allocations (state, window,
+// hash chains, pending buffer) and free them all in deflateEnd/inflateEnd.
+// The arena serves them from one preallocated slab with a bump pointer. When
+// every block has been freed the bump pointer rewinds, so the same slab is
+// reused by the next init without touching the heap. Requests that do not
+// fit fall back to calloc and are counted in `fallbacks`.
+struct swift_zarena {
+    unsigned char *base;
+    size_t capacity;
+    size_t offset;
+    size_t peak;
+    size_t live;
+    size_t fallbacks;
+};
+
+#define SWIFT_ZARENA_ALIGN 16
+
+static voidpf swift_zarena_alloc(voidpf opaque, uInt items, uInt size) {
+    swift_zarena_t *arena = (swift_zarena_t *)opaque;
+    size_t bytes = (size_t)items * size;
+    size_t aligned = (bytes + SWIFT_ZARENA_ALIGN - 1) & ~(size_t)(SWIFT_ZARENA_ALIGN - 1);
+
+    if (arena->base && aligned <= arena->capacity - arena->offset) {
+        voidpf ptr = arena->base + arena->offset;
+        arena->offset += aligned;
+        arena->live++;
+        if (arena->offset > arena->peak) arena->peak = arena->offset;
+        return ptr;
+    }
+    arena->fallbacks++;
+#if ZLIB_DEBUG
+    printf("[C] swift_zarena_alloc: %zu bytes do not fit, using calloc\n", bytes);
+    fflush(stdout);
+#endif
+    return calloc(items, size);
+}
+
+static void swift_zarena_free(voidpf opaque, voidpf ptr) {
+    swift_zarena_t *arena = (swift_zarena_t *)opaque;
+    unsigned char *p = (unsigned char *)ptr;
+
+    if (arena->base && p >= arena->base && p < arena->base + arena->capacity) {
+        if (arena->live > 0 && --arena->live == 0) {
+            arena->offset = 0;
+        }
+        return;
+    }
+    free(ptr);
+}
+
+__attribute__((used)) swift_zarena_t *swift_zarena_create(size_t capacity) {
+    swift_zarena_t *arena = (swift_zarena_t *)calloc(1, sizeof(swift_zarena_t));
+    if (!arena) return NULL;
+    arena->base = (unsigned char *)malloc(capacity);
+    if (!arena->base) {
+        free(arena);
+        return NULL;
+    }
+    arena->capacity = capacity;
+    return arena;
+}
+
+__attribute__((used)) void swift_zarena_destroy(swift_zarena_t *arena) {
+    if (!arena) return;
+    free(arena->base);
+    free(arena);
+}
+
+__attribute__((used)) void swift_zarena_attach(z_streamp strm, swift_zarena_t *arena) {
+    if (!strm || !arena) return;
+    strm->zalloc = swift_zarena_alloc;
+    strm->zfree = swift_zarena_free;
+    strm->opaque = arena;
+}
+
+__attribute__((used)) size_t swift_zarena_used(const swift_zarena_t *arena) {
+    return arena ? arena->offset : 0;
+}
+
+__attribute__((used)) size_t swift_zarena_peak(const swift_zarena_t *arena) {
+    return arena ? arena->peak : 0;
+}
+
+__attribute__((used)) size_t swift_zarena_capacity(const swift_zarena_t *arena) {
+    return arena ? arena->capacity : 0;
+}
+
+__attribute__((used)) size_t swift_zarena_fallbacks(const swift_zarena_t *arena) {
+    return arena ? arena->fallbacks : 0;
+}
+
+// Default allocator statistics (counters live next to zcalloc in zutil.c,
+// compiled in only with Z_ALLOC_STATS)
+
+#ifdef Z_ALLOC_STATS
+extern unsigned long long z_alloc_calls;
+extern unsigned long long z_alloc_bytes;
+#endif
+
+__attribute__((used)) int swift_zalloc_stats(uint64_t *calls, uint64_t *bytes) {
+#ifndef Z_ALLOC_STATS
+    if (calls) *calls = 0;
+    if (bytes) *bytes = 0;
+    return 0;
+#else
+#  if defined(__GNUC__) || defined(__clang__)
+    if (calls) *calls = __atomic_load_n(&z_alloc_calls, __ATOMIC_RELAXED);
+    if (bytes) *bytes = __atomic_load_n(&z_alloc_bytes, __ATOMIC_RELAXED);
+#  else
+    if (calls) *calls = z_alloc_calls;
+    if (bytes) *bytes = z_alloc_bytes;
+#  endif
+    return 1;
+#endif
+}
+
+static int swift_zarena_window_bits(int windowBits) {
+    if (windowBits < 0) windowBits = -windowBits;
+    if (windowBits > 15) windowBits &= 15;
+    if (windowBits < 9) windowBits = 9;
+    return windowBits;
+}
+
+// Upper bound of what deflateInit2 allocates: 2x window, prev[], head[],
+// the pending/symbol buffer and the state struct (rounded up generously)
+__attribute__((used)) size_t swift_zarena_deflate_size(int windowBits, int memLevel) {
+    int wbits = swift_zarena_window_bits(windowBits);
+    if (memLevel < 1) memLevel = 1;
+    if (memLevel > 9) memLevel = 9;
+    return ((size_t)4 << wbits) +               // window (2 * wsize) + prev (wsize * sizeof(Pos))
+           ((size_t)1 << (memLevel + 8)) +      // head (hash_size * sizeof(Pos))
+           ((size_t)5 << (memLevel + 6)) +      // pending_buf (lit_bufsize * LIT_BUFS)
+           16 * 1024;                           // deflate_state and alignment
+}
+
+// Upper bound of what inflateInit2 plus the first inflate allocate: the state
+// struct and the sliding window
+__attribute__((used)) size_t swift_zarena_inflate_size(int windowBits) {
+    int wbits = swift_zarena_window_bits(windowBits);
+    return ((size_t)1 << wbits) + 16 * 1024;
+}
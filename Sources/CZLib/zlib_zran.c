@@ -0,0 +1,731 @@
+/* zlib_zran.c -- random access into deflate, zlib and gzip streams
+ *
+ * Modeled on zlib's examples/zran.c.  A single streaming pass decodes the
+ * input with Z_BLOCK and records an access point at a deflate block boundary
+ * roughly every span uncompressed bytes.  A point holds the input position
+ * (plus the 0-7 bits of the previous byte that belong to the block), the last
+ * 32 KB of uncompressed output, and the running check value of the current
+ * zlib/gzip member.  Decoding restarts from a point with inflatePrime() and
+ * inflateSetDictionary(), and inflate_resume() re-arms the trailer check so
+ * concatenated gzip members keep working past the restart.
+ *
+ * Indexes can be built from and extracted against a FILE or a memory buffer,
+ * saved to a sidecar file, and used to reposition a gzFile read handle.  The
+ * caller may attach the source's modification time and a checksum of its
+ * compressed bytes, which are saved along with the index so that a sidecar
+ * can be matched against the file it was built from.
+ */
+
+#include "gzguts.h"
+#include "zutil.h"
+#include "zlib_shim.h"
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  include <io.h>
+#  define ZRAN_LSEEK _lseeki64
+#  define ZRAN_READ _read
+#  define ZRAN_FSEEK _fseeki64
+#  define ZRAN_FTELL _ftelli64
+#else
+#  include <unistd.h>
+#  define ZRAN_LSEEK lseek
+#  define ZRAN_READ read
+#  define ZRAN_FSEEK fseeko
+#  define ZRAN_FTELL ftello
+#endif
+
+#define ZRAN_WINSIZE 32768U     /* deflate window, and size of saved windows */
+#define ZRAN_CHUNK 65536U       /* input read size */
+#define ZRAN_RAW (-15)
+#define ZRAN_ZLIB 15
+#define ZRAN_GZIP 31
+
+static const unsigned char zran_magic[8] = {'S', 'Z', 'R', 'A', 'N', 'I', 'X', '3'};
+
+typedef struct {
+    int64_t out;            /* offset in the uncompressed data */
+    int64_t in;             /* offset in the input of the first full byte */
+    int bits;               /* bits (1-7) of the byte at in-1 in use, or 0 */
+    unsigned long check;    /* running check value of the member so far */
+    int64_t member_out;     /* uncompressed bytes of the member before here */
+    unsigned wsize;         /* bytes of window, up to ZRAN_WINSIZE */
+    unsigned char *window;  /* preceding uncompressed data */
+} zran_point;
+
+struct swift_zran_index {
+    int mode;               /* ZRAN_RAW, ZRAN_ZLIB or ZRAN_GZIP */
+    int have;               /* number of points */
+    int size;               /* allocated points */
+    int64_t span;           /* requested distance between points */
+    int64_t length;         /* total uncompressed length */
+    int64_t source_size;    /* length of the source, including data after the stream */
+    int64_t stream_size;    /* input offset of the end of the stream */
+    int64_t source_mtime;   /* caller's modification time of the source, or 0 */
+    unsigned long source_check; /* caller's checksum of the source, or 0 */
+    zran_point *list;
+};
+
+/* Input abstraction over a FILE or a memory buffer */
+typedef struct {
+    FILE *file;
+    const unsigned char *data;
+    size_t size;
+    size_t pos;
+} zran_source;
+
+static size_t source_read(zran_source *src, unsigned char *buf, size_t len) {
+    if (src->file)
+        return fread(buf, 1, len, src->file);
+    if (src->pos >= src->size)
+        return 0;
+    if (len > src->size - src->pos)
+        len = src->size - src->pos;
+    memcpy(buf, src->data + src->pos, len);
+    src->pos += len;
+    return len;
+}
+
+/* Length of the whole source (offsets are from the start of a file), or -1
+   if the file cannot seek */
+static int64_t source_length(zran_source *src) {
+    int64_t pos, end;
+
+    if (src->file == NULL)
+        return (int64_t)src->size;
+    pos = (int64_t)ZRAN_FTELL(src->file);
+    if (pos < 0 || ZRAN_FSEEK(src->file, 0, SEEK_END) != 0)
+        return -1;
+    end = (int64_t)ZRAN_FTELL(src->file);
+    if (ZRAN_FSEEK(src->file, pos, SEEK_SET) != 0)
+        return -1;
+    return end;
+}
+
+static int source_seek(zran_source *src, int64_t offset) {
+    if (offset < 0)
+        return -1;
+    if (src->file)
+        return ZRAN_FSEEK(src->file, offset, SEEK_SET);
+    if ((uint64_t)offset > src->size)
+        return -1;
+    src->pos = (size_t)offset;
+    return 0;
+}
+
+static int detect_mode(const unsigned char *buf, size_t len) {
+    if (len >= 2 && buf[0] == 0x1f && buf[1] == 0x8b)
+        return ZRAN_GZIP;
+    if (len >= 2 && (buf[0] & 0xf) == 8 && (buf[0] >> 4) <= 7 &&
+            ((unsigned)buf[0] << 8 | buf[1]) % 31 == 0)
+        return ZRAN_ZLIB;
+    return ZRAN_RAW;
+}
+
+static void index_free(swift_zran_index_t *index) {
+    int i;
+
+    if (index == NULL)
+        return;
+    for (i = 0; i < index->have; i++)
+        free(index->list[i].window);
+    free(index->list);
+    free(index);
+}
+
+static zran_point *add_point(swift_zran_index_t *index) {
+    if (index->have == index->size) {
+        int size = index->size ? index->size << 1 : 16;
+        zran_point *list = (zran_point *)realloc(index->list,
+                                                 sizeof(zran_point) * (size_t)size);
+        if (list == NULL)
+            return NULL;
+        index->list = list;
+        index->size = size;
+    }
+    memset(&index->list[index->have], 0, sizeof(zran_point));
+    return &index->list[index->have++];
+}
+
+/* Copy the last wsize bytes out of the circular window; next is the write
+   position in the ring */
+static int save_window(zran_point *point, const unsigned char *ring,
+                       unsigned next, unsigned wsize) {
+    point->wsize = wsize;
+    if (wsize == 0)
+        return 0;
+    point->window = (unsigned char *)malloc(wsize);
+    if (point->window == NULL)
+        return -1;
+    if (wsize <= next) {
+        memcpy(point->window, ring + next - wsize, wsize);
+    } else {
+        unsigned tail = wsize - next;
+        memcpy(point->window, ring + ZRAN_WINSIZE - tail, tail);
+        memcpy(point->window + tail, ring, next);
+    }
+    return 0;
+}
+
+/* Make sure at least two input bytes are available, to look for the magic of
+   another gzip member; a lone leftover byte is moved to the buffer start */
+static void refill_pair(zran_source *src, unsigned char *input, z_streamp strm,
+                        int64_t *counted) {
+    size_t got;
+
+    if (strm->avail_in >= 2)
+        return;
+    if (strm->avail_in == 1)
+        input[0] = strm->next_in[0];
+    got = source_read(src, input + strm->avail_in, ZRAN_CHUNK - strm->avail_in);
+    if (counted)
+        *counted += (int64_t)got;
+    strm->next_in = input;
+    strm->avail_in += (uInt)got;
+}
+
+static int zran_build(zran_source *src, int64_t span,
+                      swift_zran_index_t **built) {
+    z_stream strm;
+    unsigned char *input, *ring;
+    swift_zran_index_t *index;
+    int64_t totin = 0, totout = 0, last = 0, member_start = 0, totread = 0;
+    int ret = Z_OK, initialized = 0, eof = 0;
+
+    *built = NULL;
+    if (span <= 0)
+        return Z_STREAM_ERROR;
+    input = (unsigned char *)malloc(ZRAN_CHUNK);
+    ring = (unsigned char *)malloc(ZRAN_WINSIZE);
+    index = (swift_zran_index_t *)calloc(1, sizeof(swift_zran_index_t));
+    if (input == NULL || ring == NULL || index == NULL) {
+        free(input);
+        free(ring);
+        free(index);
+        return Z_MEM_ERROR;
+    }
+    index->span = span;
+
+    memset(&strm, 0, sizeof(strm));
+    strm.avail_out = 0;
+    for (;;) {
+        unsigned in_before, out_before;
+
+        if (strm.avail_in == 0 && !eof) {
+            strm.avail_in = (uInt)source_read(src, input, ZRAN_CHUNK);
+            strm.next_in = input;
+            totread += strm.avail_in;
+            eof = strm.avail_in == 0;
+            if (eof && !initialized) {
+                ret = Z_BUF_ERROR;      /* empty input */
+                break;
+            }
+            if (!initialized) {
+                index->mode = detect_mode(input, strm.avail_in);
+                ret = inflateInit2(&strm, index->mode);
+                if (ret != Z_OK)
+                    break;
+                initialized = 1;
+                /* raw inflate does not stop before the first block, so the
+                   start of the data is recorded up front */
+                if (index->mode == ZRAN_RAW && add_point(index) == NULL) {
+                    ret = Z_MEM_ERROR;
+                    break;
+                }
+            }
+        }
+        if (strm.avail_out == 0) {
+            strm.avail_out = ZRAN_WINSIZE;
+            strm.next_out = ring;
+        }
+
+        in_before = strm.avail_in;
+        out_before = strm.avail_out;
+        ret = inflate(&strm, Z_BLOCK);
+        totin += in_before - strm.avail_in;
+        totout += out_before - strm.avail_out;
+        if (ret == Z_NEED_DICT || (ret == Z_BUF_ERROR && eof))
+            ret = Z_DATA_ERROR;         /* truncated input ends up here too */
+        if (ret == Z_MEM_ERROR || ret == Z_DATA_ERROR || ret == Z_STREAM_ERROR)
+            break;
+
+        if (ret == Z_STREAM_END) {
+            if (index->mode != ZRAN_GZIP)
+                break;
+            /* look for another gzip member; anything else is trailing garbage */
+            refill_pair(src, input, &strm, &totread);
+            if (strm.avail_in < 2 || strm.next_in[0] != 0x1f ||
+                    strm.next_in[1] != 0x8b)
+                break;
+            inflateReset(&strm);
+            member_start = totout;
+            continue;
+        }
+
+        /* at a block boundary that is not the end of the last block? */
+        if ((strm.data_type & 128) && !(strm.data_type & 64) &&
+                (totout == 0 || totout - last >= span)) {
+            zran_point *point = add_point(index);
+            unsigned next = ZRAN_WINSIZE - strm.avail_out;
+            unsigned wsize = totout < ZRAN_WINSIZE ? (unsigned)totout : ZRAN_WINSIZE;
+
+            if (point == NULL || save_window(point, ring, next, wsize) != 0) {
+                ret = Z_MEM_ERROR;
+                break;
+            }
+            point->out = totout;
+            point->in = totin;
+            point->bits = strm.data_type & 7;
+            point->check = strm.adler;
+            point->member_out = totout - member_start;
+            last = totout;
+        }
+    }
+
+    if (initialized)
+        inflateEnd(&strm);
+    if (ret == Z_STREAM_END) {
+        /* trailing data after the stream still counts toward the source, which
+           may be longer than what was read; a pipe is read to its end */
+        index->source_size = source_length(src);
+        if (index->source_size < 0) {
+            size_t got;
+            while ((got = source_read(src, input, ZRAN_CHUNK)) > 0)
+                totread += (int64_t)got;
+            index->source_size = totread;
+        }
+    }
+    free(input);
+    free(ring);
+    if (ret != Z_STREAM_END) {
+        index_free(index);
+        return ret == Z_OK ? Z_DATA_ERROR : ret;
+    }
+    index->length = totout;
+    index->stream_size = totin;
+    *built = index;
+    return Z_OK;
+}
+
+/* Find the last point at or before offset */
+static const zran_point *find_point(const swift_zran_index_t *index,
+                                    int64_t offset) {
+    int lo = 0, hi = index->have - 1;
+
+    if (index->have == 0)
+        return NULL;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) >> 1;
+        if (index->list[mid].out <= offset)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return &index->list[lo];
+}
+
+/* Set up strm (already inflateInit2'ed with -15) to continue at point, whose
+   partial byte is value */
+static int restart_at(z_streamp strm, const swift_zran_index_t *index,
+                      const zran_point *point, int value) {
+    int ret = inflateReset2(strm, ZRAN_RAW);
+    if (ret == Z_OK && point->bits)
+        ret = inflatePrime(strm, point->bits, value >> (8 - point->bits));
+    if (ret == Z_OK && point->wsize)
+        ret = inflateSetDictionary(strm, point->window, point->wsize);
+    if (ret == Z_OK && index->mode != ZRAN_RAW)
+        ret = inflate_resume(strm, index->mode, point->check,
+                             (unsigned long)point->member_out);
+    return ret;
+}
+
+static int64_t zran_extract(zran_source *src, const swift_zran_index_t *index,
+                            int64_t offset, unsigned char *buf, size_t len) {
+    z_stream strm;
+    unsigned char *input, *discard;
+    const zran_point *point;
+    int64_t skip;
+    size_t got = 0;
+    int ret, value = 0, eof = 0;
+
+    if (index == NULL || offset < 0 || (len && buf == NULL))
+        return Z_STREAM_ERROR;
+    if (len == 0 || offset >= index->length)
+        return 0;
+    point = find_point(index, offset);
+    if (point == NULL)
+        return Z_DATA_ERROR;
+
+    if (source_seek(src, point->in - (point->bits ? 1 : 0)) != 0)
+        return Z_ERRNO;
+    if (point->bits) {
+        unsigned char byte;
+        if (source_read(src, &byte, 1) != 1)
+            return Z_DATA_ERROR;
+        value = byte;
+    }
+
+    input = (unsigned char *)malloc(ZRAN_CHUNK);
+    discard = (unsigned char *)malloc(ZRAN_WINSIZE);
+    if (input == NULL || discard == NULL) {
+        free(input);
+        free(discard);
+        return Z_MEM_ERROR;
+    }
+    memset(&strm, 0, sizeof(strm));
+    ret = inflateInit2(&strm, ZRAN_RAW);
+    if (ret == Z_OK)
+        ret = restart_at(&strm, index, point, value);
+    if (ret != Z_OK) {
+        inflateEnd(&strm);
+        free(input);
+        free(discard);
+        return ret;
+    }
+
+    skip = offset - point->out;
+    while (got < len) {
+        if (strm.avail_in == 0 && !eof) {
+            strm.avail_in = (uInt)source_read(src, input, ZRAN_CHUNK);
+            strm.next_in = input;
+            eof = strm.avail_in == 0;
+        }
+        if (skip > 0) {
+            strm.next_out = discard;
+            strm.avail_out = skip < ZRAN_WINSIZE ? (uInt)skip : ZRAN_WINSIZE;
+        } else {
+            size_t left = len - got;
+            strm.next_out = buf + got;
+            strm.avail_out = left < UINT_MAX ? (uInt)left : UINT_MAX;
+        }
+
+        {
+            unsigned out_before = strm.avail_out;
+            ret = inflate(&strm, Z_NO_FLUSH);
+            if (skip > 0)
+                skip -= out_before - strm.avail_out;
+            else
+                got += out_before - strm.avail_out;
+        }
+        if (ret == Z_NEED_DICT || (ret == Z_BUF_ERROR && eof))
+            ret = Z_DATA_ERROR;         /* truncated input */
+        if (ret == Z_MEM_ERROR || ret == Z_DATA_ERROR || ret == Z_STREAM_ERROR)
+            break;
+        if (ret == Z_STREAM_END) {
+            if (index->mode != ZRAN_GZIP)
+                break;
+            refill_pair(src, input, &strm, NULL);
+            if (strm.avail_in < 2 || strm.next_in[0] != 0x1f ||
+                    strm.next_in[1] != 0x8b)
+                break;
+            inflateReset(&strm);        /* keeps the gzip wrapper */
+        }
+        ret = Z_OK;
+    }
+
+    inflateEnd(&strm);
+    free(input);
+    free(discard);
+    if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+        return ret;
+    return (int64_t)got;
+}
+
+// Exported wrappers (__attribute__((used)) for the same reason as zlib_shim.c)
+
+__attribute__((used)) int swift_zran_build_file(FILE *in, int64_t span,
+                                               swift_zran_index_t **built) {
+    zran_source src = {in, NULL, 0, 0};
+    if (in == NULL || built == NULL)
+        return Z_STREAM_ERROR;
+    return zran_build(&src, span, built);
+}
+
+__attribute__((used)) int swift_zran_build_buffer(const unsigned char *data,
+                                                 size_t size, int64_t span,
+                                                 swift_zran_index_t **built) {
+    zran_source src = {NULL, data, size, 0};
+    if ((data == NULL && size) || built == NULL)
+        return Z_STREAM_ERROR;
+    return zran_build(&src, span, built);
+}
+
+__attribute__((used)) int64_t swift_zran_extract_file(
+        FILE *in, const swift_zran_index_t *index, int64_t offset,
+        unsigned char *buf, size_t len) {
+    zran_source src = {in, NULL, 0, 0};
+    if (in == NULL)
+        return Z_STREAM_ERROR;
+    return zran_extract(&src, index, offset, buf, len);
+}
+
+__attribute__((used)) int64_t swift_zran_extract_buffer(
+        const unsigned char *data, size_t size,
+        const swift_zran_index_t *index, int64_t offset,
+        unsigned char *buf, size_t len) {
+    zran_source src = {NULL, data, size, 0};
+    if (data == NULL && size)
+        return Z_STREAM_ERROR;
+    return zran_extract(&src, index, offset, buf, len);
+}
+
+/* Set up strm, already inflateInit2'ed, to continue from the last point at or
+   before offset in the in-memory data the index was built from.  Returns the
+   point's uncompressed offset and sets *in_offset to the data offset to feed
+   next, or returns a negative zlib error. */
+__attribute__((used)) int64_t swift_zran_restart(
+        z_streamp strm, const unsigned char *data, size_t size,
+        const swift_zran_index_t *index, int64_t offset, int64_t *in_offset) {
+    const zran_point *point;
+    int ret, value = 0;
+
+    if (strm == NULL || index == NULL || in_offset == NULL || offset < 0 ||
+            (data == NULL && size))
+        return Z_STREAM_ERROR;
+    point = find_point(index, offset);
+    if (point == NULL || point->in > (int64_t)size ||
+            (point->bits && point->in < 1))
+        return Z_DATA_ERROR;
+    if (point->bits)
+        value = data[point->in - 1];
+    ret = restart_at(strm, index, point, value);
+    if (ret != Z_OK)
+        return ret;
+    *in_offset = point->in;
+    return point->out;
+}
+
+__attribute__((used)) void swift_zran_free(swift_zran_index_t *index) {
+    index_free(index);
+}
+
+__attribute__((used)) int swift_zran_mode(const swift_zran_index_t *index) {
+    return index ? index->mode : 0;
+}
+
+__attribute__((used)) int swift_zran_count(const swift_zran_index_t *index) {
+    return index ? index->have : 0;
+}
+
+__attribute__((used)) int64_t swift_zran_span(const swift_zran_index_t *index) {
+    return index ? index->span : 0;
+}
+
+__attribute__((used)) int64_t swift_zran_length(const swift_zran_index_t *index) {
+    return index ? index->length : 0;
+}
+
+__attribute__((used)) int64_t swift_zran_source_size(const swift_zran_index_t *index) {
+    return index ? index->source_size : 0;
+}
+
+__attribute__((used)) int64_t swift_zran_stream_size(const swift_zran_index_t *index) {
+    return index ? index->stream_size : 0;
+}
+
+__attribute__((used)) int64_t swift_zran_source_mtime(const swift_zran_index_t *index) {
+    return index ? index->source_mtime : 0;
+}
+
+__attribute__((used)) unsigned long swift_zran_source_check(const swift_zran_index_t *index) {
+    return index ? index->source_check : 0;
+}
+
+__attribute__((used)) void swift_zran_set_source(swift_zran_index_t *index, int64_t mtime,
+                                               unsigned long check) {
+    if (index == NULL)
+        return;
+    index->source_mtime = mtime;
+    index->source_check = check;
+}
+
+__attribute__((used)) int64_t swift_zran_point_offset(const swift_zran_index_t *index,
+                                                     int64_t offset) {
+    const zran_point *point = index ? find_point(index, offset) : NULL;
+    return point ? point->out : -1;
+}
+
+// Sidecar persistence
+
+static int put_u64(FILE *out, uint64_t v) {
+    unsigned char b[8];
+    int i;
+    for (i = 0; i < 8; i++)
+        b[i] = (unsigned char)(v >> (8 * i));
+    return fwrite(b, 1, 8, out) == 8 ? 0 : -1;
+}
+
+static int get_u64(FILE *in, uint64_t *v) {
+    unsigned char b[8];
+    int i;
+    if (fread(b, 1, 8, in) != 8)
+        return -1;
+    *v = 0;
+    for (i = 7; i >= 0; i--)
+        *v = (*v << 8) | b[i];
+    return 0;
+}
+
+/* Layout: magic[8], mode, count, span, length, source_size, stream_size,
+   source_mtime, source_check, then per point out, in, bits, check, member_out, wsize and
+   wsize window bytes; every number is a little-endian 64-bit field */
+__attribute__((used)) int swift_zran_save(const swift_zran_index_t *index,
+                                         FILE *out) {
+    int i;
+
+    if (index == NULL || out == NULL)
+        return Z_STREAM_ERROR;
+    if (fwrite(zran_magic, 1, sizeof(zran_magic), out) != sizeof(zran_magic) ||
+            put_u64(out, (uint64_t)(int64_t)index->mode) ||
+            put_u64(out, (uint64_t)index->have) ||
+            put_u64(out, (uint64_t)index->span) ||
+            put_u64(out, (uint64_t)index->length) ||
+            put_u64(out, (uint64_t)index->source_size) ||
+            put_u64(out, (uint64_t)index->stream_size) ||
+            put_u64(out, (uint64_t)index->source_mtime) ||
+            put_u64(out, (uint64_t)index->source_check))
+        return Z_ERRNO;
+    for (i = 0; i < index->have; i++) {
+        const zran_point *point = &index->list[i];
+        if (put_u64(out, (uint64_t)point->out) ||
+                put_u64(out, (uint64_t)point->in) ||
+                put_u64(out, (uint64_t)point->bits) ||
+                put_u64(out, (uint64_t)point->check) ||
+                put_u64(out, (uint64_t)point->member_out) ||
+                put_u64(out, (uint64_t)point->wsize) ||
+                (point->wsize &&
+                 fwrite(point->window, 1, point->wsize, out) != point->wsize))
+            return Z_ERRNO;
+    }
+    return fflush(out) == 0 ? Z_OK : Z_ERRNO;
+}
+
+__attribute__((used)) int swift_zran_load(FILE *in, swift_zran_index_t **loaded) {
+    unsigned char magic[sizeof(zran_magic)];
+    uint64_t mode, count, span, length, source_size, stream_size, source_mtime,
+             source_check;
+    swift_zran_index_t *index;
+    uint64_t i;
+
+    if (in == NULL || loaded == NULL)
+        return Z_STREAM_ERROR;
+    *loaded = NULL;
+    if (fread(magic, 1, sizeof(magic), in) != sizeof(magic) ||
+            memcmp(magic, zran_magic, sizeof(magic)) != 0 ||
+            get_u64(in, &mode) || get_u64(in, &count) || get_u64(in, &span) ||
+            get_u64(in, &length) || get_u64(in, &source_size) ||
+            get_u64(in, &stream_size) || get_u64(in, &source_mtime) || get_u64(in, &source_check))
+        return Z_DATA_ERROR;
+    if (((int)(int64_t)mode != ZRAN_RAW && mode != ZRAN_ZLIB &&
+            mode != ZRAN_GZIP) || count == 0 || count > INT_MAX ||
+            (int64_t)span <= 0 || (int64_t)length < 0 ||
+            (int64_t)stream_size < 0 || stream_size > source_size)
+        return Z_DATA_ERROR;
+
+    index = (swift_zran_index_t *)calloc(1, sizeof(swift_zran_index_t));
+    if (index == NULL)
+        return Z_MEM_ERROR;
+    index->mode = (int)(int64_t)mode;
+    index->span = (int64_t)span;
+    index->length = (int64_t)length;
+    index->source_size = (int64_t)source_size;
+    index->stream_size = (int64_t)stream_size;
+    index->source_mtime = (int64_t)source_mtime;
+    index->source_check = (unsigned long)source_check;
+    for (i = 0; i < count; i++) {
+        uint64_t out, pos, bits, check, member_out, wsize;
+        zran_point *point;
+
+        if (get_u64(in, &out) || get_u64(in, &pos) || get_u64(in, &bits) ||
+                get_u64(in, &check) || get_u64(in, &member_out) ||
+                get_u64(in, &wsize) || bits > 7 || wsize > ZRAN_WINSIZE ||
+                (int64_t)out < 0 || (int64_t)out > index->length ||
+                (int64_t)pos < (bits ? 1 : 0)) {
+            index_free(index);
+            return Z_DATA_ERROR;
+        }
+        point = add_point(index);
+        if (point == NULL) {
+            index_free(index);
+            return Z_MEM_ERROR;
+        }
+        point->out = (int64_t)out;
+        point->in = (int64_t)pos;
+        point->bits = (int)bits;
+        point->check = (unsigned long)check;
+        point->member_out = (int64_t)member_out;
+        point->wsize = (unsigned)wsize;
+        if (wsize) {
+            point->window = (unsigned char *)malloc((size_t)wsize);
+            if (point->window == NULL) {
+                index_free(index);
+                return Z_MEM_ERROR;
+            }
+            if (fread(point->window, 1, (size_t)wsize, in) != wsize) {
+                index_free(index);
+                return Z_DATA_ERROR;
+            }
+        }
+        if (i && point->out < index->list[i - 1].out) {
+            index_free(index);
+            return Z_DATA_ERROR;
+        }
+    }
+    *loaded = index;
+    return Z_OK;
+}
+
+// gzFile repositioning
+
+/* Position a gzFile opened for reading at uncompressed offset using index:
+   the file descriptor is moved to the nearest access point and the gzFile's
+   own inflate stream is restarted there, so reads, gztell() and later gzseek()
+   calls behave exactly as if gzseek() had decoded up to the point.  Returns
+   the new offset, or -1 on error. */
+__attribute__((used)) int64_t swift_zran_gzseek(void *file,
+                                               const swift_zran_index_t *index,
+                                               int64_t offset) {
+    gz_statep state = (gz_statep)file;
+    const zran_point *point;
+    int value = 0;
+
+    if (state == NULL || index == NULL || state->mode != GZ_READ ||
+            index->mode != ZRAN_GZIP || offset < 0)
+        return -1;
+    if (state->err != Z_OK && state->err != Z_BUF_ERROR)
+        return -1;
+
+    /* make sure the read buffers and inflate state exist */
+    if (state->size == 0 && (gzgetc)((gzFile)file) == -1 && state->size == 0)
+        return -1;
+    if (state->direct)
+        return -1;
+
+    point = find_point(index, offset);
+    if (point == NULL)
+        return -1;
+    if (ZRAN_LSEEK(state->fd, point->in - (point->bits ? 1 : 0), SEEK_SET) == -1)
+        return -1;
+    if (point->bits) {
+        unsigned char byte;
+        if (ZRAN_READ(state->fd, &byte, 1) != 1)
+            return -1;
+        value = byte;
+    }
+    if (restart_at(&state->strm, index, point, value) != Z_OK)
+        return -1;
+
+    state->strm.avail_in = 0;
+    state->strm.next_in = state->in;
+    state->x.have = 0;
+    state->x.next = state->out;
+    state->x.pos = point->out;
+    state->eof = 0;
+    state->past = 0;
+    state->how = GZIP;
+    gz_error(state, Z_OK, NULL);
+    state->seek = offset > point->out;
+    state->skip = offset - point->out;
+    return offset;
+}
@@ -109,9 +109,109 @@ uLong ZEXPORT zlibCompileFlags(void) {
 #    endif
 #  endif
 #endif
+    flags += Z_VENDORED_FLAG;
     return flags;
 }
 
+/* ===========================================================================
+ * Run-time CPU feature detection for the SIMD kernels. The result is computed
+ * on first use and cached; concurrent first calls store the same value.
+ */
+#ifdef Z_X86_SIMD
+#  include <cpuid.h>
+
+local unsigned detect_cpu_features(void) {
+    unsigned eax, ebx, ecx, edx, features = 0;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return 0;
+    if (edx & (1u << 26)) features |= Z_CPU_SSE2;
+    if (ecx & (1u << 9))  features |= Z_CPU_SSSE3;
+    if (ecx & (1u << 20)) features |= Z_CPU_SSE42;
+    if (ecx & (1u << 1))  features |= Z_CPU_PCLMUL;
+
+    /* AVX2 needs both the instruction set and OS support for YMM state */
+    if ((ecx & (1u << 27)) && (ecx & (1u << 28))) {
+        unsigned xcr0_lo, xcr0_hi;
+        __asm__ volatile ("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+        if ((xcr0_lo & 6) == 6 && __get_cpuid_max(0, NULL) >= 7) {
+            __cpuid_count(7, 0, eax, ebx, ecx, edx);
+            if (ebx & (1u << 5)) features |= Z_CPU_AVX2;
+        }
+    }
+    return features;
+}
+#elif defined(Z_NEON_SIMD)
+local unsigned detect_cpu_features(void) {
+    unsigned features = Z_CPU_NEON;
+#  ifdef __ARM_FEATURE_CRC32
+    features |= Z_CPU_ARM_CRC32;
+#  endif
+    return features;
+}
+#else
+local unsigned detect_cpu_features(void) {
+    return 0;
+}
+#endif
+
+unsigned ZLIB_INTERNAL z_cpu_features(void) {
+    static volatile unsigned cached = 0;
+    unsigned features = cached;
+
+    if (features == 0) {
+        /* bit 31 marks the value as computed, even when no feature is present */
+        features = detect_cpu_features() | 0x80000000u;
+        cached = features;
+    }
+    return features & 0x7fffffffu;
+}
+
+/* ===========================================================================
+ * Dispatch table for the checksum kernels. adler32_z() and crc32_z() call
+ * through it, so inflate, deflate and the direct checksum calls all use the
+ * fastest kernel the CPU supports. The table starts out with the portable
+ * kernels and each entry is upgraded on first use. Every entry is valid at
+ * all times, so a racing first call at worst uses the portable kernel once.
+ */
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#  define CRC32_PORTABLE_NAME "armv8-crc32"
+#else
+#  define CRC32_PORTABLE_NAME "braided"
+#endif
+
+const z_functable_t * ZLIB_INTERNAL z_functable(void) {
+    static z_functable_t table = {
+        adler32_portable, crc32_portable, "portable", CRC32_PORTABLE_NAME
+    };
+    static volatile int ready = 0;
+
+    if (!ready) {
+#ifdef Z_X86_SIMD
+        unsigned cpu = z_cpu_features();
+
+        if (cpu & Z_CPU_AVX2) {
+            table.adler32_name = "avx2";
+            table.adler32 = adler32_avx2;
+        } else if (cpu & Z_CPU_SSSE3) {
+            table.adler32_name = "ssse3";
+            table.adler32 = adler32_ssse3;
+        }
+        if ((cpu & Z_CPU_PCLMUL) && (cpu & Z_CPU_SSE42)) {
+            table.crc32_name = "pclmul";
+            table.crc32 = crc32_pclmul;
+        }
+#elif defined(Z_NEON_SIMD)
+        if (z_cpu_features() & Z_CPU_NEON) {
+            table.adler32_name = "neon";
+            table.adler32 = adler32_neon;
+        }
+#endif
+        ready = 1;
+    }
+    return &table;
+}
+
 #ifdef ZLIB_DEBUG
 #include <stdlib.h>
 #  ifndef verbose
@@ -283,8 +383,26 @@ extern voidp calloc(uInt items, uInt size);
 extern void free(voidpf ptr);
 #endif
 
+#ifdef Z_ALLOC_STATS
+/* Calls and bytes served by the default allocator, read with
+   swift_zalloc_stats() by the benchmarks. Only benchmark builds define
+   Z_ALLOC_STATS, so other allocations do not pay for the atomic adds. */
+unsigned long long ZLIB_INTERNAL z_alloc_calls = 0;
+unsigned long long ZLIB_INTERNAL z_alloc_bytes = 0;
+#endif
+
 voidpf ZLIB_INTERNAL zcalloc(voidpf opaque, unsigned items, unsigned size) {
     (void)opaque;
+#ifdef Z_ALLOC_STATS
+#  if defined(__GNUC__) || defined(__clang__)
+    __atomic_fetch_add(&z_alloc_calls, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&z_alloc_bytes, (unsigned long long)items * size,
+                       __ATOMIC_RELAXED);
+#  else
+    z_alloc_calls++;
+    z_alloc_bytes += (unsigned long long)items * size;
+#  endif
+#endif
     return sizeof(uInt) > 2 ? (voidpf)malloc(items * size) :
                               (voidpf)calloc(items, size);
 }
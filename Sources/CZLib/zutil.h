@@ -247,6 +247,73 @@ extern z_const char * const z_errmsg[10]; /* indexed by 2-zlib_error */
 #define ZFREE(strm, addr)  (*((strm)->zfree))((strm)->opaque, (voidpf)(addr))
 #define TRY_FREE(s, p) {if (p) ZFREE(s, p);}
 
+/* SIMD support. Vector kernels are built with GCC/Clang target attributes and
+   selected at run time from z_cpu_features(), so the library still runs on
+   CPUs without the extensions. Define Z_NO_SIMD to build the portable code
+   only. The Windows build defines __NO_INTRINSICS__ to keep the intrinsic
+   headers out, which disables the kernels there as well.
+ */
+#if !defined(Z_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && \
+    !(defined(_WIN32) && defined(__NO_INTRINSICS__))
+#  if defined(__x86_64__) || defined(__i386__)
+#    define Z_X86_SIMD
+#  elif defined(__aarch64__) && defined(__ARM_NEON)
+#    define Z_NEON_SIMD
+#  endif
+#endif
+
+#define Z_CPU_SSE2      0x01
+#define Z_CPU_SSSE3     0x02
+#define Z_CPU_SSE42     0x04
+#define Z_CPU_PCLMUL    0x08
+#define Z_CPU_AVX2      0x10
+#define Z_CPU_NEON      0x20
+#define Z_CPU_ARM_CRC32 0x40
+
+   unsigned ZLIB_INTERNAL z_cpu_features(void);
+
+/* Checksum kernels, chosen once from z_cpu_features() by z_functable() */
+   uLong ZLIB_INTERNAL adler32_portable(uLong adler, const Bytef *buf,
+                                        z_size_t len);
+   unsigned long ZLIB_INTERNAL crc32_portable(unsigned long crc,
+                                              const unsigned char FAR *buf,
+                                              z_size_t len);
+#ifdef Z_X86_SIMD
+   uLong ZLIB_INTERNAL adler32_ssse3(uLong adler, const Bytef *buf,
+                                     z_size_t len);
+   uLong ZLIB_INTERNAL adler32_avx2(uLong adler, const Bytef *buf,
+                                    z_size_t len);
+   unsigned long ZLIB_INTERNAL crc32_pclmul(unsigned long crc,
+                                            const unsigned char FAR *buf,
+                                            z_size_t len);
+#elif defined(Z_NEON_SIMD)
+   uLong ZLIB_INTERNAL adler32_neon(uLong adler, const Bytef *buf,
+                                    z_size_t len);
+#endif
+
+typedef struct z_functable_s {
+    uLong (*adler32)(uLong adler, const Bytef *buf, z_size_t len);
+    unsigned long (*crc32)(unsigned long crc, const unsigned char FAR *buf,
+                           z_size_t len);
+    const char *adler32_name;   /* kernel names, for diagnostics */
+    const char *crc32_name;
+} z_functable_t;
+
+   const z_functable_t * ZLIB_INTERNAL z_functable(void);
+
+/* Kernel choices of deflate.c and inffast.c, for diagnostics */
+   void ZLIB_INTERNAL deflate_kernels(const char **match_len,
+                                      const char **hash);
+   int ZLIB_INTERNAL inflate_wide_enabled(void);
+
+/* Reserved zlibCompileFlags() bit set by this vendored copy, so callers can
+   tell it apart from a system zlib that the linker might have picked */
+#define Z_VENDORED_FLAG (1UL << 27)
+
+/* Resume a primed raw inflate stream as zlib (15) or gzip (31); see inflate.c */
+int ZLIB_INTERNAL inflate_resume(z_streamp strm, int windowBits,
+                                 unsigned long check, unsigned long total);
+
 /* Reverse the bytes in a 32-bit value */
 #define ZSWAP32(q) ((((q) >> 24) & 0xff) + (((q) >> 8) & 0xff00) + \
                     (((q) & 0xff00) << 8) + (((q) & 0xff) << 24))
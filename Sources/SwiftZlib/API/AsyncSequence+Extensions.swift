@@ -0,0 +1,103 @@
+//
+//  AsyncSequence+Extensions.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import Foundation
+
+@available(macOS 10.15, iOS 13.0, tvOS 13.0, watchOS 6.0, *)
+public extension AsyncSequence where Element == Data {
+    /// Compress the chunks of this sequence on a background pipeline
+    /// - Parameters:
+    ///   - level: Compression level
+    ///   - format: Output format
+    ///   - bufferSize: Size of the compressed chunks produced
+    ///   - maxBufferedChunks: Chunks each pipeline stage may run ahead of the next one
+    /// - Returns: Async sequence of compressed chunks
+    func deflated(
+        level: CompressionLevel = .defaultCompression,
+        format: CompressionFormat = .zlib,
+        bufferSize: Int = 64 * 1024,
+        maxBufferedChunks: Int = 4
+    ) -> AsyncZLibSequence<Self> {
+        deflated(options: CompressionOptions(format: format, level: level), bufferSize: bufferSize, maxBufferedChunks: maxBufferedChunks)
+    }
+
+    /// Compress the chunks of this sequence on a background pipeline
+    /// - Parameters:
+    ///   - options: Compression options
+    ///   - bufferSize: Size of the compressed chunks produced
+    ///   - maxBufferedChunks: Chunks each pipeline stage may run ahead of the next one
+    /// - Returns: Async sequence of compressed chunks
+    func deflated(options: CompressionOptions, bufferSize: Int = 64 * 1024, maxBufferedChunks: Int = 4) -> AsyncZLibSequence<Self> {
+        AsyncZLibSequence(
+            base: self,
+            mode: .compress,
+            options: ZLibStream.StreamOptions(compression: options, bufferSize: bufferSize),
+            maxBufferedChunks: maxBufferedChunks
+        )
+    }
+
+    /// Decompress the chunks of this sequence on a background pipeline
+    /// - Parameters:
+    ///   - format: Input format; `.auto` accepts zlib and (multi-member) gzip
+    ///   - bufferSize: Maximum size of the decompressed chunks produced
+    ///   - maxBufferedChunks: Chunks each pipeline stage may run ahead of the next one
+    /// - Returns: Async sequence of decompressed chunks; iteration throws if the input is invalid or truncated
+    func inflated(format: CompressionFormat = .auto, bufferSize: Int = 64 * 1024, maxBufferedChunks: Int = 4) -> AsyncZLibSequence<Self> {
+        inflated(options: DecompressionOptions(format: format), bufferSize: bufferSize, maxBufferedChunks: maxBufferedChunks)
+    }
+
+    /// Decompress the chunks of this sequence on a background pipeline
+    /// - Parameters:
+    ///   - options: Decompression options
+    ///   - bufferSize: Maximum size of the decompressed chunks produced
+    ///   - maxBufferedChunks: Chunks each pipeline stage may run ahead of the next one
+    /// - Returns: Async sequence of decompressed chunks; iteration throws if the input is invalid or truncated
+    func inflated(options: DecompressionOptions, bufferSize: Int = 64 * 1024, maxBufferedChunks: Int = 4) -> AsyncZLibSequence<Self> {
+        AsyncZLibSequence(
+            base: self,
+            mode: .decompress,
+            options: ZLibStream.StreamOptions(decompression: options, bufferSize: bufferSize),
+            maxBufferedChunks: maxBufferedChunks
+        )
+    }
+}
+
+@available(macOS 10.15, iOS 13.0, tvOS 13.0, watchOS 6.0, *)
+public extension AsyncSequence where Element == UInt8 {
+    /// Group the bytes of this sequence into `Data` chunks
+    /// - Parameter size: Maximum chunk size
+    /// - Returns: Async sequence of chunks
+    func dataChunks(ofSize size: Int = 64 * 1024) -> AsyncDataChunkSequence<Self> {
+        AsyncDataChunkSequence(base: self, chunkSize: size)
+    }
+
+    /// Compress this byte sequence (e.g. `URLSession.AsyncBytes`) on a background pipeline
+    /// - Parameters:
+    ///   - level: Compression level
+    ///   - format: Output format
+    ///   - bufferSize: Size of the input batches and of the compressed chunks produced
+    ///   - maxBufferedChunks: Chunks each pipeline stage may run ahead of the next one
+    /// - Returns: Async sequence of compressed chunks
+    func deflated(
+        level: CompressionLevel = .defaultCompression,
+        format: CompressionFormat = .zlib,
+        bufferSize: Int = 64 * 1024,
+        maxBufferedChunks: Int = 4
+    ) -> AsyncZLibSequence<AsyncDataChunkSequence<Self>> {
+        dataChunks(ofSize: bufferSize).deflated(level: level, format: format, bufferSize: bufferSize, maxBufferedChunks: maxBufferedChunks)
+    }
+
+    /// Decompress this byte sequence (e.g. `URLSession.AsyncBytes`) on a background pipeline
+    /// - Parameters:
+    ///   - format: Input format; `.auto` accepts zlib and (multi-member) gzip
+    ///   - bufferSize: Size of the input batches and maximum size of the decompressed chunks
+    ///   - maxBufferedChunks: Chunks each pipeline stage may run ahead of the next one
+    /// - Returns: Async sequence of decompressed chunks
+    func inflated(format: CompressionFormat = .auto, bufferSize: Int = 64 * 1024, maxBufferedChunks: Int = 4) -> AsyncZLibSequence<AsyncDataChunkSequence<Self>> {
+        dataChunks(ofSize: bufferSize).inflated(format: format, bufferSize: bufferSize, maxBufferedChunks: maxBufferedChunks)
+    }
+}
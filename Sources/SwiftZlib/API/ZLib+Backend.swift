@@ -0,0 +1,132 @@
+//
+//  ZLib+Backend.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+// MARK: - ZLibBackend
+
+/// The zlib implementation a process runs and the kernels it selected
+///
+/// The vendored CZLib sources are compiled in on every platform, but unless the package is
+/// built with `SWIFTZLIB_VENDORED_ZLIB=1` the host's libz is linked too, and the linker decides
+/// which one the zlib entry points resolve to. `isVendored` reports that decision; the kernel
+/// names are only meaningful for the vendored core and read "system" otherwise.
+public struct ZLibBackend: Sendable, CustomStringConvertible {
+    // MARK: Nested Types
+
+    /// CPU features detected at run time and used to pick the vector kernels
+    public struct CPUFeatures: OptionSet, Sendable, CustomStringConvertible {
+        // MARK: Static Properties
+
+        public static let sse2 = CPUFeatures(rawValue: 0x01)
+        public static let ssse3 = CPUFeatures(rawValue: 0x02)
+        public static let sse42 = CPUFeatures(rawValue: 0x04)
+        public static let pclmul = CPUFeatures(rawValue: 0x08)
+        public static let avx2 = CPUFeatures(rawValue: 0x10)
+        public static let neon = CPUFeatures(rawValue: 0x20)
+        public static let armCRC32 = CPUFeatures(rawValue: 0x40)
+
+        private static let names: [(CPUFeatures, String)] = [
+            (.sse2, "sse2"), (.ssse3, "ssse3"), (.sse42, "sse4.2"), (.pclmul, "pclmul"),
+            (.avx2, "avx2"), (.neon, "neon"), (.armCRC32, "crc32"),
+        ]
+
+        // MARK: Properties
+
+        public let rawValue: UInt32
+
+        // MARK: Computed Properties
+
+        public var description: String {
+            let present = CPUFeatures.names.filter { contains($0.0) }.map(\.1)
+            return present.isEmpty ? "none" : present.joined(separator: ",")
+        }
+
+        // MARK: Lifecycle
+
+        public init(rawValue: UInt32) {
+            self.rawValue = rawValue
+        }
+    }
+
+    /// Configuration the build-time specialized deflate was compiled for
+    public struct SpecializedDeflate: Sendable, Equatable {
+        public let level: Int
+        /// Window size as log2 bytes (9...15), for raw, zlib and gzip framing alike
+        public let windowBits: Int
+        public let memoryLevel: Int
+    }
+
+    // MARK: Properties
+
+    /// Whether the zlib in use is the vendored CZLib core rather than a system libz
+    public let isVendored: Bool
+    /// Version string of the zlib in use
+    public let version: String
+    public let cpuFeatures: CPUFeatures
+    /// Adler-32 kernel, e.g. "avx2", "ssse3", "neon" or "portable"
+    public let adler32Kernel: String
+    /// CRC-32 kernel, e.g. "pclmul", "armv8-crc32" or "braided"
+    public let crc32Kernel: String
+    /// Deflate match length kernel: "avx2", "sse2", "neon", "word" or "bytewise"
+    public let matchKernel: String
+    /// Deflate insert hash: "rolling", or "crc32c" in `Z_DEFLATE_CRC_HASH` builds
+    public let insertHash: String
+    /// Whether `inflate_fast` uses the 64-bit bit buffer decode loop
+    public let usesWideInflate: Bool
+    /// Specialized deflate of this build (`SWIFTZLIB_SPECIALIZED_DEFLATE`), if any
+    public let specializedDeflate: SpecializedDeflate?
+
+    // MARK: Computed Properties
+
+    public var description: String {
+        guard isVendored else {
+            return "system zlib \(version); cpu \(cpuFeatures)"
+        }
+        var parts = [
+            "adler32 \(adler32Kernel)",
+            "crc32 \(crc32Kernel)",
+            "match \(matchKernel)",
+            "hash \(insertHash)",
+            usesWideInflate ? "wide inflate" : "portable inflate",
+        ]
+        if let specialized = specializedDeflate {
+            parts.append("deflate specialized for level \(specialized.level), windowBits \(specialized.windowBits), memLevel \(specialized.memoryLevel)")
+        }
+        return "vendored zlib \(version); cpu \(cpuFeatures); " + parts.joined(separator: ", ")
+    }
+
+    // MARK: Lifecycle
+
+    init(_ info: swift_zlib_backend_t, version: String) {
+        isVendored = info.vendored != 0
+        self.version = version
+        cpuFeatures = CPUFeatures(rawValue: UInt32(info.cpu_features))
+        adler32Kernel = String(cString: info.adler32_kernel)
+        crc32Kernel = String(cString: info.crc32_kernel)
+        matchKernel = String(cString: info.match_kernel)
+        insertHash = String(cString: info.insert_hash)
+        usesWideInflate = info.inflate_wide != 0
+        specializedDeflate = info.specialized_level == 0 ? nil : SpecializedDeflate(
+            level: Int(info.specialized_level),
+            windowBits: Int(info.specialized_window_bits),
+            memoryLevel: Int(info.specialized_mem_level)
+        )
+    }
+}
+
+// MARK: - Backend Report
+
+public extension ZLib {
+    /// Which zlib implementation and kernels this process uses
+    static var backend: ZLibBackend {
+        var info = swift_zlib_backend_t()
+        swift_zlib_backend(&info)
+        return ZLibBackend(info, version: version)
+    }
+}
@@ -0,0 +1,80 @@
+//
+//  ZLib+Batch.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import Foundation
+
+// MARK: - Batch APIs
+
+public extension ZLib {
+    /// Compress many small payloads in one call
+    ///
+    /// Each record becomes an independent stream in the requested format. The records are spread
+    /// over worker threads that each reuse one reset z_stream, and all outputs are written into
+    /// a single buffer with an offsets table. `options.gzipHeader` is ignored.
+    /// - Parameters:
+    ///   - items: Payloads to compress
+    ///   - level: Compression level; `options.level` is used when nil
+    ///   - options: Format, strategy, memory level and optional dictionary shared by all records
+    ///   - maxConcurrency: Maximum number of worker threads (default: active CPU count)
+    /// - Returns: Compressed records in input order
+    /// - Throws: ZLibError if any record fails to compress
+    static func compressBatch(
+        _ items: [Data],
+        level: CompressionLevel? = nil,
+        options: CompressionOptions = CompressionOptions(),
+        maxConcurrency: Int? = nil
+    ) throws -> DataBatch {
+        try BatchCodec.compress(.items(items), level: level ?? options.level, options: options, maxConcurrency: maxConcurrency)
+    }
+
+    /// Compress every record of a packed batch
+    /// - Parameters:
+    ///   - batch: Payloads to compress
+    ///   - level: Compression level; `options.level` is used when nil
+    ///   - options: Format, strategy, memory level and optional dictionary shared by all records
+    ///   - maxConcurrency: Maximum number of worker threads (default: active CPU count)
+    /// - Returns: Compressed records in input order
+    /// - Throws: ZLibError if any record fails to compress
+    static func compressBatch(
+        _ batch: DataBatch,
+        level: CompressionLevel? = nil,
+        options: CompressionOptions = CompressionOptions(),
+        maxConcurrency: Int? = nil
+    ) throws -> DataBatch {
+        try BatchCodec.compress(.batch(batch), level: level ?? options.level, options: options, maxConcurrency: maxConcurrency)
+    }
+
+    /// Decompress many small independently compressed records in one call
+    /// - Parameters:
+    ///   - items: Compressed records
+    ///   - options: Format and optional dictionary shared by all records
+    ///   - maxConcurrency: Maximum number of worker threads (default: active CPU count)
+    /// - Returns: Decompressed records in input order
+    /// - Throws: ZLibError if any record is invalid or truncated
+    static func decompressBatch(
+        _ items: [Data],
+        options: DecompressionOptions = DecompressionOptions(),
+        maxConcurrency: Int? = nil
+    ) throws -> DataBatch {
+        try BatchCodec.decompress(.items(items), options: options, maxConcurrency: maxConcurrency)
+    }
+
+    /// Decompress every record of a packed batch, such as the result of `compressBatch`
+    /// - Parameters:
+    ///   - batch: Compressed records
+    ///   - options: Format and optional dictionary shared by all records
+    ///   - maxConcurrency: Maximum number of worker threads (default: active CPU count)
+    /// - Returns: Decompressed records in input order
+    /// - Throws: ZLibError if any record is invalid or truncated
+    static func decompressBatch(
+        _ batch: DataBatch,
+        options: DecompressionOptions = DecompressionOptions(),
+        maxConcurrency: Int? = nil
+    ) throws -> DataBatch {
+        try BatchCodec.decompress(.batch(batch), options: options, maxConcurrency: maxConcurrency)
+    }
+}
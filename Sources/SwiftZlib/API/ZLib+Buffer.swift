@@ -0,0 +1,255 @@
+//
+//  ZLib+Buffer.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+// MARK: - Buffer-Based One-Shot APIs
+
+public extension ZLib {
+    /// Upper bound on the compressed size of `sourceLength` bytes in zlib format
+    /// - Parameter sourceLength: Uncompressed size in bytes
+    /// - Returns: Output buffer size that `compress(_:into:)` is guaranteed to fit into
+    static func compressBound(_ sourceLength: Int) -> Int {
+        // Gzip adds 12 bytes of header/trailer over zlib's 6
+        Int(swift_compressBound(uLong(sourceLength))) + 12
+    }
+
+    /// Compress raw bytes directly into a caller-provided buffer
+    /// - Parameters:
+    ///   - input: Bytes to compress
+    ///   - output: Destination buffer; `compressBound(input.count)` bytes always suffice
+    ///   - level: Compression level (default: .defaultCompression)
+    ///   - windowBits: Output format (default: .deflate)
+    /// - Returns: Number of bytes written to `output`
+    /// - Throws: `ZLibError.bufferError` if `output` is too small, ZLibError if compression fails
+    static func compress(
+        _ input: UnsafeRawBufferPointer,
+        into output: UnsafeMutableRawBufferPointer,
+        level: CompressionLevel = .defaultCompression,
+        windowBits: WindowBits = .deflate
+    ) throws -> Int {
+        guard windowBits != .auto else {
+            throw ZLibError.invalidData
+        }
+        guard output.count > 0 else {
+            throw ZLibError.bufferError
+        }
+
+        var stream = z_stream()
+        var result = swift_deflateInit2(&stream, level.zlibLevel, Z_DEFLATED, windowBits.zlibWindowBits, 8, Z_DEFAULT_STRATEGY)
+        guard result == Z_OK else {
+            throw ZLibError.compressionFailed(result)
+        }
+        defer { swift_deflateEnd(&stream) }
+
+        var cursor = BufferCursor(input: input, output: output)
+        repeat {
+            cursor.load(into: &stream)
+            let flush = cursor.isLastInputChunk ? Z_FINISH : Z_NO_FLUSH
+            result = swift_deflate(&stream, flush)
+            cursor.store(from: &stream)
+
+            if result == Z_BUF_ERROR || (result == Z_OK && cursor.outputRemaining == 0) {
+                throw ZLibError.bufferError
+            }
+            guard result == Z_OK || result == Z_STREAM_END else {
+                throw ZLibError.compressionFailed(result)
+            }
+        } while result != Z_STREAM_END
+
+        return cursor.written
+    }
+
+    /// Decompress raw bytes directly into a caller-provided buffer
+    ///
+    /// Decoding stops at the end of the first complete stream; any trailing input is left
+    /// unconsumed and reported through `inputConsumed`.
+    /// - Parameters:
+    ///   - input: Compressed bytes
+    ///   - output: Destination buffer for the decompressed bytes (must not be empty)
+    ///   - windowBits: Input format (default: .deflate)
+    /// - Returns: Bytes consumed from `input` and bytes written to `output`
+    /// - Throws: `ZLibError.bufferError` if `output` is too small, ZLibError if decompression fails
+    static func decompress(
+        _ input: UnsafeRawBufferPointer,
+        into output: UnsafeMutableRawBufferPointer,
+        windowBits: WindowBits = .deflate
+    ) throws -> (inputConsumed: Int, outputWritten: Int) {
+        guard output.count > 0 else {
+            throw ZLibError.bufferError
+        }
+
+        var stream = z_stream()
+        var result = swift_inflateInit2(&stream, windowBits.zlibWindowBits)
+        guard result == Z_OK else {
+            throw ZLibError.decompressionFailed(result)
+        }
+        defer { swift_inflateEnd(&stream) }
+
+        var cursor = BufferCursor(input: input, output: output)
+        repeat {
+            cursor.load(into: &stream)
+            result = swift_inflate(&stream, Z_NO_FLUSH)
+            cursor.store(from: &stream)
+
+            switch result {
+                case Z_OK:
+                    continue
+                case Z_BUF_ERROR where cursor.outputRemaining == 0:
+                    throw ZLibError.bufferError
+                case Z_STREAM_END:
+                    break
+                default:
+                    // Z_BUF_ERROR with output space left means the input was truncated
+                    throw ZLibError.decompressionFailed(result)
+            }
+        } while result != Z_STREAM_END
+
+        return (cursor.consumed, cursor.written)
+    }
+
+    /// Decompress raw bytes into a new buffer that grows geometrically in a single inflate pass
+    /// - Parameters:
+    ///   - input: Compressed bytes
+    ///   - windowBits: Input format (default: .deflate)
+    ///   - initialCapacity: First output allocation; doubled whenever it fills up
+    /// - Returns: Decompressed data
+    /// - Throws: ZLibError if decompression fails
+    static func decompress(
+        _ input: UnsafeRawBufferPointer,
+        windowBits: WindowBits = .deflate,
+        initialCapacity: Int? = nil
+    ) throws -> Data {
+        try inflateGrowing(input, windowBits: windowBits, initialCapacity: initialCapacity ?? input.count * 4)
+    }
+
+    // MARK: - Internal Helpers
+
+    /// Inflate into a heap buffer that is doubled in place whenever it fills up.
+    ///
+    /// Unlike retrying `uncompress` with a bigger guess, inflation never restarts: the stream
+    /// keeps its state across reallocations, so every input byte is decoded exactly once. The
+    /// final buffer is shrunk and handed to `Data` without copying.
+    ///
+    /// Error codes mirror `uncompress`: a missing dictionary or truncated input is reported as
+    /// `decompressionFailed(Z_DATA_ERROR)`.
+    internal static func inflateGrowing(
+        _ input: UnsafeRawBufferPointer,
+        windowBits: WindowBits,
+        initialCapacity: Int
+    ) throws -> Data {
+        var stream = z_stream()
+        var result = swift_inflateInit2(&stream, windowBits.zlibWindowBits)
+        guard result == Z_OK else {
+            throw ZLibError.decompressionFailed(result)
+        }
+        defer { swift_inflateEnd(&stream) }
+
+        var capacity = max(initialCapacity, 1024)
+        logMemoryUsage("Decompression output buffer", bytes: capacity)
+        var buffer = malloc(capacity)
+        defer { free(buffer) }
+        guard buffer != nil else {
+            throw ZLibError.memoryError
+        }
+
+        var consumed = 0
+        var written = 0
+        stream.next_in = input.baseAddress.map { UnsafeMutablePointer(mutating: $0.assumingMemoryBound(to: Bytef.self)) }
+
+        repeat {
+            if written == capacity {
+                let (doubled, overflow) = capacity.multipliedReportingOverflow(by: 2)
+                guard !overflow, let grown = realloc(buffer, doubled) else {
+                    throw ZLibError.memoryError
+                }
+                buffer = grown
+                capacity = doubled
+                logMemoryUsage("Decompression buffer grown", bytes: capacity)
+            }
+
+            let inChunk = min(input.count - consumed, Int(uInt.max))
+            let outChunk = min(capacity - written, Int(uInt.max))
+            stream.avail_in = uInt(inChunk)
+            stream.next_out = buffer!.advanced(by: written).assumingMemoryBound(to: Bytef.self)
+            stream.avail_out = uInt(outChunk)
+
+            result = swift_inflate(&stream, Z_NO_FLUSH)
+            consumed += inChunk - Int(stream.avail_in)
+            written += outChunk - Int(stream.avail_out)
+
+            switch result {
+                case Z_OK, Z_STREAM_END:
+                    break
+                case Z_BUF_ERROR where written == capacity:
+                    // Output full; grow and continue
+                    result = Z_OK
+                case Z_NEED_DICT, Z_BUF_ERROR:
+                    throw ZLibError.decompressionFailed(Z_DATA_ERROR)
+                default:
+                    throw ZLibError.decompressionFailed(result)
+            }
+        } while result != Z_STREAM_END
+
+        guard written > 0 else {
+            return Data()
+        }
+        if written < capacity, let shrunk = realloc(buffer, written) {
+            buffer = shrunk
+        }
+        let data = Data(bytesNoCopy: buffer!, count: written, deallocator: .free)
+        buffer = nil
+        return data
+    }
+}
+
+// MARK: - BufferCursor
+
+/// Tracks progress through a pair of caller buffers larger than zlib's 32-bit `avail_*` fields
+private struct BufferCursor {
+    // MARK: Properties
+
+    let input: UnsafeRawBufferPointer
+    let output: UnsafeMutableRawBufferPointer
+    private(set) var consumed = 0
+    private(set) var written = 0
+    private var inChunk = 0
+    private var outChunk = 0
+
+    // MARK: Computed Properties
+
+    var outputRemaining: Int { output.count - written }
+
+    /// Whether the chunk most recently loaded holds the rest of the input
+    var isLastInputChunk: Bool { consumed + inChunk == input.count }
+
+    // MARK: Lifecycle
+
+    init(input: UnsafeRawBufferPointer, output: UnsafeMutableRawBufferPointer) {
+        self.input = input
+        self.output = output
+    }
+
+    // MARK: Functions
+
+    mutating func load(into stream: inout z_stream) {
+        inChunk = min(input.count - consumed, Int(uInt.max))
+        outChunk = min(output.count - written, Int(uInt.max))
+        stream.next_in = input.baseAddress.map {
+            UnsafeMutablePointer(mutating: $0.advanced(by: consumed).assumingMemoryBound(to: Bytef.self))
+        }
+        stream.avail_in = uInt(inChunk)
+        stream.next_out = output.baseAddress.map { $0.advanced(by: written).assumingMemoryBound(to: Bytef.self) }
+        stream.avail_out = uInt(outChunk)
+    }
+
+    mutating func store(from stream: inout z_stream) {
+        consumed += inChunk - Int(stream.avail_in)
+        written += outChunk - Int(stream.avail_out)
+    }
+}
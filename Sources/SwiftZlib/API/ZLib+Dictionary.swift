@@ -0,0 +1,36 @@
+//
+//  ZLib+Dictionary.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import Foundation
+
+// MARK: - Dictionary APIs
+
+public extension ZLib {
+    /// Train a preset dictionary from sample messages
+    /// - Parameters:
+    ///   - samples: Representative messages
+    ///   - maxSize: Maximum dictionary size, capped at 32 KB (default: 32 KB)
+    /// - Returns: Dictionary for `CompressionOptions(dictionary:)` or `PreparedDictionary`
+    static func trainDictionary(from samples: [Data], maxSize: Int = DictionaryTrainer.maxDictionarySize) -> Data {
+        DictionaryTrainer(maxSize: maxSize).train(samples)
+    }
+
+    /// Hash a dictionary once so that many streams can start from it without rehashing
+    /// - Parameters:
+    ///   - dictionary: Dictionary bytes
+    ///   - level: Compression level (default: .defaultCompression)
+    ///   - windowBits: `.deflate` or `.raw` (default: .deflate)
+    /// - Returns: A prepared dictionary shareable across threads
+    /// - Throws: ZLibError if the dictionary cannot be set for the format
+    static func prepareDictionary(
+        _ dictionary: Data,
+        level: CompressionLevel = .defaultCompression,
+        windowBits: WindowBits = .deflate
+    ) throws -> PreparedDictionary {
+        try PreparedDictionary(dictionary, level: level, windowBits: windowBits)
+    }
+}
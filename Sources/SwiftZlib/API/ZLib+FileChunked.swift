@@ -16,12 +16,14 @@ public extension ZLib {
         to destinationPath: String,
         bufferSize: Int = 64 * 1024,
         compressionLevel: CompressionLevel = .defaultCompression,
-        windowBits: WindowBits = .deflate
+        windowBits: WindowBits = .deflate,
+        parallelism: Int = 1
     ) throws {
         let compressor = FileChunkedCompressor(
             bufferSize: bufferSize,
             compressionLevel: compressionLevel,
-            windowBits: windowBits
+            windowBits: windowBits,
+            parallelism: parallelism
         )
         try compressor.compressFile(from: sourcePath, to: destinationPath)
     }
@@ -48,12 +50,14 @@ public extension ZLib {
         to destinationPath: String,
         bufferSize: Int = 64 * 1024,
         compressionLevel: CompressionLevel = .defaultCompression,
-        windowBits: WindowBits = .deflate
+        windowBits: WindowBits = .deflate,
+        parallelism: Int = 1
     ) async throws {
         let compressor = FileChunkedCompressor(
             bufferSize: bufferSize,
             compressionLevel: compressionLevel,
-            windowBits: windowBits
+            windowBits: windowBits,
+            parallelism: parallelism
         )
         try await compressor.compressFile(from: sourcePath, to: destinationPath)
     }
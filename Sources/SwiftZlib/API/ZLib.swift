@@ -65,6 +65,11 @@ public enum ZLib {
             (flags & 0x2000_0000_0000_0000) != 0
         }
 
+        /// Whether the flags come from the vendored CZLib core, which sets reserved bit 27
+        public var isVendored: Bool {
+            (flags & (1 << 27)) != 0
+        }
+
         // MARK: Lifecycle
 
         public init(flags: UInt) {
@@ -72,6 +77,11 @@ public enum ZLib {
         }
     }
 
+    // MARK: Static Properties
+
+    /// Upper bound on deflate's expansion ratio (258-byte matches coded in about 2 bits)
+    static let maxDeflateExpansion = 1032
+
     // MARK: Static Computed Properties
 
     /// Get the ZLib version string
@@ -219,6 +229,10 @@ public enum ZLib {
             warnings.append("Huffman-only strategy with no compression is redundant")
         }
 
+        if strategy == .quick, level == .noCompression {
+            warnings.append("Quick strategy with no compression is redundant")
+        }
+
         return warnings
     }
 
@@ -329,6 +343,9 @@ public enum ZLib {
     }
 
     /// Compress data with the specified compression level
+    ///
+    /// The input is always deflated at `level`. To store input that looks incompressible
+    /// instead, use `compress(_:options:)` with `skipsIncompressible: true`.
     /// - Parameters:
     ///   - data: The data to compress
     ///   - level: The compression level (default: .defaultCompression)
@@ -342,18 +359,21 @@ public enum ZLib {
             var destLen = swift_compressBound(sourceLen)
 
             logMemoryUsage("Compression output buffer", bytes: Int(destLen))
-            var compressedData = Data(repeating: 0, count: Int(destLen))
-
-            let result = compressedData.withUnsafeMutableBytes { destPtr in
-                data.withUnsafeBytes { sourcePtr in
-                    swift_compress(
-                        destPtr.bindMemory(to: Bytef.self).baseAddress!,
-                        &destLen,
-                        sourcePtr.bindMemory(to: Bytef.self).baseAddress!,
-                        sourceLen,
-                        level.zlibLevel
-                    )
-                }
+            // Uninitialized buffer: zero-filling the whole bound is wasted work for deflate
+            var buffer = malloc(Int(destLen))
+            defer { free(buffer) }
+            guard let destination = buffer else {
+                throw ZLibError.memoryError
+            }
+
+            let result = data.withUnsafeBytes { sourcePtr in
+                swift_compress(
+                    destination.assumingMemoryBound(to: Bytef.self),
+                    &destLen,
+                    sourcePtr.bindMemory(to: Bytef.self).baseAddress,
+                    sourceLen,
+                    level.zlibLevel
+                )
             }
 
             if result != Z_OK {
@@ -361,7 +381,9 @@ public enum ZLib {
                 throw ZLibError.compressionFailed(result)
             }
 
-            compressedData.count = Int(destLen)
+            let shrunk = realloc(destination, Int(destLen)) ?? destination
+            buffer = nil
+            let compressedData = Data(bytesNoCopy: shrunk, count: Int(destLen), deallocator: .free)
             let compressionRatio = Double(compressedData.count) / Double(data.count)
             zlibInfo("Compression completed: \(data.count) -> \(compressedData.count) bytes (ratio: \(String(format: "%.2f", compressionRatio)))")
 
@@ -370,76 +392,22 @@ public enum ZLib {
     }
 
     /// Decompress data
-    /// - Parameter data: The compressed data to decompress
+    /// - Parameters:
+    ///   - data: The compressed data to decompress
+    ///   - expectedSize: Expected decompressed size (optional); used to allocate the output once
     /// - Returns: Decompressed data
     /// - Throws: ZLibError if decompression fails
-    public static func decompress(_ data: Data) throws -> Data {
+    public static func decompress(_ data: Data, expectedSize: Int? = nil) throws -> Data {
         zlibInfo("Starting decompression: \(data.count) bytes")
 
-        // For very large data (>1MB), use streaming to avoid memory issues
-        if data.count > 1_000_000 {
-            zlibDebug("Large data detected, using streaming decompression")
-            let decompressor = Decompressor()
-            try decompressor.initialize()
-            return try decompressor.decompress(data)
-        }
-
         return try withTiming("Decompression") {
-            // For decompression, we need to estimate the output size
-            // Start with a reasonable guess and grow if needed
-            var destLen = uLong(data.count * 4) // Initial guess
-            logMemoryUsage("Decompression output buffer", bytes: Int(destLen))
-            var decompressedData = Data(repeating: 0, count: Int(destLen))
-
-            let result = decompressedData.withUnsafeMutableBytes { destPtr in
-                data.withUnsafeBytes { sourcePtr in
-                    swift_uncompress(
-                        destPtr.bindMemory(to: Bytef.self).baseAddress!,
-                        &destLen,
-                        sourcePtr.bindMemory(to: Bytef.self).baseAddress!,
-                        uLong(data.count)
-                    )
-                }
+            // Inflate once into a buffer that doubles in place, instead of restarting
+            // uncompress with ever larger guesses
+            let capacity = outputSizeHint(for: data, format: .zlib, expectedSize: expectedSize) ?? data.count * 4
+            let decompressedData = try data.withUnsafeBytes { sourcePtr in
+                try inflateGrowing(sourcePtr, windowBits: .deflate, initialCapacity: capacity)
             }
 
-            if result == Z_BUF_ERROR {
-                // Buffer too small, try with progressively larger buffers
-                zlibDebug("Buffer too small, retrying with larger buffer")
-                var bufferMultiplier = 8
-                var retryResult = result
-
-                // For very large data, use more reasonable limits
-                let maxMultiplier = data.count > 1_000_000 ? 64 : 512
-
-                while retryResult == Z_BUF_ERROR, bufferMultiplier <= maxMultiplier {
-                    destLen = uLong(data.count * bufferMultiplier)
-                    logMemoryUsage("Decompression retry buffer (multiplier: \(bufferMultiplier))", bytes: Int(destLen))
-                    decompressedData = Data(repeating: 0, count: Int(destLen))
-
-                    retryResult = decompressedData.withUnsafeMutableBytes { destPtr in
-                        data.withUnsafeBytes { sourcePtr in
-                            swift_uncompress(
-                                destPtr.bindMemory(to: Bytef.self).baseAddress!,
-                                &destLen,
-                                sourcePtr.bindMemory(to: Bytef.self).baseAddress!,
-                                uLong(data.count)
-                            )
-                        }
-                    }
-
-                    bufferMultiplier *= 2
-                }
-
-                if retryResult != Z_OK {
-                    zlibError("Decompression retry failed with code: \(retryResult) - \(String(cString: swift_zError(retryResult)))")
-                    throw ZLibError.decompressionFailed(retryResult)
-                }
-            } else if result != Z_OK {
-                zlibError("Decompression failed with code: \(result) - \(String(cString: swift_zError(result)))")
-                throw ZLibError.decompressionFailed(result)
-            }
-
-            decompressedData.count = Int(destLen)
             let expansionRatio = Double(decompressedData.count) / Double(data.count)
             zlibInfo("Decompression completed: \(data.count) -> \(decompressedData.count) bytes (ratio: \(String(format: "%.2f", expansionRatio)))")
 
@@ -447,6 +415,20 @@ public enum ZLib {
         }
     }
 
+    /// Lazily decompressed view of a blob, inflated only as far as it is read
+    ///
+    /// Unlike `partialDecompress`, later reads continue where earlier ones stopped, and reads
+    /// behind that point resume from saved checkpoints (see `LazyInflatedData`).
+    /// - Parameters:
+    ///   - data: The compressed blob
+    ///   - windowBits: Stream format (default: zlib)
+    ///   - index: Index built with `GzipIndex.build(for:)` from the same blob, for far reads
+    /// - Returns: The view; nothing is inflated until it is read
+    /// - Throws: ZLibError if the stream cannot be initialized or the index does not fit
+    public static func lazyDecompress(_ data: Data, windowBits: WindowBits = .deflate, index: GzipIndex? = nil) throws -> LazyInflatedData {
+        try LazyInflatedData(data, windowBits: windowBits, index: index)
+    }
+
     /// Partially decompress data, returning how much input/output was consumed
     /// - Parameters:
     ///   - data: The compressed data to decompress
@@ -518,8 +500,9 @@ public enum ZLib {
     public static func adler32(_ data: Data, initialValue: uLong = 1) -> uLong {
         zlibDebug("Calculating Adler-32 for \(data.count) bytes with initial value: \(initialValue)")
 
+        // size_t length: buffers over 4 GB are hashed whole rather than truncated to uInt
         let result = data.withUnsafeBytes { buffer in
-            swift_adler32(initialValue, buffer.bindMemory(to: Bytef.self).baseAddress!, uInt(data.count))
+            swift_adler32_z(initialValue, buffer.bindMemory(to: Bytef.self).baseAddress, buffer.count)
         }
 
         zlibDebug("Adler-32 result: \(result)")
@@ -534,8 +517,9 @@ public enum ZLib {
     public static func crc32(_ data: Data, initialValue: uLong = 0) -> uLong {
         zlibDebug("Calculating CRC-32 for \(data.count) bytes with initial value: \(initialValue)")
 
+        // size_t length: buffers over 4 GB are hashed whole rather than truncated to uInt
         let result = data.withUnsafeBytes { buffer in
-            swift_crc32(initialValue, buffer.bindMemory(to: Bytef.self).baseAddress!, uInt(data.count))
+            swift_crc32_z(initialValue, buffer.bindMemory(to: Bytef.self).baseAddress, buffer.count)
         }
 
         zlibDebug("CRC-32 result: \(result)")
@@ -571,7 +555,7 @@ public enum ZLib {
     ///   - len2: Length of the second data block
     /// - Returns: Combined Adler-32 checksum
     public static func adler32Combine(_ adler1: uLong, _ adler2: uLong, len2: Int) -> uLong {
-        swift_adler32_combine(adler1, adler2, CLong(len2))
+        swift_adler32_combine64(adler1, adler2, Int64(len2))
     }
 
     /// Combine two CRC-32 checksums
@@ -581,7 +565,7 @@ public enum ZLib {
     ///   - len2: Length of the second data block
     /// - Returns: Combined CRC-32 checksum
     public static func crc32Combine(_ crc1: uLong, _ crc2: uLong, len2: Int) -> uLong {
-        swift_crc32_combine(crc1, crc2, CLong(len2))
+        swift_crc32_combine64(crc1, crc2, Int64(len2))
     }
 
     /// Compress data with advanced options
@@ -596,6 +580,7 @@ public enum ZLib {
         return try withTiming("Compression with options") {
             // Use Compressor for advanced options
             let compressor = Compressor()
+            compressor.skipsIncompressible = options.skipsIncompressible
             try compressor.initializeAdvanced(
                 level: options.level,
                 method: .deflate,
@@ -603,6 +588,9 @@ public enum ZLib {
                 memoryLevel: options.memoryLevel,
                 strategy: options.strategy
             )
+            if let tuning = options.tuning {
+                try compressor.tune(tuning)
+            }
 
             // Set dictionary if provided
             if let dictionary = options.dictionary {
@@ -634,10 +622,13 @@ public enum ZLib {
         zlibInfo("Starting decompression with options: format=\(options.format)")
 
         return try withTiming("Decompression with options") {
+            let sizeHint = outputSizeHint(for: data, format: options.format, expectedSize: options.expectedSize)
+
             // For very large data (>1MB), use streaming to avoid memory issues
             if data.count > 1_000_000 {
                 zlibDebug("Large data detected, using streaming decompression")
                 let decompressor = Decompressor()
+                decompressor.applyLimits(of: options)
                 try decompressor.initializeAdvanced(windowBits: options.format.windowBits)
 
                 // Set dictionary if provided
@@ -645,11 +636,12 @@ public enum ZLib {
                     try decompressor.setDictionary(dictionary)
                 }
 
-                return try decompressor.decompress(data)
+                return try decompressor.decompress(data, expectedSize: sizeHint)
             }
 
             // Use simple decompression for smaller data
             let decompressor = Decompressor()
+            decompressor.applyLimits(of: options)
             try decompressor.initializeAdvanced(windowBits: options.format.windowBits)
 
             // Set dictionary if provided
@@ -657,7 +649,7 @@ public enum ZLib {
                 try decompressor.setDictionary(dictionary)
             }
 
-            let decompressed = try decompressor.decompress(data)
+            let decompressed = try decompressor.decompress(data, expectedSize: sizeHint)
 
             let expansionRatio = Double(decompressed.count) / Double(data.count)
             zlibInfo("Decompression completed: \(data.count) -> \(decompressed.count) bytes (ratio: \(String(format: "%.2f", expansionRatio)))")
@@ -693,10 +685,47 @@ public enum ZLib {
     /// - Parameters:
     ///   - data: The compressed data to decompress
     ///   - dictionary: Optional dictionary for decompression
+    ///   - expectedSize: Expected decompressed size (optional); gzip input falls back to its ISIZE trailer
     /// - Returns: Decompressed data
     /// - Throws: ZLibError if decompression fails
-    public static func decompressAuto(_ data: Data, dictionary: Data? = nil) throws -> Data {
-        let options = DecompressionOptions(format: .auto, dictionary: dictionary)
+    public static func decompressAuto(_ data: Data, dictionary: Data? = nil, expectedSize: Int? = nil) throws -> Data {
+        let options = DecompressionOptions(format: .auto, dictionary: dictionary, expectedSize: expectedSize)
         return try decompress(data, options: options)
     }
+
+    // MARK: - Size Hints
+
+    /// Read the ISIZE field from the trailer of a gzip stream
+    ///
+    /// ISIZE is the uncompressed length of the last gzip member modulo 2^32, so it is exact
+    /// for single-member files under 4 GB and only a hint otherwise.
+    /// - Parameter data: Gzip-compressed data
+    /// - Returns: The ISIZE value, or nil if `data` does not look like a gzip stream
+    public static func gzipUncompressedSize(_ data: Data) -> Int? {
+        // 10-byte header + 8-byte trailer at minimum
+        guard data.count >= 18,
+              data[data.startIndex] == 0x1F,
+              data[data.startIndex + 1] == 0x8B
+        else {
+            return nil
+        }
+        let trailer = data.suffix(4)
+        return trailer.reversed().reduce(0) { ($0 << 8) | Int($1) }
+    }
+
+    /// Pick an initial output allocation for decompressing `data`
+    ///
+    /// An explicit `expectedSize` wins; gzip input (or `.auto` input with a gzip magic) uses
+    /// ISIZE. Values read from the stream are capped at deflate's maximum expansion ratio so
+    /// a forged trailer cannot trigger an oversized allocation.
+    static func outputSizeHint(for data: Data, format: CompressionFormat, expectedSize: Int?) -> Int? {
+        if let expectedSize, expectedSize > 0 {
+            return expectedSize
+        }
+        guard format == .gzip || format == .auto, let isize = gzipUncompressedSize(data) else {
+            return nil
+        }
+        let (limit, overflow) = data.count.multipliedReportingOverflow(by: maxDeflateExpansion)
+        return overflow ? isize : min(isize, limit)
+    }
 }
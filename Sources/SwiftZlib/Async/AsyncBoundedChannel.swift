@@ -0,0 +1,179 @@
+//
+//  AsyncBoundedChannel.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import Foundation
+
+/// Single-producer, single-consumer async channel with a fixed capacity
+///
+/// `send` suspends while `capacity` elements are waiting, so a slow consumer throttles the
+/// producer instead of letting chunks pile up in memory. Cancelling the channel wakes both
+/// sides with `CancellationError`.
+@available(macOS 10.15, iOS 13.0, tvOS 13.0, watchOS 6.0, *)
+final class AsyncBoundedChannel<Element>: @unchecked Sendable {
+    // MARK: Nested Types
+
+    private struct Dequeued {
+        let result: Result<Element?, Error>
+        let sender: CheckedContinuation<Void, Error>?
+    }
+
+    // MARK: Properties
+
+    let capacity: Int
+
+    private let lock = NSLock()
+    private var buffer: [Element] = []
+    private var isFinished = false
+    private var isCancelled = false
+    private var failure: Error?
+    private var waitingSender: CheckedContinuation<Void, Error>?
+    private var waitingReceiver: CheckedContinuation<Element?, Error>?
+
+    // MARK: Lifecycle
+
+    init(capacity: Int) {
+        self.capacity = max(capacity, 1)
+        buffer.reserveCapacity(self.capacity)
+    }
+
+    // MARK: Functions
+
+    /// Enqueue an element, suspending while the channel is full
+    /// - Parameter element: Element to deliver
+    /// - Throws: CancellationError if the channel was cancelled
+    func send(_ element: Element) async throws {
+        guard try enqueue(element) else { return }
+        try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
+            waitForRoom(continuation)
+        }
+    }
+
+    /// Dequeue the next element, suspending while the channel is empty
+    /// - Returns: The next element, or nil once the producer finished and the buffer is drained
+    /// - Throws: The producer's error after all buffered elements, or CancellationError
+    func receive() async throws -> Element? {
+        if let next = dequeue() {
+            next.sender?.resume()
+            return try next.result.get()
+        }
+        return try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Element?, Error>) in
+            waitForElement(continuation)
+        }
+    }
+
+    /// Mark the end of the stream; buffered elements are still delivered
+    /// - Parameter error: Error to deliver to the consumer after the buffered elements
+    func finish(throwing error: Error? = nil) {
+        lock.lock()
+        guard !isFinished, !isCancelled else {
+            lock.unlock()
+            return
+        }
+        isFinished = true
+        // A waiting receiver implies an empty buffer, so it gets the end of the stream right away
+        let receiver = waitingReceiver
+        waitingReceiver = nil
+        failure = receiver == nil ? error : nil
+        lock.unlock()
+
+        if let error {
+            receiver?.resume(throwing: error)
+        } else {
+            receiver?.resume(returning: nil)
+        }
+    }
+
+    /// Drop buffered elements and wake both sides with `CancellationError`
+    func cancel() {
+        lock.lock()
+        guard !isCancelled else {
+            lock.unlock()
+            return
+        }
+        isCancelled = true
+        buffer.removeAll()
+        let sender = waitingSender
+        let receiver = waitingReceiver
+        waitingSender = nil
+        waitingReceiver = nil
+        lock.unlock()
+
+        sender?.resume(throwing: CancellationError())
+        receiver?.resume(throwing: CancellationError())
+    }
+
+    // MARK: Private Functions
+
+    /// - Returns: Whether the sender has to wait for the consumer before sending more
+    private func enqueue(_ element: Element) throws -> Bool {
+        lock.lock()
+        guard !isCancelled, !isFinished else {
+            lock.unlock()
+            throw CancellationError()
+        }
+        if let receiver = waitingReceiver {
+            waitingReceiver = nil
+            lock.unlock()
+            receiver.resume(returning: element)
+            return false
+        }
+        buffer.append(element)
+        let isFull = buffer.count >= capacity
+        lock.unlock()
+        return isFull
+    }
+
+    private func waitForRoom(_ continuation: CheckedContinuation<Void, Error>) {
+        lock.lock()
+        if isCancelled {
+            lock.unlock()
+            continuation.resume(throwing: CancellationError())
+        } else if buffer.count < capacity {
+            lock.unlock()
+            continuation.resume()
+        } else {
+            waitingSender = continuation
+            lock.unlock()
+        }
+    }
+
+    private func dequeue() -> Dequeued? {
+        lock.lock()
+        defer { lock.unlock() }
+        return dequeueLocked()
+    }
+
+    private func waitForElement(_ continuation: CheckedContinuation<Element?, Error>) {
+        lock.lock()
+        if let next = dequeueLocked() {
+            lock.unlock()
+            next.sender?.resume()
+            continuation.resume(with: next.result)
+        } else {
+            waitingReceiver = continuation
+            lock.unlock()
+        }
+    }
+
+    private func dequeueLocked() -> Dequeued? {
+        if isCancelled {
+            return Dequeued(result: .failure(CancellationError()), sender: nil)
+        }
+        if !buffer.isEmpty {
+            let element = buffer.removeFirst()
+            let sender = waitingSender
+            waitingSender = nil
+            return Dequeued(result: .success(element), sender: sender)
+        }
+        guard isFinished else { return nil }
+        if let error = failure {
+            failure = nil
+            return Dequeued(result: .failure(error), sender: nil)
+        }
+        return Dequeued(result: .success(nil), sender: nil)
+    }
+}
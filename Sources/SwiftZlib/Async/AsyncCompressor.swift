@@ -48,6 +48,9 @@ public final class AsyncCompressor: @unchecked Sendable {
                         memoryLevel: options.memoryLevel,
                         strategy: options.strategy
                     )
+                    if let tuning = options.tuning {
+                        try self.compressor.tune(tuning)
+                    }
                     continuation.resume()
                 } catch {
                     continuation.resume(throwing: error)
@@ -122,4 +125,14 @@ public final class AsyncCompressor: @unchecked Sendable {
             }
         }
     }
+
+    /// Get the underlying stream's performance counters asynchronously
+    /// - Returns: Metrics accumulated so far
+    public func getMetrics() async -> StreamMetrics {
+        await withCheckedContinuation { continuation in
+            queue.async {
+                continuation.resume(returning: self.compressor.metrics)
+            }
+        }
+    }
 }
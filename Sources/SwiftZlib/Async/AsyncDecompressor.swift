@@ -41,6 +41,7 @@ public final class AsyncDecompressor: @unchecked Sendable {
             let options = self.options
             queue.async {
                 do {
+                    self.decompressor.applyLimits(of: options)
                     try self.decompressor.initializeAdvanced(windowBits: options.format.windowBits)
                     continuation.resume()
                 } catch {
@@ -97,4 +98,14 @@ public final class AsyncDecompressor: @unchecked Sendable {
             }
         }
     }
+
+    /// Get the underlying stream's performance counters asynchronously
+    /// - Returns: Metrics accumulated so far
+    public func getMetrics() async -> StreamMetrics {
+        await withCheckedContinuation { continuation in
+            queue.async {
+                continuation.resume(returning: self.decompressor.metrics)
+            }
+        }
+    }
 }
@@ -0,0 +1,455 @@
+//
+//  AsyncZLibSequence.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+// MARK: - AsyncZLibSequence
+
+/// Compresses or decompresses an async sequence of `Data` chunks
+///
+/// Iterating starts a pipeline of three concurrent stages joined by bounded channels: one
+/// task reads the base sequence, a second runs zlib, and the consumer pulls output at its
+/// own pace. When the consumer falls behind, the channels fill up and the upstream stages
+/// suspend, so at most `maxBufferedChunks` chunks wait between two stages no matter how fast
+/// the source is. Cancelling the consuming task or dropping the iterator cancels the whole
+/// pipeline, including the read of the base sequence.
+@available(macOS 10.15, iOS 13.0, tvOS 13.0, watchOS 6.0, *)
+public struct AsyncZLibSequence<Base: AsyncSequence>: AsyncSequence where Base.Element == Data {
+    public typealias Element = Data
+
+    // MARK: Nested Types
+
+    public struct AsyncIterator: AsyncIteratorProtocol {
+        // MARK: Properties
+
+        private let pipeline: Pipeline
+
+        // MARK: Lifecycle
+
+        fileprivate init(pipeline: Pipeline) {
+            self.pipeline = pipeline
+        }
+
+        // MARK: Functions
+
+        public mutating func next() async throws -> Data? {
+            let pipeline = pipeline
+            return try await withTaskCancellationHandler {
+                try await pipeline.output.receive()
+            } onCancel: {
+                pipeline.cancel()
+            }
+        }
+    }
+
+    /// Reader and codec tasks of one iteration; cancelled when the iterator goes away
+    fileprivate final class Pipeline: @unchecked Sendable {
+        // MARK: Properties
+
+        let output: AsyncBoundedChannel<Data>
+
+        private let input: AsyncBoundedChannel<Data>
+        private let reader: Task<Void, Never>
+        private let worker: Task<Void, Never>
+
+        // MARK: Lifecycle
+
+        init(base: Base, mode: ZLibStream.StreamMode, options: ZLibStream.StreamOptions, maxBufferedChunks: Int) {
+            let input = AsyncBoundedChannel<Data>(capacity: maxBufferedChunks)
+            let output = AsyncBoundedChannel<Data>(capacity: maxBufferedChunks)
+            self.input = input
+            self.output = output
+
+            // The tasks must not capture the pipeline, otherwise it could never be released
+            reader = Task.detached {
+                do {
+                    for try await chunk in base where !chunk.isEmpty {
+                        try await input.send(chunk)
+                    }
+                    input.finish()
+                } catch {
+                    input.finish(throwing: error)
+                }
+            }
+            worker = Task.detached {
+                do {
+                    let codec = try AsyncZLibSequenceCodec(mode: mode, options: options)
+                    while let chunk = try await input.receive() {
+                        codec.feed(chunk)
+                        while let block = try codec.nextOutput(finishing: false) {
+                            try await output.send(block)
+                        }
+                    }
+                    while let block = try codec.nextOutput(finishing: true) {
+                        try await output.send(block)
+                    }
+                    output.finish()
+                } catch {
+                    // Stop reading once the codec fails or the consumer is gone
+                    input.cancel()
+                    output.finish(throwing: error)
+                }
+            }
+        }
+
+        deinit {
+            cancel()
+        }
+
+        // MARK: Functions
+
+        func cancel() {
+            reader.cancel()
+            worker.cancel()
+            input.cancel()
+            output.cancel()
+        }
+    }
+
+    // MARK: Properties
+
+    private let base: Base
+    private let mode: ZLibStream.StreamMode
+    private let options: ZLibStream.StreamOptions
+    private let maxBufferedChunks: Int
+
+    // MARK: Lifecycle
+
+    /// Create a pipeline over a sequence of chunks
+    /// - Parameters:
+    ///   - base: Source of input chunks
+    ///   - mode: Compress or decompress
+    ///   - options: Codec options; `bufferSize` is the size of the output chunks
+    ///   - maxBufferedChunks: Chunks each stage may run ahead of the next one
+    public init(base: Base, mode: ZLibStream.StreamMode, options: ZLibStream.StreamOptions = ZLibStream.StreamOptions(), maxBufferedChunks: Int = 4) {
+        self.base = base
+        self.mode = mode
+        self.options = options
+        self.maxBufferedChunks = max(maxBufferedChunks, 1)
+    }
+
+    // MARK: Functions
+
+    public func makeAsyncIterator() -> AsyncIterator {
+        AsyncIterator(pipeline: Pipeline(base: base, mode: mode, options: options, maxBufferedChunks: maxBufferedChunks))
+    }
+}
+
+@available(macOS 10.15, iOS 13.0, tvOS 13.0, watchOS 6.0, *)
+extension AsyncZLibSequence: Sendable where Base: Sendable {}
+
+// MARK: - AsyncDataChunkSequence
+
+/// Groups an async byte sequence, such as `URLSession.AsyncBytes`, into `Data` chunks
+@available(macOS 10.15, iOS 13.0, tvOS 13.0, watchOS 6.0, *)
+public struct AsyncDataChunkSequence<Base: AsyncSequence>: AsyncSequence where Base.Element == UInt8 {
+    public typealias Element = Data
+
+    // MARK: Nested Types
+
+    public struct AsyncIterator: AsyncIteratorProtocol {
+        // MARK: Properties
+
+        private var base: Base.AsyncIterator
+        private let chunkSize: Int
+
+        // MARK: Lifecycle
+
+        fileprivate init(base: Base.AsyncIterator, chunkSize: Int) {
+            self.base = base
+            self.chunkSize = chunkSize
+        }
+
+        // MARK: Functions
+
+        public mutating func next() async throws -> Data? {
+            var bytes: [UInt8] = []
+            bytes.reserveCapacity(chunkSize)
+            while bytes.count < chunkSize, let byte = try await base.next() {
+                bytes.append(byte)
+            }
+            return bytes.isEmpty ? nil : Data(bytes)
+        }
+    }
+
+    // MARK: Properties
+
+    private let base: Base
+    private let chunkSize: Int
+
+    // MARK: Lifecycle
+
+    /// - Parameters:
+    ///   - base: Byte sequence
+    ///   - chunkSize: Maximum size of each produced chunk
+    public init(base: Base, chunkSize: Int) {
+        self.base = base
+        self.chunkSize = max(chunkSize, 1)
+    }
+
+    // MARK: Functions
+
+    public func makeAsyncIterator() -> AsyncIterator {
+        AsyncIterator(base: base.makeAsyncIterator(), chunkSize: chunkSize)
+    }
+}
+
+@available(macOS 10.15, iOS 13.0, tvOS 13.0, watchOS 6.0, *)
+extension AsyncDataChunkSequence: Sendable where Base: Sendable {}
+
+// MARK: - AsyncZLibSequenceCodec
+
+/// z_stream driver behind `AsyncZLibSequence`, producing output one buffer at a time
+///
+/// Input stays in the caller's `Data` and is re-pointed on every call, so nothing is copied
+/// on the way in; output is written into one buffer that lives as long as the stream.
+/// Compressed output is emitted in full `bufferSize` chunks, decompressed output as soon as
+/// the current input is used up so that consumers can parse it early.
+final class AsyncZLibSequenceCodec {
+    // MARK: Properties
+
+    private var stream = z_stream()
+    private let mode: ZLibStream.StreamMode
+    private let dictionary: Data?
+    /// Gzip and auto-detected input may hold several concatenated members (RFC 1952)
+    private let allowsConcatenatedMembers: Bool
+    private let buffer: UnsafeMutableRawBufferPointer
+    private var filled = 0
+    private var input = Data()
+    private var inputOffset = 0
+    private var isStreamEnd = false
+    private var isInitialized = false
+    private var gzipHeaderStorage: GzipHeaderStorage?
+    /// Output limits of the decompression options, checked against all members together
+    private var limits = DecompressionOptions()
+    private var inputSeen = 0
+    private var produced = 0
+
+    // MARK: Computed Properties
+
+    private var hasInput: Bool { inputOffset < input.count }
+
+    // MARK: Lifecycle
+
+    init(mode: ZLibStream.StreamMode, options: ZLibStream.StreamOptions) throws {
+        self.mode = mode
+        switch mode {
+            case .compress:
+                dictionary = options.compression.dictionary
+                allowsConcatenatedMembers = false
+            case .decompress:
+                dictionary = options.decompression.dictionary
+                allowsConcatenatedMembers = options.decompression.format == .gzip || options.decompression.format == .auto
+                limits = options.decompression
+        }
+        buffer = .allocate(byteCount: max(options.bufferSize, 64), alignment: MemoryLayout<UInt64>.alignment)
+
+        switch mode {
+            case .compress:
+                let compression = options.compression
+                let result = swift_deflateInit2(
+                    &stream,
+                    compression.tuning.map { Int32($0.level) } ?? compression.level.zlibLevel,
+                    Z_DEFLATED,
+                    compression.format.windowBits.zlibWindowBits,
+                    compression.memoryLevel.zlibMemoryLevel,
+                    compression.strategy.zlibStrategy
+                )
+                guard result == Z_OK else {
+                    throw ZLibError.compressionFailed(result)
+                }
+                isInitialized = true
+
+                if let tuning = compression.tuning {
+                    let tuneResult = tuning.apply(to: &stream)
+                    guard tuneResult == Z_OK else {
+                        throw ZLibError.compressionFailed(tuneResult)
+                    }
+                }
+                if compression.format == .gzip, let header = compression.gzipHeader {
+                    let storage = GzipHeaderStorage(swiftHeader: header)
+                    let headerResult = swift_deflateSetHeader(&stream, &storage.cHeader)
+                    guard headerResult == Z_OK else {
+                        throw ZLibError.compressionFailed(headerResult)
+                    }
+                    gzipHeaderStorage = storage
+                }
+                if let dictionary {
+                    let dictionaryResult = setDictionary(dictionary)
+                    guard dictionaryResult == Z_OK else {
+                        throw ZLibError.compressionFailed(dictionaryResult)
+                    }
+                }
+
+            case .decompress:
+                let decompression = options.decompression
+                let result = swift_inflateInit2(&stream, decompression.format.windowBits.zlibWindowBits)
+                guard result == Z_OK else {
+                    throw ZLibError.decompressionFailed(result)
+                }
+                isInitialized = true
+
+                // Raw deflate has no header to ask for the dictionary, so it is set up front
+                if decompression.format == .raw, let dictionary {
+                    let dictionaryResult = setDictionary(dictionary)
+                    guard dictionaryResult == Z_OK else {
+                        throw ZLibError.decompressionFailed(dictionaryResult)
+                    }
+                }
+        }
+    }
+
+    deinit {
+        if isInitialized {
+            switch mode {
+                case .compress: swift_deflateEnd(&stream)
+                case .decompress: swift_inflateEnd(&stream)
+            }
+        }
+        buffer.deallocate()
+    }
+
+    // MARK: Functions
+
+    /// Hand the codec the next input chunk; the previous one must have been fully consumed
+    func feed(_ data: Data) {
+        input = data
+        inputOffset = 0
+        inputSeen += data.count
+    }
+
+    /// Produce the next block of output
+    /// - Parameter finishing: Whether the input has ended
+    /// - Returns: Next output block, or nil when more input is needed (or, when finishing, the stream is complete)
+    /// - Throws: ZLibError if the data is invalid or truncated
+    func nextOutput(finishing: Bool) throws -> Data? {
+        switch mode {
+            case .compress: try nextDeflateOutput(finishing: finishing)
+            case .decompress: try nextInflateOutput(finishing: finishing)
+        }
+    }
+
+    // MARK: Private Functions
+
+    private func nextDeflateOutput(finishing: Bool) throws -> Data? {
+        while !isStreamEnd {
+            let result = step(flush: finishing ? Z_FINISH : Z_NO_FLUSH)
+            guard result != Z_STREAM_ERROR else {
+                throw ZLibError.streamError(result)
+            }
+            if result == Z_STREAM_END {
+                isStreamEnd = true
+            }
+            if filled == buffer.count {
+                return takeOutput()
+            }
+            if !finishing, !hasInput {
+                return nil
+            }
+        }
+        return filled > 0 ? takeOutput() : nil
+    }
+
+    private func nextInflateOutput(finishing: Bool) throws -> Data? {
+        while true {
+            if isStreamEnd {
+                guard hasInput else {
+                    return filled > 0 ? takeOutput() : nil
+                }
+                guard allowsConcatenatedMembers else {
+                    // Trailing bytes after a complete zlib or raw deflate stream
+                    throw ZLibError.invalidData
+                }
+                let resetResult = swift_inflateReset(&stream)
+                guard resetResult == Z_OK else {
+                    throw ZLibError.decompressionFailed(resetResult)
+                }
+                isStreamEnd = false
+            }
+
+            let result = step(flush: Z_NO_FLUSH)
+            switch result {
+                case Z_OK, Z_BUF_ERROR:
+                    break
+                case Z_STREAM_END:
+                    isStreamEnd = true
+                case Z_NEED_DICT:
+                    guard let dictionary else {
+                        throw ZLibError.decompressionFailed(result)
+                    }
+                    let dictionaryResult = setDictionary(dictionary)
+                    guard dictionaryResult == Z_OK else {
+                        throw ZLibError.decompressionFailed(dictionaryResult)
+                    }
+                    continue
+                default:
+                    throw ZLibError.decompressionFailed(result)
+            }
+            // Checked before any output past the limit is handed out
+            if let limit = limits.outputLimit(forInputSize: inputSeen), produced > limit {
+                throw ZLibError.outputLimitExceeded(limit: limit)
+            }
+
+            if filled == buffer.count {
+                return takeOutput()
+            }
+            if !isStreamEnd, !hasInput {
+                if filled > 0 {
+                    return takeOutput()
+                }
+                guard !finishing else {
+                    // The source ended before the compressed stream did
+                    throw ZLibError.decompressionFailed(Z_DATA_ERROR)
+                }
+                return nil
+            }
+        }
+    }
+
+    /// One deflate/inflate call from the current input position into the free part of the buffer
+    private func step(flush: Int32) -> Int32 {
+        let available = min(input.count - inputOffset, Int(uInt.max))
+        return input.withUnsafeBytes { (bytes: UnsafeRawBufferPointer) -> Int32 in
+            if available > 0, let base = bytes.bindMemory(to: Bytef.self).baseAddress {
+                stream.next_in = UnsafeMutablePointer(mutating: base + inputOffset)
+            } else {
+                stream.next_in = nil
+            }
+            stream.avail_in = uInt(available)
+            stream.next_out = buffer.baseAddress!.assumingMemoryBound(to: Bytef.self) + filled
+            stream.avail_out = uInt(buffer.count - filled)
+
+            let result = mode == .compress ? swift_deflate(&stream, flush) : swift_inflate(&stream, flush)
+
+            inputOffset += available - Int(stream.avail_in)
+            let written = buffer.count - Int(stream.avail_out)
+            produced += written - filled
+            filled = written
+            // The input pointer is only valid inside withUnsafeBytes
+            stream.next_in = nil
+            stream.avail_in = 0
+            return result
+        }
+    }
+
+    private func takeOutput() -> Data {
+        let output = Data(bytes: buffer.baseAddress!, count: filled)
+        filled = 0
+        return output
+    }
+
+    private func setDictionary(_ dictionary: Data) -> Int32 {
+        dictionary.withUnsafeBytes { (bytes: UnsafeRawBufferPointer) -> Int32 in
+            let pointer = bytes.bindMemory(to: Bytef.self).baseAddress
+            switch mode {
+                case .compress: return swift_deflateSetDictionary(&stream, pointer, uInt(bytes.count))
+                case .decompress: return swift_inflateSetDictionary(&stream, pointer, uInt(bytes.count))
+            }
+        }
+    }
+}
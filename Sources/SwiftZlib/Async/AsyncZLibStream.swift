@@ -135,4 +135,27 @@ public final class AsyncZLibStream: @unchecked Sendable {
                 return try await asyncDecompressor.getStreamInfo()
         }
     }
+
+    /// Get the stream's performance counters asynchronously
+    /// - Returns: Metrics of the underlying compressor or decompressor
+    /// - Throws: ZLibError if the stream is not initialized
+    public func getMetrics() async throws -> StreamMetrics {
+        guard isInitialized else {
+            throw ZLibError.streamError(Z_STREAM_ERROR)
+        }
+
+        switch mode {
+            case .compress:
+                guard let asyncCompressor else {
+                    throw ZLibError.streamError(Z_STREAM_ERROR)
+                }
+                return await asyncCompressor.getMetrics()
+
+            case .decompress:
+                guard let asyncDecompressor else {
+                    throw ZLibError.streamError(Z_STREAM_ERROR)
+                }
+                return await asyncDecompressor.getMetrics()
+        }
+    }
 }
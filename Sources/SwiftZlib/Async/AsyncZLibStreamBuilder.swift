@@ -71,4 +71,13 @@ public final class AsyncZLibStreamBuilder: @unchecked Sendable {
     public func build() -> AsyncZLibStream {
         AsyncZLibStream(mode: mode, options: options)
     }
+
+    /// Build a backpressured pipeline over an async sequence of chunks
+    /// - Parameters:
+    ///   - base: Source of input chunks
+    ///   - maxBufferedChunks: Chunks each pipeline stage may run ahead of the next one
+    /// - Returns: Async sequence of processed chunks, each at most `bufferSize` bytes
+    public func pipeline<Base: AsyncSequence>(over base: Base, maxBufferedChunks: Int = 4) -> AsyncZLibSequence<Base> where Base.Element == Data {
+        AsyncZLibSequence(base: base, mode: mode, options: options, maxBufferedChunks: maxBufferedChunks)
+    }
 }
@@ -0,0 +1,466 @@
+//
+//  CompressionExecutor.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import Foundation
+
+/// Fixed pool of worker threads that runs compression jobs from many clients
+///
+/// Every `AsyncCompressor` dispatches onto a global queue of its own, so a burst of clients
+/// becomes a burst of threads all inside deflate at once. An executor caps that at
+/// `threadCount` threads. Each worker has its own job queue; new jobs are spread over the
+/// queues round robin. A worker whose queue is empty takes the newest job from another
+/// worker's queue, so one long job does not hold up the short ones queued behind it.
+///
+/// `compress(_:options:)` and `decompress(_:options:)` run on streams owned by the worker
+/// thread. Each worker keeps an arena-backed `CompressorPool` per configuration and a
+/// `DecompressorPool` per format, so a job costs a `deflateReset`/`inflateReset` instead of
+/// `deflateInit2` plus allocations. Compression with a dictionary or gzip header uses a fresh
+/// stream. `perform(_:)` runs any other codec work, such as a client's own `Compressor`, on
+/// the same threads.
+@available(macOS 10.15, iOS 13.0, tvOS 13.0, watchOS 6.0, *)
+public final class CompressionExecutor: @unchecked Sendable {
+    // MARK: Nested Types
+
+    /// Job counters since the executor was created
+    public struct Statistics: Sendable, Equatable {
+        // MARK: Properties
+
+        public var submitted = 0
+        /// Jobs a worker has started
+        public var executed = 0
+        /// Jobs run by a worker other than the one they were queued on
+        public var stolen = 0
+        /// Jobs dropped because their task was cancelled before a worker started them
+        public var cancelled = 0
+    }
+
+    /// Streams owned by one worker thread; only that thread touches them
+    final class WorkerContext {
+        // MARK: Nested Types
+
+        private struct CompressorKey: Hashable {
+            let windowBits: WindowBits
+            let level: CompressionLevel
+            let strategy: CompressionStrategy
+            let memoryLevel: MemoryLevel
+        }
+
+        // MARK: Properties
+
+        private var compressorPools: [CompressorKey: CompressorPool] = [:]
+        private var decompressorPools: [WindowBits: DecompressorPool] = [:]
+
+        // MARK: Functions
+
+        func compress(_ data: Data, options: CompressionOptions) throws -> Data {
+            guard options.dictionary == nil, options.gzipHeader == nil, options.tuning == nil else {
+                return try ZLib.compress(data, options: options)
+            }
+            let key = CompressorKey(
+                windowBits: options.format.windowBits,
+                level: options.level,
+                strategy: options.strategy,
+                memoryLevel: options.memoryLevel
+            )
+            let pool = compressorPools[key] ?? makeCompressorPool(for: key)
+            return try pool.withCompressor { compressor in
+                compressor.skipsIncompressible = options.skipsIncompressible
+                return try compressor.compress(data, flush: .finish)
+            }
+        }
+
+        func decompress(_ data: Data, options: DecompressionOptions) throws -> Data {
+            let windowBits = options.format.windowBits
+            let pool = decompressorPools[windowBits] ?? makeDecompressorPool(for: windowBits)
+            let sizeHint = ZLib.outputSizeHint(for: data, format: options.format, expectedSize: options.expectedSize)
+            return try pool.withDecompressor { decompressor in
+                decompressor.applyLimits(of: options)
+                if let dictionary = options.dictionary {
+                    try decompressor.setDictionary(dictionary)
+                }
+                return try decompressor.decompress(data, expectedSize: sizeHint)
+            }
+        }
+
+        // MARK: Private Functions
+
+        private func makeCompressorPool(for key: CompressorKey) -> CompressorPool {
+            if compressorPools.count >= CompressionExecutor.maxCachedConfigurations {
+                compressorPools.remove(at: compressorPools.startIndex)
+            }
+            // One stream per configuration: only this thread uses the pool
+            let pool = CompressorPool(
+                level: key.level,
+                windowBits: key.windowBits,
+                memoryLevel: key.memoryLevel,
+                strategy: key.strategy,
+                maxPooled: 1
+            )
+            compressorPools[key] = pool
+            return pool
+        }
+
+        private func makeDecompressorPool(for windowBits: WindowBits) -> DecompressorPool {
+            if decompressorPools.count >= CompressionExecutor.maxCachedConfigurations {
+                decompressorPools.remove(at: decompressorPools.startIndex)
+            }
+            let pool = DecompressorPool(windowBits: windowBits, maxPooled: 1)
+            decompressorPools[windowBits] = pool
+            return pool
+        }
+    }
+
+    /// A submitted closure and its cancellation state
+    private final class Job: @unchecked Sendable {
+        // MARK: Nested Types
+
+        private enum State {
+            case pending
+            case queued
+            case running
+            case cancelled
+        }
+
+        // MARK: Properties
+
+        private let lock = NSLock()
+        private var state = State.pending
+        private var work: ((WorkerContext) -> Void)?
+        private var abandon: (() -> Void)?
+
+        // MARK: Functions
+
+        /// Attach the work before queueing
+        /// - Returns: false if the job was cancelled first; `abandon` has then been called
+        func arm(work: @escaping (WorkerContext) -> Void, abandon: @escaping () -> Void) -> Bool {
+            lock.lock()
+            guard state == .pending else {
+                lock.unlock()
+                abandon()
+                return false
+            }
+            state = .queued
+            self.work = work
+            self.abandon = abandon
+            lock.unlock()
+            return true
+        }
+
+        /// Drop the job unless a worker has already started it
+        func cancel() {
+            lock.lock()
+            let abandon = state == .queued ? self.abandon : nil
+            if state == .pending || state == .queued {
+                state = .cancelled
+                work = nil
+                self.abandon = nil
+            }
+            lock.unlock()
+            abandon?()
+        }
+
+        /// Take the work for running
+        /// - Returns: nil if the job was cancelled while queued
+        func claim() -> ((WorkerContext) -> Void)? {
+            lock.lock()
+            defer { lock.unlock() }
+            guard state == .queued else {
+                return nil
+            }
+            state = .running
+            let claimed = work
+            work = nil
+            abandon = nil
+            return claimed
+        }
+    }
+
+    /// One worker's jobs; the owner takes the oldest, other workers steal the newest
+    private final class WorkQueue {
+        // MARK: Properties
+
+        private let lock = NSLock()
+        private var jobs: [Job] = []
+        private var head = 0
+
+        // MARK: Functions
+
+        func push(_ job: Job) {
+            lock.lock()
+            jobs.append(job)
+            lock.unlock()
+        }
+
+        func popOldest() -> Job? {
+            lock.lock()
+            defer { lock.unlock() }
+            guard head < jobs.count else {
+                return nil
+            }
+            let job = jobs[head]
+            head += 1
+            if head == jobs.count {
+                jobs.removeAll(keepingCapacity: true)
+                head = 0
+            } else if head >= 64, head * 2 >= jobs.count {
+                jobs.removeFirst(head)
+                head = 0
+            }
+            return job
+        }
+
+        func stealNewest() -> Job? {
+            lock.lock()
+            defer { lock.unlock() }
+            guard head < jobs.count else {
+                return nil
+            }
+            let job = jobs.removeLast()
+            if head == jobs.count {
+                jobs.removeAll(keepingCapacity: true)
+                head = 0
+            }
+            return job
+        }
+    }
+
+    /// State shared by the worker threads; kept apart so the threads do not retain the executor
+    private final class Scheduler: @unchecked Sendable {
+        // MARK: Properties
+
+        let queues: [WorkQueue]
+
+        private let condition = NSCondition()
+        /// Jobs queued and not yet taken; may dip below zero between a push and its count
+        private var pending = 0
+        private var nextQueue = 0
+        private var isShutdown = false
+        private var counters = Statistics()
+
+        // MARK: Computed Properties
+
+        var statistics: Statistics {
+            condition.lock()
+            defer { condition.unlock() }
+            return counters
+        }
+
+        // MARK: Lifecycle
+
+        init(workerCount: Int) {
+            queues = (0 ..< workerCount).map { _ in WorkQueue() }
+        }
+
+        // MARK: Functions
+
+        /// Queue a job on the next worker in turn
+        /// - Returns: false once the executor is shut down
+        func submit(_ job: Job) -> Bool {
+            condition.lock()
+            guard !isShutdown else {
+                condition.unlock()
+                return false
+            }
+            let index = nextQueue
+            nextQueue = (nextQueue + 1) % queues.count
+            counters.submitted += 1
+            condition.unlock()
+
+            queues[index].push(job)
+
+            condition.lock()
+            pending += 1
+            condition.signal()
+            condition.unlock()
+            return true
+        }
+
+        func shutdown() {
+            condition.lock()
+            isShutdown = true
+            condition.broadcast()
+            condition.unlock()
+        }
+
+        /// Run jobs until shutdown, then drain the remaining ones and return
+        func runWorker(_ index: Int, context: WorkerContext) {
+            while true {
+                if let taken = take(for: index) {
+                    let work = taken.job.claim()
+                    condition.lock()
+                    pending -= 1
+                    if work == nil {
+                        counters.cancelled += 1
+                    } else {
+                        counters.executed += 1
+                        counters.stolen += taken.isStolen ? 1 : 0
+                    }
+                    condition.unlock()
+
+                    work?(context)
+                    continue
+                }
+
+                condition.lock()
+                while pending <= 0, !isShutdown {
+                    condition.wait()
+                }
+                let isDone = isShutdown && pending <= 0
+                condition.unlock()
+                if isDone {
+                    return
+                }
+            }
+        }
+
+        // MARK: Private Functions
+
+        private func take(for index: Int) -> (job: Job, isStolen: Bool)? {
+            if let job = queues[index].popOldest() {
+                return (job, false)
+            }
+            for offset in 1 ..< queues.count {
+                if let job = queues[(index + offset) % queues.count].stealNewest() {
+                    return (job, true)
+                }
+            }
+            return nil
+        }
+    }
+
+    // MARK: Static Properties
+
+    /// Executor with one worker per active CPU, created on first use
+    public static let shared = CompressionExecutor()
+
+    /// Stream configurations each worker keeps ready, per direction
+    static let maxCachedConfigurations = 8
+
+    // MARK: Properties
+
+    /// Number of worker threads
+    public let threadCount: Int
+
+    private let scheduler: Scheduler
+
+    // MARK: Computed Properties
+
+    /// Job counters so far
+    public var statistics: Statistics {
+        scheduler.statistics
+    }
+
+    // MARK: Lifecycle
+
+    /// Start an executor
+    /// - Parameters:
+    ///   - threadCount: Number of worker threads (default: active CPU count)
+    ///   - qualityOfService: Quality of service of the worker threads (default: .userInitiated)
+    public init(
+        threadCount: Int = ProcessInfo.processInfo.activeProcessorCount,
+        qualityOfService: QualityOfService = .userInitiated
+    ) {
+        self.threadCount = max(threadCount, 1)
+        scheduler = Scheduler(workerCount: self.threadCount)
+
+        for index in 0 ..< self.threadCount {
+            let scheduler = scheduler
+            let thread = Thread {
+                scheduler.runWorker(index, context: WorkerContext())
+            }
+            thread.name = "SwiftZlib.CompressionExecutor.\(index)"
+            thread.qualityOfService = qualityOfService
+            thread.start()
+        }
+        zlibDebug("Compression executor started with \(self.threadCount) worker(s)")
+    }
+
+    /// Start an executor sized by `ZLib.calculateOptimalBufferSizes`
+    ///
+    /// The thread count is the number of streams that fit in `availableMemory`, capped at the
+    /// active CPU count.
+    /// - Parameters:
+    ///   - dataSize: Typical size of one job's input
+    ///   - availableMemory: Memory budget for the workers' streams, in bytes
+    public convenience init(dataSize: Int, availableMemory: Int) {
+        let sizes = ZLib.calculateOptimalBufferSizes(dataSize: dataSize, availableMemory: availableMemory)
+        self.init(threadCount: min(sizes.maxStreams, ProcessInfo.processInfo.activeProcessorCount))
+    }
+
+    deinit {
+        scheduler.shutdown()
+    }
+
+    // MARK: Functions
+
+    /// Compress a complete buffer on a worker's reusable stream
+    /// - Parameters:
+    ///   - data: Data to compress
+    ///   - options: Compression options (default: zlib format, default level)
+    /// - Returns: Compressed data
+    /// - Throws: ZLibError if compression fails, CancellationError if the task was cancelled
+    ///   before a worker started the job or the executor was shut down
+    public func compress(_ data: Data, options: CompressionOptions = CompressionOptions()) async throws -> Data {
+        try await submit { context in
+            try context.compress(data, options: options)
+        }
+    }
+
+    /// Decompress a complete buffer on a worker's reusable stream
+    /// - Parameters:
+    ///   - data: Compressed data
+    ///   - options: Decompression options (default: format detected automatically)
+    /// - Returns: Decompressed data
+    /// - Throws: ZLibError if decompression fails, CancellationError if the task was cancelled
+    ///   before a worker started the job or the executor was shut down
+    public func decompress(_ data: Data, options: DecompressionOptions = DecompressionOptions()) async throws -> Data {
+        try await submit { context in
+            try context.decompress(data, options: options)
+        }
+    }
+
+    /// Run a closure on one of the worker threads
+    ///
+    /// Use this for codec work the convenience methods do not cover, for example feeding a
+    /// `Compressor` owned by the caller. The closure blocks its worker until it returns.
+    /// - Parameter body: Work to run
+    /// - Returns: The closure's result
+    /// - Throws: Any error thrown by `body`, or CancellationError as for `compress(_:options:)`
+    public func perform<T: Sendable>(_ body: @escaping () throws -> T) async throws -> T {
+        try await submit { _ in
+            try body()
+        }
+    }
+
+    /// Stop accepting jobs; queued jobs still run, then the worker threads exit
+    public func shutdown() {
+        scheduler.shutdown()
+    }
+
+    // MARK: Private Functions
+
+    private func submit<T: Sendable>(_ body: @escaping (WorkerContext) throws -> T) async throws -> T {
+        let job = Job()
+        return try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<T, Error>) in
+                let isArmed = job.arm(
+                    work: { context in
+                        continuation.resume(with: Result { try body(context) })
+                    },
+                    abandon: {
+                        continuation.resume(throwing: CancellationError())
+                    }
+                )
+                if isArmed, !scheduler.submit(job) {
+                    job.cancel()
+                }
+            }
+        } onCancel: {
+            job.cancel()
+        }
+    }
+}
@@ -0,0 +1,271 @@
+//
+//  AdaptiveCompressor.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+/// Streaming compressor that retunes its level per block to hold a throughput or ratio target
+///
+/// Input is compressed in blocks of `blockSize` bytes, each ended with a `Z_BLOCK` flush so the
+/// parameters can change at the next block with `deflateParams`. After every block the achieved
+/// MB/s and output ratio, taken from the stream's `StreamMetrics`, move the compressor one step
+/// along a ladder: level 1 with the quick strategy, then levels 1 through 9. Each step's recent
+/// result is remembered, so the controller does not climb back to a step it has just seen miss
+/// the target; results older than `estimateLifetime` blocks are forgotten, so changing load is
+/// picked up again.
+///
+/// With `skipsIncompressible`, blocks whose sampled byte entropy says deflate would not shrink
+/// them are written as stored blocks at level 0, which costs about a copy.
+public final class AdaptiveCompressor {
+    // MARK: Nested Types
+
+    /// What the controller optimizes for
+    public enum Target: Sendable, Equatable {
+        /// Keep input throughput at or above this many MB/s, at the strongest level that does
+        case throughput(Double)
+        /// Keep output size at or below this fraction of the input, at the fastest level that does
+        case ratio(Double)
+    }
+
+    /// Outcome of one compressed block
+    public struct BlockReport: Sendable, Equatable {
+        // MARK: Properties
+
+        /// zlib level the block was compressed at (0 when stored)
+        public let level: Int
+        public let strategy: CompressionStrategy
+        /// Whether the block was passed through as stored data because it looked incompressible
+        public let isStored: Bool
+        public let bytesIn: Int
+        public let bytesOut: Int
+        /// Time spent in deflate for this block
+        public let nanoseconds: UInt64
+
+        // MARK: Computed Properties
+
+        /// Input megabytes per second of deflate time
+        public var throughputMBps: Double {
+            nanoseconds > 0 ? Double(bytesIn) / 1_048_576 / (Double(nanoseconds) / 1_000_000_000) : .infinity
+        }
+
+        /// Output bytes per input byte
+        public var ratio: Double {
+            bytesIn > 0 ? Double(bytesOut) / Double(bytesIn) : 0
+        }
+    }
+
+    /// One rung of the level ladder
+    private struct Step {
+        let level: Int32
+        let strategy: CompressionStrategy
+    }
+
+    /// A step's smoothed result and the block it was last updated at
+    private struct Estimate {
+        let value: Double
+        let block: Int
+    }
+
+    // MARK: Static Properties
+
+    /// Default uncompressed bytes per block (256 KB)
+    public static let defaultBlockSize = 256 * 1024
+
+    /// Smallest block; shorter blocks make the per-block timing too noisy to act on
+    public static let minimumBlockSize = 16 * 1024
+
+    /// Blocks after which a step's remembered result is ignored
+    static let estimateLifetime = 32
+
+    /// Required margin before moving to a step whose result is not known yet
+    static let probeMargin = 1.25
+
+    /// Weight of the newest block in a step's smoothed result
+    static let smoothing = 0.3
+
+    /// Fastest to strongest
+    private static let ladder: [Step] = [Step(level: 1, strategy: .quick)]
+        + (1 ... 9).map { Step(level: Int32($0), strategy: .defaultStrategy) }
+
+    /// Level 6, zlib's default
+    private static let initialStep = 6
+
+    // MARK: Properties
+
+    public let target: Target
+    public let windowBits: WindowBits
+    public let blockSize: Int
+    public let skipsIncompressible: Bool
+
+    /// Called after every block, for example to export the controller's decisions
+    public var blockHandler: ((BlockReport) -> Void)?
+
+    /// Report of the most recent block
+    public private(set) var lastBlock: BlockReport?
+
+    private let compressor = Compressor()
+    private var step = AdaptiveCompressor.initialStep
+    /// Ladder index the stream is currently configured for; nil while storing
+    private var appliedStep: Int?
+    private var estimates = [Estimate?](repeating: nil, count: AdaptiveCompressor.ladder.count)
+    private var blockCount = 0
+    /// Input waiting to fill a block
+    private var pending = Data()
+
+    // MARK: Computed Properties
+
+    /// zlib level the controller will use for the next compressible block
+    public var currentLevel: Int {
+        Int(Self.ladder[step].level)
+    }
+
+    /// Strategy the controller will use for the next compressible block
+    public var currentStrategy: CompressionStrategy {
+        Self.ladder[step].strategy
+    }
+
+    /// Counters of the underlying stream
+    public var metrics: StreamMetrics {
+        compressor.metrics
+    }
+
+    // MARK: Lifecycle
+
+    /// Create an adaptive compressor
+    /// - Parameters:
+    ///   - target: Throughput or ratio to hold
+    ///   - windowBits: Output format (default: zlib)
+    ///   - blockSize: Uncompressed bytes between adjustments (default: 256 KB, at least 16 KB)
+    ///   - skipsIncompressible: Store blocks that look incompressible instead of deflating them
+    /// - Throws: ZLibError if the stream cannot be initialized
+    public init(
+        target: Target,
+        windowBits: WindowBits = .deflate,
+        blockSize: Int = AdaptiveCompressor.defaultBlockSize,
+        skipsIncompressible: Bool = true
+    ) throws {
+        self.target = target
+        self.windowBits = windowBits
+        self.blockSize = max(blockSize, Self.minimumBlockSize)
+        self.skipsIncompressible = skipsIncompressible
+
+        let initial = Self.ladder[Self.initialStep]
+        try compressor.initializeAdvanced(level: .defaultCompression, windowBits: windowBits)
+        try compressor.setParameters(zlibLevel: initial.level, strategy: initial.strategy)
+        appliedStep = Self.initialStep
+    }
+
+    // MARK: Functions
+
+    /// Compress more input; complete blocks are compressed now, the rest waits for more input
+    /// - Parameter data: Input to append
+    /// - Returns: Compressed output produced so far
+    /// - Throws: ZLibError if compression fails, CancellationError if cancelled
+    public func compress(_ data: Data) throws -> Data {
+        pending.append(data)
+        var output = Data()
+        var offset = pending.startIndex
+        while pending.endIndex - offset >= blockSize {
+            output.append(try compressBlock(pending.subdata(in: offset ..< offset + blockSize), flush: .block))
+            offset += blockSize
+        }
+        pending = pending.subdata(in: offset ..< pending.endIndex)
+        return output
+    }
+
+    /// Compress the remaining input and end the stream
+    /// - Returns: Final compressed output, including the trailer
+    /// - Throws: ZLibError if compression fails, CancellationError if cancelled
+    public func finish() throws -> Data {
+        let last = pending
+        pending = Data()
+        return try compressBlock(last, flush: .finish)
+    }
+
+    /// Compress a whole buffer in one call
+    /// - Parameter data: Data to compress
+    /// - Returns: Complete compressed stream
+    /// - Throws: ZLibError if compression fails, CancellationError if cancelled
+    public func compressAll(_ data: Data) throws -> Data {
+        var output = try compress(data)
+        output.append(try finish())
+        return output
+    }
+
+    // MARK: Private Functions
+
+    private func compressBlock(_ block: Data, flush: FlushMode) throws -> Data {
+        let stored = skipsIncompressible && ByteEntropy.isLikelyIncompressible(block)
+        let wanted: Int? = stored ? nil : step
+        if wanted != appliedStep {
+            // The previous block ended with Z_BLOCK, so deflateParams has nothing to flush
+            let next = wanted.map { Self.ladder[$0] } ?? Step(level: 0, strategy: .defaultStrategy)
+            try compressor.setParameters(zlibLevel: next.level, strategy: next.strategy)
+            appliedStep = wanted
+        }
+
+        let before = compressor.metrics
+        let output = try compressor.compress(block, flush: flush)
+        let after = compressor.metrics
+        let applied = wanted.map { Self.ladder[$0] }
+        let report = BlockReport(
+            level: Int(applied?.level ?? 0),
+            strategy: applied?.strategy ?? .defaultStrategy,
+            isStored: stored,
+            bytesIn: after.bytesIn - before.bytesIn,
+            bytesOut: after.bytesOut - before.bytesOut,
+            nanoseconds: after.callNanoseconds - before.callNanoseconds
+        )
+        blockCount += 1
+        if !stored, !block.isEmpty {
+            adapt(to: report)
+        }
+        lastBlock = report
+        blockHandler?(report)
+        return output
+    }
+
+    /// Move one step along the ladder based on the block just compressed
+    private func adapt(to report: BlockReport) {
+        let observed: Double
+        switch target {
+            case .throughput: observed = report.throughputMBps
+            case .ratio: observed = report.ratio
+        }
+        let smoothed = estimate(for: step).map { $0 + (observed - $0) * Self.smoothing } ?? observed
+        estimates[step] = Estimate(value: smoothed, block: blockCount)
+
+        switch target {
+            case let .throughput(goal):
+                if smoothed < goal {
+                    step = max(step - 1, 0)
+                } else if step + 1 < Self.ladder.count {
+                    // Climb only if the stronger step is known to keep up, or there is headroom to try
+                    let stronger = estimate(for: step + 1)
+                    if stronger.map({ $0 >= goal }) ?? (smoothed >= goal * Self.probeMargin) {
+                        step += 1
+                    }
+                }
+            case let .ratio(goal):
+                if smoothed > goal {
+                    step = min(step + 1, Self.ladder.count - 1)
+                } else if step > 0 {
+                    let faster = estimate(for: step - 1)
+                    if faster.map({ $0 <= goal }) ?? (smoothed * Self.probeMargin <= goal) {
+                        step -= 1
+                    }
+                }
+        }
+    }
+
+    private func estimate(for index: Int) -> Double? {
+        guard let estimate = estimates[index], blockCount - estimate.block <= Self.estimateLifetime else {
+            return nil
+        }
+        return estimate.value
+    }
+}
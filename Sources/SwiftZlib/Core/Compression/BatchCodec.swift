@@ -0,0 +1,330 @@
+//
+//  BatchCodec.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+/// Engine behind `ZLib.compressBatch` and `ZLib.decompressBatch`
+///
+/// The records are split into one contiguous range per worker. Each worker initializes a
+/// single z_stream and resets it between records, so a record pays for the codec work only,
+/// not for `deflateInit2`/`deflateEnd` and a zero-filled bound-sized buffer. Workers write
+/// into uninitialized buffers that grow geometrically; the first worker's buffer becomes
+/// the batch storage and the others are appended to it once at the end.
+enum BatchCodec {
+    // MARK: Nested Types
+
+    /// Input records, either separate values or an existing batch
+    enum Input {
+        case items([Data])
+        case batch(DataBatch)
+
+        // MARK: Computed Properties
+
+        var count: Int {
+            switch self {
+                case let .items(items): items.count
+                case let .batch(batch): batch.count
+            }
+        }
+
+        // MARK: Functions
+
+        func withItem<R>(_ index: Int, _ body: (UnsafeRawBufferPointer) throws -> R) rethrows -> R {
+            switch self {
+                case let .items(items): return try items[index].withUnsafeBytes(body)
+                case let .batch(batch): return try batch.withUnsafeBytes(at: index, body)
+            }
+        }
+    }
+
+    /// Records produced by one worker, packed back to back
+    private final class WorkerOutput {
+        // MARK: Properties
+
+        var buffer: UnsafeMutableRawPointer?
+        var capacity = 0
+        var used = 0
+        var lengths: [Int] = []
+
+        // MARK: Computed Properties
+
+        var freeSpace: UnsafeMutablePointer<Bytef> {
+            buffer!.assumingMemoryBound(to: Bytef.self) + used
+        }
+
+        // MARK: Lifecycle
+
+        deinit {
+            free(buffer)
+        }
+
+        // MARK: Functions
+
+        /// Make room for at least `additional` more bytes, leaving them uninitialized
+        func reserve(_ additional: Int) throws {
+            guard used + additional > capacity else { return }
+            let newCapacity = max(capacity * 2, used + additional, 4096)
+            guard let grown = realloc(buffer, newCapacity) else {
+                throw ZLibError.memoryError
+            }
+            buffer = grown
+            capacity = newCapacity
+        }
+    }
+
+    // MARK: Static Properties
+
+    /// Records per worker below which another thread costs more than it saves
+    static let minimumItemsPerWorker = 64
+
+    // MARK: Static Functions
+
+    static func compress(_ input: Input, level: CompressionLevel, options: CompressionOptions, maxConcurrency: Int?) throws -> DataBatch {
+        try run(input, maxConcurrency: maxConcurrency) { range, output in
+            try compressRange(range, of: input, level: level, options: options, into: output)
+        }
+    }
+
+    static func decompress(_ input: Input, options: DecompressionOptions, maxConcurrency: Int?) throws -> DataBatch {
+        try run(input, maxConcurrency: maxConcurrency) { range, output in
+            try decompressRange(range, of: input, options: options, into: output)
+        }
+    }
+
+    static func workerCount(items: Int, maxConcurrency: Int?) -> Int {
+        let limit = maxConcurrency ?? ProcessInfo.processInfo.activeProcessorCount
+        return max(1, min(limit, items / minimumItemsPerWorker))
+    }
+
+    // MARK: Private Static Functions
+
+    private static func run(
+        _ input: Input,
+        maxConcurrency: Int?,
+        worker: (Range<Int>, WorkerOutput) throws -> Void
+    ) throws -> DataBatch {
+        let count = input.count
+        guard count > 0 else { return DataBatch() }
+
+        let workers = workerCount(items: count, maxConcurrency: maxConcurrency)
+        let perWorker = (count + workers - 1) / workers
+        let outputs = (0 ..< workers).map { _ in WorkerOutput() }
+        zlibDebug("Batch of \(count) records on \(workers) worker(s)")
+
+        var failures = [Error?](repeating: nil, count: workers)
+        failures.withUnsafeMutableBufferPointer { buffer in
+            let slots = buffer
+            DispatchQueue.concurrentPerform(iterations: workers) { index in
+                let range = min(index * perWorker, count) ..< min((index + 1) * perWorker, count)
+                do {
+                    try worker(range, outputs[index])
+                } catch {
+                    slots[index] = error
+                }
+            }
+        }
+        if let failure = failures.lazy.compactMap({ $0 }).first {
+            throw failure
+        }
+        return try pack(outputs, count: count)
+    }
+
+    private static func pack(_ outputs: [WorkerOutput], count: Int) throws -> DataBatch {
+        var offsets = [0]
+        offsets.reserveCapacity(count + 1)
+        for output in outputs {
+            for length in output.lengths {
+                offsets.append(offsets[offsets.count - 1] + length)
+            }
+        }
+        let total = offsets[offsets.count - 1]
+        guard total > 0 else {
+            return DataBatch(storage: Data(), offsets: offsets)
+        }
+
+        // Grow the first worker's buffer into the arena and append the others behind it
+        let first = outputs[0]
+        guard let arena = realloc(first.buffer, total) else {
+            throw ZLibError.memoryError
+        }
+        first.buffer = nil
+        var position = first.used
+        for output in outputs.dropFirst() where output.used > 0 {
+            memcpy(arena + position, output.buffer!, output.used)
+            position += output.used
+        }
+        return DataBatch(storage: Data(bytesNoCopy: arena, count: total, deallocator: .free), offsets: offsets)
+    }
+
+    private static func compressRange(
+        _ range: Range<Int>,
+        of input: Input,
+        level: CompressionLevel,
+        options: CompressionOptions,
+        into output: WorkerOutput
+    ) throws {
+        // Heap-allocated so the address zlib records in its state never changes
+        let stream = UnsafeMutablePointer<z_stream>.allocate(capacity: 1)
+        stream.initialize(to: z_stream())
+        defer {
+            stream.deinitialize(count: 1)
+            stream.deallocate()
+        }
+
+        let result = swift_deflateInit2(
+            stream,
+            options.tuning.map { Int32($0.level) } ?? level.zlibLevel,
+            Z_DEFLATED,
+            options.format.windowBits.zlibWindowBits,
+            options.memoryLevel.zlibMemoryLevel,
+            options.strategy.zlibStrategy
+        )
+        guard result == Z_OK else {
+            throw ZLibError.compressionFailed(result)
+        }
+        defer { swift_deflateEnd(stream) }
+        output.lengths.reserveCapacity(range.count)
+
+        for index in range {
+            if index != range.lowerBound {
+                let resetResult = swift_deflateReset(stream)
+                guard resetResult == Z_OK else {
+                    throw ZLibError.compressionFailed(resetResult)
+                }
+            }
+            // Set after every reset, which reloads the level's table values
+            if let tuning = options.tuning {
+                let tuneResult = tuning.apply(to: stream)
+                guard tuneResult == Z_OK else {
+                    throw ZLibError.compressionFailed(tuneResult)
+                }
+            }
+            if let dictionary = options.dictionary {
+                let dictionaryResult = dictionary.withUnsafeBytes { bytes in
+                    swift_deflateSetDictionary(stream, bytes.bindMemory(to: Bytef.self).baseAddress, uInt(bytes.count))
+                }
+                guard dictionaryResult == Z_OK else {
+                    throw ZLibError.compressionFailed(dictionaryResult)
+                }
+            }
+
+            try input.withItem(index) { bytes in
+                guard bytes.count <= Int(uInt.max) else {
+                    throw ZLibError.bufferError
+                }
+                // deflateBound guarantees a single Z_FINISH call completes the stream
+                let bound = min(Int(swift_deflateBound(stream, uLong(bytes.count))), Int(uInt.max))
+                try output.reserve(bound)
+
+                stream.pointee.next_in = bytes.baseAddress.map { UnsafeMutablePointer(mutating: $0.assumingMemoryBound(to: Bytef.self)) }
+                stream.pointee.avail_in = uInt(bytes.count)
+                stream.pointee.next_out = output.freeSpace
+                stream.pointee.avail_out = uInt(bound)
+
+                let status = swift_deflate(stream, Z_FINISH)
+                guard status == Z_STREAM_END else {
+                    throw ZLibError.compressionFailed(status)
+                }
+                let produced = bound - Int(stream.pointee.avail_out)
+                output.used += produced
+                output.lengths.append(produced)
+            }
+        }
+    }
+
+    private static func decompressRange(
+        _ range: Range<Int>,
+        of input: Input,
+        options: DecompressionOptions,
+        into output: WorkerOutput
+    ) throws {
+        let stream = UnsafeMutablePointer<z_stream>.allocate(capacity: 1)
+        stream.initialize(to: z_stream())
+        defer {
+            stream.deinitialize(count: 1)
+            stream.deallocate()
+        }
+
+        let result = swift_inflateInit2(stream, options.format.windowBits.zlibWindowBits)
+        guard result == Z_OK else {
+            throw ZLibError.decompressionFailed(result)
+        }
+        defer { swift_inflateEnd(stream) }
+        output.lengths.reserveCapacity(range.count)
+
+        func setDictionary() throws {
+            guard let dictionary = options.dictionary else {
+                throw ZLibError.decompressionFailed(Z_NEED_DICT)
+            }
+            let dictionaryResult = dictionary.withUnsafeBytes { bytes in
+                swift_inflateSetDictionary(stream, bytes.bindMemory(to: Bytef.self).baseAddress, uInt(bytes.count))
+            }
+            guard dictionaryResult == Z_OK else {
+                throw ZLibError.decompressionFailed(dictionaryResult)
+            }
+        }
+
+        for index in range {
+            if index != range.lowerBound {
+                let resetResult = swift_inflateReset(stream)
+                guard resetResult == Z_OK else {
+                    throw ZLibError.decompressionFailed(resetResult)
+                }
+            }
+            // Raw deflate has no header to ask for the dictionary
+            if options.format == .raw, options.dictionary != nil {
+                try setDictionary()
+            }
+
+            try input.withItem(index) { bytes in
+                guard bytes.count <= Int(uInt.max) else {
+                    throw ZLibError.bufferError
+                }
+                stream.pointee.next_in = bytes.baseAddress.map { UnsafeMutablePointer(mutating: $0.assumingMemoryBound(to: Bytef.self)) }
+                stream.pointee.avail_in = uInt(bytes.count)
+
+                let start = output.used
+                // Limits apply per record; one byte of headroom past the limit detects the overrun
+                let limit = options.outputLimit(forInputSize: bytes.count)
+                // Small records usually expand 2-4x; the buffer grows geometrically beyond that
+                let headroom = min(max(bytes.count * 4, 1024), limit.map { $0 + 1 } ?? Int.max)
+                var status: Int32 = Z_OK
+                repeat {
+                    try output.reserve(headroom)
+                    var available = min(output.capacity - output.used, Int(uInt.max))
+                    if let limit {
+                        available = min(available, limit - (output.used - start) + 1)
+                    }
+                    stream.pointee.next_out = output.freeSpace
+                    stream.pointee.avail_out = uInt(available)
+
+                    status = swift_inflate(stream, Z_NO_FLUSH)
+                    output.used += available - Int(stream.pointee.avail_out)
+                    if let limit, output.used - start > limit {
+                        throw ZLibError.outputLimitExceeded(limit: limit)
+                    }
+
+                    switch status {
+                        case Z_OK, Z_STREAM_END:
+                            break
+                        case Z_NEED_DICT:
+                            try setDictionary()
+                        case Z_BUF_ERROR where stream.pointee.avail_in == 0:
+                            // The record ended before its compressed stream did
+                            throw ZLibError.decompressionFailed(Z_DATA_ERROR)
+                        case Z_BUF_ERROR:
+                            break
+                        default:
+                            throw ZLibError.decompressionFailed(status)
+                    }
+                } while status != Z_STREAM_END
+                output.lengths.append(output.used - start)
+            }
+        }
+    }
+}
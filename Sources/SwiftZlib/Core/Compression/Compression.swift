@@ -25,6 +25,10 @@ public struct CompressionOptions: Sendable {
     public var dictionary: Data?
     /// Gzip header information (optional, only used with gzip format)
     public var gzipHeader: GzipHeader?
+    /// Store input that looks incompressible instead of deflating it (see `Compressor.skipsIncompressible`, default: false)
+    public var skipsIncompressible: Bool
+    /// Match finder tuning such as `DeflateTuning.json` (optional); its level replaces `level`
+    public var tuning: DeflateTuning?
 
     // MARK: Lifecycle
 
@@ -36,13 +40,17 @@ public struct CompressionOptions: Sendable {
     ///   - memoryLevel: Memory level
     ///   - dictionary: Dictionary for compression
     ///   - gzipHeader: Gzip header information
+    ///   - skipsIncompressible: Store input that looks incompressible
+    ///   - tuning: Match finder tuning, overriding `level`
     public init(
         format: CompressionFormat = .zlib,
         level: CompressionLevel = .defaultCompression,
         strategy: CompressionStrategy = .defaultStrategy,
         memoryLevel: MemoryLevel = .maximum,
         dictionary: Data? = nil,
-        gzipHeader: GzipHeader? = nil
+        gzipHeader: GzipHeader? = nil,
+        skipsIncompressible: Bool = false,
+        tuning: DeflateTuning? = nil
     ) {
         self.format = format
         self.level = level
@@ -50,6 +58,8 @@ public struct CompressionOptions: Sendable {
         self.memoryLevel = memoryLevel
         self.dictionary = dictionary
         self.gzipHeader = gzipHeader
+        self.skipsIncompressible = skipsIncompressible
+        self.tuning = tuning
     }
 }
 
@@ -65,6 +75,18 @@ public struct DecompressionOptions: Sendable {
     public var dictionary: Data?
     /// Whether to auto-detect format (only used when format is .auto)
     public var autoDetect: Bool
+    /// Expected decompressed size (optional); for gzip input the ISIZE trailer is used when this is nil
+    public var expectedSize: Int?
+    /// Most bytes the decompressed output may have (nil: unlimited)
+    ///
+    /// Inflate stops with `ZLibError.outputLimitExceeded` as soon as the output would grow past
+    /// this, so a decompression bomb costs at most this much memory and the time to produce it.
+    public var maxOutputSize: Int?
+    /// Most decompressed bytes per byte of compressed input seen so far (nil: unlimited)
+    ///
+    /// Deflate cannot expand beyond about 1032:1; ordinary data stays under 10:1, so a limit
+    /// in the low hundreds rejects bombs without touching real payloads.
+    public var maxExpansionRatio: Double?
 
     // MARK: Lifecycle
 
@@ -73,14 +95,45 @@ public struct DecompressionOptions: Sendable {
     ///   - format: Decompression format
     ///   - dictionary: Dictionary for decompression
     ///   - autoDetect: Whether to auto-detect format
+    ///   - expectedSize: Expected decompressed size, used to allocate the output once
+    ///   - maxOutputSize: Most decompressed bytes allowed
+    ///   - maxExpansionRatio: Most decompressed bytes allowed per compressed byte
     public init(
         format: CompressionFormat = .auto,
         dictionary: Data? = nil,
-        autoDetect: Bool = true
+        autoDetect: Bool = true,
+        expectedSize: Int? = nil,
+        maxOutputSize: Int? = nil,
+        maxExpansionRatio: Double? = nil
     ) {
         self.format = format
         self.dictionary = dictionary
         self.autoDetect = autoDetect
+        self.expectedSize = expectedSize
+        self.maxOutputSize = maxOutputSize
+        self.maxExpansionRatio = maxExpansionRatio
+    }
+
+    // MARK: Static Functions
+
+    /// Output bound that `maxOutputSize` and `maxExpansionRatio` allow after `inputSize` compressed bytes
+    /// - Returns: The bound in bytes, or nil when neither limit is set
+    static func outputLimit(maxOutputSize: Int?, maxExpansionRatio: Double?, inputSize: Int) -> Int? {
+        var limit = maxOutputSize
+        if let maxExpansionRatio {
+            let product = (maxExpansionRatio * Double(inputSize)).rounded(.down)
+            // NaN and anything past Int.max count as unlimited for the ratio
+            let bound = product < Double(Int.max) ? Int(max(product, 0)) : Int.max
+            limit = min(limit ?? Int.max, bound)
+        }
+        return limit.map { max($0, 0) }
+    }
+
+    // MARK: Functions
+
+    /// Output bound these options allow after `inputSize` compressed bytes, or nil if unlimited
+    func outputLimit(forInputSize inputSize: Int) -> Int? {
+        DecompressionOptions.outputLimit(maxOutputSize: maxOutputSize, maxExpansionRatio: maxExpansionRatio, inputSize: inputSize)
     }
 }
 
@@ -19,6 +19,12 @@ public enum CompressionStrategy: Int32, Sendable {
     case rle = 3
     /// Fixed strategy (predefined Huffman codes)
     case fixed = 4
+    /// Quick strategy (single-probe matching with fixed Huffman codes; fastest, standard deflate output)
+    ///
+    /// Trades compression ratio for speed on transient data such as caches and IPC payloads.
+    /// Any inflater can decode the output. The level only selects stored blocks at
+    /// `.noCompression`; every other level behaves the same.
+    case quick = 5
 
     // MARK: Computed Properties
 
@@ -19,6 +19,31 @@ public final class Compressor {
     /// Gzip header memory management
     private var gzipHeaderStorage: GzipHeaderStorage?
 
+    /// Arena backing the stream's allocations; must outlive deflateEnd in deinit
+    private var arena: ZStreamArena?
+
+    /// Performance counters for this compressor's `deflate` calls
+    public private(set) var metrics = StreamMetrics()
+
+    /// Store input chunks that look incompressible instead of deflating them (default: false)
+    ///
+    /// Each `compress(_:flush:)` call of at least 1 KB is checked with a sampled byte-entropy
+    /// estimate. When a chunk looks incompressible (already compressed or encrypted data), the
+    /// input so far is ended with a `Z_BLOCK` flush and the stream switches to level 0, so the
+    /// chunk is copied into stored blocks. The configured level comes back the same way at the
+    /// next chunk that looks compressible. The estimate only sees byte frequencies, so
+    /// high-entropy data that repeats within the window is stored rather than matched.
+    public var skipsIncompressible = false
+
+    /// Level and strategy set by initialization or `setParameters`, restored after stored chunks
+    private var configuredLevel = Z_DEFAULT_COMPRESSION
+    private var configuredStrategy = CompressionStrategy.defaultStrategy
+    /// Match finder parameters from `tune`, applied again whenever zlib reloads its table values
+    private var configuredTuning: DeflateTuning?
+
+    /// Whether the stream is at level 0 because the last checked chunk looked incompressible
+    private(set) var isBypassing = false
+
     // MARK: Lifecycle
 
     public init() {
@@ -54,6 +79,8 @@ public final class Compressor {
             throw ZLibError.compressionFailed(result)
         }
         isInitialized = true
+        configure(level: level.zlibLevel, strategy: .defaultStrategy)
+        metrics.noteStateMemory(swift_deflate_state_bytes(&stream))
         zlibInfo("Compressor initialized successfully")
     }
 
@@ -71,12 +98,30 @@ public final class Compressor {
         windowBits: WindowBits = .deflate,
         memoryLevel: MemoryLevel = .maximum,
         strategy: CompressionStrategy = .defaultStrategy
+    ) throws {
+        try initializeAdvanced(
+            level: level,
+            method: method,
+            zlibWindowBits: windowBits.zlibWindowBits,
+            memoryLevel: memoryLevel,
+            strategy: strategy
+        )
+    }
+
+    /// Initialize with any zlib window bits (9-15, negated for raw, plus 16 for gzip), including
+    /// windows smaller than the `WindowBits` cases
+    func initializeAdvanced(
+        level: CompressionLevel,
+        method: CompressionMethod = .deflate,
+        zlibWindowBits: Int32,
+        memoryLevel: MemoryLevel,
+        strategy: CompressionStrategy
     ) throws {
         let result = swift_deflateInit2(
             &stream,
             level.zlibLevel,
             method.zlibMethod,
-            windowBits.zlibWindowBits,
+            zlibWindowBits,
             memoryLevel.zlibMemoryLevel,
             strategy.zlibStrategy
         )
@@ -84,22 +129,49 @@ public final class Compressor {
             throw ZLibError.compressionFailed(result)
         }
         isInitialized = true
+        configure(level: level.zlibLevel, strategy: strategy)
+        metrics.noteStateMemory(swift_deflate_state_bytes(&stream))
+    }
+
+    /// Initialize the compressor from a prepared dictionary
+    ///
+    /// The stream is cloned from the dictionary's hashed template with `deflateCopy`, so it
+    /// starts with the dictionary loaded and skips `deflateInit2` and `deflateSetDictionary`.
+    /// Level, window bits, memory level and strategy are those of the prepared dictionary.
+    /// - Parameter prepared: Prepared dictionary to start from
+    /// - Throws: ZLibError if the compressor is already initialized or the copy fails
+    public func initialize(with prepared: PreparedDictionary) throws {
+        // deflateCopy also copies the template's allocators, which would bypass an arena
+        guard !isInitialized, arena == nil else {
+            throw ZLibError.streamError(Z_STREAM_ERROR)
+        }
+
+        let result = prepared.copyState(into: &stream)
+        guard result == Z_OK else {
+            throw ZLibError.compressionFailed(result)
+        }
+        isInitialized = true
+        configure(level: prepared.level.zlibLevel, strategy: prepared.strategy)
+        metrics.noteStateMemory(swift_deflate_state_bytes(&stream))
     }
 
     /// Change compression parameters mid-stream
+    ///
+    /// Switching to a level with a different match finder, or to another strategy, needs the
+    /// input so far to be compressed first: call `compress(_:flush:)` with `.block` (or a stronger
+    /// flush) beforehand, otherwise this throws `compressionFailed(Z_BUF_ERROR)`.
     /// - Parameters:
     ///   - level: New compression level
     ///   - strategy: New compression strategy
     /// - Throws: ZLibError if parameter change fails
     public func setParameters(level: CompressionLevel, strategy: CompressionStrategy) throws {
-        guard isInitialized else {
-            throw ZLibError.streamError(Z_STREAM_ERROR)
-        }
+        try setParameters(zlibLevel: level.zlibLevel, strategy: strategy)
+    }
 
-        let result = swift_deflateParams(&stream, level.zlibLevel, strategy.zlibStrategy)
-        guard result == Z_OK else {
-            throw ZLibError.compressionFailed(result)
-        }
+    /// Change parameters to any zlib level (0-9), including those without a `CompressionLevel` case
+    func setParameters(zlibLevel: Int32, strategy: CompressionStrategy) throws {
+        try applyParameters(zlibLevel: zlibLevel, strategy: strategy)
+        configure(level: zlibLevel, strategy: strategy)
     }
 
     /// Set compression dictionary
@@ -136,6 +208,53 @@ public final class Compressor {
         guard result == Z_OK else {
             throw ZLibError.compressionFailed(result)
         }
+        // deflateReset reloads the level's table values
+        if !isBypassing {
+            try applyTuning()
+        }
+    }
+
+    /// Clear the performance counters, keeping the state memory currently in use as the peak
+    public func resetMetrics() {
+        metrics = StreamMetrics()
+        metrics.noteStateMemory(swift_deflate_state_bytes(&stream))
+    }
+
+    /// Route zlib's allocations for this compressor through an arena
+    /// - Parameter arena: Arena sized for the stream; must be attached before initialization
+    func attachArena(_ arena: ZStreamArena) {
+        precondition(!isInitialized, "Arena must be attached before the compressor is initialized")
+        self.arena = arena
+        arena.attach(to: &stream)
+    }
+
+    /// Return the compressor to a freshly initialized state for pooling
+    ///
+    /// Unlike `reset()` this does not check for task cancellation, restores the given
+    /// parameters in case `setParameters` was called, and drops any gzip header.
+    /// - Parameters:
+    ///   - level: Compression level to restore
+    ///   - strategy: Compression strategy to restore
+    /// - Throws: ZLibError if the reset fails
+    func prepareForReuse(level: CompressionLevel, strategy: CompressionStrategy) throws {
+        guard isInitialized else {
+            throw ZLibError.streamError(Z_STREAM_ERROR)
+        }
+
+        var result = swift_deflateReset(&stream)
+        if result == Z_OK {
+            // Right after a reset there is no pending input, so this only swaps the config
+            result = swift_deflateParams(&stream, level.zlibLevel, strategy.zlibStrategy)
+        }
+        guard result == Z_OK else {
+            throw ZLibError.compressionFailed(result)
+        }
+        configure(level: level.zlibLevel, strategy: strategy)
+        if gzipHeaderStorage != nil {
+            swift_deflateSetHeader(&stream, nil)
+            gzipHeaderStorage = nil
+        }
+        isFinished = false
     }
 
     /// Reset the compressor with different window bits
@@ -165,6 +284,12 @@ public final class Compressor {
             throw ZLibError.compressionFailed(result)
         }
         destination.isInitialized = true
+        destination.skipsIncompressible = skipsIncompressible
+        destination.configuredLevel = configuredLevel
+        destination.configuredStrategy = configuredStrategy
+        destination.configuredTuning = configuredTuning
+        destination.isBypassing = isBypassing
+        destination.metrics.noteStateMemory(swift_deflate_state_bytes(&destination.stream))
     }
 
     /// Prime the compressor with bits
@@ -217,6 +342,9 @@ public final class Compressor {
     }
 
     /// Fine-tune deflate parameters
+    ///
+    /// The values stay in effect across `reset()` and stored incompressible chunks, until
+    /// `setParameters` or another `tune` call replaces them.
     /// - Parameters:
     ///   - goodLength: Good match length
     ///   - maxLazy: Maximum lazy match length
@@ -232,6 +360,32 @@ public final class Compressor {
         guard result == Z_OK else {
             throw ZLibError.compressionFailed(result)
         }
+        configuredTuning = DeflateTuning(
+            level: configuredLevel == Z_DEFAULT_COMPRESSION ? 6 : Int(configuredLevel),
+            goodLength: Int(goodLength),
+            maxLazy: Int(maxLazy),
+            niceLength: Int(niceLength),
+            maxChain: Int(maxChain)
+        )
+    }
+
+    /// Switch to a tuning's level and match finder parameters
+    ///
+    /// Changing to a level with the other match finder follows the rules of `setParameters`:
+    /// call it before the first input or after a `.block` (or stronger) flush.
+    /// - Parameter tuning: Level and parameters, such as `DeflateTuning.logs`
+    /// - Throws: ZLibError if the level change or the tuning fails
+    public func tune(_ tuning: DeflateTuning) throws {
+        guard isInitialized else {
+            throw ZLibError.streamError(Z_STREAM_ERROR)
+        }
+
+        let currentLevel = configuredLevel == Z_DEFAULT_COMPRESSION ? 6 : Int(configuredLevel)
+        if currentLevel != tuning.level || isBypassing {
+            try setParameters(zlibLevel: Int32(tuning.level), strategy: configuredStrategy)
+        }
+        configuredTuning = tuning
+        try applyTuning()
     }
 
     /// Get the current dictionary
@@ -322,7 +476,8 @@ public final class Compressor {
         zlibDebug("Input (hex, first 32 bytes): \(inputHex)\(input.count > 32 ? "..." : "")")
         logStreamState(stream, operation: "Compression start")
 
-        var output = Data()
+        var output = try skipsIncompressible ? updateBypass(for: input) : Data()
+        var reserved = output.count
         let outputBufferSize = 4096
         var outputBuffer = [Bytef](repeating: 0, count: outputBufferSize)
 
@@ -363,7 +518,7 @@ public final class Compressor {
                     }()
                     zlibDebug("[Compressor] Before deflate: next_in=0x\(String(inAddr, radix: 16)), avail_in=\(inAvail), preview=\(inPreview)")
 
-                    result = swift_deflate(&stream, flush.zlibFlush)
+                    result = deflateStep(flush.zlibFlush)
                     if result == Z_STREAM_ERROR {
                         zlibError("Compression failed with Z_STREAM_ERROR")
                         throw ZLibError.streamError(result)
@@ -371,8 +526,8 @@ public final class Compressor {
 
                     bytesProcessed = outputBufferSize - Int(stream.avail_out)
                     if bytesProcessed > 0 {
-                        let chunk = Data(bytes: buffer.baseAddress!, count: bytesProcessed)
-                        output.append(chunk)
+                        let chunk = UnsafeRawBufferPointer(start: buffer.baseAddress, count: bytesProcessed)
+                        metrics.append(to: &output, reserved: &reserved, chunk)
                         totalProduced += bytesProcessed
                         let chunkHex = chunk.prefix(32).map { String(format: "%02x", $0) }.joined()
                         zlibDebug("Output chunk (hex, first 32 bytes): \(chunkHex)\(chunk.count > 32 ? "..." : "")")
@@ -404,6 +559,7 @@ public final class Compressor {
         }
 
         var output = Data()
+        var reserved = 0
         let outputBufferSize = 4096
         var outputBuffer = [Bytef](repeating: 0, count: outputBufferSize)
 
@@ -422,15 +578,15 @@ public final class Compressor {
                 stream.next_out = buffer.baseAddress
                 stream.avail_out = uInt(outputBufferSize)
 
-                result = swift_deflate(&stream, FlushMode.finish.zlibFlush)
+                result = deflateStep(FlushMode.finish.zlibFlush)
                 guard result != Z_STREAM_ERROR else {
                     throw ZLibError.streamError(result)
                 }
 
                 bytesProcessed = outputBufferSize - Int(stream.avail_out)
                 if bytesProcessed > 0 {
-                    // Fix: Copy the data within the closure scope where the pointer is valid
-                    output.append(Data(bytes: buffer.baseAddress!, count: bytesProcessed))
+                    // Copy the data within the closure scope where the pointer is valid
+                    metrics.append(to: &output, reserved: &reserved, UnsafeRawBufferPointer(start: buffer.baseAddress, count: bytesProcessed))
                 }
             }
         } while stream.avail_out == 0 && result != Z_STREAM_END // Continue until stream ends
@@ -438,6 +594,27 @@ public final class Compressor {
         return output
     }
 
+    /// Compress between two ring buffers, pointing `next_in`/`next_out` at their storage
+    ///
+    /// Backs `RingBufferStream`; `skipsIncompressible` is not applied here.
+    func process(from input: ByteRingBuffer, into output: ByteRingBuffer, flush: FlushMode) throws -> RingBufferStream.Progress {
+        guard isInitialized else {
+            throw ZLibError.streamError(Z_STREAM_ERROR)
+        }
+
+        return try ByteRingBuffer.pump(from: input, into: output, flush: flush.zlibFlush) { source, destination, zlibFlush in
+            stream.next_in = source.baseAddress.map { UnsafeMutablePointer(mutating: $0.assumingMemoryBound(to: Bytef.self)) }
+            stream.avail_in = uInt(source.count)
+            stream.next_out = destination.baseAddress?.assumingMemoryBound(to: Bytef.self)
+            stream.avail_out = uInt(destination.count)
+            let result = deflateStep(zlibFlush)
+            guard result != Z_STREAM_ERROR else {
+                throw ZLibError.streamError(result)
+            }
+            return (result, source.count - Int(stream.avail_in), destination.count - Int(stream.avail_out))
+        }
+    }
+
     /// Set the gzip header for the stream (must be called after initializeAdvanced)
     public func setGzipHeader(_ header: GzipHeader) throws {
         guard gzipHeaderStorage == nil else {
@@ -450,4 +627,69 @@ public final class Compressor {
         }
         gzipHeaderStorage = storage
     }
+
+    // MARK: Private Functions
+
+    private func configure(level: Int32, strategy: CompressionStrategy) {
+        configuredLevel = level
+        configuredStrategy = strategy
+        configuredTuning = nil
+        isBypassing = false
+    }
+
+    private func applyTuning() throws {
+        guard let tuning = configuredTuning else {
+            return
+        }
+        let result = tuning.apply(to: &stream)
+        guard result == Z_OK else {
+            throw ZLibError.compressionFailed(result)
+        }
+    }
+
+    private func applyParameters(zlibLevel: Int32, strategy: CompressionStrategy) throws {
+        guard isInitialized else {
+            throw ZLibError.streamError(Z_STREAM_ERROR)
+        }
+
+        // deflateParams may flush pending input with deflate(Z_BLOCK); no output space keeps it
+        // from writing through the output pointer left over from the last compress call
+        stream.avail_out = 0
+        let result = swift_deflateParams(&stream, zlibLevel, strategy.zlibStrategy)
+        guard result == Z_OK else {
+            throw ZLibError.compressionFailed(result)
+        }
+    }
+
+    /// Switch between stored blocks and the configured level to match the next input chunk
+    /// - Returns: Output of the block flush that ends the input compressed so far, if any
+    private func updateBypass(for input: Data) throws -> Data {
+        guard configuredLevel != 0, input.count >= ByteEntropy.minimumInputSize else {
+            return Data()
+        }
+        let incompressible = ByteEntropy.isLikelyIncompressible(input)
+        guard incompressible != isBypassing else {
+            return Data()
+        }
+
+        // Compress everything buffered so far at the old level, so deflateParams has nothing to flush
+        let flushed = try compress(Data(), flush: .block)
+        try applyParameters(zlibLevel: incompressible ? 0 : configuredLevel, strategy: configuredStrategy)
+        isBypassing = incompressible
+        // deflateParams reloads the level's table values
+        if !incompressible {
+            try applyTuning()
+        }
+        zlibDebug("Input looks \(incompressible ? "incompressible, storing" : "compressible again, deflating") from here")
+        return flushed
+    }
+
+    /// Run one `deflate` call on the current buffers, counting it in `metrics`
+    private func deflateStep(_ flush: Int32) -> Int32 {
+        let result = metrics.measure(.deflate, &stream) { swift_deflate(&$0, flush) }
+        if result == Z_STREAM_END {
+            ZLibMetrics.report(.deflate, metrics)
+        }
+        return result
+    }
 }
@@ -0,0 +1,153 @@
+//
+//  CompressorPool.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+/// Thread-safe pool of initialized compressors sharing one configuration.
+///
+/// `deflateInit2` allocates roughly 256 KB of state at `MemoryLevel.maximum` and `deflateEnd`
+/// frees it again, which dominates the cost of compressing small messages. A pool keeps
+/// released compressors around and resets them with `deflateReset`, so the next `acquire()`
+/// skips initialization entirely. With `usesArena` enabled each compressor's zlib state also
+/// lives in a private slab wired into `zalloc`/`zfree`, so a reused stream performs no heap
+/// allocation inside zlib.
+public final class CompressorPool {
+    // MARK: Properties
+
+    public let level: CompressionLevel
+    public let windowBits: WindowBits
+    public let memoryLevel: MemoryLevel
+    public let strategy: CompressionStrategy
+
+    /// Maximum number of idle compressors kept for reuse
+    public let maxPooled: Int
+
+    /// Whether new compressors allocate their zlib state from an arena
+    public let usesArena: Bool
+
+    private let lock = NSLock()
+    private var available: [Compressor] = []
+
+    // MARK: Computed Properties
+
+    /// Number of idle compressors currently held by the pool
+    public var pooledCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return available.count
+    }
+
+    // MARK: Lifecycle
+
+    /// Create a compressor pool
+    /// - Parameters:
+    ///   - level: Compression level
+    ///   - windowBits: Window bits for format (default: .deflate)
+    ///   - memoryLevel: Memory level (default: .maximum)
+    ///   - strategy: Compression strategy (default: .defaultStrategy)
+    ///   - maxPooled: Maximum number of idle compressors kept (default: twice the active CPU count)
+    ///   - usesArena: Allocate each compressor's zlib state from an arena (default: true)
+    public init(
+        level: CompressionLevel = .defaultCompression,
+        windowBits: WindowBits = .deflate,
+        memoryLevel: MemoryLevel = .maximum,
+        strategy: CompressionStrategy = .defaultStrategy,
+        maxPooled: Int = ProcessInfo.processInfo.activeProcessorCount * 2,
+        usesArena: Bool = true
+    ) {
+        self.level = level
+        self.windowBits = windowBits
+        self.memoryLevel = memoryLevel
+        self.strategy = strategy
+        self.maxPooled = max(maxPooled, 0)
+        self.usesArena = usesArena
+    }
+
+    // MARK: Functions
+
+    /// Take a ready-to-use compressor from the pool, creating one if the pool is empty
+    /// - Returns: An initialized compressor at the start of a new stream
+    /// - Throws: ZLibError if a new compressor cannot be initialized
+    public func acquire() throws -> Compressor {
+        lock.lock()
+        let pooled = available.popLast()
+        lock.unlock()
+
+        if let pooled {
+            return pooled
+        }
+        return try makeCompressor()
+    }
+
+    /// Return a compressor to the pool
+    ///
+    /// The compressor is reset before it is pooled. Compressors that fail to reset, or that
+    /// arrive while the pool is full, are dropped. Only pass compressors obtained from this
+    /// pool's `acquire()`.
+    /// - Parameter compressor: Compressor to return
+    public func release(_ compressor: Compressor) {
+        do {
+            try compressor.prepareForReuse(level: level, strategy: strategy)
+        } catch {
+            zlibWarning("Discarding pooled compressor after failed reset: \(error)")
+            return
+        }
+
+        lock.lock()
+        defer { lock.unlock() }
+        if available.count < maxPooled {
+            available.append(compressor)
+        }
+    }
+
+    /// Run a closure with a pooled compressor, returning it to the pool afterwards
+    /// - Parameter body: Closure receiving the compressor
+    /// - Returns: The closure's result
+    /// - Throws: ZLibError if no compressor can be created, or any error thrown by `body`
+    public func withCompressor<T>(_ body: (Compressor) throws -> T) throws -> T {
+        let compressor = try acquire()
+        defer { release(compressor) }
+        return try body(compressor)
+    }
+
+    /// Compress a complete buffer with a pooled compressor
+    /// - Parameter data: Data to compress
+    /// - Returns: Compressed data in the pool's format
+    /// - Throws: ZLibError if compression fails
+    public func compress(_ data: Data) throws -> Data {
+        try withCompressor { compressor in
+            try compressor.compress(data, flush: .finish)
+        }
+    }
+
+    /// Drop all idle compressors
+    public func drain() {
+        lock.lock()
+        available.removeAll()
+        lock.unlock()
+    }
+
+    // MARK: Private Functions
+
+    private func makeCompressor() throws -> Compressor {
+        let compressor = Compressor()
+        if usesArena {
+            guard let arena = ZStreamArena.forDeflate(windowBits: windowBits, memoryLevel: memoryLevel) else {
+                throw ZLibError.memoryError
+            }
+            compressor.attachArena(arena)
+        }
+        try compressor.initializeAdvanced(
+            level: level,
+            windowBits: windowBits,
+            memoryLevel: memoryLevel,
+            strategy: strategy
+        )
+        return compressor
+    }
+}
@@ -0,0 +1,87 @@
+//
+//  DataBatch.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import Foundation
+
+/// Variable-length records stored back to back in one contiguous buffer
+///
+/// Record `i` occupies bytes `offsets[i] ..< offsets[i + 1]` of `storage`. Subscripting
+/// returns a slice that shares `storage`, so reading records never copies; as with any `Data`
+/// slice, the indices of a record are those of `storage`.
+public struct DataBatch: RandomAccessCollection, Sendable {
+    // MARK: Properties
+
+    /// All records, back to back
+    public let storage: Data
+
+    /// `count + 1` ascending byte offsets into `storage`, starting at 0
+    public let offsets: [Int]
+
+    // MARK: Computed Properties
+
+    public var startIndex: Int { 0 }
+
+    public var endIndex: Int { offsets.count - 1 }
+
+    // MARK: Lifecycle
+
+    /// Create an empty batch
+    public init() {
+        storage = Data()
+        offsets = [0]
+    }
+
+    /// Pack separate records into one buffer
+    /// - Parameter items: Records to pack
+    public init(_ items: [Data]) {
+        var offsets = [0]
+        offsets.reserveCapacity(items.count + 1)
+        for item in items {
+            offsets.append(offsets[offsets.count - 1] + item.count)
+        }
+        var storage = Data(capacity: offsets[offsets.count - 1])
+        for item in items {
+            storage.append(item)
+        }
+        self.storage = storage
+        self.offsets = offsets
+    }
+
+    /// Wrap an existing buffer and offsets table
+    /// - Parameters:
+    ///   - storage: Records, back to back
+    ///   - offsets: `count + 1` ascending offsets; the first must be 0 and the last `storage.count`
+    public init(storage: Data, offsets: [Int]) {
+        precondition(offsets.first == 0 && offsets.last == storage.count, "Offsets must span the whole storage")
+        precondition(zip(offsets, offsets.dropFirst()).allSatisfy { $0 <= $1 }, "Offsets must be ascending")
+        self.storage = storage
+        self.offsets = offsets
+    }
+
+    // MARK: Functions
+
+    public subscript(position: Int) -> Data {
+        let base = storage.startIndex
+        return storage[(base + offsets[position]) ..< (base + offsets[position + 1])]
+    }
+
+    /// Byte range of a record within `storage`, relative to its start
+    public func range(at index: Int) -> Range<Int> {
+        offsets[index] ..< offsets[index + 1]
+    }
+
+    /// Access the bytes of one record without creating a `Data` slice
+    /// - Parameters:
+    ///   - index: Record index
+    ///   - body: Closure receiving the record's bytes; the pointer must not escape
+    /// - Returns: The closure's result
+    public func withUnsafeBytes<R>(at index: Int, _ body: (UnsafeRawBufferPointer) throws -> R) rethrows -> R {
+        try storage.withUnsafeBytes { bytes in
+            try body(UnsafeRawBufferPointer(rebasing: bytes[offsets[index] ..< offsets[index + 1]]))
+        }
+    }
+}
@@ -12,11 +12,46 @@ import Foundation
 
 /// Stream-based decompression for large data or streaming scenarios
 public final class Decompressor {
+    // MARK: Static Properties
+
+    /// Largest working buffer used when the caller supplies an expected output size
+    static let maxHintedChunkSize = 256 * 1024
+
     // MARK: Properties
 
     private var stream = z_stream()
     private var isInitialized = false
 
+    /// Arena backing the stream's allocations; must outlive inflateEnd in deinit
+    private var arena: ZStreamArena?
+
+    /// Performance counters for this decompressor's `inflate` calls
+    public private(set) var metrics = StreamMetrics()
+
+    /// Most bytes the stream may produce since initialization or the last reset (nil: unlimited)
+    ///
+    /// Checked inside the inflate loop: `decompress` and `finish` throw
+    /// `ZLibError.outputLimitExceeded` after producing at most one byte more than allowed.
+    public var maxOutputSize: Int?
+    /// Most output bytes per input byte handed to the stream since initialization or the last reset
+    public var maxExpansionRatio: Double?
+
+    /// Whether `inflate` has returned `Z_STREAM_END` since the stream was initialized or reset
+    private(set) var reachedStreamEnd = false
+    /// Input bytes the last `decompress` call left unread, such as data past the end of the stream
+    private(set) var unconsumedInputCount = 0
+
+    // MARK: Computed Properties
+
+    /// Output bound the limits allow for the input handed over so far, or nil if unlimited
+    private var outputLimit: Int? {
+        DecompressionOptions.outputLimit(
+            maxOutputSize: maxOutputSize,
+            maxExpansionRatio: maxExpansionRatio,
+            inputSize: Int(stream.total_in) + Int(stream.avail_in)
+        )
+    }
+
     // MARK: Lifecycle
 
     public init() {
@@ -48,6 +83,7 @@ public final class Decompressor {
             throw ZLibError.decompressionFailed(result)
         }
         isInitialized = true
+        metrics.noteStateMemory(swift_inflate_state_bytes(&stream))
         zlibInfo("Decompressor initialized successfully")
     }
 
@@ -55,11 +91,18 @@ public final class Decompressor {
     /// - Parameter windowBits: Window bits for format (default: .deflate)
     /// - Throws: ZLibError if initialization fails
     public func initializeAdvanced(windowBits: WindowBits = .deflate) throws {
-        let result = swift_inflateInit2(&stream, windowBits.zlibWindowBits)
+        try initializeAdvanced(zlibWindowBits: windowBits.zlibWindowBits)
+    }
+
+    /// Initialize with any zlib window bits, including windows smaller than the `WindowBits` cases
+    func initializeAdvanced(zlibWindowBits: Int32) throws {
+        let result = swift_inflateInit2(&stream, zlibWindowBits)
         guard result == Z_OK else {
             throw ZLibError.decompressionFailed(result)
         }
         isInitialized = true
+        reachedStreamEnd = false
+        metrics.noteStateMemory(swift_inflate_state_bytes(&stream))
     }
 
     /// Set decompression dictionary
@@ -100,6 +143,39 @@ public final class Decompressor {
         guard result == Z_OK else {
             throw ZLibError.decompressionFailed(result)
         }
+        reachedStreamEnd = false
+    }
+
+    /// Clear the performance counters, keeping the state memory currently in use as the peak
+    public func resetMetrics() {
+        metrics = StreamMetrics()
+        metrics.noteStateMemory(swift_inflate_state_bytes(&stream))
+    }
+
+    /// Route zlib's allocations for this decompressor through an arena
+    /// - Parameter arena: Arena sized for the stream; must be attached before initialization
+    func attachArena(_ arena: ZStreamArena) {
+        precondition(!isInitialized, "Arena must be attached before the decompressor is initialized")
+        self.arena = arena
+        arena.attach(to: &stream)
+    }
+
+    /// Return the decompressor to a freshly initialized state for pooling
+    ///
+    /// Unlike `reset()` this does not check for task cancellation, and it clears the output limits.
+    /// - Throws: ZLibError if the reset fails
+    func prepareForReuse() throws {
+        guard isInitialized else {
+            throw ZLibError.streamError(Z_STREAM_ERROR)
+        }
+
+        let result = swift_inflateReset(&stream)
+        guard result == Z_OK else {
+            throw ZLibError.decompressionFailed(result)
+        }
+        reachedStreamEnd = false
+        maxOutputSize = nil
+        maxExpansionRatio = nil
     }
 
     /// Copy the decompressor state to another decompressor
@@ -115,6 +191,8 @@ public final class Decompressor {
             throw ZLibError.decompressionFailed(result)
         }
         destination.isInitialized = true
+        destination.reachedStreamEnd = reachedStreamEnd
+        destination.metrics.noteStateMemory(swift_inflate_state_bytes(&destination.stream))
     }
 
     /// Prime the decompressor with bits
@@ -162,14 +240,20 @@ public final class Decompressor {
     /// - Parameter windowBits: New window bits
     /// - Throws: ZLibError if reset fails
     public func resetWithWindowBits(_ windowBits: WindowBits) throws {
+        try resetWithWindowBits(zlibWindowBits: windowBits.zlibWindowBits)
+    }
+
+    /// Reset to any zlib window bits; the window is kept when its size does not change
+    func resetWithWindowBits(zlibWindowBits: Int32) throws {
         guard isInitialized else {
             throw ZLibError.streamError(Z_STREAM_ERROR)
         }
 
-        let result = swift_inflateReset2(&stream, windowBits.zlibWindowBits)
+        let result = swift_inflateReset2(&stream, zlibWindowBits)
         guard result == Z_OK else {
             throw ZLibError.decompressionFailed(result)
         }
+        reachedStreamEnd = false
     }
 
     /// Get the current dictionary
@@ -269,9 +353,11 @@ public final class Decompressor {
     ///   - input: Input compressed data chunk
     ///   - flush: Flush mode
     ///   - dictionary: Optional dictionary for decompression
+    ///   - expectedSize: Expected size of this chunk's output; when given, the output is
+    ///     allocated once up front and inflated in larger steps
     /// - Returns: Decompressed data chunk
     /// - Throws: ZLibError if decompression fails
-    public func decompress(_ input: Data, flush: FlushMode = .noFlush, dictionary: Data? = nil) throws -> Data {
+    public func decompress(_ input: Data, flush: FlushMode = .noFlush, dictionary: Data? = nil, expectedSize: Int? = nil) throws -> Data {
         // Check for cancellation before starting work
         try Task.checkCancellation()
         zlibDebug("[Decompressor.decompress] Called with input size: \(input.count), flush: \(flush), dictionary: \(dictionary?.count ?? 0)")
@@ -288,7 +374,21 @@ public final class Decompressor {
         logStreamState(stream, operation: "Decompression start")
 
         var output = Data()
-        var outputBuffer = Data(repeating: 0, count: 1024) // 1KB chunks
+        var reserved = 0
+        var chunkSize = 1024 // 1KB chunks
+        // A hint past the output limit cannot be right, so never allocate beyond the limit
+        let limit = DecompressionOptions.outputLimit(
+            maxOutputSize: maxOutputSize,
+            maxExpansionRatio: maxExpansionRatio,
+            inputSize: Int(stream.total_in) + input.count
+        )
+        if let expectedSize, expectedSize > 0 {
+            let allowed = limit.map { min(expectedSize, max($0 - Int(stream.total_out), 0) + 1) } ?? expectedSize
+            output.reserveCapacity(allowed)
+            reserved = allowed
+            chunkSize = min(max(allowed, chunkSize), Self.maxHintedChunkSize)
+        }
+        var outputBuffer = Data(repeating: 0, count: chunkSize)
         var dictWasSet = false
 
         // Set input data
@@ -306,12 +406,12 @@ public final class Decompressor {
                 if ZLibVerboseConfig.logProgress {
                     zlibDebug("[Decompressor.decompress] Iteration \(iteration): avail_in=\(stream.avail_in), avail_out=\(stream.avail_out)")
                 }
-                let outputBufferCount = outputBuffer.count
+                let outputBufferCount = try outputAllowance(limit: limit, bufferSize: outputBuffer.count)
                 var bytesProcessed = 0
                 result = try outputBuffer.withUnsafeMutableBytes { outputPtr -> Int32 in
                     stream.next_out = outputPtr.bindMemory(to: Bytef.self).baseAddress
                     stream.avail_out = uInt(outputBufferCount)
-                    let inflateResult = swift_inflate(&stream, flush.zlibFlush)
+                    let inflateResult = inflateStep(flush.zlibFlush)
                     zlibDebug("[Decompressor.decompress] swift_inflate returned: \(inflateResult)")
                     if inflateResult == Z_NEED_DICT {
                         if let dict = dictionary, !dictWasSet {
@@ -332,9 +432,9 @@ public final class Decompressor {
                     }
                     bytesProcessed = outputBufferCount - Int(stream.avail_out)
                     if bytesProcessed > 0 {
-                        // Fix: Copy the data within the closure scope where the pointer is valid
-                        let temp = Data(bytes: outputPtr.baseAddress!, count: bytesProcessed)
-                        output.append(temp)
+                        // Copy the data within the closure scope where the pointer is valid
+                        let temp = UnsafeRawBufferPointer(rebasing: outputPtr[..<bytesProcessed])
+                        metrics.append(to: &output, reserved: &reserved, temp)
                         // Log output chunk (hex, truncated)
                         let chunkHex = temp.prefix(32).map { String(format: "%02x", $0) }.joined()
                         zlibDebug("Output chunk (hex, first 32 bytes): \(chunkHex)\(temp.count > 32 ? "..." : "")")
@@ -343,11 +443,13 @@ public final class Decompressor {
                     }
                     return inflateResult
                 }
+                try checkOutputLimit(limit)
                 logStreamState(stream, operation: "Decompression iteration \(iteration) end")
                 if dictWasSet {
                     dictWasSet = false // Only allow one extra pass after setting dictionary
                 }
             } while result != Z_STREAM_END && (stream.avail_in > 0 || stream.avail_out == 0 || dictWasSet)
+            unconsumedInputCount = Int(stream.avail_in)
         }
 
         logStreamState(stream, operation: "Decompression end")
@@ -371,11 +473,13 @@ public final class Decompressor {
         }
 
         var output = Data()
+        var reserved = 0
         var outputBuffer = Data(repeating: 0, count: 1024) // 1KB chunks
 
         // Set empty input for finish
         stream.next_in = nil
         stream.avail_in = 0
+        let limit = outputLimit
 
         // Process until stream is finished
         var result: Int32 = Z_OK
@@ -383,7 +487,7 @@ public final class Decompressor {
             // Check for cancellation before each iteration
             try Task.checkCancellation()
             var bytesProcessed = 0
-            let outputBufferCount = outputBuffer.count
+            let outputBufferCount = try outputAllowance(limit: limit, bufferSize: outputBuffer.count)
             // We assign the result of withUnsafeMutableBytes to _ because
             // the closure's return value (Int32) is not needed outside the closure.
             // The important side effects (decompression, updating `result`, appending to `output`)
@@ -392,26 +496,48 @@ public final class Decompressor {
                 stream.next_out = outputPtr.bindMemory(to: Bytef.self).baseAddress
                 stream.avail_out = uInt(outputBufferCount)
 
-                result = swift_inflate(&stream, FlushMode.finish.zlibFlush)
+                result = inflateStep(FlushMode.finish.zlibFlush)
                 guard result != Z_STREAM_ERROR else {
                     throw ZLibError.streamError(result)
                 }
 
                 bytesProcessed = outputBufferCount - Int(stream.avail_out)
                 if bytesProcessed > 0 {
-                    // Fix: Copy the data within the closure scope where the pointer is valid
-                    let temp = Data(bytes: outputPtr.baseAddress!, count: bytesProcessed)
-                    output.append(temp)
+                    // Copy the data within the closure scope where the pointer is valid
+                    metrics.append(to: &output, reserved: &reserved, UnsafeRawBufferPointer(rebasing: outputPtr[..<bytesProcessed]))
                     zlibDebug("[Decompressor.finish] Produced \(bytesProcessed) bytes of decompressed data")
                 }
                 return result
             }
+            try checkOutputLimit(limit)
         } while stream.avail_out == 0 && result != Z_STREAM_END // Continue until stream ends
 
         zlibInfo("[Decompressor.finish] Decompression finished: \(output.count) bytes")
         return output
     }
 
+    /// Decompress between two ring buffers, pointing `next_in`/`next_out` at their storage
+    ///
+    /// Backs `RingBufferStream`. A stream that needs a dictionary fails with
+    /// `decompressionFailed(Z_NEED_DICT)`.
+    func process(from input: ByteRingBuffer, into output: ByteRingBuffer) throws -> RingBufferStream.Progress {
+        guard isInitialized else {
+            throw ZLibError.streamError(Z_STREAM_ERROR)
+        }
+
+        return try ByteRingBuffer.pump(from: input, into: output, flush: Z_NO_FLUSH) { source, destination, zlibFlush in
+            stream.next_in = source.baseAddress.map { UnsafeMutablePointer(mutating: $0.assumingMemoryBound(to: Bytef.self)) }
+            stream.avail_in = uInt(source.count)
+            stream.next_out = destination.baseAddress?.assumingMemoryBound(to: Bytef.self)
+            stream.avail_out = uInt(destination.count)
+            let result = inflateStep(zlibFlush)
+            guard result == Z_OK || result == Z_STREAM_END || result == Z_BUF_ERROR else {
+                throw ZLibError.decompressionFailed(result)
+            }
+            return (result, source.count - Int(stream.avail_in), destination.count - Int(stream.avail_out))
+        }
+    }
+
     /// Get the gzip header from the stream (must be called after initializeAdvanced)
     public func getGzipHeader() throws -> GzipHeader {
         var cHeader = gz_header()
@@ -421,4 +547,40 @@ public final class Decompressor {
         }
         return from_c_gz_header(&cHeader)
     }
+
+    /// Apply the output limits of `options` to this decompressor
+    func applyLimits(of options: DecompressionOptions) {
+        maxOutputSize = options.maxOutputSize
+        maxExpansionRatio = options.maxExpansionRatio
+    }
+
+    // MARK: Private Functions
+
+    /// Output space for the next `inflate` call: the buffer, cut to one byte past the limit
+    private func outputAllowance(limit: Int?, bufferSize: Int) throws -> Int {
+        guard let limit else {
+            return bufferSize
+        }
+        try checkOutputLimit(limit)
+        return min(bufferSize, limit - Int(stream.total_out) + 1)
+    }
+
+    private func checkOutputLimit(_ limit: Int?) throws {
+        if let limit, Int(stream.total_out) > limit {
+            zlibError("Decompressed output exceeds the limit of \(limit) bytes")
+            throw ZLibError.outputLimitExceeded(limit: limit)
+        }
+    }
+
+    /// Run one `inflate` call on the current buffers, counting it in `metrics`
+    private func inflateStep(_ flush: Int32) -> Int32 {
+        let result = metrics.measure(.inflate, &stream) { swift_inflate(&$0, flush) }
+        // The window is allocated by the first call that returns output before the stream ends
+        metrics.noteStateMemory(swift_inflate_state_bytes(&stream))
+        if result == Z_STREAM_END {
+            reachedStreamEnd = true
+            ZLibMetrics.report(.inflate, metrics)
+        }
+        return result
+    }
 }
@@ -0,0 +1,134 @@
+//
+//  DecompressorPool.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+/// Thread-safe pool of initialized decompressors sharing one window-bits setting.
+///
+/// Released decompressors are reset with `inflateReset`, which keeps the inflate state and
+/// its sliding window allocated, so the next `acquire()` skips `inflateInit2`. With
+/// `usesArena` enabled that state lives in a per-decompressor slab wired into
+/// `zalloc`/`zfree`. See `CompressorPool` for the compression side.
+public final class DecompressorPool {
+    // MARK: Properties
+
+    public let windowBits: WindowBits
+
+    /// Maximum number of idle decompressors kept for reuse
+    public let maxPooled: Int
+
+    /// Whether new decompressors allocate their zlib state from an arena
+    public let usesArena: Bool
+
+    private let lock = NSLock()
+    private var available: [Decompressor] = []
+
+    // MARK: Computed Properties
+
+    /// Number of idle decompressors currently held by the pool
+    public var pooledCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return available.count
+    }
+
+    // MARK: Lifecycle
+
+    /// Create a decompressor pool
+    /// - Parameters:
+    ///   - windowBits: Window bits for format (default: .deflate)
+    ///   - maxPooled: Maximum number of idle decompressors kept (default: twice the active CPU count)
+    ///   - usesArena: Allocate each decompressor's zlib state from an arena (default: true)
+    public init(
+        windowBits: WindowBits = .deflate,
+        maxPooled: Int = ProcessInfo.processInfo.activeProcessorCount * 2,
+        usesArena: Bool = true
+    ) {
+        self.windowBits = windowBits
+        self.maxPooled = max(maxPooled, 0)
+        self.usesArena = usesArena
+    }
+
+    // MARK: Functions
+
+    /// Take a ready-to-use decompressor from the pool, creating one if the pool is empty
+    /// - Returns: An initialized decompressor at the start of a new stream
+    /// - Throws: ZLibError if a new decompressor cannot be initialized
+    public func acquire() throws -> Decompressor {
+        lock.lock()
+        let pooled = available.popLast()
+        lock.unlock()
+
+        if let pooled {
+            return pooled
+        }
+        return try makeDecompressor()
+    }
+
+    /// Return a decompressor to the pool
+    ///
+    /// The decompressor is reset before it is pooled. Decompressors that fail to reset, or
+    /// that arrive while the pool is full, are dropped. Only pass decompressors obtained from
+    /// this pool's `acquire()`.
+    /// - Parameter decompressor: Decompressor to return
+    public func release(_ decompressor: Decompressor) {
+        do {
+            try decompressor.prepareForReuse()
+        } catch {
+            zlibWarning("Discarding pooled decompressor after failed reset: \(error)")
+            return
+        }
+
+        lock.lock()
+        defer { lock.unlock() }
+        if available.count < maxPooled {
+            available.append(decompressor)
+        }
+    }
+
+    /// Run a closure with a pooled decompressor, returning it to the pool afterwards
+    /// - Parameter body: Closure receiving the decompressor
+    /// - Returns: The closure's result
+    /// - Throws: ZLibError if no decompressor can be created, or any error thrown by `body`
+    public func withDecompressor<T>(_ body: (Decompressor) throws -> T) throws -> T {
+        let decompressor = try acquire()
+        defer { release(decompressor) }
+        return try body(decompressor)
+    }
+
+    /// Decompress a complete buffer with a pooled decompressor
+    /// - Parameter data: Compressed data in the pool's format
+    /// - Returns: Decompressed data
+    /// - Throws: ZLibError if decompression fails
+    public func decompress(_ data: Data) throws -> Data {
+        try withDecompressor { decompressor in
+            try decompressor.decompress(data)
+        }
+    }
+
+    /// Drop all idle decompressors
+    public func drain() {
+        lock.lock()
+        available.removeAll()
+        lock.unlock()
+    }
+
+    // MARK: Private Functions
+
+    private func makeDecompressor() throws -> Decompressor {
+        let decompressor = Decompressor()
+        if usesArena {
+            guard let arena = ZStreamArena.forInflate(windowBits: windowBits) else {
+                throw ZLibError.memoryError
+            }
+            decompressor.attachArena(arena)
+        }
+        try decompressor.initializeAdvanced(windowBits: windowBits)
+        return decompressor
+    }
+}
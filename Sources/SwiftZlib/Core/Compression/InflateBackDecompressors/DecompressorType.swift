@@ -31,7 +31,8 @@ public protocol DecompressorType {
     /// Process data from a Data source
     /// - Parameters:
     ///   - input: Input compressed data
-    ///   - maxOutputSize: Maximum output buffer size (optional)
+    ///   - maxOutputSize: Most decompressed bytes to produce; `InflateBackDecompressorCBridged` throws
+    ///     `ZLibError.outputLimitExceeded` past it
     /// - Returns: Decompressed data
     /// - Throws: ZLibError if processing fails
     func processData(_ input: Data, maxOutputSize: Int) throws -> Data
@@ -45,11 +46,11 @@ public protocol DecompressorType {
 // MARK: - Default Implementation
 
 public extension DecompressorType {
-    /// Process data with default max output size
+    /// Process data without an output limit
     /// - Parameter input: Input compressed data
     /// - Returns: Decompressed data
     /// - Throws: ZLibError if processing fails
     func processData(_ input: Data) throws -> Data {
-        try processData(input, maxOutputSize: 4096)
+        try processData(input, maxOutputSize: .max)
     }
 }
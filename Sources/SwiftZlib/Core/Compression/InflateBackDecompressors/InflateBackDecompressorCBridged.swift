@@ -9,34 +9,47 @@ import CZLib
 import Foundation
 
 /// True InflateBack decompressor using C callback bridging
+///
+/// `process(_:output:)` is the fast path: input is read directly from a borrowed buffer on
+/// the C side and each output window is lent to the handler without copying, so a whole
+/// stream costs one Swift/C round trip per 32 KB of output and no allocations.
 public class InflateBackDecompressorCBridged: DecompressorType {
+    // MARK: Static Properties
+
+    /// Default size of the input chunks used by `processData(_:)` and custom input providers
+    public static let defaultChunkSize = 64 * 1024
+
+    /// InflateBack always uses the maximum 32 KB window
+    private static let windowSize = 1 << 15
+
     // MARK: Properties
 
     private var stream = z_stream()
     private var isInitialized = false
-    private var window: [UInt8]
-    private let windowSize: Int
+    /// Stable allocation: inflateBack keeps the pointer for the lifetime of the stream
+    private let window: UnsafeMutablePointer<UInt8>
     private let chunkSize: Int // Chunk size for input processing
 
     // MARK: Lifecycle
 
-    public init(windowBits: WindowBits = .deflate, chunkSize: Int = 1024) {
-        windowSize = 1 << windowBits.zlibWindowBits
-        window = [UInt8](repeating: 0, count: windowSize)
-        self.chunkSize = chunkSize
+    public init(windowBits _: WindowBits = .deflate, chunkSize: Int = InflateBackDecompressorCBridged.defaultChunkSize) {
+        window = UnsafeMutablePointer<UInt8>.allocate(capacity: InflateBackDecompressorCBridged.windowSize)
+        self.chunkSize = max(chunkSize, 1)
     }
 
     deinit {
         if isInitialized {
             swift_inflateBackEnd(&stream)
         }
+        window.deallocate()
     }
 
     // MARK: Functions
 
     /// Initialize the InflateBack decompressor
     public func initialize() throws {
-        let result = swift_inflateBackInit(&stream, WindowBits.deflate.zlibWindowBits, &window)
+        guard !isInitialized else { return }
+        let result = swift_inflateBackInit(&stream, WindowBits.deflate.zlibWindowBits, window)
         guard result == Z_OK else {
             throw ZLibError.decompressionFailed(result)
         }
@@ -101,28 +114,76 @@ public class InflateBackDecompressorCBridged: DecompressorType {
         }
     }
 
-    /// Process all data from a Data source
-    public func processData(_ input: Data, maxOutputSize: Int = 4096) throws -> Data {
+    /// Decompress a raw deflate stream from a borrowed buffer without intermediate copies
+    ///
+    /// The output handler receives a view into the 32 KB inflateBack window that is only
+    /// valid for the duration of the call; copy the bytes out if they need to outlive it.
+    /// Throwing from the handler stops decompression and rethrows the error.
+    /// - Parameters:
+    ///   - input: Raw deflate data; bytes after the end of the stream are left unread
+    ///   - output: Handler receiving each block of decompressed bytes
+    /// - Returns: Number of input bytes consumed, up to and including the end of the deflate stream
+    /// - Throws: ZLibError if the data is invalid or truncated, or the handler's error
+    @discardableResult
+    public func process(_ input: UnsafeRawBufferPointer, output: (UnsafeRawBufferPointer) throws -> Void) throws -> Int {
         guard isInitialized else {
             throw ZLibError.streamError(Z_STREAM_ERROR)
         }
+
+        return try withoutActuallyEscaping(output) { handler in
+            var context = BorrowedOutputContext(handler: handler)
+            var consumed = 0
+            let result = withUnsafeMutablePointer(to: &context) { contextPointer in
+                swift_inflateBackBuffer(
+                    &stream,
+                    input.baseAddress?.assumingMemoryBound(to: UInt8.self),
+                    input.count,
+                    chunkSize,
+                    borrowedOutput,
+                    contextPointer,
+                    &consumed
+                )
+            }
+            if let error = context.error {
+                throw error
+            }
+            guard result == Z_STREAM_END else {
+                // Z_BUF_ERROR here means the input ran out before the end of the stream
+                throw ZLibError.decompressionFailed(result == Z_BUF_ERROR ? Z_DATA_ERROR : result)
+            }
+            return consumed
+        }
+    }
+
+    /// Decompress a raw deflate stream held in `Data` without intermediate copies
+    /// - Parameters:
+    ///   - input: Raw deflate data
+    ///   - output: Handler receiving each block of decompressed bytes (borrowed, see `process(_:output:)`)
+    /// - Returns: Number of input bytes consumed
+    /// - Throws: ZLibError if the data is invalid or truncated, or the handler's error
+    @discardableResult
+    public func process(_ input: Data, output: (UnsafeRawBufferPointer) throws -> Void) throws -> Int {
+        try input.withUnsafeBytes { try process($0, output: output) }
+    }
+
+    /// Process all data from a Data source
+    /// - Parameters:
+    ///   - input: Raw deflate data
+    ///   - maxOutputSize: Most decompressed bytes to produce (default: unlimited)
+    /// - Returns: Decompressed data
+    /// - Throws: `ZLibError.outputLimitExceeded` as soon as the output would grow past `maxOutputSize`,
+    ///   or ZLibError if the data is invalid or truncated
+    public func processData(_ input: Data, maxOutputSize: Int = .max) throws -> Data {
+        let limit = max(maxOutputSize, 0)
         var output = Data()
-        var inputIndex = 0
-        let cSize = chunkSize
-        try processWithCallbacks(
-            inputProvider: {
-                guard inputIndex < input.count else { return nil }
-                let remaining = input.count - inputIndex
-                let size = min(remaining, cSize)
-                let chunk = input.subdata(in: inputIndex ..< (inputIndex + size))
-                inputIndex += size
-                return chunk
-            },
-            outputHandler: { data in
-                output.append(data)
-                return true
+        try process(input) { block in
+            guard block.count <= limit - output.count else {
+                throw ZLibError.outputLimitExceeded(limit: limit)
             }
-        )
+            if let base = block.baseAddress {
+                output.append(base.assumingMemoryBound(to: UInt8.self), count: block.count)
+            }
+        }
         return output
     }
 
@@ -141,3 +202,26 @@ public class InflateBackDecompressorCBridged: DecompressorType {
         return (totalIn, totalOut, isActive)
     }
 }
+
+// MARK: - BorrowedOutputContext
+
+/// Stack-allocated state shared with the C output callback of `process(_:output:)`
+private struct BorrowedOutputContext {
+    let handler: (UnsafeRawBufferPointer) throws -> Void
+    var error: Error?
+}
+
+/// C output callback: lends the window to the Swift handler, non-zero aborts inflateBack
+private let borrowedOutput: @convention(c) (UnsafeMutableRawPointer?, UnsafeMutablePointer<UInt8>?, Int32) -> Int32 = {
+    contextPointer, buffer, length in
+    guard let context = contextPointer?.assumingMemoryBound(to: BorrowedOutputContext.self) else {
+        return Z_STREAM_ERROR
+    }
+    do {
+        try context.pointee.handler(UnsafeRawBufferPointer(start: buffer, count: Int(length)))
+        return Z_OK
+    } catch {
+        context.pointee.error = error
+        return Z_STREAM_ERROR
+    }
+}
@@ -0,0 +1,390 @@
+//
+//  LazyInflatedData.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+/// Decompressed view of an in-memory deflate, zlib or gzip blob, inflated only as far as it is read
+///
+/// Reading a range inflates from the current position up to the end of the range and no further,
+/// so the first kilobyte of a 50 MB blob costs about a kilobyte of inflate and the compressed
+/// bytes behind it. While decoding forward, the view saves an `inflateCopy` of its stream every
+/// `checkpointInterval` output bytes. A read behind the current position resumes from the nearest
+/// checkpoint instead of from the start of the blob. When more than `maxCheckpoints` exist, every
+/// other one is dropped and the interval doubles, so checkpoints stay evenly spread and bounded,
+/// at about 40 KB each.
+///
+/// With a `GzipIndex` built for the same blob, a read far from both the current position and the
+/// saved checkpoints restarts at the index's access point instead, and `knownCount` is available
+/// up front. The most recent inflate step is kept, so nearby small reads do not decode twice.
+///
+/// A view is not thread-safe; use one per thread or serialize access.
+public final class LazyInflatedData {
+    // MARK: Nested Types
+
+    /// Copy of the inflate stream at one output offset
+    private final class Checkpoint {
+        // MARK: Properties
+
+        let stream: UnsafeMutablePointer<z_stream>
+        let outputOffset: Int
+        let inputOffset: Int
+
+        // MARK: Lifecycle
+
+        init?(copying source: UnsafeMutablePointer<z_stream>, outputOffset: Int, inputOffset: Int) {
+            stream = .allocate(capacity: 1)
+            stream.initialize(to: z_stream())
+            guard swift_inflateCopy(stream, source) == Z_OK else {
+                stream.deinitialize(count: 1)
+                stream.deallocate()
+                return nil
+            }
+            self.outputOffset = outputOffset
+            self.inputOffset = inputOffset
+        }
+
+        deinit {
+            swift_inflateEnd(stream)
+            stream.deinitialize(count: 1)
+            stream.deallocate()
+        }
+    }
+
+    // MARK: Static Properties
+
+    /// Default output distance between saved checkpoints
+    public static let defaultCheckpointInterval = 1 << 20
+
+    /// Default number of saved checkpoints
+    public static let defaultMaxCheckpoints = 16
+
+    /// Most output decoded per inflate step, and the size of the kept step
+    static let stepSize = 64 * 1024
+
+    // MARK: Properties
+
+    /// The compressed blob
+    public let compressed: Data
+    /// Stream format
+    public let windowBits: WindowBits
+    /// Access points for reads far from the current position, if provided
+    public let index: GzipIndex?
+    /// Most checkpoints kept at once
+    public let maxCheckpoints: Int
+    /// Current output distance between checkpoints; doubles whenever the checkpoints are thinned
+    public private(set) var checkpointInterval: Int
+    /// Uncompressed size, from the index or once the end of the stream has been decoded
+    public private(set) var knownCount: Int?
+    /// Output bytes inflated so far, counting output decoded again after a rewind
+    public private(set) var decodedBytes = 0
+    /// Furthest compressed offset any read needed
+    public private(set) var compressedBytesRead = 0
+
+    /// The stream at `outputOffset`; heap-allocated so the address zlib records never changes
+    private let stream: UnsafeMutablePointer<z_stream>
+    private var outputOffset = 0
+    private var inputOffset = 0
+    private var isAtEnd = false
+    /// Output offset the current run of decoding started from
+    private var runStart = 0
+    /// Saved streams, ordered by output offset
+    private var checkpoints: [Checkpoint] = []
+    /// Output of the last inflate step, starting at `cacheStart`
+    private let cache: UnsafeMutablePointer<UInt8>
+    private var cacheStart = 0
+    private var cacheCount = 0
+
+    // MARK: Computed Properties
+
+    /// Number of saved checkpoints
+    public var checkpointCount: Int {
+        checkpoints.count
+    }
+
+    /// Whether concatenated gzip members are decoded as one stream
+    private var allowsConcatenatedMembers: Bool {
+        windowBits == .gzip || windowBits == .auto
+    }
+
+    // MARK: Lifecycle
+
+    /// Create a lazy view; nothing is inflated until the first read
+    /// - Parameters:
+    ///   - compressed: The compressed blob
+    ///   - windowBits: Stream format (default: zlib); an index's own format takes precedence
+    ///   - index: Index built with `GzipIndex.build(for:)` from the same blob
+    ///   - checkpointInterval: Output distance between saved checkpoints, at least 64 KB
+    ///   - maxCheckpoints: Most checkpoints kept at once, at least 2
+    /// - Throws: ZLibError.invalidData if the index was built from data of another size
+    ///   (`GzipIndex.sourceSize`, which counts bytes after the stream too),
+    ///   ZLibError if the stream cannot be initialized
+    public init(
+        _ compressed: Data,
+        windowBits: WindowBits = .deflate,
+        index: GzipIndex? = nil,
+        checkpointInterval: Int = defaultCheckpointInterval,
+        maxCheckpoints: Int = defaultMaxCheckpoints
+    ) throws {
+        if let index, index.sourceSize != compressed.count {
+            throw ZLibError.invalidData
+        }
+        self.compressed = compressed
+        self.windowBits = index?.windowBits ?? windowBits
+        self.index = index
+        self.checkpointInterval = max(checkpointInterval, Self.stepSize)
+        self.maxCheckpoints = max(maxCheckpoints, 2)
+        knownCount = index?.uncompressedSize
+
+        stream = .allocate(capacity: 1)
+        stream.initialize(to: z_stream())
+        cache = .allocate(capacity: Self.stepSize)
+        let result = swift_inflateInit2(stream, self.windowBits.zlibWindowBits)
+        guard result == Z_OK else {
+            stream.deinitialize(count: 1)
+            stream.deallocate()
+            cache.deallocate()
+            throw ZLibError.decompressionFailed(result)
+        }
+    }
+
+    deinit {
+        checkpoints.removeAll()
+        swift_inflateEnd(stream)
+        stream.deinitialize(count: 1)
+        stream.deallocate()
+        cache.deallocate()
+    }
+
+    // MARK: Functions
+
+    /// The decompressed byte at `position`
+    /// - Throws: ZLibError.invalidData if `position` is outside the data, ZLibError if decoding fails
+    public subscript(position: Int) -> UInt8 {
+        get throws {
+            guard position >= 0, let byte = try bytes(in: position ..< position + 1).first else {
+                throw ZLibError.invalidData
+            }
+            return byte
+        }
+    }
+
+    /// The decompressed bytes in `range`; shorter than the range only at the end of the data
+    /// - Throws: ZLibError.invalidData for a negative bound, ZLibError if decoding fails
+    public subscript(range: Range<Int>) -> Data {
+        get throws {
+            try bytes(in: range)
+        }
+    }
+
+    /// Decompressed bytes in a range, inflating only as far as its end
+    /// - Parameter range: Uncompressed offsets to read
+    /// - Returns: The bytes; shorter than the range only at the end of the data
+    /// - Throws: ZLibError.invalidData for a negative bound, ZLibError if decoding fails
+    public func bytes(in range: Range<Int>) throws -> Data {
+        guard range.lowerBound >= 0 else {
+            throw ZLibError.invalidData
+        }
+        let upper = knownCount.map { min(range.upperBound, $0) } ?? range.upperBound
+        var result = Data()
+        var position = range.lowerBound
+        guard position < upper else {
+            return result
+        }
+        result.reserveCapacity(min(upper - position, Self.stepSize * 16))
+
+        while position < upper {
+            if position >= cacheStart, position < cacheStart + cacheCount {
+                let end = min(upper, cacheStart + cacheCount)
+                result.append(cache + (position - cacheStart), count: end - position)
+                position = end
+                continue
+            }
+            try seek(to: position)
+            if isAtEnd {
+                break
+            }
+            // Skip to `position` in whole steps, then decode only what the range still needs
+            let skip = position - outputOffset
+            try step(length: min(skip > 0 ? skip : upper - position, Self.stepSize))
+        }
+        return result
+    }
+
+    /// The first `maxLength` decompressed bytes, or all of them if there are fewer
+    /// - Throws: ZLibError if decoding fails
+    public func prefix(_ maxLength: Int) throws -> Data {
+        try bytes(in: 0 ..< max(maxLength, 0))
+    }
+
+    /// Decode to the end of the stream if needed and return the uncompressed size
+    /// - Throws: ZLibError if decoding fails
+    public func uncompressedCount() throws -> Int {
+        while knownCount == nil {
+            try seek(to: outputOffset)
+            try step(length: Self.stepSize)
+        }
+        return knownCount ?? outputOffset
+    }
+
+    // MARK: Private Functions
+
+    /// Place the stream at or before `position`, from the cheapest of the current position,
+    /// a checkpoint, an index access point and the start
+    private func seek(to position: Int) throws {
+        if position >= outputOffset {
+            if let index, index.checkpointOffset(before: position) > outputOffset + Self.stepSize {
+                try restart(from: index, at: position)
+            }
+            return
+        }
+
+        let checkpoint = checkpoints.last { $0.outputOffset <= position }
+        let indexPoint = index?.checkpointOffset(before: position) ?? -1
+        if let index, indexPoint > (checkpoint?.outputOffset ?? 0) {
+            try restart(from: index, at: position)
+        } else if let checkpoint {
+            try restore(checkpoint)
+        } else {
+            try restartFromBeginning()
+        }
+    }
+
+    private func restore(_ checkpoint: Checkpoint) throws {
+        swift_inflateEnd(stream)
+        let result = swift_inflateCopy(stream, checkpoint.stream)
+        guard result == Z_OK else {
+            // The stream was ended above; start over so the view stays usable
+            try reinitialize()
+            throw result == Z_MEM_ERROR ? ZLibError.memoryError : ZLibError.decompressionFailed(result)
+        }
+        moveTo(outputOffset: checkpoint.outputOffset, inputOffset: checkpoint.inputOffset)
+    }
+
+    private func restart(from index: GzipIndex, at position: Int) throws {
+        var resumeInput: Int64 = 0
+        let resumeOutput = compressed.withUnsafeBytes { bytes in
+            swift_zran_restart(
+                stream,
+                bytes.bindMemory(to: UInt8.self).baseAddress,
+                bytes.count,
+                index.pointer,
+                Int64(position),
+                &resumeInput
+            )
+        }
+        guard resumeOutput >= 0 else {
+            try reinitialize()
+            throw ZLibError.decompressionFailed(Int32(truncatingIfNeeded: resumeOutput))
+        }
+        moveTo(outputOffset: Int(resumeOutput), inputOffset: Int(resumeInput))
+    }
+
+    private func restartFromBeginning() throws {
+        let result = swift_inflateReset2(stream, windowBits.zlibWindowBits)
+        guard result == Z_OK else {
+            throw ZLibError.decompressionFailed(result)
+        }
+        moveTo(outputOffset: 0, inputOffset: 0)
+    }
+
+    private func reinitialize() throws {
+        swift_inflateEnd(stream)
+        stream.pointee = z_stream()
+        let result = swift_inflateInit2(stream, windowBits.zlibWindowBits)
+        moveTo(outputOffset: 0, inputOffset: 0)
+        guard result == Z_OK else {
+            throw ZLibError.decompressionFailed(result)
+        }
+    }
+
+    private func moveTo(outputOffset: Int, inputOffset: Int) {
+        self.outputOffset = outputOffset
+        self.inputOffset = inputOffset
+        runStart = outputOffset
+        isAtEnd = false
+    }
+
+    /// Inflate up to `length` bytes into the cache and advance
+    private func step(length: Int) throws {
+        cacheStart = outputOffset
+        cacheCount = 0
+        do {
+            try inflateStep(length: length)
+        } catch {
+            // The stream moved past `outputOffset`; drop what this step produced and start over
+            cacheCount = 0
+            try? reinitialize()
+            throw error
+        }
+        outputOffset += cacheCount
+        decodedBytes += cacheCount
+        compressedBytesRead = max(compressedBytesRead, inputOffset)
+        if isAtEnd {
+            knownCount = outputOffset
+        } else {
+            saveCheckpointIfDue()
+        }
+    }
+
+    private func inflateStep(length: Int) throws {
+        try compressed.withUnsafeBytes { bytes in
+            let base = bytes.bindMemory(to: Bytef.self).baseAddress
+            while cacheCount < length {
+                let available = min(bytes.count - inputOffset, Int(uInt.max))
+                stream.pointee.next_in = base.map { UnsafeMutablePointer(mutating: $0 + inputOffset) }
+                stream.pointee.avail_in = uInt(available)
+                stream.pointee.next_out = cache + cacheCount
+                stream.pointee.avail_out = uInt(length - cacheCount)
+
+                let status = swift_inflate(stream, Z_NO_FLUSH)
+                inputOffset += available - Int(stream.pointee.avail_in)
+                cacheCount = length - Int(stream.pointee.avail_out)
+                switch status {
+                    case Z_OK:
+                        continue
+                    case Z_STREAM_END:
+                        let next = inputOffset
+                        if allowsConcatenatedMembers, next + 1 < bytes.count, bytes[next] == 0x1F, bytes[next + 1] == 0x8B {
+                            let resetResult = swift_inflateReset(stream)
+                            guard resetResult == Z_OK else {
+                                throw ZLibError.decompressionFailed(resetResult)
+                            }
+                            continue
+                        }
+                        isAtEnd = true
+                        return
+                    case Z_NEED_DICT:
+                        throw ZLibError.needDictionary
+                    case Z_BUF_ERROR where inputOffset >= bytes.count:
+                        // The blob ended before the compressed stream did
+                        throw ZLibError.decompressionFailed(Z_DATA_ERROR)
+                    default:
+                        throw ZLibError.decompressionFailed(status)
+                }
+            }
+        }
+    }
+
+    private func saveCheckpointIfDue() {
+        // A run restarted at an index access point is as cheap to repeat as a checkpoint
+        let previous = max(checkpoints.last { $0.outputOffset <= outputOffset }?.outputOffset ?? 0, runStart)
+        guard outputOffset - previous >= checkpointInterval,
+              let checkpoint = Checkpoint(copying: stream, outputOffset: outputOffset, inputOffset: inputOffset)
+        else {
+            return
+        }
+        let insertion = checkpoints.firstIndex { $0.outputOffset > outputOffset } ?? checkpoints.endIndex
+        checkpoints.insert(checkpoint, at: insertion)
+
+        if checkpoints.count > maxCheckpoints {
+            // Keep every other checkpoint, so they stay evenly spread over what has been read
+            checkpoints = checkpoints.enumerated().filter { $0.offset % 2 == 1 }.map(\.element)
+            checkpointInterval *= 2
+        }
+    }
+}
@@ -0,0 +1,236 @@
+//
+//  ParallelCompressor.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+/// Block-parallel deflate engine (pigz-style).
+///
+/// The input is split into independent blocks that are deflated concurrently as raw
+/// deflate streams. Every block except the first is primed with the last 32 KB of the
+/// previous block via `deflateSetDictionary`, so matches keep reaching across block
+/// boundaries. Non-final blocks end with a sync flush, which byte-aligns them, and the
+/// blocks are concatenated behind a zlib or gzip header. The trailer checksum is built
+/// from per-block checksums with `crc32_combine`/`adler32_combine`, so the result is a
+/// single ordinary stream that any inflater can read.
+public final class ParallelCompressor {
+    // MARK: Static Properties
+
+    /// Default block size (128 KB, same as pigz)
+    public static let defaultBlockSize = 128 * 1024
+
+    /// Size of the deflate window used to prime each block
+    static let dictionarySize = 32 * 1024
+
+    // MARK: Properties
+
+    public let level: CompressionLevel
+    public let windowBits: WindowBits
+    public let blockSize: Int
+    public let threadCount: Int
+    /// Store blocks that look incompressible (see `Compressor.skipsIncompressible`). Off by
+    /// default: a block primed with its predecessor can match repeats the entropy sample misses.
+    public let skipsIncompressible: Bool
+
+    // MARK: Lifecycle
+
+    /// Create a parallel compressor
+    /// - Parameters:
+    ///   - level: Compression level
+    ///   - windowBits: Output format (`.deflate`, `.gzip` or `.raw`)
+    ///   - blockSize: Uncompressed bytes per block (default: 128 KB)
+    ///   - threadCount: Number of blocks compressed concurrently (default: active CPU count)
+    ///   - skipsIncompressible: Store blocks that look incompressible (default: false)
+    public init(
+        level: CompressionLevel = .defaultCompression,
+        windowBits: WindowBits = .deflate,
+        blockSize: Int = ParallelCompressor.defaultBlockSize,
+        threadCount: Int = ProcessInfo.processInfo.activeProcessorCount,
+        skipsIncompressible: Bool = false
+    ) {
+        self.level = level
+        self.windowBits = windowBits
+        self.blockSize = max(blockSize, 1)
+        self.threadCount = max(threadCount, 1)
+        self.skipsIncompressible = skipsIncompressible
+    }
+
+    // MARK: Functions
+
+    /// Compress data in memory using parallel blocks
+    /// - Parameter data: Data to compress
+    /// - Returns: Compressed data in the configured format
+    /// - Throws: ZLibError if compression fails
+    public func compress(_ data: Data) throws -> Data {
+        var output = Data()
+        var offset = data.startIndex
+        try compress(
+            reader: { maxLength in
+                let end = data.index(offset, offsetBy: min(maxLength, data.endIndex - offset))
+                let chunk = data[offset ..< end]
+                offset = end
+                return Data(chunk)
+            },
+            writer: { output.append($0) }
+        )
+        return output
+    }
+
+    /// Compress a stream of input using parallel blocks
+    /// - Parameters:
+    ///   - reader: Returns up to the requested number of bytes; a short (or empty) read marks the end of input
+    ///   - writer: Receives compressed output in stream order
+    ///   - progress: Optional callback receiving the number of input bytes consumed so far
+    /// - Throws: ZLibError if compression fails, or any error thrown by `reader`/`writer`
+    public func compress(
+        reader: (Int) throws -> Data,
+        writer: (Data) throws -> Void,
+        progress: ((Int) -> Void)? = nil
+    ) throws {
+        guard windowBits != .auto else {
+            throw ZLibError.invalidData
+        }
+
+        zlibInfo("Parallel compression: blockSize=\(blockSize), threads=\(threadCount), level=\(level)")
+        try writer(header())
+
+        var checksum: uLong = windowBits == .gzip ? 0 : 1
+        var totalLength = 0
+        var history = Data()
+        var pendingBlock: Data? = try readBlock(reader)
+        var finished = false
+
+        while !finished {
+            // Gather one batch of blocks; read one block ahead so the last block is known
+            var batch: [Data] = []
+            while batch.count < threadCount, let block = pendingBlock {
+                batch.append(block)
+                pendingBlock = block.count < blockSize ? nil : try readBlock(reader)
+                if pendingBlock?.isEmpty == true { pendingBlock = nil }
+            }
+            finished = pendingBlock == nil
+
+            var dictionaries: [Data] = []
+            dictionaries.reserveCapacity(batch.count)
+            for block in batch {
+                dictionaries.append(history)
+                history = Data(block.suffix(Self.dictionarySize))
+            }
+
+            let results = try compressBatch(batch, dictionaries: dictionaries, finalIndex: finished ? batch.count - 1 : nil)
+            for (block, result) in zip(batch, results) {
+                try writer(result.compressed)
+                checksum = combine(checksum, result.checksum, length: block.count)
+                totalLength += block.count
+            }
+            progress?(totalLength)
+        }
+
+        try writer(trailer(checksum: checksum, totalLength: totalLength))
+        zlibInfo("Parallel compression completed: \(totalLength) bytes")
+    }
+
+    // MARK: Private Functions
+
+    private func readBlock(_ reader: (Int) throws -> Data) throws -> Data {
+        var block = try reader(blockSize)
+        // Readers may return short chunks before end of input; top up to a full block
+        while block.count > 0, block.count < blockSize {
+            let more = try reader(blockSize - block.count)
+            if more.isEmpty { break }
+            block.append(more)
+        }
+        return block
+    }
+
+    private func compressBatch(_ batch: [Data], dictionaries: [Data], finalIndex: Int?) throws -> [BlockResult] {
+        var results = [Result<BlockResult, Error>?](repeating: nil, count: batch.count)
+        results.withUnsafeMutableBufferPointer { buffer in
+            let slots = buffer
+            DispatchQueue.concurrentPerform(iterations: batch.count) { index in
+                slots[index] = Result {
+                    try self.compressBlock(batch[index], dictionary: dictionaries[index], isLast: index == finalIndex)
+                }
+            }
+        }
+        return try results.map { try $0!.get() }
+    }
+
+    private func compressBlock(_ block: Data, dictionary: Data, isLast: Bool) throws -> BlockResult {
+        let compressor = Compressor()
+        compressor.skipsIncompressible = skipsIncompressible
+        try compressor.initializeAdvanced(level: level, windowBits: .raw)
+        if !dictionary.isEmpty {
+            try compressor.setDictionary(dictionary)
+        }
+        // Sync flush ends the block on a byte boundary so blocks can be concatenated
+        let compressed = try compressor.compress(block, flush: isLast ? .finish : .syncFlush)
+        return BlockResult(compressed: compressed, checksum: blockChecksum(block))
+    }
+
+    private func blockChecksum(_ block: Data) -> uLong {
+        let isGzip = windowBits == .gzip
+        guard !block.isEmpty else { return isGzip ? 0 : 1 }
+        return isGzip ? ZLib.crc32(block) : ZLib.adler32(block)
+    }
+
+    private func combine(_ running: uLong, _ next: uLong, length: Int) -> uLong {
+        guard length > 0 else { return running }
+        switch windowBits {
+            case .gzip:
+                return ZLib.crc32Combine(running, next, len2: length)
+            default:
+                return ZLib.adler32Combine(running, next, len2: length)
+        }
+    }
+
+    private func header() -> Data {
+        switch windowBits {
+            case .gzip:
+                // ID1 ID2 CM FLG MTIME(4) XFL OS
+                let xfl: UInt8 = level == .bestCompression ? 2 : (level == .bestSpeed ? 4 : 0)
+                return Data([0x1F, 0x8B, 0x08, 0x00, 0, 0, 0, 0, xfl, 0x03])
+            case .deflate:
+                // CMF: deflate with 32K window; FLG carries FLEVEL and FCHECK as deflate.c does
+                let cmf: UInt16 = 0x78
+                let levelFlags: UInt16
+                switch level {
+                    case .noCompression, .bestSpeed: levelFlags = 0
+                    case .defaultCompression: levelFlags = 2
+                    case .bestCompression: levelFlags = 3
+                }
+                var flg = levelFlags << 6
+                flg += 31 - ((cmf << 8) + flg) % 31
+                return Data([UInt8(cmf), UInt8(flg)])
+            default:
+                return Data()
+        }
+    }
+
+    private func trailer(checksum: uLong, totalLength: Int) -> Data {
+        let value = UInt32(truncatingIfNeeded: checksum)
+        switch windowBits {
+            case .gzip:
+                let size = UInt32(truncatingIfNeeded: totalLength)
+                return Data([
+                    UInt8(value & 0xFF), UInt8((value >> 8) & 0xFF), UInt8((value >> 16) & 0xFF), UInt8(value >> 24),
+                    UInt8(size & 0xFF), UInt8((size >> 8) & 0xFF), UInt8((size >> 16) & 0xFF), UInt8(size >> 24),
+                ])
+            case .deflate:
+                return Data([UInt8(value >> 24), UInt8((value >> 16) & 0xFF), UInt8((value >> 8) & 0xFF), UInt8(value & 0xFF)])
+            default:
+                return Data()
+        }
+    }
+}
+
+// MARK: - BlockResult
+
+private struct BlockResult {
+    let compressed: Data
+    let checksum: uLong
+}
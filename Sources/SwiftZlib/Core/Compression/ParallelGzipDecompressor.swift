@@ -0,0 +1,329 @@
+//
+//  ParallelGzipDecompressor.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+/// Multi-core decoder for multi-member gzip input
+///
+/// Concatenated gzip files, and archives written as independent members, can be decoded
+/// member by member on separate threads. Where a member ends is only known after inflating it,
+/// so the decoder scans ahead for byte sequences that look like gzip headers and inflates each
+/// candidate speculatively on a worker. The results are then chained from the start of the input:
+/// a member is accepted only if it starts where the previous one ended. Candidates that were
+/// really compressed bytes fail or are never reached, and are discarded. Every accepted member
+/// has passed zlib's CRC-32 and ISIZE trailer checks. Output is written strictly in input order.
+///
+/// Up to `maxMembersInFlight` decoded members are held in memory at once, each at most
+/// `maxBufferedMemberSize` bytes. A member that outgrows that, or `maxBufferedExpansionRatio`,
+/// is abandoned and inflated again on the calling thread straight into the writer, as is a member
+/// with no further header candidates after it, such as the only member of an ordinary file.
+/// Memory use therefore stays bounded whatever the input's size or compression ratio.
+public final class ParallelGzipDecompressor {
+    // MARK: Nested Types
+
+    /// A verified member and the input offset just past its trailer
+    private struct Member {
+        let output: Data
+        let end: Int
+    }
+
+    // MARK: Static Properties
+
+    /// Smallest possible member: 10-byte header, empty final block, 8-byte trailer
+    static let minimumMemberSize = 20
+
+    /// Output produced per inflate call, and the size of each chunk a streamed member is written in
+    private static let outputChunkSize = 64 * 1024
+
+    // MARK: Properties
+
+    public let threadCount: Int
+
+    /// Maximum number of members decoded ahead of the writer
+    public let maxMembersInFlight: Int
+
+    /// Largest member output held in memory; bigger members are streamed on the calling thread
+    public let maxBufferedMemberSize: Int
+
+    /// Most output per compressed byte a member may reach while buffered; denser members are streamed
+    public let maxBufferedExpansionRatio: Double
+
+    // MARK: Lifecycle
+
+    /// Create a parallel gzip decompressor
+    /// - Parameters:
+    ///   - threadCount: Number of members inflated concurrently (default: active CPU count)
+    ///   - maxMembersInFlight: Members decoded ahead of the writer (default: twice `threadCount`)
+    ///   - maxBufferedMemberSize: Largest member output decoded ahead (default: 4 MB)
+    ///   - maxBufferedExpansionRatio: Most output per compressed byte decoded ahead (default: 64)
+    public init(
+        threadCount: Int = ProcessInfo.processInfo.activeProcessorCount,
+        maxMembersInFlight: Int? = nil,
+        maxBufferedMemberSize: Int = 4 * 1024 * 1024,
+        maxBufferedExpansionRatio: Double = 64
+    ) {
+        self.threadCount = max(threadCount, 1)
+        self.maxMembersInFlight = max(maxMembersInFlight ?? self.threadCount * 2, 1)
+        self.maxBufferedMemberSize = max(maxBufferedMemberSize, 0)
+        self.maxBufferedExpansionRatio = max(maxBufferedExpansionRatio, 0)
+    }
+
+    // MARK: Static Functions
+
+    /// Whether a gzip member header (deflate method, no reserved flags) starts at an offset
+    static func isMemberHeader(_ input: UnsafeRawBufferPointer, at offset: Int) -> Bool {
+        offset >= 0 && offset + minimumMemberSize <= input.count
+            && input[offset] == 0x1F && input[offset + 1] == 0x8B && input[offset + 2] == 0x08
+            && input[offset + 3] & 0xE0 == 0
+    }
+
+    /// Whether anything after the member at `offset` looks like another member header
+    ///
+    /// When nothing does, the input is a single member that only `ParallelInflater` could split.
+    public static func hasMemberCandidate(_ input: UnsafeRawBufferPointer, after offset: Int) -> Bool {
+        !memberCandidates(in: input, after: offset, limit: 1) { _ in true }.isEmpty
+    }
+
+    /// Offsets after `offset` that look like member headers, in input order
+    private static func memberCandidates(
+        in input: UnsafeRawBufferPointer,
+        after offset: Int,
+        limit: Int,
+        where isWanted: (Int) -> Bool
+    ) -> [Int] {
+        guard let base = input.baseAddress else { return [] }
+        var candidates: [Int] = []
+        var next = offset + 1
+        let lastStart = input.count - minimumMemberSize
+        while candidates.count < limit, next <= lastStart {
+            guard let hit = memchr(base + next, 0x1F, lastStart - next + 1) else { break }
+            let candidate = base.distance(to: UnsafeRawPointer(hit))
+            if isWanted(candidate), isMemberHeader(input, at: candidate) {
+                candidates.append(candidate)
+            }
+            next = candidate + 1
+        }
+        return candidates
+    }
+
+    // MARK: Functions
+
+    /// Decompress multi-member gzip data in memory
+    /// - Parameter data: One or more concatenated gzip members
+    /// - Returns: Concatenated output of all members
+    /// - Throws: ZLibError if a member is corrupt or truncated
+    public func decompress(_ data: Data) throws -> Data {
+        var output = Data()
+        try data.withUnsafeBytes { bytes in
+            _ = try decompress(bytes) { output.append($0) }
+        }
+        return output
+    }
+
+    /// Decompress a multi-member gzip file to another file
+    /// - Parameters:
+    ///   - sourcePath: Gzip file to read; it is memory-mapped
+    ///   - destinationPath: File receiving the decompressed output
+    /// - Returns: Number of members decoded
+    /// - Throws: ZLibError if the data is invalid or a file cannot be accessed
+    @discardableResult
+    public func decompressFile(from sourcePath: String, to destinationPath: String) throws -> Int {
+        let source = try MappedFile(path: sourcePath)
+        guard FileManager.default.createFile(atPath: destinationPath, contents: nil) else {
+            throw ZLibError.fileError(NSError(domain: NSCocoaErrorDomain, code: NSFileWriteUnknownError, userInfo: [
+                NSLocalizedDescriptionKey: "Failed to create destination file at \(destinationPath)",
+            ]))
+        }
+        let output: FileHandle
+        do {
+            output = try FileHandle(forWritingTo: URL(fileURLWithPath: destinationPath))
+        } catch {
+            throw ZLibError.fileError(error)
+        }
+        defer { try? output.close() }
+
+        return try decompress(source.bytes) { chunk in
+            do {
+                try output.write(contentsOf: chunk)
+            } catch {
+                throw ZLibError.fileError(error)
+            }
+        }
+    }
+
+    /// Decompress multi-member gzip input, delivering each member's output in order
+    ///
+    /// Bytes after the last member that do not start a gzip header are ignored, as `gzread` does.
+    /// - Parameters:
+    ///   - input: One or more concatenated gzip members
+    ///   - writer: Receives the output of each member, in input order; streamed members arrive in several pieces
+    /// - Returns: Number of members decoded
+    /// - Throws: ZLibError if a member is corrupt or truncated, or any error thrown by `writer`
+    @discardableResult
+    public func decompress(_ input: UnsafeRawBufferPointer, writer: (Data) throws -> Void) throws -> Int {
+        var position = 0
+        var members = 0
+        var decoded: [Int: Result<Member, Error>] = [:]
+
+        while position < input.count {
+            if decoded[position] == nil {
+                guard Self.isMemberHeader(input, at: position) else {
+                    guard members > 0 else {
+                        throw ZLibError.decompressionFailed(Z_DATA_ERROR)
+                    }
+                    zlibWarning("Ignoring \(input.count - position) bytes after the last gzip member")
+                    break
+                }
+                decoded = decoded.filter { $0.key > position }
+                let candidates = Self.memberCandidates(in: input, after: position, limit: maxMembersInFlight - 1) {
+                    decoded[$0] == nil
+                }
+                if candidates.isEmpty {
+                    // Nothing new to decode alongside it, so buffering the member would gain nothing
+                    position = try streamMember(input, at: position, writer: writer)
+                    members += 1
+                    continue
+                }
+                decodeAhead([position] + candidates, in: input, into: &decoded)
+            }
+
+            let member: Member
+            do {
+                member = try decoded.removeValue(forKey: position)!.get()
+            } catch ZLibError.outputLimitExceeded {
+                // Too large to hold; inflate it again straight into the writer
+                position = try streamMember(input, at: position, writer: writer)
+                members += 1
+                continue
+            }
+            if !member.output.isEmpty {
+                try writer(member.output)
+            }
+            members += 1
+            position = member.end
+        }
+        zlibInfo("Parallel gzip decompression: \(members) member(s), \(input.count) bytes")
+        return members
+    }
+
+    // MARK: Private Functions
+
+    /// Inflate the candidates concurrently, each into memory up to the buffering limits
+    private func decodeAhead(_ candidates: [Int], in input: UnsafeRawBufferPointer, into decoded: inout [Int: Result<Member, Error>]) {
+        let maxOutputSize = maxBufferedMemberSize
+        let maxExpansionRatio = maxBufferedExpansionRatio
+        var results = [Result<Member, Error>?](repeating: nil, count: candidates.count)
+        results.withUnsafeMutableBufferPointer { buffer in
+            let slots = buffer
+            let workers = min(threadCount, candidates.count)
+            DispatchQueue.concurrentPerform(iterations: workers) { worker in
+                for index in stride(from: worker, to: candidates.count, by: workers) {
+                    slots[index] = Result {
+                        var output = Data()
+                        let end = try Self.inflateMember(
+                            input,
+                            at: candidates[index],
+                            maxOutputSize: maxOutputSize,
+                            maxExpansionRatio: maxExpansionRatio
+                        ) { chunk in
+                            output.append(chunk.baseAddress!.assumingMemoryBound(to: UInt8.self), count: chunk.count)
+                        }
+                        return Member(output: output, end: end)
+                    }
+                }
+            }
+        }
+        for (candidate, result) in zip(candidates, results) {
+            decoded[candidate] = result
+        }
+    }
+
+    /// Inflate the member at `offset` on the calling thread, writing its output as it is produced
+    /// - Returns: The input offset just past the member's trailer
+    private func streamMember(_ input: UnsafeRawBufferPointer, at offset: Int, writer: (Data) throws -> Void) throws -> Int {
+        try Self.inflateMember(input, at: offset, maxOutputSize: nil, maxExpansionRatio: nil) { chunk in
+            try writer(Data(bytes: chunk.baseAddress!, count: chunk.count))
+        }
+    }
+
+    /// Inflate one gzip member, verifying its trailer
+    /// - Parameters:
+    ///   - maxOutputSize: Output bound; past it the member is abandoned with `ZLibError.outputLimitExceeded`
+    ///   - maxExpansionRatio: Output bound per compressed byte consumed so far, enforced the same way
+    ///   - sink: Receives the output in pieces of at most `outputChunkSize` bytes
+    /// - Returns: The input offset just past the member's trailer
+    private static func inflateMember(
+        _ input: UnsafeRawBufferPointer,
+        at offset: Int,
+        maxOutputSize: Int?,
+        maxExpansionRatio: Double?,
+        sink: (UnsafeRawBufferPointer) throws -> Void
+    ) throws -> Int {
+        let stream = UnsafeMutablePointer<z_stream>.allocate(capacity: 1)
+        stream.initialize(to: z_stream())
+        defer {
+            stream.deinitialize(count: 1)
+            stream.deallocate()
+        }
+
+        let result = swift_inflateInit2(stream, WindowBits.gzip.zlibWindowBits)
+        guard result == Z_OK else {
+            throw ZLibError.decompressionFailed(result)
+        }
+        defer { swift_inflateEnd(stream) }
+
+        let buffer = UnsafeMutableRawPointer.allocate(byteCount: outputChunkSize, alignment: 1)
+        defer { buffer.deallocate() }
+
+        let source = input.baseAddress! + offset
+        let available = input.count - offset
+        var fed = 0
+        var produced = 0
+        var status: Int32 = Z_OK
+        repeat {
+            if stream.pointee.avail_in == 0, fed < available {
+                let chunk = min(available - fed, Int(uInt.max))
+                stream.pointee.next_in = UnsafeMutablePointer(mutating: (source + fed).assumingMemoryBound(to: Bytef.self))
+                stream.pointee.avail_in = uInt(chunk)
+                fed += chunk
+            }
+            stream.pointee.next_out = buffer.assumingMemoryBound(to: Bytef.self)
+            stream.pointee.avail_out = uInt(outputChunkSize)
+
+            status = swift_inflate(stream, Z_NO_FLUSH)
+            let count = outputChunkSize - Int(stream.pointee.avail_out)
+            produced += count
+
+            switch status {
+                case Z_OK, Z_STREAM_END:
+                    break
+                case Z_BUF_ERROR where stream.pointee.avail_in == 0 && fed == available:
+                    // The input ended inside the member
+                    throw ZLibError.decompressionFailed(Z_DATA_ERROR)
+                case Z_BUF_ERROR:
+                    break
+                default:
+                    throw ZLibError.decompressionFailed(status)
+            }
+
+            let consumed = fed - Int(stream.pointee.avail_in)
+            if let limit = DecompressionOptions.outputLimit(
+                maxOutputSize: maxOutputSize,
+                maxExpansionRatio: maxExpansionRatio,
+                inputSize: consumed
+            ), produced > limit {
+                throw ZLibError.outputLimitExceeded(limit: limit)
+            }
+            if count > 0 {
+                try sink(UnsafeRawBufferPointer(start: buffer, count: count))
+            }
+        } while status != Z_STREAM_END
+
+        return offset + fed - Int(stream.pointee.avail_in)
+    }
+}
@@ -0,0 +1,242 @@
+//
+//  ParallelInflater.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+/// Multi-core decoder for a single large deflate, zlib or gzip stream
+///
+/// Every deflate block may refer back into the previous 32 KB of output, so a stream normally
+/// decodes on one thread from its start. Following pugz and rapidgzip, this engine cuts the
+/// compressed input into chunks. A worker per chunk searches forward from the chunk's offset for
+/// a bit position where a dynamic Huffman block decodes, then decodes from there with the
+/// preceding window unresolved: back-references into it are kept as markers. A chunk is accepted
+/// only if it starts exactly where the previous chunk ended; otherwise the previous chunk decodes
+/// across it. Once each window is known the markers are patched and the chunk checksums computed,
+/// again in parallel. A round of chunks that cannot be completed this way is redone with plain
+/// zlib from the last known block boundary, so output and errors match `Decompressor`, and the
+/// gzip CRC-32 and ISIZE or zlib Adler-32 trailer is verified for every stream.
+///
+/// Speculation costs about twice the CPU time of serial inflate, so the engine pays off for large
+/// inputs (see `recommendedMinimumInputSize`) on several cores. Output is delivered in order, one
+/// round of `threadCount` chunks at a time, which bounds memory use.
+public final class ParallelInflater {
+    // MARK: Static Properties
+
+    /// Compressed size from which parallel decoding is worth its overhead
+    public static let recommendedMinimumInputSize = 100 * 1024 * 1024
+
+    /// Default compressed bytes per chunk
+    public static let defaultChunkSize = 1024 * 1024
+
+    /// Smallest accepted chunk size
+    static let minimumChunkSize = 64 * 1024
+
+    /// Output decoded speculatively per chunk, as a multiple of `chunkSize`; more
+    /// compressible rounds are decoded serially
+    static let maxChunkExpansion = 32
+
+    /// Stream modes understood by the C engine
+    private static let rawMode: Int32 = 0
+    private static let zlibMode: Int32 = 1
+    private static let gzipMode: Int32 = 2
+
+    // MARK: Properties
+
+    /// Stream format; `.auto` accepts zlib and gzip
+    public let windowBits: WindowBits
+    public let threadCount: Int
+    /// Compressed bytes handed to each worker per round
+    public let chunkSize: Int
+
+    // MARK: Lifecycle
+
+    /// Create a parallel inflater
+    /// - Parameters:
+    ///   - windowBits: Stream format (default: gzip)
+    ///   - threadCount: Chunks decoded concurrently (default: active CPU count)
+    ///   - chunkSize: Compressed bytes per chunk, at least 64 KB
+    public init(
+        windowBits: WindowBits = .gzip,
+        threadCount: Int = ProcessInfo.processInfo.activeProcessorCount,
+        chunkSize: Int = defaultChunkSize
+    ) {
+        self.windowBits = windowBits
+        self.threadCount = max(threadCount, 1)
+        self.chunkSize = max(chunkSize, Self.minimumChunkSize)
+    }
+
+    // MARK: Functions
+
+    /// Decompress a stream in memory
+    /// - Parameter data: Compressed stream
+    /// - Returns: Decompressed data
+    /// - Throws: ZLibError if the stream is corrupt or truncated
+    public func decompress(_ data: Data) throws -> Data {
+        var output = Data()
+        try data.withUnsafeBytes { bytes in
+            _ = try decompress(bytes) { output.append($0) }
+        }
+        return output
+    }
+
+    /// Decompress a file to another file
+    /// - Parameters:
+    ///   - sourcePath: Compressed file to read; it is memory-mapped
+    ///   - destinationPath: File receiving the decompressed output
+    /// - Returns: Number of decompressed bytes written
+    /// - Throws: ZLibError if the data is invalid or a file cannot be accessed
+    @discardableResult
+    public func decompressFile(from sourcePath: String, to destinationPath: String) throws -> Int {
+        let source = try MappedFile(path: sourcePath)
+        guard FileManager.default.createFile(atPath: destinationPath, contents: nil) else {
+            throw ZLibError.fileError(NSError(domain: NSCocoaErrorDomain, code: NSFileWriteUnknownError, userInfo: [
+                NSLocalizedDescriptionKey: "Failed to create destination file at \(destinationPath)",
+            ]))
+        }
+        let output: FileHandle
+        do {
+            output = try FileHandle(forWritingTo: URL(fileURLWithPath: destinationPath))
+        } catch {
+            throw ZLibError.fileError(error)
+        }
+        defer { try? output.close() }
+
+        return try decompress(source.bytes) { chunk in
+            do {
+                try output.write(contentsOf: chunk)
+            } catch {
+                throw ZLibError.fileError(error)
+            }
+        }
+    }
+
+    /// Decompress a stream, delivering output in order
+    ///
+    /// Gzip input may hold several members; each is decoded in turn. When a member shorter than
+    /// one round is followed by more members, the rest is decoded member-parallel with
+    /// `ParallelGzipDecompressor`. Bytes after the last member that do not start a gzip header
+    /// are ignored, as `gzread` does.
+    /// - Parameters:
+    ///   - input: Compressed stream
+    ///   - writer: Receives decompressed output, in order
+    /// - Returns: Number of decompressed bytes delivered
+    /// - Throws: ZLibError if the stream is corrupt or truncated, or any error thrown by `writer`
+    @discardableResult
+    public func decompress(_ input: UnsafeRawBufferPointer, writer: (Data) throws -> Void) throws -> Int {
+        let mode = streamMode(of: input)
+        var produced = 0
+        func deliver(_ chunk: Data) throws {
+            produced += chunk.count
+            try writer(chunk)
+        }
+
+        var position = 0
+        repeat {
+            let length = try inflateStream(UnsafeRawBufferPointer(rebasing: input[position...]), mode: mode, writer: deliver)
+            position += length
+            if mode == Self.gzipMode, length < chunkSize * threadCount, ParallelGzipDecompressor.isMemberHeader(input, at: position) {
+                // Many small members decode faster one member per thread
+                try ParallelGzipDecompressor(threadCount: threadCount).decompress(
+                    UnsafeRawBufferPointer(rebasing: input[position...]),
+                    writer: deliver
+                )
+                position = input.count
+            }
+        } while mode == Self.gzipMode && ParallelGzipDecompressor.isMemberHeader(input, at: position)
+
+        if position < input.count {
+            zlibWarning("Ignoring \(input.count - position) bytes after the compressed stream")
+        }
+        return produced
+    }
+
+    // MARK: Private Functions
+
+    /// Engine mode for the configured format
+    private func streamMode(of input: UnsafeRawBufferPointer) -> Int32 {
+        switch windowBits {
+            case .raw:
+                return Self.rawMode
+            case .deflate:
+                return Self.zlibMode
+            case .gzip:
+                return Self.gzipMode
+            case .auto:
+                return input.count >= 2 && input[0] == 0x1F && input[1] == 0x8B ? Self.gzipMode : Self.zlibMode
+        }
+    }
+
+    /// Decode one stream round by round, returning the input bytes it spans including its trailer
+    private func inflateStream(_ input: UnsafeRawBufferPointer, mode: Int32, writer: (Data) throws -> Void) throws -> Int {
+        var status: Int32 = Z_OK
+        guard let engine = swift_pinflate_create(
+            input.baseAddress?.assumingMemoryBound(to: UInt8.self),
+            input.count,
+            mode,
+            chunkSize,
+            Int32(clamping: threadCount),
+            chunkSize * Self.maxChunkExpansion,
+            &status
+        ) else {
+            throw status == Z_MEM_ERROR ? ZLibError.memoryError : ZLibError.decompressionFailed(status)
+        }
+        defer { swift_pinflate_free(engine) }
+
+        while true {
+            let count = Int(swift_pinflate_begin_round(engine))
+            guard count > 0 else { break }
+            DispatchQueue.concurrentPerform(iterations: count) { index in
+                swift_pinflate_decode_chunk(engine, Int32(index))
+            }
+
+            var accepted = Int(swift_pinflate_stitch(engine))
+            if accepted > 0 {
+                var statuses = [Int32](repeating: Z_OK, count: accepted)
+                statuses.withUnsafeMutableBufferPointer { buffer in
+                    let slots = buffer
+                    DispatchQueue.concurrentPerform(iterations: slots.count) { index in
+                        slots[index] = swift_pinflate_resolve_chunk(engine, Int32(index))
+                    }
+                }
+                if statuses.contains(where: { $0 != Z_OK }) {
+                    accepted = 0
+                }
+            }
+            if accepted <= 0 {
+                zlibDebug("Speculative round could not be completed; decoding it serially")
+                let result = swift_pinflate_serial_round(engine)
+                guard result == Z_OK else {
+                    throw result == Z_MEM_ERROR ? ZLibError.memoryError : ZLibError.decompressionFailed(result)
+                }
+                accepted = 1
+            }
+
+            for index in 0 ..< accepted {
+                var length = 0
+                guard let bytes = swift_pinflate_take_output(engine, Int32(index), &length) else {
+                    continue
+                }
+                if length > 0 {
+                    try writer(Data(bytesNoCopy: bytes, count: length, deallocator: .free))
+                } else {
+                    free(bytes)
+                }
+            }
+            if swift_pinflate_end_round(engine) != 0 {
+                break
+            }
+        }
+
+        let end = swift_pinflate_finish(engine)
+        guard end >= 0 else {
+            throw ZLibError.decompressionFailed(Int32(truncatingIfNeeded: end))
+        }
+        zlibInfo("Parallel inflate: \(end) bytes, \(swift_pinflate_speculative_chunks(engine)) speculative chunk(s), \(swift_pinflate_serial_rounds(engine)) serial round(s)")
+        return Int(end)
+    }
+}
@@ -0,0 +1,203 @@
+//
+//  PreparedDictionary.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+/// Preset dictionary with a cached, already hashed deflate state
+///
+/// `deflateSetDictionary` copies the dictionary into the window and inserts every position into
+/// the hash chains, which for a 32 KB dictionary costs more than compressing a small message.
+/// A prepared dictionary does that work once, in a template stream that is never used for
+/// compression. New streams start from a `deflateCopy` of the template, so they begin with the
+/// dictionary loaded and hashed. The template is only ever read, so one instance can be shared
+/// by any number of threads.
+///
+/// Preset dictionaries are supported for the zlib and raw deflate formats only.
+public final class PreparedDictionary: @unchecked Sendable {
+    // MARK: Properties
+
+    /// Dictionary bytes; decompressors need the same bytes
+    public let dictionary: Data
+
+    public let level: CompressionLevel
+    public let windowBits: WindowBits
+    public let memoryLevel: MemoryLevel
+    public let strategy: CompressionStrategy
+
+    /// Adler-32 of the dictionary, as stored in the DICTID field of zlib headers
+    public let dictionaryID: UInt32
+
+    /// Deflate state right after `deflateSetDictionary`; only ever read by `deflateCopy`
+    private let template: UnsafeMutablePointer<z_stream>
+
+    // MARK: Lifecycle
+
+    /// Hash a dictionary once for reuse by many streams
+    /// - Parameters:
+    ///   - dictionary: Dictionary bytes, e.g. from `DictionaryTrainer`; only the last 32 KB are used
+    ///   - level: Compression level (default: .defaultCompression)
+    ///   - windowBits: `.deflate` or `.raw` (default: .deflate)
+    ///   - memoryLevel: Memory level (default: .maximum)
+    ///   - strategy: Compression strategy (default: .defaultStrategy)
+    /// - Throws: ZLibError if the format does not support dictionaries or zlib rejects the dictionary
+    public init(
+        _ dictionary: Data,
+        level: CompressionLevel = .defaultCompression,
+        windowBits: WindowBits = .deflate,
+        memoryLevel: MemoryLevel = .maximum,
+        strategy: CompressionStrategy = .defaultStrategy
+    ) throws {
+        guard windowBits == .deflate || windowBits == .raw, !dictionary.isEmpty else {
+            throw ZLibError.streamError(Z_STREAM_ERROR)
+        }
+        template = try Self.makeTemplate(
+            dictionary: dictionary,
+            level: level,
+            windowBits: windowBits,
+            memoryLevel: memoryLevel,
+            strategy: strategy
+        )
+        self.dictionary = dictionary
+        self.level = level
+        self.windowBits = windowBits
+        self.memoryLevel = memoryLevel
+        self.strategy = strategy
+        dictionaryID = UInt32(truncatingIfNeeded: ZLib.adler32(dictionary))
+    }
+
+    deinit {
+        swift_deflateEnd(template)
+        template.deinitialize(count: 1)
+        template.deallocate()
+    }
+
+    // MARK: Functions
+
+    /// Create a compressor that starts with this dictionary loaded
+    /// - Returns: An initialized compressor at the start of a new stream
+    /// - Throws: ZLibError if the state cannot be copied
+    public func makeCompressor() throws -> Compressor {
+        let compressor = Compressor()
+        try compressor.initialize(with: self)
+        return compressor
+    }
+
+    /// Create a decompressor for streams compressed with this dictionary
+    ///
+    /// Raw streams get the dictionary immediately. For zlib streams pass `dictionary` to
+    /// `Decompressor.decompress(_:flush:dictionary:expectedSize:)`, which supplies it when the
+    /// header asks for it.
+    /// - Returns: An initialized decompressor
+    /// - Throws: ZLibError if initialization fails
+    public func makeDecompressor() throws -> Decompressor {
+        let decompressor = Decompressor()
+        try decompressor.initializeAdvanced(windowBits: windowBits)
+        if windowBits == .raw {
+            try decompressor.setDictionary(dictionary)
+        }
+        return decompressor
+    }
+
+    /// Compress one message as a complete stream
+    /// - Parameter data: Message to compress
+    /// - Returns: Compressed stream referencing the dictionary
+    /// - Throws: ZLibError if compression fails
+    public func compress(_ data: Data) throws -> Data {
+        guard data.count <= Int(uInt.max) else {
+            throw ZLibError.bufferError
+        }
+        let stream = UnsafeMutablePointer<z_stream>.allocate(capacity: 1)
+        stream.initialize(to: z_stream())
+        defer {
+            stream.deinitialize(count: 1)
+            stream.deallocate()
+        }
+
+        let result = copyState(into: stream)
+        guard result == Z_OK else {
+            throw ZLibError.compressionFailed(result)
+        }
+        defer { swift_deflateEnd(stream) }
+
+        // deflateBound guarantees a single Z_FINISH call completes the stream
+        let bound = Int(swift_deflateBound(stream, uLong(data.count)))
+        var output = Data(count: bound)
+        let status = data.withUnsafeBytes { (input: UnsafeRawBufferPointer) -> Int32 in
+            output.withUnsafeMutableBytes { (buffer: UnsafeMutableRawBufferPointer) -> Int32 in
+                stream.pointee.next_in = input.baseAddress.map { UnsafeMutablePointer(mutating: $0.assumingMemoryBound(to: Bytef.self)) }
+                stream.pointee.avail_in = uInt(input.count)
+                stream.pointee.next_out = buffer.baseAddress?.assumingMemoryBound(to: Bytef.self)
+                stream.pointee.avail_out = uInt(buffer.count)
+                return swift_deflate(stream, Z_FINISH)
+            }
+        }
+        guard status == Z_STREAM_END else {
+            throw ZLibError.compressionFailed(status)
+        }
+        output.count = bound - Int(stream.pointee.avail_out)
+        return output
+    }
+
+    /// Decompress one message compressed with this dictionary
+    /// - Parameters:
+    ///   - data: Compressed stream
+    ///   - expectedSize: Optional decompressed size hint
+    /// - Returns: Decompressed message
+    /// - Throws: ZLibError if the data is invalid or uses a different dictionary
+    public func decompress(_ data: Data, expectedSize: Int? = nil) throws -> Data {
+        let decompressor = try makeDecompressor()
+        return try decompressor.decompress(
+            data,
+            dictionary: windowBits == .raw ? nil : dictionary,
+            expectedSize: expectedSize
+        )
+    }
+
+    /// Copy the hashed template state into an uninitialized stream
+    /// - Parameter destination: Zeroed z_stream at a stable address
+    /// - Returns: zlib status of `deflateCopy`
+    func copyState(into destination: UnsafeMutablePointer<z_stream>) -> Int32 {
+        swift_deflateCopy(destination, template)
+    }
+
+    // MARK: Private Static Functions
+
+    private static func makeTemplate(
+        dictionary: Data,
+        level: CompressionLevel,
+        windowBits: WindowBits,
+        memoryLevel: MemoryLevel,
+        strategy: CompressionStrategy
+    ) throws -> UnsafeMutablePointer<z_stream> {
+        let template = UnsafeMutablePointer<z_stream>.allocate(capacity: 1)
+        template.initialize(to: z_stream())
+
+        var result = swift_deflateInit2(
+            template,
+            level.zlibLevel,
+            Z_DEFLATED,
+            windowBits.zlibWindowBits,
+            memoryLevel.zlibMemoryLevel,
+            strategy.zlibStrategy
+        )
+        if result == Z_OK {
+            result = dictionary.withUnsafeBytes { bytes in
+                swift_deflateSetDictionary(template, bytes.bindMemory(to: Bytef.self).baseAddress, uInt(bytes.count))
+            }
+            if result != Z_OK {
+                swift_deflateEnd(template)
+            }
+        }
+        guard result == Z_OK else {
+            template.deinitialize(count: 1)
+            template.deallocate()
+            throw ZLibError.compressionFailed(result)
+        }
+        return template
+    }
+}
@@ -0,0 +1,82 @@
+//
+//  ZStreamArena.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+/// Bump allocator that backs a single z_stream's `zalloc`/`zfree`.
+///
+/// The slab is sized for the stream's full deflate or inflate state, so `deflateInit2`/
+/// `inflateInit2` never reach `malloc`. When every allocation has been freed (after
+/// `deflateEnd`/`inflateEnd`) the arena rewinds and the slab is reused. Requests that do not
+/// fit fall back to the heap and are counted in `fallbackCount`.
+///
+/// An arena must be attached before the stream is initialized and must outlive it; the owning
+/// `Compressor`/`Decompressor` keeps a strong reference for that reason.
+final class ZStreamArena {
+    // MARK: Properties
+
+    let pointer: OpaquePointer
+
+    // MARK: Computed Properties
+
+    /// Bytes currently handed out from the slab
+    var usedBytes: Int { Int(swift_zarena_used(pointer)) }
+
+    /// High-water mark of `usedBytes`
+    var peakBytes: Int { Int(swift_zarena_peak(pointer)) }
+
+    /// Slab size in bytes
+    var capacity: Int { Int(swift_zarena_capacity(pointer)) }
+
+    /// Number of allocations that did not fit and went to the heap
+    var fallbackCount: Int { Int(swift_zarena_fallbacks(pointer)) }
+
+    // MARK: Lifecycle
+
+    /// Create an arena with a slab of the given size
+    /// - Parameter capacity: Slab size in bytes
+    init?(capacity: Int) {
+        guard let arena = swift_zarena_create(capacity) else {
+            return nil
+        }
+        pointer = arena
+    }
+
+    deinit {
+        swift_zarena_destroy(pointer)
+    }
+
+    // MARK: Static Functions
+
+    /// Create an arena large enough for a deflate stream
+    static func forDeflate(windowBits: WindowBits, memoryLevel: MemoryLevel) -> ZStreamArena? {
+        forDeflate(zlibWindowBits: windowBits.zlibWindowBits, memoryLevel: memoryLevel)
+    }
+
+    /// Create an arena large enough for a deflate stream with any zlib window bits
+    static func forDeflate(zlibWindowBits: Int32, memoryLevel: MemoryLevel) -> ZStreamArena? {
+        ZStreamArena(capacity: swift_zarena_deflate_size(zlibWindowBits, memoryLevel.zlibMemoryLevel))
+    }
+
+    /// Create an arena large enough for an inflate stream
+    static func forInflate(windowBits: WindowBits) -> ZStreamArena? {
+        forInflate(zlibWindowBits: windowBits.zlibWindowBits)
+    }
+
+    /// Create an arena large enough for an inflate stream with any zlib window bits
+    static func forInflate(zlibWindowBits: Int32) -> ZStreamArena? {
+        ZStreamArena(capacity: swift_zarena_inflate_size(zlibWindowBits))
+    }
+
+    // MARK: Functions
+
+    /// Route the stream's allocations through this arena
+    func attach(to stream: inout z_stream) {
+        swift_zarena_attach(&stream, pointer)
+    }
+}
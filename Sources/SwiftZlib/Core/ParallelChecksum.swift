@@ -0,0 +1,147 @@
+//
+//  ParallelChecksum.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+/// Multi-core CRC-32 and Adler-32 of large buffers and files
+///
+/// The input is cut into equal slices that are hashed on separate threads from the algorithm's
+/// initial value. The slice checksums are then folded left to right with
+/// `crc32_combine`/`adler32_combine`, which gives exactly the checksum a single pass would. All
+/// lengths are 64-bit, so inputs over 4 GB are hashed in full. Inputs of one slice or less are
+/// hashed on the calling thread.
+public final class ParallelChecksum {
+    // MARK: Nested Types
+
+    /// Checksum to compute
+    public enum Algorithm: String, Sendable {
+        case crc32
+        case adler32
+
+        // MARK: Computed Properties
+
+        /// Checksum of empty input, and the seed of every slice after the first
+        public var initialValue: uLong {
+            switch self {
+                case .crc32: return 0
+                case .adler32: return 1
+            }
+        }
+    }
+
+    // MARK: Static Properties
+
+    /// Default upper bound of a slice (16 MB)
+    public static let defaultSliceSize = 16 * 1024 * 1024
+
+    /// Smallest slice; below this the combine step and thread hand-off outweigh the hashing
+    public static let minimumSliceSize = 256 * 1024
+
+    // MARK: Properties
+
+    public let algorithm: Algorithm
+    public let threadCount: Int
+
+    /// Upper bound of a slice; inputs smaller than `threadCount` slices are cut into smaller
+    /// slices (down to `minimumSliceSize`) so every thread gets work
+    public let sliceSize: Int
+
+    // MARK: Lifecycle
+
+    /// Create a parallel checksum
+    /// - Parameters:
+    ///   - algorithm: Checksum to compute (default: CRC-32)
+    ///   - threadCount: Slices hashed concurrently (default: active CPU count)
+    ///   - sliceSize: Upper bound of a slice (default: 16 MB, at least 256 KB)
+    public init(
+        algorithm: Algorithm = .crc32,
+        threadCount: Int = ProcessInfo.processInfo.activeProcessorCount,
+        sliceSize: Int = ParallelChecksum.defaultSliceSize
+    ) {
+        self.algorithm = algorithm
+        self.threadCount = max(threadCount, 1)
+        self.sliceSize = max(sliceSize, Self.minimumSliceSize)
+    }
+
+    // MARK: Functions
+
+    /// Checksum data in memory
+    /// - Parameters:
+    ///   - data: Data to hash
+    ///   - initialValue: Running checksum to continue from (default: the algorithm's initial value)
+    /// - Returns: Checksum of `data`
+    public func checksum(_ data: Data, initialValue: uLong? = nil) -> uLong {
+        data.withUnsafeBytes { checksum($0, initialValue: initialValue) }
+    }
+
+    /// Checksum a file, memory-mapping it so slices are paged in by the threads hashing them
+    /// - Parameters:
+    ///   - path: File to hash
+    ///   - initialValue: Running checksum to continue from (default: the algorithm's initial value)
+    /// - Returns: Checksum of the file's contents
+    /// - Throws: `ZLibError.fileError` if the file cannot be opened or mapped
+    public func checksumFile(at path: String, initialValue: uLong? = nil) throws -> uLong {
+        let source = try MappedFile(path: path)
+        return checksum(source.bytes, initialValue: initialValue)
+    }
+
+    /// Checksum a buffer
+    /// - Parameters:
+    ///   - input: Bytes to hash
+    ///   - initialValue: Running checksum to continue from (default: the algorithm's initial value)
+    /// - Returns: Checksum of `input`
+    public func checksum(_ input: UnsafeRawBufferPointer, initialValue: uLong? = nil) -> uLong {
+        let seed = initialValue ?? algorithm.initialValue
+        let length = min(sliceSize, max(Self.minimumSliceSize, (input.count + threadCount - 1) / threadCount))
+        guard threadCount > 1, input.count > length else {
+            return hash(seed, input)
+        }
+
+        let sliceCount = (input.count + length - 1) / length
+        var checksums = [uLong](repeating: 0, count: sliceCount)
+        checksums.withUnsafeMutableBufferPointer { buffer in
+            let slots = buffer
+            let workers = min(threadCount, sliceCount)
+            DispatchQueue.concurrentPerform(iterations: workers) { worker in
+                for index in stride(from: worker, to: sliceCount, by: workers) {
+                    let start = index * length
+                    let slice = UnsafeRawBufferPointer(rebasing: input[start ..< min(start + length, input.count)])
+                    slots[index] = hash(index == 0 ? seed : algorithm.initialValue, slice)
+                }
+            }
+        }
+
+        // Every slice but the last has the same length, so the CRC-32 combine operator is
+        // generated once
+        let fullSliceOperator = algorithm == .crc32 ? swift_crc32_combine_gen64(Int64(length)) : 0
+        var result = checksums[0]
+        for index in 1 ..< sliceCount {
+            let sliceLength = min(length, input.count - index * length)
+            switch algorithm {
+                case .crc32 where sliceLength == length:
+                    result = swift_crc32_combine_op(result, checksums[index], fullSliceOperator)
+                case .crc32:
+                    result = swift_crc32_combine64(result, checksums[index], Int64(sliceLength))
+                case .adler32:
+                    result = swift_adler32_combine64(result, checksums[index], Int64(sliceLength))
+            }
+        }
+        zlibInfo("Parallel \(algorithm.rawValue): \(input.count) bytes in \(sliceCount) slices")
+        return result
+    }
+
+    // MARK: Private Functions
+
+    private func hash(_ value: uLong, _ slice: UnsafeRawBufferPointer) -> uLong {
+        let bytes = slice.baseAddress?.assumingMemoryBound(to: Bytef.self)
+        switch algorithm {
+            case .crc32: return swift_crc32_z(value, bytes, slice.count)
+            case .adler32: return swift_adler32_z(value, bytes, slice.count)
+        }
+    }
+}
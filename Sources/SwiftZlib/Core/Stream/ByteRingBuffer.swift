@@ -0,0 +1,196 @@
+//
+//  ByteRingBuffer.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+/// Fixed-capacity byte FIFO backed by one allocation made at creation
+///
+/// Bytes are written at the tail and read from the head; both wrap around the end of the
+/// storage. Besides copying `write`/`read`, the buffer exposes its contiguous readable and
+/// writable regions so producers and consumers (a socket read, zlib's `next_in`/`next_out`)
+/// can work on the storage in place and then move the cursors with `consume(_:)` and
+/// `commitWrite(_:)`. When the buffer drains the cursors rewind to the start, so regions stay
+/// as long as possible. Not thread-safe.
+public final class ByteRingBuffer {
+    // MARK: Properties
+
+    /// Total storage in bytes
+    public let capacity: Int
+
+    /// Bytes written and not read yet
+    public private(set) var count = 0
+
+    private let storage: UnsafeMutableRawPointer
+    /// Offset of the first readable byte
+    private var head = 0
+
+    // MARK: Computed Properties
+
+    /// Bytes that can be written before the buffer is full
+    public var freeCount: Int {
+        capacity - count
+    }
+
+    public var isEmpty: Bool {
+        count == 0
+    }
+
+    public var isFull: Bool {
+        count == capacity
+    }
+
+    /// Readable bytes from the head up to the end of the storage or of the data, whichever is first
+    public var readableRegion: UnsafeRawBufferPointer {
+        UnsafeRawBufferPointer(start: storage + head, count: min(count, capacity - head))
+    }
+
+    /// Free bytes from the tail up to the end of the storage or the head, whichever is first
+    public var writableRegion: UnsafeMutableRawBufferPointer {
+        let tail = (head + count) % capacity
+        let length = isFull ? 0 : (tail >= head ? capacity - tail : head - tail)
+        return UnsafeMutableRawBufferPointer(start: storage + tail, count: length)
+    }
+
+    // MARK: Lifecycle
+
+    /// Create a ring buffer
+    /// - Parameter capacity: Storage size in bytes (at least 1)
+    public init(capacity: Int) {
+        precondition(capacity > 0, "Ring buffer capacity must be positive")
+        self.capacity = capacity
+        storage = UnsafeMutableRawPointer.allocate(byteCount: capacity, alignment: MemoryLayout<UInt64>.alignment)
+    }
+
+    deinit {
+        storage.deallocate()
+    }
+
+    // MARK: Static Functions
+
+    /// Run a zlib codec from one ring buffer into another until input, output or the stream ends
+    ///
+    /// `step` gets the current readable and writable regions and the zlib flush to use, runs
+    /// `deflate` or `inflate` on them, and reports the zlib result and the bytes consumed and
+    /// produced. The flush is only passed once the region holds all buffered input, since a
+    /// flush with input left behind the wrap point would end the block (or stream) too early.
+    static func pump(
+        from input: ByteRingBuffer,
+        into output: ByteRingBuffer,
+        flush: Int32,
+        step: (UnsafeRawBufferPointer, UnsafeMutableRawBufferPointer, Int32) throws -> (result: Int32, consumed: Int, produced: Int)
+    ) rethrows -> RingBufferStream.Progress {
+        precondition(input !== output, "Input and output must be different ring buffers")
+        var progress = RingBufferStream.Progress()
+        while true {
+            let source = input.readableRegion
+            let destination = output.writableRegion
+            guard destination.count > 0 else {
+                break
+            }
+
+            let outcome = try step(source, destination, source.count == input.count ? flush : Z_NO_FLUSH)
+            input.consume(outcome.consumed)
+            output.commitWrite(outcome.produced)
+            progress.bytesConsumed += outcome.consumed
+            progress.bytesProduced += outcome.produced
+
+            if outcome.result == Z_STREAM_END {
+                progress.isStreamEnd = true
+                break
+            }
+            // Z_BUF_ERROR: nothing left to do until there is more input or output space
+            if outcome.consumed == 0, outcome.produced == 0 {
+                break
+            }
+            // Output space left over with all input taken means any flush has completed
+            if outcome.produced < destination.count, input.isEmpty {
+                break
+            }
+        }
+        return progress
+    }
+
+    // MARK: Functions
+
+    /// Copy bytes in at the tail
+    /// - Parameter bytes: Bytes to append
+    /// - Returns: Number of bytes written, less than `bytes.count` if the buffer filled up
+    @discardableResult
+    public func write(_ bytes: UnsafeRawBufferPointer) -> Int {
+        var written = 0
+        while written < bytes.count {
+            let region = writableRegion
+            let length = min(region.count, bytes.count - written)
+            guard length > 0, let source = bytes.baseAddress else {
+                break
+            }
+            region.baseAddress!.copyMemory(from: source + written, byteCount: length)
+            commitWrite(length)
+            written += length
+        }
+        return written
+    }
+
+    /// Copy bytes in at the tail
+    /// - Parameter data: Bytes to append
+    /// - Returns: Number of bytes written, less than `data.count` if the buffer filled up
+    @discardableResult
+    public func write(_ data: Data) -> Int {
+        data.withUnsafeBytes { write($0) }
+    }
+
+    /// Copy bytes out from the head
+    /// - Parameter destination: Buffer to fill
+    /// - Returns: Number of bytes read, less than `destination.count` if the buffer ran empty
+    @discardableResult
+    public func read(into destination: UnsafeMutableRawBufferPointer) -> Int {
+        var read = 0
+        while read < destination.count {
+            let region = readableRegion
+            let length = min(region.count, destination.count - read)
+            guard length > 0, let target = destination.baseAddress else {
+                break
+            }
+            (target + read).copyMemory(from: region.baseAddress!, byteCount: length)
+            consume(length)
+            read += length
+        }
+        return read
+    }
+
+    /// Move up to `maxLength` bytes out into a new `Data`; allocates, unlike `read(into:)`
+    /// - Parameter maxLength: Upper bound on the bytes returned (default: everything buffered)
+    /// - Returns: The bytes read
+    public func readData(maxLength: Int = .max) -> Data {
+        let length = min(maxLength, count)
+        var data = Data(count: length)
+        data.withUnsafeMutableBytes { _ = read(into: $0) }
+        return data
+    }
+
+    /// Drop bytes from the head, typically after reading them through `readableRegion`
+    /// - Parameter length: Number of bytes, at most `count`
+    public func consume(_ length: Int) {
+        precondition(length >= 0 && length <= count, "Cannot consume more bytes than are buffered")
+        count -= length
+        head = count == 0 ? 0 : (head + length) % capacity
+    }
+
+    /// Mark bytes as written, typically after filling them through `writableRegion`
+    /// - Parameter length: Number of bytes, at most `writableRegion.count`
+    public func commitWrite(_ length: Int) {
+        precondition(length >= 0 && length <= freeCount, "Cannot commit more bytes than are free")
+        count += length
+    }
+
+    /// Discard everything buffered
+    public func removeAll() {
+        count = 0
+        head = 0
+    }
+}
@@ -0,0 +1,546 @@
+//
+//  HTTPContentCodec.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+// MARK: - HTTPContentEncoding
+
+/// `Content-Encoding` values handled by `HTTPBodyEncoder` and `HTTPBodyDecoder`
+public enum HTTPContentEncoding: String, Sendable, CaseIterable {
+    /// gzip member (RFC 1952)
+    case gzip
+    /// zlib stream (RFC 1950); the decoder also accepts the raw deflate some servers send
+    case deflate
+
+    // MARK: Lifecycle
+
+    /// Parse a single encoding token, ignoring case and surrounding whitespace
+    /// - Parameter headerValue: Token such as `gzip`, `x-gzip` or `deflate`
+    public init?(headerValue: String) {
+        switch headerValue.trimmingCharacters(in: .whitespaces).lowercased() {
+            case "gzip", "x-gzip":
+                self = .gzip
+            case "deflate":
+                self = .deflate
+            default:
+                return nil
+        }
+    }
+
+    // MARK: Static Functions
+
+    /// Pick the encoding to answer an `Accept-Encoding` header with
+    ///
+    /// Tokens with `q=0` are refused; among the rest the highest q-value wins, and gzip wins
+    /// ties because every client that lists both decodes it the same way.
+    /// - Parameter acceptEncoding: Header value, for example `gzip;q=0.8, deflate, br`
+    /// - Returns: The preferred encoding, or nil if neither is acceptable
+    public static func preferred(acceptEncoding: String) -> HTTPContentEncoding? {
+        var best: (encoding: HTTPContentEncoding, quality: Double)?
+        var refused: Set<HTTPContentEncoding> = []
+        var wildcardQuality: Double?
+        for item in acceptEncoding.split(separator: ",") {
+            let parts = item.split(separator: ";")
+            guard let token = parts.first?.trimmingCharacters(in: .whitespaces) else {
+                continue
+            }
+            var quality = 1.0
+            for parameter in parts.dropFirst() {
+                let pair = parameter.split(separator: "=", maxSplits: 1)
+                if pair.count == 2, pair[0].trimmingCharacters(in: .whitespaces).lowercased() == "q" {
+                    quality = Double(pair[1].trimmingCharacters(in: .whitespaces)) ?? 0
+                }
+            }
+            if token == "*" {
+                wildcardQuality = quality
+                continue
+            }
+            guard let encoding = HTTPContentEncoding(headerValue: token) else {
+                continue
+            }
+            guard quality > 0 else {
+                refused.insert(encoding)
+                continue
+            }
+            if best.map({ quality > $0.quality || (quality == $0.quality && encoding == .gzip) }) ?? true {
+                best = (encoding, quality)
+            }
+        }
+        // `*` covers the encodings not listed by name
+        if best == nil, let wildcardQuality, wildcardQuality > 0 {
+            return [HTTPContentEncoding.gzip, .deflate].first { !refused.contains($0) }
+        }
+        return best?.encoding
+    }
+
+    // MARK: Functions
+
+    /// zlib window bits for a `1 << windowLog` byte window in this encoding's framing
+    func zlibWindowBits(windowLog: Int) -> Int32 {
+        self == .gzip ? Int32(windowLog) + 16 : Int32(windowLog)
+    }
+}
+
+// MARK: - HTTPCodecConfiguration
+
+/// Stream settings for HTTP body codecs, chosen for many concurrent connections
+///
+/// zlib's defaults (a 32 KB window with memory level 8, or the `.maximum` level used by
+/// `initializeAdvanced`) cost 256-450 KB per deflate stream. The `lowMemory` preset uses a 4 KB
+/// window and memory level 3, about 37 KB per encoder, for a few percent of ratio on typical
+/// text bodies. The decoder window has to cover whatever the peer used, so it stays at 32 KB
+/// unless both ends are known.
+public struct HTTPCodecConfiguration: Sendable, Equatable {
+    // MARK: Static Properties
+
+    /// Smallest window zlib accepts for every framing (512 bytes)
+    public static let minimumWindowLog = 9
+
+    /// Largest window, and the one any peer may have used (32 KB)
+    public static let maximumWindowLog = 15
+
+    /// 4 KB window, memory level 3, level 1: small per-stream state for busy servers
+    public static let lowMemory = HTTPCodecConfiguration()
+
+    /// zlib's own defaults: 32 KB window, memory level 8, level 6
+    public static let standard = HTTPCodecConfiguration(level: .defaultCompression, windowLog: 15, memoryLevel: .level8)
+
+    // MARK: Properties
+
+    public var level: CompressionLevel
+    public var strategy: CompressionStrategy
+    /// The encoder's window is `1 << windowLog` bytes (9-15)
+    public var windowLog: Int
+    public var memoryLevel: MemoryLevel
+    /// The decoder's window is `1 << decoderWindowLog` bytes; must be at least the peer's window
+    public var decoderWindowLog: Int
+    /// Flush ending each `encode` call: `.syncFlush` makes every chunk decodable on arrival,
+    /// `.fullFlush` also lets a decoder restart at that chunk, `.noFlush` lets zlib buffer
+    public var chunkFlush: FlushMode
+    /// Allocate each stream's state from a single arena slab
+    public var usesArena: Bool
+    /// Most decoded bytes one body may have (nil: unlimited); see `DecompressionOptions.maxOutputSize`
+    public var maxDecodedBodySize: Int?
+    /// Most decoded bytes per encoded byte of one body (nil: unlimited)
+    public var maxDecodedExpansionRatio: Double?
+
+    // MARK: Computed Properties
+
+    /// Upper bound of one encoder's zlib state in bytes
+    public var encoderStateBytes: Int {
+        Int(swift_zarena_deflate_size(Int32(windowLog), memoryLevel.zlibMemoryLevel))
+    }
+
+    /// Upper bound of one decoder's zlib state in bytes, window included
+    public var decoderStateBytes: Int {
+        Int(swift_zarena_inflate_size(Int32(decoderWindowLog)))
+    }
+
+    // MARK: Lifecycle
+
+    /// Create a configuration; window sizes are clamped to 9-15
+    /// - Parameters:
+    ///   - level: Compression level (default: best speed)
+    ///   - strategy: Compression strategy (default: default strategy)
+    ///   - windowLog: Encoder window as a power of two (default: 12, 4 KB)
+    ///   - memoryLevel: Encoder memory level (default: level 3)
+    ///   - decoderWindowLog: Decoder window as a power of two (default: 15, 32 KB)
+    ///   - chunkFlush: Flush at the end of each encoded chunk (default: sync flush)
+    ///   - usesArena: Allocate each stream's state from an arena (default: true)
+    ///   - maxDecodedBodySize: Most decoded bytes per body (default: unlimited)
+    ///   - maxDecodedExpansionRatio: Most decoded bytes per encoded byte of a body (default: unlimited)
+    public init(
+        level: CompressionLevel = .bestSpeed,
+        strategy: CompressionStrategy = .defaultStrategy,
+        windowLog: Int = 12,
+        memoryLevel: MemoryLevel = .level3,
+        decoderWindowLog: Int = HTTPCodecConfiguration.maximumWindowLog,
+        chunkFlush: FlushMode = .syncFlush,
+        usesArena: Bool = true,
+        maxDecodedBodySize: Int? = nil,
+        maxDecodedExpansionRatio: Double? = nil
+    ) {
+        let windowLogs = Self.minimumWindowLog ... Self.maximumWindowLog
+        self.level = level
+        self.strategy = strategy
+        self.windowLog = min(max(windowLog, windowLogs.lowerBound), windowLogs.upperBound)
+        self.memoryLevel = memoryLevel
+        self.decoderWindowLog = min(max(decoderWindowLog, windowLogs.lowerBound), windowLogs.upperBound)
+        self.chunkFlush = chunkFlush
+        self.usesArena = usesArena
+        self.maxDecodedBodySize = maxDecodedBodySize
+        self.maxDecodedExpansionRatio = maxDecodedExpansionRatio
+    }
+}
+
+// MARK: - HTTPBodyEncoder
+
+/// Connection-scoped encoder for gzip or deflate HTTP response bodies
+///
+/// One encoder serves the bodies of one connection in turn. Each `encode(_:flush:)` call takes
+/// the next piece of the body and returns bytes ready to send as a chunk of a chunked transfer;
+/// with the default sync flush the peer can decode them as they arrive. `finish()` writes the
+/// trailer and resets the stream with `deflateReset`, so the next body reuses the same state.
+/// `release()` frees the state while the connection is idle; it is allocated again when the
+/// next body starts. Not thread-safe: use one encoder per connection.
+public final class HTTPBodyEncoder {
+    // MARK: Properties
+
+    public let encoding: HTTPContentEncoding
+    public let configuration: HTTPCodecConfiguration
+
+    /// Bodies finished so far
+    public private(set) var bodyCount = 0
+
+    /// Whether a body has been started and not finished yet
+    public private(set) var isInBody = false
+
+    private var compressor: Compressor?
+
+    // MARK: Computed Properties
+
+    /// Whether zlib state is currently allocated
+    public var isHoldingState: Bool {
+        compressor != nil
+    }
+
+    // MARK: Lifecycle
+
+    /// Create an encoder; no zlib state is allocated until the first body starts
+    /// - Parameters:
+    ///   - encoding: Content encoding to produce
+    ///   - configuration: Stream settings (default: low memory)
+    public init(encoding: HTTPContentEncoding, configuration: HTTPCodecConfiguration = .lowMemory) {
+        self.encoding = encoding
+        self.configuration = configuration
+    }
+
+    // MARK: Functions
+
+    /// Encode the next piece of the current body, starting a body if none is in progress
+    /// - Parameters:
+    ///   - chunk: Body bytes
+    ///   - flush: Flush for this chunk (default: the configuration's `chunkFlush`)
+    /// - Returns: Encoded bytes to send; empty when `.noFlush` let zlib buffer the input
+    /// - Throws: ZLibError if the stream cannot be set up or compression fails
+    public func encode(_ chunk: Data, flush: FlushMode? = nil) throws -> Data {
+        let compressor = try startBody()
+        return try compressor.compress(chunk, flush: flush ?? configuration.chunkFlush)
+    }
+
+    /// End the current body and reset the stream for the next one
+    /// - Returns: Remaining encoded bytes, including the gzip or zlib trailer
+    /// - Throws: ZLibError if compression fails
+    public func finish() throws -> Data {
+        let compressor = try startBody()
+        let output = try compressor.compress(Data(), flush: .finish)
+        try endBody(compressor)
+        bodyCount += 1
+        return output
+    }
+
+    /// Encode a complete body in one call
+    /// - Parameter body: Body bytes
+    /// - Returns: The whole encoded body
+    /// - Throws: ZLibError if compression fails
+    public func encodeBody(_ body: Data) throws -> Data {
+        let compressor = try startBody()
+        let output = try compressor.compress(body, flush: .finish)
+        try endBody(compressor)
+        bodyCount += 1
+        return output
+    }
+
+    /// Drop a body that will not be completed, for example when the peer went away
+    ///
+    /// The stream is reset and stays allocated for the next body.
+    public func abort() {
+        guard let compressor, isInBody else {
+            return
+        }
+        do {
+            try endBody(compressor)
+        } catch {
+            zlibWarning("HTTP encoder reset failed, releasing its state: \(error)")
+            release()
+        }
+    }
+
+    /// Free the zlib state, for example while the connection is idle
+    ///
+    /// A body in progress is dropped. The state is allocated again when the next body starts.
+    public func release() {
+        compressor = nil
+        isInBody = false
+    }
+
+    // MARK: Private Functions
+
+    private func startBody() throws -> Compressor {
+        if let compressor {
+            isInBody = true
+            return compressor
+        }
+
+        let windowBits = encoding.zlibWindowBits(windowLog: configuration.windowLog)
+        let compressor = Compressor()
+        if configuration.usesArena {
+            guard let arena = ZStreamArena.forDeflate(zlibWindowBits: windowBits, memoryLevel: configuration.memoryLevel) else {
+                throw ZLibError.memoryError
+            }
+            compressor.attachArena(arena)
+        }
+        try compressor.initializeAdvanced(
+            level: configuration.level,
+            zlibWindowBits: windowBits,
+            memoryLevel: configuration.memoryLevel,
+            strategy: configuration.strategy
+        )
+        self.compressor = compressor
+        isInBody = true
+        return compressor
+    }
+
+    private func endBody(_ compressor: Compressor) throws {
+        isInBody = false
+        try compressor.prepareForReuse(level: configuration.level, strategy: configuration.strategy)
+    }
+}
+
+// MARK: - HTTPBodyDecoder
+
+/// Connection-scoped decoder for gzip or deflate HTTP bodies
+///
+/// Feed the body as it arrives, in chunks of any size, to `decode(_:)`; chunk boundaries do not
+/// have to line up with the sender's flushes. For `deflate` the first two bytes decide between
+/// a zlib stream and the raw deflate some servers send instead. A `gzip` body may hold several
+/// members back to back, which decode as one body. `finish()` checks that the body
+/// was complete and resets the stream with `inflateReset` for the next body; `release()` frees
+/// the state while the connection is idle. Not thread-safe: use one decoder per connection.
+public final class HTTPBodyDecoder {
+    // MARK: Static Properties
+
+    /// First two bytes of every gzip member
+    private static let gzipMagic = Data([0x1F, 0x8B])
+
+    // MARK: Properties
+
+    public let encoding: HTTPContentEncoding
+    public let configuration: HTTPCodecConfiguration
+
+    /// Bodies finished so far
+    public private(set) var bodyCount = 0
+
+    /// Whether a body has been started and not finished yet
+    public private(set) var isInBody = false
+
+    private var decompressor: Decompressor?
+    /// zlib window bits the decompressor is currently set up for
+    private var streamWindowBits: Int32 = 0
+    /// Whether a deflate body has started but its first two bytes have not arrived yet
+    private var isAwaitingFraming = false
+    /// Start of a deflate body, or of a gzip member, held until it can be told apart
+    private var heldBytes = Data()
+    /// Bytes the earlier gzip members of the current body decoded to
+    private var decodedBeforeMember = 0
+
+    // MARK: Computed Properties
+
+    /// Whether zlib state is currently allocated
+    public var isHoldingState: Bool {
+        decompressor != nil
+    }
+
+    /// Whether the current body's end-of-stream marker has been decoded
+    public var isComplete: Bool {
+        isInBody && !isAwaitingFraming && heldBytes.isEmpty && decompressor?.reachedStreamEnd == true
+    }
+
+    // MARK: Lifecycle
+
+    /// Create a decoder; no zlib state is allocated until the first body starts
+    /// - Parameters:
+    ///   - encoding: Content encoding of the bodies
+    ///   - configuration: Stream settings (default: low memory, with a 32 KB decoding window)
+    public init(encoding: HTTPContentEncoding, configuration: HTTPCodecConfiguration = .lowMemory) {
+        self.encoding = encoding
+        self.configuration = configuration
+    }
+
+    // MARK: Functions
+
+    /// Decode the next piece of the current body, starting a body if none is in progress
+    ///
+    /// A gzip body may hold several members back to back, as gzip itself allows. Each member that
+    /// follows a finished one is decoded in turn, and the size limit applies to the whole body.
+    /// - Parameter chunk: Encoded bytes as received
+    /// - Returns: Decoded body bytes available so far
+    /// - Throws: ZLibError if the data is invalid or continues past the end of the stream, or
+    ///   `outputLimitExceeded` if the body decodes past the configured limits
+    public func decode(_ chunk: Data) throws -> Data {
+        if isComplete, encoding != .gzip {
+            guard chunk.isEmpty else {
+                throw trailingData(chunk.count)
+            }
+            return Data()
+        }
+
+        var input = chunk
+        if !isInBody {
+            isInBody = true
+            if encoding == .deflate {
+                isAwaitingFraming = true
+            } else {
+                try startStream(raw: false)
+            }
+        }
+        if isAwaitingFraming {
+            // A zlib header is two bytes; hold the start of the body until both have arrived
+            heldBytes.append(chunk)
+            guard heldBytes.count >= 2 else {
+                return Data()
+            }
+            input = heldBytes
+            heldBytes = Data()
+            isAwaitingFraming = false
+            try startStream(raw: !Self.isZlibHeader(input))
+        }
+        guard let decompressor else {
+            throw ZLibError.streamError(Z_STREAM_ERROR)
+        }
+        var output = Data()
+        while true {
+            if decompressor.reachedStreamEnd {
+                // Only gzip gets here: a finished member may be followed by another one, whose
+                // magic bytes are held until both have arrived
+                let pending = heldBytes + input
+                guard pending.starts(with: Self.gzipMagic.prefix(pending.count)) else {
+                    // The finished body stays as it was, so it can still be finished
+                    heldBytes = Data()
+                    throw trailingData(pending.count)
+                }
+                guard pending.count >= 2 else {
+                    heldBytes = pending
+                    return output
+                }
+                input = pending
+                heldBytes = Data()
+                try startNextMember(decompressor)
+            }
+            let decoded = try decompressor.decompress(input)
+            output.append(decoded)
+            decodedBeforeMember += decoded.count
+            // inflate stops at the end of the stream; bytes after it in the same chunk are not
+            // body, unless they start another gzip member
+            let unread = decompressor.unconsumedInputCount
+            guard decompressor.reachedStreamEnd, unread > 0 else {
+                return output
+            }
+            guard encoding == .gzip else {
+                throw trailingData(unread)
+            }
+            input = input.suffix(unread)
+        }
+    }
+
+    /// End the current body and reset the stream for the next one
+    /// - Throws: ZLibError.decompressionFailed(Z_BUF_ERROR) if the body was cut short; the
+    ///   stream is reset either way
+    public func finish() throws {
+        guard isInBody else {
+            return
+        }
+        let complete = isComplete
+        abort()
+        guard complete else {
+            throw ZLibError.decompressionFailed(Z_BUF_ERROR)
+        }
+        bodyCount += 1
+    }
+
+    /// Drop a body that will not be completed, for example after a decoding error
+    ///
+    /// The stream is reset and stays allocated for the next body.
+    public func abort() {
+        isInBody = false
+        isAwaitingFraming = false
+        heldBytes = Data()
+        decodedBeforeMember = 0
+        guard let decompressor else {
+            return
+        }
+        do {
+            try decompressor.prepareForReuse()
+        } catch {
+            zlibWarning("HTTP decoder reset failed, releasing its state: \(error)")
+            release()
+        }
+    }
+
+    /// Free the zlib state, for example while the connection is idle
+    ///
+    /// A body in progress is dropped. The state is allocated again when the next body starts.
+    public func release() {
+        decompressor = nil
+        streamWindowBits = 0
+        isAwaitingFraming = false
+        heldBytes = Data()
+        decodedBeforeMember = 0
+        isInBody = false
+    }
+
+    // MARK: Private Static Functions
+
+    /// Whether two bytes form a valid zlib header: deflate method, window up to 32 KB, check bits
+    private static func isZlibHeader(_ data: Data) -> Bool {
+        let first = data[data.startIndex]
+        let second = data[data.startIndex + 1]
+        return first & 0x0F == 8 && first >> 4 <= 7 && (UInt16(first) << 8 | UInt16(second)) % 31 == 0
+    }
+
+    // MARK: Private Functions
+
+    private func startStream(raw: Bool) throws {
+        let windowLog = Int32(configuration.decoderWindowLog)
+        let windowBits = raw ? -windowLog : encoding.zlibWindowBits(windowLog: configuration.decoderWindowLog)
+        if let decompressor {
+            // Same window size, so inflateReset2 keeps the window already allocated
+            if windowBits != streamWindowBits {
+                try decompressor.resetWithWindowBits(zlibWindowBits: windowBits)
+            }
+        } else {
+            let decompressor = Decompressor()
+            if configuration.usesArena {
+                guard let arena = ZStreamArena.forInflate(zlibWindowBits: windowBits) else {
+                    throw ZLibError.memoryError
+                }
+                decompressor.attachArena(arena)
+            }
+            try decompressor.initializeAdvanced(zlibWindowBits: windowBits)
+            self.decompressor = decompressor
+        }
+        // Reuse clears the limits, so they are set again for every body
+        decompressor?.maxOutputSize = configuration.maxDecodedBodySize
+        decompressor?.maxExpansionRatio = configuration.maxDecodedExpansionRatio
+        streamWindowBits = windowBits
+        decodedBeforeMember = 0
+    }
+
+    /// Reset the stream for the next member of a gzip body, keeping what is left of the size limit
+    ///
+    /// The expansion ratio is checked per member, which bounds the whole body by the same ratio.
+    private func startNextMember(_ decompressor: Decompressor) throws {
+        try decompressor.reset()
+        decompressor.maxOutputSize = configuration.maxDecodedBodySize.map { max($0 - decodedBeforeMember, 0) }
+    }
+
+    private func trailingData(_ count: Int) -> ZLibError {
+        zlibError("HTTP body continues \(count) bytes past the end of its stream")
+        return ZLibError.decompressionFailed(Z_DATA_ERROR)
+    }
+}
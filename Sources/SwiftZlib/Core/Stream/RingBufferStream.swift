@@ -0,0 +1,158 @@
+//
+//  RingBufferStream.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+/// Streaming compressor or decompressor working between two caller-owned ring buffers
+///
+/// The input and output `ByteRingBuffer`s are registered once. The producer writes into the
+/// input ring, `process(flush:)` points zlib's `next_in`/`next_out` straight at the rings'
+/// storage and advances their cursors, and the consumer drains the output ring. Unlike
+/// `Compressor.compress(_:flush:)` and `Decompressor.decompress(_:flush:dictionary:)`, no
+/// temporary chunk or `Data` is allocated per call, so the steady state allocates nothing.
+///
+/// As with `deflate` itself, when a flush stops because the output ring is full, call
+/// `process(flush:)` again with the same flush once output has been drained.
+public final class RingBufferStream {
+    // MARK: Nested Types
+
+    /// Work done by one `process(flush:)` call
+    public struct Progress: Sendable, Equatable {
+        // MARK: Properties
+
+        /// Bytes taken from the input ring
+        public var bytesConsumed = 0
+        /// Bytes added to the output ring
+        public var bytesProduced = 0
+        /// Whether the stream ended: the trailer was written, or read for decompression
+        public var isStreamEnd = false
+
+        // MARK: Lifecycle
+
+        public init(bytesConsumed: Int = 0, bytesProduced: Int = 0, isStreamEnd: Bool = false) {
+            self.bytesConsumed = bytesConsumed
+            self.bytesProduced = bytesProduced
+            self.isStreamEnd = isStreamEnd
+        }
+    }
+
+    private enum Codec {
+        case deflate(Compressor, level: CompressionLevel, strategy: CompressionStrategy)
+        case inflate(Decompressor)
+    }
+
+    // MARK: Properties
+
+    /// Ring the stream reads from
+    public let input: ByteRingBuffer
+    /// Ring the stream writes to
+    public let output: ByteRingBuffer
+
+    /// Whether the end of the stream has been reached since creation or the last `reset()`
+    public private(set) var isStreamEnd = false
+
+    private let codec: Codec
+
+    // MARK: Computed Properties
+
+    /// Counters of the underlying stream
+    public var metrics: StreamMetrics {
+        switch codec {
+            case let .deflate(compressor, _, _):
+                compressor.metrics
+            case let .inflate(decompressor):
+                decompressor.metrics
+        }
+    }
+
+    // MARK: Lifecycle
+
+    /// Create a compressing stream
+    /// - Parameters:
+    ///   - input: Ring holding uncompressed bytes
+    ///   - output: Ring receiving compressed bytes
+    ///   - level: Compression level (default: .defaultCompression)
+    ///   - windowBits: Output format (default: .deflate)
+    ///   - memoryLevel: Memory level (default: .maximum)
+    ///   - strategy: Compression strategy (default: .defaultStrategy)
+    /// - Throws: ZLibError if the stream cannot be initialized
+    public init(
+        compressingFrom input: ByteRingBuffer,
+        into output: ByteRingBuffer,
+        level: CompressionLevel = .defaultCompression,
+        windowBits: WindowBits = .deflate,
+        memoryLevel: MemoryLevel = .maximum,
+        strategy: CompressionStrategy = .defaultStrategy
+    ) throws {
+        precondition(input !== output, "Input and output must be different ring buffers")
+        let compressor = Compressor()
+        try compressor.initializeAdvanced(level: level, windowBits: windowBits, memoryLevel: memoryLevel, strategy: strategy)
+        self.input = input
+        self.output = output
+        codec = .deflate(compressor, level: level, strategy: strategy)
+    }
+
+    /// Create a decompressing stream
+    /// - Parameters:
+    ///   - input: Ring holding compressed bytes
+    ///   - output: Ring receiving decompressed bytes
+    ///   - windowBits: Input format (default: .deflate)
+    /// - Throws: ZLibError if the stream cannot be initialized
+    public init(
+        decompressingFrom input: ByteRingBuffer,
+        into output: ByteRingBuffer,
+        windowBits: WindowBits = .deflate
+    ) throws {
+        precondition(input !== output, "Input and output must be different ring buffers")
+        let decompressor = Decompressor()
+        try decompressor.initializeAdvanced(windowBits: windowBits)
+        self.input = input
+        self.output = output
+        codec = .inflate(decompressor)
+    }
+
+    // MARK: Functions
+
+    /// Move as much data as possible from the input ring through zlib into the output ring
+    ///
+    /// Returns when the input is used up (and any flush has completed), the output ring is
+    /// full, or the stream ends. Input after the end of a compressed stream is left in the ring.
+    /// - Parameter flush: Flush for compression: `.syncFlush` or `.fullFlush` to make the input
+    ///   so far decodable, `.finish` once the input ring holds the last bytes. Decompression
+    ///   ignores it.
+    /// - Returns: Bytes consumed and produced by this call
+    /// - Throws: ZLibError if the data is invalid or the stream fails
+    @discardableResult
+    public func process(flush: FlushMode = .noFlush) throws -> Progress {
+        let progress: Progress
+        switch codec {
+            case let .deflate(compressor, _, _):
+                progress = try compressor.process(from: input, into: output, flush: flush)
+            case let .inflate(decompressor):
+                progress = try decompressor.process(from: input, into: output)
+        }
+        if progress.isStreamEnd {
+            isStreamEnd = true
+        }
+        return progress
+    }
+
+    /// Reset the stream with `deflateReset`/`inflateReset` to start a new one
+    ///
+    /// The rings are left as they are; clear them with `removeAll()` if needed.
+    /// - Throws: ZLibError if the reset fails
+    public func reset() throws {
+        switch codec {
+            case let .deflate(compressor, level, strategy):
+                try compressor.prepareForReuse(level: level, strategy: strategy)
+            case let .inflate(decompressor):
+                try decompressor.prepareForReuse()
+        }
+        isStreamEnd = false
+    }
+}
@@ -17,6 +17,8 @@ public struct StreamingConfig {
     public let compressionLevel: Int
     /// Window bits for streaming operations
     public let windowBits: Int
+    /// Whether file operations map the source file instead of loading it into a `Data`
+    public let useMemoryMapping: Bool
 
     // MARK: Lifecycle
 
@@ -24,11 +26,13 @@ public struct StreamingConfig {
         bufferSize: Int = 64 * 1024, // 64KB default
         useTempFiles: Bool = false,
         compressionLevel: Int = 6,
-        windowBits: Int = 15
+        windowBits: Int = 15,
+        useMemoryMapping: Bool = false
     ) {
         self.bufferSize = bufferSize
         self.useTempFiles = useTempFiles
         self.compressionLevel = compressionLevel
         self.windowBits = windowBits
+        self.useMemoryMapping = useMemoryMapping
     }
 }
@@ -0,0 +1,180 @@
+//
+//  StreamMetrics.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+#if canImport(os)
+    import os
+#endif
+
+// MARK: - StreamMetrics
+
+/// Performance counters of one compression or decompression stream
+///
+/// Counters are always collected: each `deflate`/`inflate` call costs two clock reads and a few
+/// additions. They accumulate over the stream's lifetime, across `reset()`, until `resetMetrics()`
+/// is called on the owning `Compressor` or `Decompressor`.
+public struct StreamMetrics: Sendable, Equatable {
+    // MARK: Properties
+
+    /// Input bytes consumed by the C calls
+    public internal(set) var bytesIn: Int = 0
+    /// Output bytes produced by the C calls
+    public internal(set) var bytesOut: Int = 0
+    /// Number of `deflate` or `inflate` calls
+    public internal(set) var calls: Int = 0
+    /// Time spent inside the C calls, in nanoseconds
+    public internal(set) var callNanoseconds: UInt64 = 0
+    /// Number of times the accumulated output had to grow its storage
+    public internal(set) var bufferReallocations: Int = 0
+    /// Number of calls that returned `Z_BUF_ERROR` (no progress possible) before the loop retried
+    /// or ended
+    public internal(set) var bufferErrorRetries: Int = 0
+    /// Largest zlib state allocation observed, in bytes (window, hash tables and buffers)
+    public internal(set) var peakStateMemory: Int = 0
+
+    // MARK: Computed Properties
+
+    /// Time spent inside the C calls, in seconds
+    public var callDuration: TimeInterval {
+        TimeInterval(callNanoseconds) / 1_000_000_000
+    }
+
+    /// Output bytes per input byte, or 0 before any input
+    public var ratio: Double {
+        bytesIn > 0 ? Double(bytesOut) / Double(bytesIn) : 0
+    }
+
+    /// Input megabytes consumed per second of C time, or 0 before any call
+    public var throughputMBps: Double {
+        callNanoseconds > 0 ? Double(bytesIn) / 1_048_576 / callDuration : 0
+    }
+
+    // MARK: Lifecycle
+
+    public init() {}
+
+    // MARK: Functions
+
+    /// Run one `deflate`/`inflate` call and count it
+    /// - Parameters:
+    ///   - operation: Kind of call, for signposts
+    ///   - stream: Stream the call works on
+    ///   - call: The C call
+    /// - Returns: The call's zlib status
+    mutating func measure(_ operation: ZLibMetrics.Operation, _ stream: inout z_stream, _ call: (inout z_stream) -> Int32) -> Int32 {
+        let availIn = stream.avail_in
+        let availOut = stream.avail_out
+        let signpost = ZLibMetrics.signpostsEnabled ? ZLibMetrics.beginSignpost(operation) : nil
+        let start = DispatchTime.now().uptimeNanoseconds
+        let result = call(&stream)
+        callNanoseconds += DispatchTime.now().uptimeNanoseconds &- start
+        calls += 1
+        bytesIn += Int(availIn &- stream.avail_in)
+        bytesOut += Int(availOut &- stream.avail_out)
+        if result == Z_BUF_ERROR {
+            bufferErrorRetries += 1
+        }
+        if let signpost {
+            ZLibMetrics.endSignpost(operation, signpost, status: result)
+        }
+        return result
+    }
+
+    /// Record the current size of the stream's zlib state
+    mutating func noteStateMemory(_ bytes: Int) {
+        peakStateMemory = max(peakStateMemory, bytes)
+    }
+
+    /// Append output, growing its storage geometrically and counting each growth
+    /// - Parameters:
+    ///   - output: Accumulated output
+    ///   - reserved: Capacity reserved so far for `output`
+    ///   - bytes: Bytes to append
+    mutating func append(to output: inout Data, reserved: inout Int, _ bytes: UnsafeRawBufferPointer) {
+        let needed = output.count + bytes.count
+        if needed > reserved {
+            reserved = max(needed, reserved * 2, 4096)
+            output.reserveCapacity(reserved)
+            bufferReallocations += 1
+        }
+        output.append(contentsOf: bytes)
+    }
+}
+
+// MARK: - ZLibMetrics
+
+/// Export hooks for `StreamMetrics`
+///
+/// Like `ZLibVerboseConfig`, these are process-wide settings meant to be configured once at
+/// startup, before streams are in flight.
+public enum ZLibMetrics {
+    // MARK: Nested Types
+
+    /// Kind of C call being measured
+    public enum Operation: String, Sendable {
+        case deflate
+        case inflate
+    }
+
+    // MARK: Static Properties
+
+    /// Emit an `os_signpost` interval around every `deflate`/`inflate` call (Apple platforms
+    /// only), for the Points of Interest and os_signpost instruments
+    public static var signpostsEnabled: Bool = false
+
+    /// Called with a stream's metrics when it reaches `Z_STREAM_END`, to forward them to a
+    /// metrics backend
+    public static var reportHandler: ((Operation, StreamMetrics) -> Void)?
+
+    // MARK: Static Functions
+
+    /// Hand a finished stream's metrics to `reportHandler`
+    static func report(_ operation: Operation, _ metrics: StreamMetrics) {
+        reportHandler?(operation, metrics)
+    }
+
+    /// Begin a signpost interval; returns nil where signposts are unavailable
+    static func beginSignpost(_ operation: Operation) -> UInt64? {
+        #if canImport(os)
+            if #available(macOS 10.14, iOS 12.0, tvOS 12.0, watchOS 5.0, *) {
+                let log = SignpostLog.log
+                let id = OSSignpostID(log: log)
+                switch operation {
+                    case .deflate: os_signpost(.begin, log: log, name: "deflate", signpostID: id)
+                    case .inflate: os_signpost(.begin, log: log, name: "inflate", signpostID: id)
+                }
+                return id.rawValue
+            }
+        #endif
+        return nil
+    }
+
+    /// End a signpost interval started by `beginSignpost`
+    static func endSignpost(_ operation: Operation, _ rawID: UInt64, status: Int32) {
+        #if canImport(os)
+            if #available(macOS 10.14, iOS 12.0, tvOS 12.0, watchOS 5.0, *) {
+                let log = SignpostLog.log
+                let id = OSSignpostID(rawID)
+                switch operation {
+                    case .deflate: os_signpost(.end, log: log, name: "deflate", signpostID: id, "status %d", status)
+                    case .inflate: os_signpost(.end, log: log, name: "inflate", signpostID: id, "status %d", status)
+                }
+            }
+        #endif
+    }
+}
+
+#if canImport(os)
+    // MARK: - SignpostLog
+
+    @available(macOS 10.14, iOS 12.0, tvOS 12.0, watchOS 5.0, *)
+    private enum SignpostLog {
+        static let log = OSLog(subsystem: "com.swiftzlib", category: .pointsOfInterest)
+    }
+#endif
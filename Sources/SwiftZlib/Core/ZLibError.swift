@@ -30,6 +30,8 @@ public enum ZLibError: Error, LocalizedError {
     case bufferError
     /// File operation failed with the underlying error
     case fileError(Error)
+    /// Decompressed output would exceed the byte limit set by `maxOutputSize` or `maxExpansionRatio`
+    case outputLimitExceeded(limit: Int)
 
     // MARK: Computed Properties
 
@@ -56,6 +58,8 @@ public enum ZLibError: Error, LocalizedError {
                 "Buffer error during operation"
             case let .fileError(underlyingError):
                 "File operation failed: \(underlyingError.localizedDescription)"
+            case let .outputLimitExceeded(limit):
+                "Decompressed output exceeds the limit of \(limit) bytes"
         }
     }
 }
@@ -83,6 +83,9 @@ public final class ZLibStream {
                     memoryLevel: options.compression.memoryLevel,
                     strategy: options.compression.strategy
                 )
+                if let tuning = options.compression.tuning {
+                    try compressor?.tune(tuning)
+                }
 
                 if let dictionary = options.compression.dictionary {
                     try compressor?.setDictionary(dictionary)
@@ -90,6 +93,7 @@ public final class ZLibStream {
 
             case .decompress:
                 decompressor = Decompressor()
+                decompressor?.applyLimits(of: options.decompression)
                 try decompressor?.initializeAdvanced(windowBits: options.decompression.format.windowBits)
 
                 if let dictionary = options.decompression.dictionary {
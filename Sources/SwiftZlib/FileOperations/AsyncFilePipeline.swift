@@ -0,0 +1,317 @@
+//
+//  AsyncFilePipeline.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import Dispatch
+import Foundation
+
+// MARK: - FileReadAhead
+
+/// Reads a file through `DispatchIO` into a fixed ring of buffers, ahead of its consumer
+///
+/// A background task keeps up to `depth` chunks read and queued in an `AsyncBoundedChannel`
+/// while the consumer works on the current one, so the disk and the CPU overlap. The ring has
+/// `depth + 2` buffers, one for the chunk being read, up to `depth` queued and one held by the
+/// consumer, so no buffer is reused before the consumer asked for the next chunk and nothing is
+/// allocated per chunk. Call `close()` when done, also after an error.
+@available(macOS 10.15, iOS 13.0, tvOS 13.0, watchOS 6.0, *)
+final class FileReadAhead: @unchecked Sendable {
+    // MARK: Nested Types
+
+    /// One chunk of the file, valid until the next call to `next()`
+    struct Chunk {
+        // MARK: Properties
+
+        let bytes: UnsafeMutableRawPointer
+        let count: Int
+        /// Whether the chunk ended at the end of the file
+        let isLast: Bool
+
+        // MARK: Computed Properties
+
+        /// The chunk as `Data` viewing the ring buffer, without a copy
+        var data: Data {
+            Data(bytesNoCopy: bytes, count: count, deallocator: .none)
+        }
+    }
+
+    // MARK: Properties
+
+    let chunkSize: Int
+    let depth: Int
+
+    private let channel: DispatchIOChannel
+    private let queued: AsyncBoundedChannel<Chunk>
+    private let buffers: [UnsafeMutableRawPointer]
+    private var task: Task<Void, Never>?
+
+    // MARK: Lifecycle
+
+    /// Start reading
+    /// - Parameters:
+    ///   - handle: File to read from its start; it must stay open until `close()` returns
+    ///   - chunkSize: Bytes per chunk; only the last chunk is shorter
+    ///   - depth: Chunks read ahead of the consumer
+    init(handle: FileHandle, chunkSize: Int, depth: Int) {
+        self.chunkSize = max(chunkSize, 1)
+        self.depth = max(depth, 1)
+        channel = DispatchIOChannel(type: .random, handle: handle, label: "SwiftZlib.FileReadAhead")
+        queued = AsyncBoundedChannel(capacity: self.depth)
+        buffers = (0 ..< self.depth + 2).map { _ in
+            UnsafeMutableRawPointer.allocate(byteCount: max(chunkSize, 1), alignment: MemoryLayout<UInt64>.alignment)
+        }
+        task = Task { [self] in
+            await readAll()
+        }
+    }
+
+    deinit {
+        for buffer in buffers {
+            buffer.deallocate()
+        }
+    }
+
+    // MARK: Functions
+
+    /// Wait for the next chunk
+    /// - Returns: The chunk, or nil after the last one
+    /// - Throws: ZLibError.fileError if reading failed, CancellationError after `close()`
+    func next() async throws -> Chunk? {
+        try await queued.receive()
+    }
+
+    /// Stop reading and wait until no read is in flight and the channel is closed
+    func close() async {
+        queued.cancel()
+        await task?.value
+        task = nil
+        await channel.close()
+    }
+
+    // MARK: Private Functions
+
+    private func readAll() async {
+        var index = 0
+        var offset = 0
+        do {
+            while true {
+                let buffer = buffers[index % buffers.count]
+                let count = try await channel.read(into: buffer, length: chunkSize, at: offset)
+                let chunk = Chunk(bytes: buffer, count: count, isLast: count < chunkSize)
+                try await queued.send(chunk)
+                if chunk.isLast {
+                    break
+                }
+                index += 1
+                offset += count
+            }
+            queued.finish()
+        } catch {
+            queued.finish(throwing: error)
+        }
+    }
+}
+
+// MARK: - FileWriteBehind
+
+/// Appends to a file through `DispatchIO` without waiting for each write to complete
+///
+/// Up to `depth` writes are in flight; `write(_:)` only suspends beyond that, so the producer
+/// keeps compressing while earlier output reaches the disk. Errors surface from the next
+/// `write(_:)` or from `finish()`. Call `close()` when done, also after an error.
+@available(macOS 10.15, iOS 13.0, tvOS 13.0, watchOS 6.0, *)
+final class FileWriteBehind: @unchecked Sendable {
+    // MARK: Properties
+
+    let depth: Int
+
+    private let channel: DispatchIOChannel
+    private let lock = NSLock()
+    private var inFlight = 0
+    private var failure: Error?
+    private var waiter: (limit: Int, continuation: CheckedContinuation<Void, Never>)?
+
+    // MARK: Lifecycle
+
+    /// - Parameters:
+    ///   - handle: File to append to from its current position; it must stay open until `close()` returns
+    ///   - depth: Writes allowed in flight
+    init(handle: FileHandle, depth: Int) {
+        self.depth = max(depth, 1)
+        channel = DispatchIOChannel(type: .stream, handle: handle, label: "SwiftZlib.FileWriteBehind")
+    }
+
+    // MARK: Functions
+
+    /// Queue bytes for writing, suspending while `depth` writes are in flight
+    /// - Parameter data: Bytes to append; copied, so the caller may reuse its storage
+    /// - Throws: ZLibError.fileError if an earlier write failed
+    func write(_ data: Data) async throws {
+        guard !data.isEmpty else {
+            return
+        }
+        await waitForInFlight(atMost: depth - 1)
+        try reserveWrite()
+        let bytes = data.withUnsafeBytes { DispatchData(bytes: $0) }
+        channel.io.write(offset: 0, data: bytes, queue: channel.queue) { [self] done, _, error in
+            if done {
+                writeCompleted(error: error)
+            }
+        }
+    }
+
+    /// Wait until every queued write has completed
+    /// - Throws: ZLibError.fileError if any write failed
+    func finish() async throws {
+        await waitForInFlight(atMost: 0)
+        try reserveWrite(counting: false)
+    }
+
+    /// Wait for queued writes and close the channel
+    func close() async {
+        await waitForInFlight(atMost: 0)
+        await channel.close()
+    }
+
+    // MARK: Private Functions
+
+    private func reserveWrite(counting: Bool = true) throws {
+        lock.lock()
+        defer { lock.unlock() }
+        if let failure {
+            throw failure
+        }
+        if counting {
+            inFlight += 1
+        }
+    }
+
+    private func waitForInFlight(atMost limit: Int) async {
+        await withCheckedContinuation { (continuation: CheckedContinuation<Void, Never>) in
+            lock.lock()
+            if inFlight <= limit {
+                lock.unlock()
+                continuation.resume()
+            } else {
+                waiter = (limit, continuation)
+                lock.unlock()
+            }
+        }
+    }
+
+    private func writeCompleted(error: Int32) {
+        lock.lock()
+        inFlight -= 1
+        if error != 0, failure == nil {
+            failure = DispatchIOChannel.fileError(error)
+        }
+        var ready: CheckedContinuation<Void, Never>?
+        if let waiter, inFlight <= waiter.limit {
+            ready = waiter.continuation
+            self.waiter = nil
+        }
+        lock.unlock()
+        ready?.resume()
+    }
+}
+
+// MARK: - DispatchIOChannel
+
+/// `DispatchIO` channel over a `FileHandle`'s descriptor, closed asynchronously
+private final class DispatchIOChannel: @unchecked Sendable {
+    // MARK: Nested Types
+
+    /// Resumes a waiter once the channel's cleanup handler ran
+    private final class Cleanup: @unchecked Sendable {
+        // MARK: Properties
+
+        private let lock = NSLock()
+        private var isDone = false
+        private var waiter: CheckedContinuation<Void, Never>?
+
+        // MARK: Functions
+
+        func signal() {
+            lock.lock()
+            isDone = true
+            let waiter = waiter
+            self.waiter = nil
+            lock.unlock()
+            waiter?.resume()
+        }
+
+        func wait() async {
+            await withCheckedContinuation { (continuation: CheckedContinuation<Void, Never>) in
+                lock.lock()
+                if isDone {
+                    lock.unlock()
+                    continuation.resume()
+                } else {
+                    waiter = continuation
+                    lock.unlock()
+                }
+            }
+        }
+    }
+
+    // MARK: Properties
+
+    let io: DispatchIO
+    let queue: DispatchQueue
+
+    /// Keeps the descriptor open until the cleanup handler ran
+    private let handle: FileHandle
+    private let cleanup: Cleanup
+
+    // MARK: Lifecycle
+
+    init(type: DispatchIO.StreamType, handle: FileHandle, label: String) {
+        let cleanup = Cleanup()
+        self.cleanup = cleanup
+        self.handle = handle
+        queue = DispatchQueue(label: label)
+        io = DispatchIO(type: type, fileDescriptor: handle.fileDescriptor, queue: queue) { _ in
+            cleanup.signal()
+        }
+    }
+
+    // MARK: Static Functions
+
+    static func fileError(_ code: Int32) -> ZLibError {
+        ZLibError.fileError(NSError(domain: NSPOSIXErrorDomain, code: Int(code)))
+    }
+
+    // MARK: Functions
+
+    /// Read up to `length` bytes at `offset` into `buffer`
+    /// - Returns: Bytes read, less than `length` only at the end of the file
+    func read(into buffer: UnsafeMutableRawPointer, length: Int, at offset: Int) async throws -> Int {
+        try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Int, Error>) in
+            var filled = 0
+            io.read(offset: off_t(offset), length: length, queue: queue) { done, data, error in
+                if let data, !data.isEmpty {
+                    let count = min(data.count, length - filled)
+                    data.copyBytes(to: UnsafeMutableRawBufferPointer(start: buffer + filled, count: count), count: count)
+                    filled += count
+                }
+                guard done else {
+                    return
+                }
+                if error != 0 {
+                    continuation.resume(throwing: DispatchIOChannel.fileError(error))
+                } else {
+                    continuation.resume(returning: filled)
+                }
+            }
+        }
+    }
+
+    /// Close once pending operations are done and wait for the cleanup handler
+    func close() async {
+        io.close()
+        await cleanup.wait()
+    }
+}
@@ -15,13 +15,37 @@ public final class FileChunkedCompressor {
     public let bufferSize: Int
     public let compressionLevel: CompressionLevel
     public let windowBits: WindowBits
+    /// Number of worker threads; values above 1 enable block-parallel compression (see `ParallelCompressor`)
+    public let parallelism: Int
+    /// Uncompressed block size used when `parallelism` is above 1
+    public let parallelBlockSize: Int
+    /// Map the source file and feed it to zlib in place instead of reading `bufferSize` chunks
+    public let useMemoryMapping: Bool
+    /// Store chunks that look incompressible instead of deflating them (see `Compressor.skipsIncompressible`, default: false)
+    public let skipsIncompressible: Bool
+    /// Chunks the async variants read ahead, and writes they keep in flight, while compressing
+    public let readAheadDepth: Int
 
     // MARK: Lifecycle
 
-    public init(bufferSize: Int = 64 * 1024, compressionLevel: CompressionLevel = .defaultCompression, windowBits: WindowBits = .deflate) {
+    public init(
+        bufferSize: Int = 64 * 1024,
+        compressionLevel: CompressionLevel = .defaultCompression,
+        windowBits: WindowBits = .deflate,
+        parallelism: Int = 1,
+        parallelBlockSize: Int = ParallelCompressor.defaultBlockSize,
+        useMemoryMapping: Bool = false,
+        skipsIncompressible: Bool = false,
+        readAheadDepth: Int = 4
+    ) {
         self.bufferSize = bufferSize
         self.compressionLevel = compressionLevel
         self.windowBits = windowBits
+        self.parallelism = parallelism
+        self.parallelBlockSize = parallelBlockSize
+        self.useMemoryMapping = useMemoryMapping
+        self.skipsIncompressible = skipsIncompressible
+        self.readAheadDepth = max(readAheadDepth, 1)
     }
 
     // MARK: Functions
@@ -41,8 +65,16 @@ public final class FileChunkedCompressor {
         let output = try wrapFileError { try FileHandle(forWritingTo: URL(fileURLWithPath: destinationPath)) }
         defer { try? output.close() }
 
-        let compressor = Compressor()
-        try compressor.initializeAdvanced(level: compressionLevel, windowBits: windowBits)
+        if useMemoryMapping {
+            try compressMapped(sourcePath: sourcePath, output: output, progress: nil)
+            return
+        }
+        if parallelism > 1 {
+            try compressParallel(input: input, output: output, progress: nil)
+            return
+        }
+
+        let compressor = try makeCompressor()
 
         var isFinished = false
         while !isFinished {
@@ -75,13 +107,26 @@ public final class FileChunkedCompressor {
         let output = try wrapFileError { try FileHandle(forWritingTo: URL(fileURLWithPath: destinationPath)) }
         defer { try? output.close() }
 
-        let compressor = Compressor()
-        try compressor.initializeAdvanced(level: compressionLevel, windowBits: windowBits)
-
-        var processedBytes = 0
         let totalBytes = try input.seekToEnd()
         try input.seek(toOffset: 0)
 
+        if useMemoryMapping {
+            try compressMapped(sourcePath: sourcePath, output: output) { processed in
+                progress(processed, Int(totalBytes))
+            }
+            return
+        }
+        if parallelism > 1 {
+            try compressParallel(input: input, output: output) { processed in
+                progress(processed, Int(totalBytes))
+            }
+            return
+        }
+
+        let compressor = try makeCompressor()
+
+        var processedBytes = 0
+
         var isFinished = false
         while !isFinished {
             let chunk = input.readData(ofLength: bufferSize)
@@ -100,31 +145,31 @@ public final class FileChunkedCompressor {
     }
 
     /// Async version: Compress a file to another file using true streaming (constant memory)
+    ///
+    /// Reading, compression and writing run as a pipeline: the source is read `readAheadDepth`
+    /// chunks ahead and output is written behind through `DispatchIO`, so the compressor does
+    /// not wait for the disk.
     public func compressFile(from sourcePath: String, to destinationPath: String) async throws {
-        try await withCheckedThrowingContinuation { continuation in
-            do {
-                try compressFile(from: sourcePath, to: destinationPath)
-                continuation.resume()
-            } catch {
-                // The synchronous method already wraps errors in ZLibError, so we can pass through
-                continuation.resume(throwing: error)
-            }
+        guard !useMemoryMapping, parallelism <= 1 else {
+            return try compressFile(from: sourcePath, to: destinationPath)
         }
+        try await compressPipelined(from: sourcePath, to: destinationPath) { _, _, _ in }
     }
 
     /// Async version: Compress a file to another file using true streaming with progress tracking
+    ///
+    /// Runs the same read-ahead/write-behind pipeline as `compressFile(from:to:)`.
     public func compressFile(
         from sourcePath: String,
         to destinationPath: String,
         progress: @escaping (Int, Int) -> Void
     ) async throws {
-        try await withCheckedThrowingContinuation { continuation in
-            do {
-                try compressFile(from: sourcePath, to: destinationPath, progress: progress)
-                continuation.resume()
-            } catch {
-                // The synchronous method already wraps errors in ZLibError, so we can pass through
-                continuation.resume(throwing: error)
+        guard !useMemoryMapping, parallelism <= 1 else {
+            return try compressFile(from: sourcePath, to: destinationPath, progress: progress)
+        }
+        try await compressPipelined(from: sourcePath, to: destinationPath) { processedBytes, totalBytes, isStart in
+            if !isStart {
+                progress(processedBytes, totalBytes)
             }
         }
     }
@@ -150,8 +195,7 @@ public final class FileChunkedCompressor {
         let output = try wrapFileError { try FileHandle(forWritingTo: URL(fileURLWithPath: destinationPath)) }
         defer { try? output.close() }
 
-        let compressor = Compressor()
-        try compressor.initializeAdvanced(level: compressionLevel, windowBits: windowBits)
+        let compressor = try makeCompressor()
 
         let totalBytes = try Int(input.seekToEnd())
         try input.seek(toOffset: 0)
@@ -238,29 +282,10 @@ public final class FileChunkedCompressor {
         return AsyncThrowingStream<ProgressInfo, Error> { continuation in
             holder.task = Task {
                 do {
-                    let input = try FileHandle(forReadingFrom: URL(fileURLWithPath: sourcePath))
-                    defer { try? input.close() }
-                    try wrapFileError {
-                        guard FileManager.default.createFile(atPath: destinationPath, contents: nil) else {
-                            throw NSError(domain: NSCocoaErrorDomain, code: NSFileWriteUnknownError, userInfo: [
-                                NSLocalizedDescriptionKey: "Failed to create destination file at \(destinationPath)",
-                            ])
-                        }
-                    }
-                    let output = try FileHandle(forWritingTo: URL(fileURLWithPath: destinationPath))
-                    defer { try? output.close() }
-
-                    let compressor = Compressor()
-                    try compressor.initializeAdvanced(level: compressionLevel, windowBits: windowBits)
-
-                    let totalBytes = try Int(input.seekToEnd())
-                    try input.seek(toOffset: 0)
                     var processedBytes = 0
+                    var totalBytes = 0
                     var lastReport = Date()
                     let startTime = Date()
-                    var phase: CompressionPhase = .reading
-                    var isFinished = false
-                    var firstIteration = true
 
                     func reportProgress(phase: CompressionPhase) {
                         let now = Date()
@@ -280,32 +305,17 @@ public final class FileChunkedCompressor {
                         continuation.yield(info)
                     }
 
-                    while !isFinished {
-                        try Task.checkCancellation()
-
-                        phase = .reading
+                    try await compressPipelined(from: sourcePath, to: destinationPath) { processed, total, isStart in
+                        processedBytes = processed
+                        totalBytes = total
                         let now = Date()
-                        if firstIteration || now.timeIntervalSince(lastReport) >= progressInterval {
-                            reportProgress(phase: phase)
+                        if isStart {
+                            reportProgress(phase: .reading)
+                        } else if processed == total || now.timeIntervalSince(lastReport) >= progressInterval {
+                            reportProgress(phase: processed == total ? .writing : .compressing)
                             lastReport = now
-                            firstIteration = false
-                        }
-                        let chunk = input.readData(ofLength: bufferSize)
-                        let isLast = chunk.count < bufferSize
-                        phase = .compressing
-                        let flush: FlushMode = isLast ? .finish : .noFlush
-                        let compressed = try compressor.compress(chunk, flush: flush)
-                        phase = .writing
-                        if !compressed.isEmpty {
-                            try output.write(contentsOf: compressed)
-                        }
-                        processedBytes += chunk.count
-                        if isLast {
-                            reportProgress(phase: phase)
                         }
-                        if isLast { isFinished = true }
                     }
-                    phase = .flushing
                     reportProgress(phase: .finished)
                     continuation.finish()
                 } catch {
@@ -320,6 +330,122 @@ public final class FileChunkedCompressor {
         }
     }
 
+    /// Read-ahead/compress/write-behind pipeline behind the async `compressFile` variants
+    ///
+    /// `progress` gets the bytes read so far, the file size, and whether this is the report
+    /// before the first chunk; it runs between chunks, while the next reads and earlier writes
+    /// are in flight.
+    private func compressPipelined(
+        from sourcePath: String,
+        to destinationPath: String,
+        progress: (_ processedBytes: Int, _ totalBytes: Int, _ isStart: Bool) throws -> Void
+    ) async throws {
+        let input = try wrapFileError { try FileHandle(forReadingFrom: URL(fileURLWithPath: sourcePath)) }
+        defer { try? input.close() }
+        try wrapFileError {
+            guard FileManager.default.createFile(atPath: destinationPath, contents: nil) else {
+                throw NSError(domain: NSCocoaErrorDomain, code: NSFileWriteUnknownError, userInfo: [
+                    NSLocalizedDescriptionKey: "Failed to create destination file at \(destinationPath)",
+                ])
+            }
+        }
+        let output = try wrapFileError { try FileHandle(forWritingTo: URL(fileURLWithPath: destinationPath)) }
+        defer { try? output.close() }
+
+        let totalBytes = try wrapFileError { try Int(input.seekToEnd()) }
+        let compressor = try makeCompressor()
+        try progress(0, totalBytes, true)
+
+        let reader = FileReadAhead(handle: input, chunkSize: bufferSize, depth: readAheadDepth)
+        let writer = FileWriteBehind(handle: output, depth: readAheadDepth)
+        do {
+            var processedBytes = 0
+            while let chunk = try await reader.next() {
+                let compressed = try compressor.compress(chunk.data, flush: chunk.isLast ? .finish : .noFlush)
+                try await writer.write(compressed)
+                processedBytes += chunk.count
+                try progress(processedBytes, totalBytes, false)
+            }
+            try await writer.finish()
+        } catch {
+            await reader.close()
+            await writer.close()
+            throw error
+        }
+        await reader.close()
+        await writer.close()
+    }
+
+    /// Block-parallel path shared by the `compressFile` variants when `parallelism > 1`
+    private func compressParallel(input: FileHandle, output: FileHandle, progress: ((Int) -> Void)?) throws {
+        let engine = ParallelCompressor(
+            level: compressionLevel,
+            windowBits: windowBits,
+            blockSize: parallelBlockSize,
+            threadCount: parallelism,
+            skipsIncompressible: skipsIncompressible
+        )
+        try engine.compress(
+            reader: { length in input.readData(ofLength: length) },
+            writer: { data in
+                if !data.isEmpty {
+                    try self.wrapFileError { try output.write(contentsOf: data) }
+                }
+            },
+            progress: progress
+        )
+    }
+
+    /// Memory-mapped path shared by the `compressFile` variants when `useMemoryMapping` is set
+    private func compressMapped(sourcePath: String, output: FileHandle, progress: ((Int) -> Void)?) throws {
+        let source = try MappedFile(path: sourcePath)
+        guard parallelism > 1 else {
+            try MappedFileCodec.compress(
+                source,
+                to: output,
+                level: compressionLevel.zlibLevel,
+                windowBits: windowBits.zlibWindowBits,
+                bufferSize: bufferSize,
+                skipsIncompressible: skipsIncompressible,
+                progress: progress
+            )
+            return
+        }
+
+        // Parallel blocks become no-copy views into the mapping
+        let engine = ParallelCompressor(
+            level: compressionLevel,
+            windowBits: windowBits,
+            blockSize: parallelBlockSize,
+            threadCount: parallelism,
+            skipsIncompressible: skipsIncompressible
+        )
+        var offset = 0
+        try engine.compress(
+            reader: { length in
+                let count = min(length, source.bytes.count - offset)
+                guard count > 0, let base = source.bytes.baseAddress else {
+                    return Data()
+                }
+                defer { offset += count }
+                return Data(bytesNoCopy: UnsafeMutableRawPointer(mutating: base + offset), count: count, deallocator: .none)
+            },
+            writer: { data in
+                if !data.isEmpty {
+                    try self.wrapFileError { try output.write(contentsOf: data) }
+                }
+            },
+            progress: progress
+        )
+    }
+
+    private func makeCompressor() throws -> Compressor {
+        let compressor = Compressor()
+        compressor.skipsIncompressible = skipsIncompressible
+        try compressor.initializeAdvanced(level: compressionLevel, windowBits: windowBits)
+        return compressor
+    }
+
     @discardableResult
     private func wrapFileError<T>(_ operation: () throws -> T) throws -> T {
         do {
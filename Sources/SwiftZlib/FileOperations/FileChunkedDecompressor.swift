@@ -13,12 +13,19 @@ public final class FileChunkedDecompressor {
 
     public let bufferSize: Int
     public let windowBits: WindowBits
+    /// Map the source file and feed it to zlib in place instead of reading `bufferSize` chunks
+    public let useMemoryMapping: Bool
+    /// Number of worker threads; values above 1 decode multi-member gzip input with `ParallelGzipDecompressor`,
+    /// and gzip input from `ParallelInflater.recommendedMinimumInputSize` on with `ParallelInflater`
+    public let parallelism: Int
 
     // MARK: Lifecycle
 
-    public init(bufferSize: Int = 64 * 1024, windowBits: WindowBits = .deflate) {
+    public init(bufferSize: Int = 64 * 1024, windowBits: WindowBits = .deflate, useMemoryMapping: Bool = false, parallelism: Int = 1) {
         self.bufferSize = bufferSize
         self.windowBits = windowBits
+        self.useMemoryMapping = useMemoryMapping
+        self.parallelism = parallelism
     }
 
     // MARK: Functions
@@ -37,6 +44,17 @@ public final class FileChunkedDecompressor {
         let output = try wrapFileError { try FileHandle(forWritingTo: URL(fileURLWithPath: destinationPath)) }
         defer { try? output.close() }
 
+        if parallelism > 1, windowBits == .gzip || windowBits == .auto,
+           try decompressParallel(sourcePath: sourcePath, output: output)
+        {
+            return
+        }
+
+        if useMemoryMapping {
+            try decompressMapped(sourcePath: sourcePath, output: output, progress: nil)
+            return
+        }
+
         let decompressor = Decompressor()
         try decompressor.initializeAdvanced(windowBits: windowBits)
 
@@ -71,13 +89,20 @@ public final class FileChunkedDecompressor {
         let output = try wrapFileError { try FileHandle(forWritingTo: URL(fileURLWithPath: destinationPath)) }
         defer { try? output.close() }
 
-        let decompressor = Decompressor()
-        try decompressor.initializeAdvanced(windowBits: windowBits)
-
         var processedBytes = 0
         let totalBytes = try input.seekToEnd()
         try input.seek(toOffset: 0)
 
+        if useMemoryMapping {
+            try decompressMapped(sourcePath: sourcePath, output: output) { processed in
+                progress(processed, Int(totalBytes))
+            }
+            return
+        }
+
+        let decompressor = Decompressor()
+        try decompressor.initializeAdvanced(windowBits: windowBits)
+
         var isFinished = false
         while !isFinished {
             let chunk = input.readData(ofLength: bufferSize)
@@ -342,6 +367,43 @@ public final class FileChunkedDecompressor {
         return stream
     }
 
+    /// Memory-mapped path shared by the `decompressFile` variants when `useMemoryMapping` is set
+    private func decompressMapped(sourcePath: String, output: FileHandle, progress: ((Int) -> Void)?) throws {
+        let source = try MappedFile(path: sourcePath)
+        try MappedFileCodec.decompress(
+            source,
+            to: output,
+            windowBits: windowBits.zlibWindowBits,
+            bufferSize: bufferSize,
+            progress: progress
+        )
+    }
+
+    /// Parallel path for gzip sources; returns false when the source is better streamed
+    ///
+    /// Large sources are usually one big member, which only speculative decoding can split. Smaller
+    /// sources are decoded member by member, so one with a single member, or that is not gzip at all,
+    /// is left to the constant-memory streaming path.
+    private func decompressParallel(sourcePath: String, output: FileHandle) throws -> Bool {
+        let source = try MappedFile(path: sourcePath)
+        guard ParallelGzipDecompressor.isMemberHeader(source.bytes, at: 0) else {
+            return false
+        }
+        let isLarge = source.bytes.count >= ParallelInflater.recommendedMinimumInputSize
+        guard isLarge || ParallelGzipDecompressor.hasMemberCandidate(source.bytes, after: 0) else {
+            return false
+        }
+        let write: (Data) throws -> Void = { chunk in
+            try self.wrapFileError { try output.write(contentsOf: chunk) }
+        }
+        if isLarge {
+            try ParallelInflater(windowBits: .gzip, threadCount: parallelism).decompress(source.bytes, writer: write)
+        } else {
+            try ParallelGzipDecompressor(threadCount: parallelism).decompress(source.bytes, writer: write)
+        }
+        return true
+    }
+
     @discardableResult
     private func wrapFileError<T>(_ operation: () throws -> T) throws -> T {
         do {
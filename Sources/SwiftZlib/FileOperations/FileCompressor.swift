@@ -24,6 +24,10 @@ public final class FileCompressor {
 
     /// Compress a file to another file
     public func compressFile(from sourcePath: String, to destinationPath: String) throws {
+        if config.useMemoryMapping {
+            try compressMapped(from: sourcePath, to: destinationPath, progress: nil)
+            return
+        }
         let sourceData = try Data(contentsOf: URL(fileURLWithPath: sourcePath))
         let compressedData = try ZLib.compress(sourceData)
         try compressedData.write(to: URL(fileURLWithPath: destinationPath))
@@ -41,10 +45,47 @@ public final class FileCompressor {
         to destinationPath: String,
         progress: @escaping (Int, Int) -> Void
     ) throws {
+        if config.useMemoryMapping {
+            try compressMapped(from: sourcePath, to: destinationPath, progress: progress)
+            return
+        }
         let sourceData = try Data(contentsOf: URL(fileURLWithPath: sourcePath))
         progress(sourceData.count, sourceData.count)
 
         let compressedData = try ZLib.compress(sourceData)
         try compressedData.write(to: URL(fileURLWithPath: destinationPath))
     }
+
+    // MARK: Private Functions
+
+    /// Stream a mapped source through zlib using `config.compressionLevel`/`config.windowBits`
+    private func compressMapped(
+        from sourcePath: String,
+        to destinationPath: String,
+        progress: ((Int, Int) -> Void)?
+    ) throws {
+        let source = try MappedFile(path: sourcePath)
+        guard FileManager.default.createFile(atPath: destinationPath, contents: nil) else {
+            throw ZLibError.fileError(NSError(domain: NSCocoaErrorDomain, code: NSFileWriteUnknownError, userInfo: [
+                NSLocalizedDescriptionKey: "Failed to create destination file at \(destinationPath)",
+            ]))
+        }
+        let output: FileHandle
+        do {
+            output = try FileHandle(forWritingTo: URL(fileURLWithPath: destinationPath))
+        } catch {
+            throw ZLibError.fileError(error)
+        }
+        defer { try? output.close() }
+
+        try MappedFileCodec.compress(
+            source,
+            to: output,
+            level: Int32(config.compressionLevel),
+            windowBits: Int32(config.windowBits),
+            bufferSize: config.bufferSize
+        ) { processed in
+            progress?(processed, source.bytes.count)
+        }
+    }
 }
@@ -0,0 +1,344 @@
+//
+//  GzipAppendWriter.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+/// Append-friendly gzip writer that continues one deflate stream across sessions
+///
+/// Reopening a gzip file in append mode (`GzipFile` with "ab") starts a new member with an empty
+/// window, so short appends compress poorly. This writer keeps one member open instead. Each
+/// `append(_:)` ends with a sync flush, which byte-aligns the deflate output. The flushed output
+/// is followed by an empty final block and the gzip trailer, so the file is complete and valid
+/// between appends. The next append overwrites those 10 bytes and carries on with the stream.
+///
+/// After every append a checkpoint is saved next to the file (`<path>.gzstate`). It holds the
+/// deflate window (the last 32 KB of input, from `deflateGetDictionary`), the running CRC-32 and
+/// length, and the file size. A later process resumes by priming a raw deflate stream with that
+/// window, so matches keep reaching into earlier records and nothing already written is
+/// recompressed. If the checkpoint is missing or no longer matches the file, a new member is
+/// started after the existing data, as gzip's own append does.
+public final class GzipAppendWriter {
+    // MARK: Nested Types
+
+    /// Resumable state saved after each append
+    private struct Checkpoint {
+        // MARK: Static Properties
+
+        /// "SZGA", little-endian
+        static let magic: UInt32 = 0x4147_5A53
+        static let version: UInt32 = 1
+        /// magic, version, file size, CRC-32, length, dictionary length
+        static let headerSize = 32
+
+        // MARK: Properties
+
+        /// Size of the gzip file when the checkpoint was taken
+        let fileSize: UInt64
+        let crc: UInt32
+        let length: UInt64
+        let dictionary: Data
+
+        // MARK: Lifecycle
+
+        init(fileSize: UInt64, crc: UInt32, length: UInt64, dictionary: Data) {
+            self.fileSize = fileSize
+            self.crc = crc
+            self.length = length
+            self.dictionary = dictionary
+        }
+
+        init?(decoding data: Data) {
+            guard data.count >= Self.headerSize,
+                  readLittleEndian(UInt32.self, from: data, at: 0) == Self.magic,
+                  readLittleEndian(UInt32.self, from: data, at: 4) == Self.version
+            else {
+                return nil
+            }
+            let dictionaryLength = Int(readLittleEndian(UInt32.self, from: data, at: 28))
+            guard dictionaryLength <= GzipAppendWriter.windowSize, data.count == Self.headerSize + dictionaryLength else {
+                return nil
+            }
+            fileSize = readLittleEndian(UInt64.self, from: data, at: 8)
+            crc = readLittleEndian(UInt32.self, from: data, at: 16)
+            length = readLittleEndian(UInt64.self, from: data, at: 20)
+            dictionary = data.subdata(in: data.startIndex + Self.headerSize ..< data.endIndex)
+        }
+
+        // MARK: Functions
+
+        func encoded() -> Data {
+            var data = Data(capacity: Self.headerSize + dictionary.count)
+            appendLittleEndian(Self.magic, to: &data)
+            appendLittleEndian(Self.version, to: &data)
+            appendLittleEndian(fileSize, to: &data)
+            appendLittleEndian(crc, to: &data)
+            appendLittleEndian(length, to: &data)
+            appendLittleEndian(UInt32(dictionary.count), to: &data)
+            data.append(dictionary)
+            return data
+        }
+    }
+
+    // MARK: Static Properties
+
+    /// File extension appended to a gzip path to locate its checkpoint
+    public static let checkpointExtension = "gzstate"
+
+    /// Deflate window carried from one session to the next
+    static let windowSize = 32 * 1024
+
+    /// ID1 ID2 CM FLG MTIME(4) XFL OS
+    private static let memberHeader = Data([0x1F, 0x8B, 0x08, 0x00, 0, 0, 0, 0, 0, 0x03])
+
+    /// Empty final block (fixed Huffman, end-of-block only) plus CRC-32 and ISIZE
+    private static let tailSize = 10
+
+    // MARK: Properties
+
+    public let path: String
+    public let level: CompressionLevel
+    public let strategy: CompressionStrategy
+
+    /// Whether the previous session's member was continued rather than a new member started
+    public let isResumed: Bool
+
+    /// CRC-32 of the current member's uncompressed data
+    public private(set) var crc32: uLong
+
+    /// Uncompressed bytes in the current member, across sessions
+    public private(set) var uncompressedSize: Int
+
+    private var compressor = Compressor()
+    private var handle: FileHandle?
+
+    /// Offset of the empty final block, where the next append's output goes
+    private var streamEnd: UInt64
+
+    /// Deflate window at the last checkpoint
+    private var dictionary: Data
+
+    // MARK: Lifecycle
+
+    /// Open a gzip file for appending, resuming its last member when a valid checkpoint exists
+    /// - Parameters:
+    ///   - path: Gzip file; created if it does not exist
+    ///   - level: Compression level for appended data
+    ///   - strategy: Compression strategy for appended data
+    /// - Throws: GzipFileError if the file cannot be opened or written, ZLibError if deflate fails
+    public init(
+        path: String,
+        level: CompressionLevel = .defaultCompression,
+        strategy: CompressionStrategy = .defaultStrategy
+    ) throws {
+        if !FileManager.default.fileExists(atPath: path) {
+            guard FileManager.default.createFile(atPath: path, contents: nil) else {
+                throw GzipFileError.openFailed(path)
+            }
+        }
+        let file: FileHandle
+        let fileSize: UInt64
+        do {
+            file = try FileHandle(forUpdating: URL(fileURLWithPath: path))
+            fileSize = try file.seekToEnd()
+        } catch {
+            throw GzipFileError.openFailed(path)
+        }
+
+        self.path = path
+        self.level = level
+        self.strategy = strategy
+        handle = file
+        if let checkpoint = Self.loadCheckpoint(for: path, from: file, fileSize: fileSize) {
+            isResumed = true
+            crc32 = uLong(checkpoint.crc)
+            uncompressedSize = Int(checkpoint.length)
+            streamEnd = checkpoint.fileSize - UInt64(Self.tailSize)
+            dictionary = checkpoint.dictionary
+        } else {
+            isResumed = false
+            crc32 = 0
+            uncompressedSize = 0
+            streamEnd = fileSize + UInt64(Self.memberHeader.count)
+            dictionary = Data()
+        }
+
+        if !isResumed {
+            try write(Self.memberHeader + Self.tail(crc: 0, size: 0), at: fileSize)
+            saveCheckpoint()
+        }
+        try startStream()
+        zlibInfo("Gzip append writer for \(path): \(isResumed ? "resumed member at \(uncompressedSize) bytes" : "new member")")
+    }
+
+    deinit {
+        try? handle?.close()
+    }
+
+    // MARK: Static Functions
+
+    /// Path of the checkpoint for a gzip file
+    /// - Parameter path: Path of the gzip file
+    /// - Returns: `path` with `.gzstate` appended
+    public static func checkpointPath(for path: String) -> String {
+        "\(path).\(checkpointExtension)"
+    }
+
+    // MARK: Functions
+
+    /// Compress and append data, leaving a complete gzip file and a fresh checkpoint
+    ///
+    /// If the write fails, the previous end of the file is restored and the stream restarts from
+    /// the last checkpoint, so the file stays valid and the call can be retried.
+    /// - Parameter data: Uncompressed data to append
+    /// - Throws: GzipFileError if the file cannot be written, ZLibError if deflate fails
+    public func append(_ data: Data) throws {
+        guard handle != nil else {
+            throw GzipFileError.writeFailed("\(path) is closed")
+        }
+        guard !data.isEmpty else {
+            return
+        }
+
+        let compressed = try compressor.compress(data, flush: .syncFlush)
+        // A sync flush leaves no bits pending, so the stream can be continued at a byte boundary
+        let pending = try compressor.getPending()
+        guard pending.pending == 0, pending.bits == 0 else {
+            throw ZLibError.streamError(Z_STREAM_ERROR)
+        }
+
+        let newCRC = ZLib.crc32(data, initialValue: crc32)
+        let newSize = uncompressedSize + data.count
+        do {
+            try write(compressed + Self.tail(crc: newCRC, size: newSize), at: streamEnd)
+        } catch {
+            try rollBack()
+            throw error
+        }
+
+        streamEnd += UInt64(compressed.count)
+        crc32 = newCRC
+        uncompressedSize = newSize
+        dictionary = try compressor.getDictionary()
+        saveCheckpoint()
+    }
+
+    /// Close the file; the last checkpoint stays in place for the next session
+    /// - Throws: GzipFileError if closing fails
+    public func close() throws {
+        guard let file = handle else {
+            return
+        }
+        handle = nil
+        do {
+            try file.close()
+        } catch {
+            throw GzipFileError.closeFailed(path)
+        }
+    }
+
+    // MARK: Private Static Functions
+
+    /// Load the checkpoint for a file if it still describes the file's current contents
+    private static func loadCheckpoint(for path: String, from file: FileHandle, fileSize: UInt64) -> Checkpoint? {
+        let checkpointPath = Self.checkpointPath(for: path)
+        guard let data = FileManager.default.contents(atPath: checkpointPath) else {
+            return nil
+        }
+        guard let checkpoint = Checkpoint(decoding: data),
+              checkpoint.fileSize == fileSize,
+              fileSize >= UInt64(memberHeader.count + tailSize)
+        else {
+            zlibWarning("Ignoring stale or unreadable gzip append checkpoint at \(checkpointPath)")
+            return nil
+        }
+
+        // The file must still end with the final block and trailer this checkpoint wrote
+        let expected = tail(crc: uLong(checkpoint.crc), size: Int(truncatingIfNeeded: checkpoint.length))
+        let actual: Data?
+        do {
+            try file.seek(toOffset: fileSize - UInt64(tailSize))
+            actual = try file.read(upToCount: tailSize)
+        } catch {
+            actual = nil
+        }
+        guard actual == expected else {
+            zlibWarning("Gzip file \(path) no longer ends where its append checkpoint does; starting a new member")
+            return nil
+        }
+        return checkpoint
+    }
+
+    /// Empty final block followed by the gzip trailer
+    private static func tail(crc: uLong, size: Int) -> Data {
+        var data = Data([0x03, 0x00])
+        appendLittleEndian(UInt32(truncatingIfNeeded: crc), to: &data)
+        appendLittleEndian(UInt32(truncatingIfNeeded: size), to: &data)
+        return data
+    }
+
+    // MARK: Private Functions
+
+    /// Start a raw deflate stream primed with the window of the last checkpoint
+    private func startStream() throws {
+        try compressor.initializeAdvanced(level: level, windowBits: .raw, strategy: strategy)
+        if !dictionary.isEmpty {
+            try compressor.setDictionary(dictionary)
+        }
+    }
+
+    /// Restore the file and stream to the last checkpoint after a failed append
+    private func rollBack() throws {
+        try? handle?.truncate(atOffset: streamEnd)
+        try? write(Self.tail(crc: crc32, size: uncompressedSize), at: streamEnd)
+        // The compressor has consumed the input, so it restarts from the saved window
+        compressor = Compressor()
+        try startStream()
+    }
+
+    private func write(_ data: Data, at offset: UInt64) throws {
+        guard let file = handle else {
+            throw GzipFileError.writeFailed("\(path) is closed")
+        }
+        do {
+            try file.seek(toOffset: offset)
+            try file.write(contentsOf: data)
+        } catch {
+            throw GzipFileError.writeFailed(path)
+        }
+    }
+
+    /// Save the checkpoint; a failure only costs ratio, since the next session then starts a new member
+    private func saveCheckpoint() {
+        let checkpoint = Checkpoint(
+            fileSize: streamEnd + UInt64(Self.tailSize),
+            crc: UInt32(truncatingIfNeeded: crc32),
+            length: UInt64(uncompressedSize),
+            dictionary: dictionary
+        )
+        let checkpointPath = Self.checkpointPath(for: path)
+        do {
+            try checkpoint.encoded().write(to: URL(fileURLWithPath: checkpointPath), options: .atomic)
+        } catch {
+            zlibWarning("Could not save gzip append checkpoint to \(checkpointPath): \(error)")
+        }
+    }
+}
+
+// MARK: - Little-Endian Helpers
+
+private func appendLittleEndian<T: FixedWidthInteger>(_ value: T, to data: inout Data) {
+    withUnsafeBytes(of: value.littleEndian) { data.append(contentsOf: $0) }
+}
+
+private func readLittleEndian<T: FixedWidthInteger>(_: T.Type, from data: Data, at offset: Int) -> T {
+    var value: T = 0
+    for index in 0 ..< MemoryLayout<T>.size {
+        value |= T(data[data.startIndex + offset + index]) << (8 * index)
+    }
+    return value
+}
@@ -0,0 +1,372 @@
+//
+//  GzipIndex.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+/// Random-access index over a gzip, zlib or raw deflate stream
+///
+/// The index records an inflate checkpoint roughly every `span` uncompressed bytes: the
+/// compressed offset of a deflate block boundary, the bit position within that byte and the
+/// 32 KB of history needed to resume decoding there. Reading at an arbitrary offset then only
+/// inflates from the nearest checkpoint instead of from the start of the file.
+///
+/// Each checkpoint stores its window uncompressed, so an index costs about 32 KB per
+/// checkpoint; a 1 MB span keeps it near 3% of the uncompressed size.
+public final class GzipIndex {
+    // MARK: Static Properties
+
+    /// Default distance between checkpoints in uncompressed bytes
+    public static let defaultSpan = 1 << 20
+
+    /// File extension appended to a gzip path to locate its sidecar index
+    public static let sidecarExtension = "gzidx"
+
+    /// Bytes at each end of the source covered by the checksum `matches(fileAt:)` compares
+    static let fingerprintLength = 64 * 1024
+
+    // MARK: Properties
+
+    internal let pointer: OpaquePointer
+
+    // MARK: Computed Properties
+
+    /// Total uncompressed size of the indexed stream (all gzip members)
+    public var uncompressedSize: Int {
+        Int(swift_zran_length(pointer))
+    }
+
+    /// Compressed bytes of the indexed stream, up to the end of its last member
+    public var compressedSize: Int {
+        Int(swift_zran_stream_size(pointer))
+    }
+
+    /// Size of the file or data the index was built from, including any bytes after the stream
+    public var sourceSize: Int {
+        Int(swift_zran_source_size(pointer))
+    }
+
+    /// Number of recorded checkpoints
+    public var checkpointCount: Int {
+        Int(swift_zran_count(pointer))
+    }
+
+    /// Requested distance between checkpoints in uncompressed bytes
+    public var span: Int {
+        Int(swift_zran_span(pointer))
+    }
+
+    /// Detected stream format of the indexed data
+    public var windowBits: WindowBits {
+        switch swift_zran_mode(pointer) {
+            case 31: .gzip
+            case 15: .deflate
+            default: .raw
+        }
+    }
+
+    // MARK: Lifecycle
+
+    private init(pointer: OpaquePointer) {
+        self.pointer = pointer
+    }
+
+    /// Load an index previously saved with `write(to:)`
+    /// - Parameter path: Path of the index file
+    /// - Throws: GzipFileError if the file cannot be read, `ZLibError.invalidData` if it is not a valid index
+    public convenience init(contentsOf path: String) throws {
+        guard let file = fopen(path, "rb") else {
+            throw GzipFileError.openFailed(path)
+        }
+        defer { fclose(file) }
+
+        var loaded: OpaquePointer?
+        let result = swift_zran_load(file, &loaded)
+        switch result {
+            case Z_OK:
+                break
+            case Z_MEM_ERROR:
+                throw ZLibError.memoryError
+            case Z_ERRNO:
+                throw GzipFileError.readFailed(path)
+            default:
+                throw ZLibError.invalidData
+        }
+        guard let loaded else {
+            throw ZLibError.invalidData
+        }
+        self.init(pointer: loaded)
+    }
+
+    deinit {
+        swift_zran_free(pointer)
+    }
+
+    // MARK: Static Functions
+
+    /// Build an index for a compressed file in a single streaming pass
+    /// - Parameters:
+    ///   - path: Path of the gzip, zlib or raw deflate file
+    ///   - span: Distance between checkpoints in uncompressed bytes
+    /// - Returns: The built index
+    /// - Throws: GzipFileError if the file cannot be opened, ZLibError if the stream is invalid or truncated
+    public static func build(forFileAt path: String, span: Int = defaultSpan) throws -> GzipIndex {
+        guard let file = fopen(path, "rb") else {
+            throw GzipFileError.openFailed(path)
+        }
+        defer { fclose(file) }
+
+        // Taken before the pass, so a write during it leaves the index stale rather than trusted
+        let modificationTime = modificationTime(ofFileAt: path)
+        zlibInfo("Building gzip index for \(path) (span: \(span))")
+        var built: OpaquePointer?
+        let result = withTiming("Gzip index build") {
+            swift_zran_build_file(file, Int64(span), &built)
+        }
+        let index = try wrap(result, built)
+        guard let checksum = fingerprint(ofFileAt: path, size: index.sourceSize) else {
+            throw GzipFileError.readFailed(path)
+        }
+        swift_zran_set_source(index.pointer, modificationTime ?? 0, uLong(checksum))
+        return index
+    }
+
+    /// Build an index for compressed data held in memory
+    /// - Parameters:
+    ///   - data: Gzip, zlib or raw deflate data
+    ///   - span: Distance between checkpoints in uncompressed bytes
+    /// - Returns: The built index
+    /// - Throws: ZLibError if the stream is invalid or truncated
+    public static func build(for data: Data, span: Int = defaultSpan) throws -> GzipIndex {
+        var built: OpaquePointer?
+        let result = data.withUnsafeBytes { buffer in
+            swift_zran_build_buffer(buffer.bindMemory(to: UInt8.self).baseAddress, buffer.count, Int64(span), &built)
+        }
+        let index = try wrap(result, built)
+        // No modification time; a sidecar saved from it is matched on size and checksum alone
+        let checksum = data.withUnsafeBytes { fingerprint(of: $0) }
+        swift_zran_set_source(index.pointer, 0, uLong(checksum))
+        return index
+    }
+
+    /// Path of the sidecar index for a gzip file
+    /// - Parameter path: Path of the gzip file
+    /// - Returns: `path` with `.gzidx` appended
+    public static func sidecarPath(for path: String) -> String {
+        "\(path).\(sidecarExtension)"
+    }
+
+    /// Load the sidecar index for a file, building and saving it first if needed
+    ///
+    /// A sidecar that `matches(fileAt:)` rejects is treated as stale and rebuilt.
+    /// - Parameters:
+    ///   - path: Path of the compressed file
+    ///   - buildIfMissing: Build (and try to save) the index when no valid sidecar exists
+    ///   - span: Distance between checkpoints for a newly built index
+    /// - Returns: The index, or nil if no valid sidecar exists and `buildIfMissing` is false
+    /// - Throws: GzipFileError or ZLibError if building fails
+    public static func sidecar(
+        forFileAt path: String,
+        buildIfMissing: Bool = true,
+        span: Int = defaultSpan
+    ) throws -> GzipIndex? {
+        let indexPath = sidecarPath(for: path)
+        if FileManager.default.fileExists(atPath: indexPath) {
+            if let index = try? GzipIndex(contentsOf: indexPath), index.matches(fileAt: path) {
+                return index
+            }
+            zlibWarning("Ignoring stale or unreadable gzip index at \(indexPath)")
+        }
+        guard buildIfMissing else {
+            return nil
+        }
+
+        let index = try build(forFileAt: path, span: span)
+        do {
+            try index.write(to: indexPath)
+        } catch {
+            // A read-only directory still gets an in-memory index
+            zlibWarning("Could not save gzip index to \(indexPath): \(error)")
+        }
+        return index
+    }
+
+    // MARK: Functions
+
+    /// Save the index so later sessions can skip the build pass
+    /// - Parameter path: Destination path, typically `GzipIndex.sidecarPath(for:)`
+    /// - Throws: GzipFileError if the file cannot be written
+    public func write(to path: String) throws {
+        guard let file = fopen(path, "wb") else {
+            throw GzipFileError.openFailed(path)
+        }
+        let result = swift_zran_save(pointer, file)
+        let closed = fclose(file)
+        guard result == Z_OK, closed == 0 else {
+            unlink(path)
+            throw GzipFileError.writeFailed(path)
+        }
+    }
+
+    /// Whether this index still describes the file at `path`
+    ///
+    /// Compares the size, the modification time and a CRC-32 of the first and last 64 KB of the
+    /// file with those recorded at build time. The sampled ends hold the gzip header and the last
+    /// member's CRC and length, so a same-size rewrite is caught without reading the whole file.
+    /// - Parameter path: Path of the compressed file
+    /// - Returns: True if the file still matches the one the index was built from
+    public func matches(fileAt path: String) -> Bool {
+        guard let attributes = try? FileManager.default.attributesOfItem(atPath: path),
+              let size = attributes[.size] as? NSNumber, size.intValue == sourceSize
+        else {
+            return false
+        }
+        let recordedTime = swift_zran_source_mtime(pointer)
+        if recordedTime != 0, Self.modificationTime(ofFileAt: path) != recordedTime {
+            return false
+        }
+        guard let checksum = Self.fingerprint(ofFileAt: path, size: sourceSize) else {
+            return false
+        }
+        return uLong(checksum) == swift_zran_source_check(pointer)
+    }
+
+    /// Read uncompressed bytes from a file starting at an arbitrary offset
+    /// - Parameters:
+    ///   - path: Path of the file the index was built from
+    ///   - offset: Uncompressed offset to start at
+    ///   - count: Maximum number of bytes to read
+    /// - Returns: The bytes read; shorter than `count` only at the end of the stream
+    /// - Throws: GzipFileError if the file cannot be opened, ZLibError if decoding fails
+    public func read(fromFileAt path: String, offset: Int, count: Int) throws -> Data {
+        guard offset >= 0, count >= 0 else {
+            throw ZLibError.invalidData
+        }
+        guard let file = fopen(path, "rb") else {
+            throw GzipFileError.openFailed(path)
+        }
+        defer { fclose(file) }
+
+        return try extract(count: count) { buffer in
+            swift_zran_extract_file(file, pointer, Int64(offset), buffer.baseAddress, buffer.count)
+        }
+    }
+
+    /// Read uncompressed bytes from in-memory compressed data starting at an arbitrary offset
+    /// - Parameters:
+    ///   - data: Compressed data the index was built from
+    ///   - offset: Uncompressed offset to start at
+    ///   - count: Maximum number of bytes to read
+    /// - Returns: The bytes read; shorter than `count` only at the end of the stream
+    /// - Throws: ZLibError if decoding fails
+    public func read(from data: Data, offset: Int, count: Int) throws -> Data {
+        guard offset >= 0, count >= 0 else {
+            throw ZLibError.invalidData
+        }
+        return try data.withUnsafeBytes { source in
+            try extract(count: count) { buffer in
+                swift_zran_extract_buffer(
+                    source.bindMemory(to: UInt8.self).baseAddress,
+                    source.count,
+                    pointer,
+                    Int64(offset),
+                    buffer.baseAddress,
+                    buffer.count
+                )
+            }
+        }
+    }
+
+    /// Uncompressed offset of the checkpoint a read at `offset` resumes from
+    /// - Parameter offset: Uncompressed offset
+    /// - Returns: Offset of the nearest checkpoint at or before `offset`
+    public func checkpointOffset(before offset: Int) -> Int {
+        Int(swift_zran_point_offset(pointer, Int64(offset)))
+    }
+
+    // MARK: Private Functions
+
+    /// Modification time of a file in nanoseconds since 1970, or nil if it cannot be read
+    private static func modificationTime(ofFileAt path: String) -> Int64? {
+        guard let attributes = try? FileManager.default.attributesOfItem(atPath: path),
+              let date = attributes[.modificationDate] as? Date
+        else {
+            return nil
+        }
+        return Int64((date.timeIntervalSince1970 * 1_000_000_000).rounded())
+    }
+
+    /// CRC-32 of the first and last `fingerprintLength` bytes of the source, each byte counted once
+    private static func fingerprint(of bytes: UnsafeRawBufferPointer) -> UInt32 {
+        let head = min(bytes.count, fingerprintLength)
+        let tail = max(bytes.count - fingerprintLength, head)
+        var checksum = swift_crc32_z(0, bytes.baseAddress?.assumingMemoryBound(to: Bytef.self), head)
+        checksum = swift_crc32_z(checksum, bytes.baseAddress.map { ($0 + tail).assumingMemoryBound(to: Bytef.self) }, bytes.count - tail)
+        return UInt32(truncatingIfNeeded: checksum)
+    }
+
+    /// `fingerprint(of:)` for the first `size` bytes of a file, or nil if they cannot be read
+    private static func fingerprint(ofFileAt path: String, size: Int) -> UInt32? {
+        guard let handle = FileHandle(forReadingAtPath: path) else {
+            return nil
+        }
+        defer { try? handle.close() }
+        let head = min(size, fingerprintLength)
+        let tail = max(size - fingerprintLength, head)
+        guard var sample = try? handle.read(upToCount: head) ?? Data(), sample.count == head else {
+            return nil
+        }
+        if size > tail {
+            guard (try? handle.seek(toOffset: UInt64(tail))) != nil,
+                  let end = try? handle.read(upToCount: size - tail), end.count == size - tail
+            else {
+                return nil
+            }
+            sample.append(end)
+        }
+        return sample.withUnsafeBytes { bytes in
+            UInt32(truncatingIfNeeded: swift_crc32_z(0, bytes.baseAddress?.assumingMemoryBound(to: Bytef.self), bytes.count))
+        }
+    }
+
+    private static func wrap(_ result: Int32, _ built: OpaquePointer?) throws -> GzipIndex {
+        switch result {
+            case Z_OK:
+                guard let built else {
+                    throw ZLibError.memoryError
+                }
+                return GzipIndex(pointer: built)
+            case Z_MEM_ERROR:
+                throw ZLibError.memoryError
+            default:
+                throw ZLibError.decompressionFailed(result)
+        }
+    }
+
+    private func extract(
+        count: Int,
+        _ body: (UnsafeMutableBufferPointer<UInt8>) -> Int64
+    ) throws -> Data {
+        let length = min(count, max(uncompressedSize, 0))
+        guard length > 0 else {
+            return Data()
+        }
+        var output = Data(count: length)
+        let got = output.withUnsafeMutableBytes { buffer in
+            body(buffer.bindMemory(to: UInt8.self))
+        }
+        switch got {
+            case 0...:
+                output.count = Int(got)
+                return output
+            case Int64(Z_MEM_ERROR):
+                throw ZLibError.memoryError
+            default:
+                throw ZLibError.decompressionFailed(Int32(truncatingIfNeeded: got))
+        }
+    }
+}
@@ -0,0 +1,241 @@
+//
+//  MappedFile.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+/// Read-only memory mapping of a whole file
+///
+/// The mapping is handed straight to `z_stream.next_in`, so file bytes reach zlib without a
+/// per-chunk `Data` allocation or copy; the kernel pages them in as deflate/inflate walks
+/// forward.
+final class MappedFile {
+    // MARK: Properties
+
+    /// Mapped contents of the file (empty for a zero-length file)
+    let bytes: UnsafeRawBufferPointer
+
+    private let isMapped: Bool
+
+    // MARK: Lifecycle
+
+    /// Map a file for reading
+    /// - Parameter path: Path of the file to map
+    /// - Throws: `ZLibError.fileError` if the file cannot be opened or mapped
+    init(path: String) throws {
+        #if os(Windows)
+            // No mmap here; a Foundation mapping (or read) keeps the code path identical
+            let data: Data
+            do {
+                data = try Data(contentsOf: URL(fileURLWithPath: path), options: .alwaysMapped)
+            } catch {
+                throw ZLibError.fileError(error)
+            }
+            let copy = UnsafeMutableRawBufferPointer.allocate(byteCount: max(data.count, 1), alignment: 16)
+            data.copyBytes(to: copy.bindMemory(to: UInt8.self))
+            bytes = UnsafeRawBufferPointer(rebasing: UnsafeRawBufferPointer(copy)[0 ..< data.count])
+            isMapped = false
+        #else
+            let fd = open(path, O_RDONLY)
+            guard fd >= 0 else {
+                throw ZLibError.fileError(MappedFile.posixError(path))
+            }
+            defer { _ = close(fd) }
+
+            var info = stat()
+            guard fstat(fd, &info) == 0 else {
+                throw ZLibError.fileError(MappedFile.posixError(path))
+            }
+            let size = Int(info.st_size)
+            guard size > 0 else {
+                bytes = UnsafeRawBufferPointer(start: nil, count: 0)
+                isMapped = false
+                return
+            }
+
+            let address = mmap(nil, size, PROT_READ, MAP_PRIVATE, fd, 0)
+            guard let address, address != UnsafeMutableRawPointer(bitPattern: -1) else {
+                throw ZLibError.fileError(MappedFile.posixError(path))
+            }
+            // Both codecs read front to back; ask for aggressive read-ahead
+            _ = madvise(address, size, MADV_SEQUENTIAL)
+            bytes = UnsafeRawBufferPointer(start: address, count: size)
+            isMapped = true
+            logMemoryUsage("Mapped \(path)", bytes: size)
+        #endif
+    }
+
+    deinit {
+        #if os(Windows)
+            if let base = bytes.baseAddress {
+                UnsafeMutableRawPointer(mutating: base).deallocate()
+            }
+        #else
+            if isMapped, let base = bytes.baseAddress {
+                munmap(UnsafeMutableRawPointer(mutating: base), bytes.count)
+            }
+        #endif
+    }
+
+    // MARK: Static Functions
+
+    #if !os(Windows)
+        private static func posixError(_ path: String) -> NSError {
+            let code = errno
+            return NSError(domain: NSPOSIXErrorDomain, code: Int(code), userInfo: [
+                NSLocalizedDescriptionKey: "\(path): \(String(cString: strerror(code)))",
+            ])
+        }
+    #endif
+}
+
+// MARK: - MappedFileCodec
+
+/// Streams a mapped source through a single z_stream into a reused output buffer
+///
+/// This is the engine behind the `useMemoryMapping` options of the file compressors.
+/// Output is written from one buffer allocated up front rather than a mapped destination:
+/// a mapped, pre-sized output file would turn a full disk into SIGBUS instead of an error.
+enum MappedFileCodec {
+    // MARK: Static Properties
+
+    /// Smallest output buffer used regardless of the configured buffer size
+    static let minimumOutputBuffer = 16 * 1024
+
+    // MARK: Static Functions
+
+    /// Compress a mapped file
+    /// - Parameters:
+    ///   - source: Mapped input
+    ///   - output: Destination handle
+    ///   - level: zlib compression level (-1...9)
+    ///   - windowBits: zlib window bits selecting the output format
+    ///   - bufferSize: Size of the reused output buffer
+    ///   - skipsIncompressible: Store the whole file when its sampled entropy says deflate cannot shrink it
+    ///   - progress: Called with the number of input bytes consumed so far
+    /// - Throws: ZLibError if compression or writing fails
+    static func compress(
+        _ source: MappedFile,
+        to output: FileHandle,
+        level: Int32,
+        windowBits: Int32,
+        bufferSize: Int,
+        skipsIncompressible: Bool = false,
+        progress: ((Int) -> Void)? = nil
+    ) throws {
+        // The mapping is fed to deflate in one piece, so the whole file is judged at once
+        let level = skipsIncompressible && ByteEntropy.isLikelyIncompressible(source.bytes) ? 0 : level
+        var stream = z_stream()
+        let result = swift_deflateInit2(&stream, level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY)
+        guard result == Z_OK else {
+            throw ZLibError.compressionFailed(result)
+        }
+        defer { swift_deflateEnd(&stream) }
+
+        try run(&stream, source: source, output: output, bufferSize: bufferSize, progress: progress) { stream, isLastInput in
+            let result = swift_deflate(&stream, isLastInput ? Z_FINISH : Z_NO_FLUSH)
+            switch result {
+                case Z_OK, Z_STREAM_END, Z_BUF_ERROR:
+                    // Z_BUF_ERROR only means no progress was possible with the buffers given
+                    return result == Z_STREAM_END
+                default:
+                    throw ZLibError.compressionFailed(result)
+            }
+        }
+    }
+
+    /// Decompress a mapped file; decoding stops at the end of the first complete stream
+    /// - Parameters:
+    ///   - source: Mapped input
+    ///   - output: Destination handle
+    ///   - windowBits: zlib window bits selecting the input format
+    ///   - bufferSize: Size of the reused output buffer
+    ///   - progress: Called with the number of input bytes consumed so far
+    /// - Throws: ZLibError if decompression or writing fails
+    static func decompress(
+        _ source: MappedFile,
+        to output: FileHandle,
+        windowBits: Int32,
+        bufferSize: Int,
+        progress: ((Int) -> Void)? = nil
+    ) throws {
+        var stream = z_stream()
+        let result = swift_inflateInit2(&stream, windowBits)
+        guard result == Z_OK else {
+            throw ZLibError.decompressionFailed(result)
+        }
+        defer { swift_inflateEnd(&stream) }
+
+        try run(&stream, source: source, output: output, bufferSize: bufferSize, progress: progress) { stream, isLastInput in
+            let result = swift_inflate(&stream, Z_NO_FLUSH)
+            switch result {
+                case Z_OK:
+                    return false
+                case Z_STREAM_END:
+                    return true
+                case Z_BUF_ERROR where isLastInput && stream.avail_in == 0:
+                    // Every input byte consumed without reaching the stream end: truncated input
+                    throw ZLibError.decompressionFailed(Z_DATA_ERROR)
+                case Z_BUF_ERROR:
+                    // Input slice exhausted; the next one is loaded before the following call
+                    return false
+                case Z_NEED_DICT:
+                    throw ZLibError.needDictionary
+                default:
+                    throw ZLibError.decompressionFailed(result)
+            }
+        }
+    }
+
+    // MARK: Private Static Functions
+
+    /// Drive `step` until it reports the end of the stream, writing each filled output buffer
+    private static func run(
+        _ stream: inout z_stream,
+        source: MappedFile,
+        output: FileHandle,
+        bufferSize: Int,
+        progress: ((Int) -> Void)?,
+        step: (inout z_stream, Bool) throws -> Bool
+    ) throws {
+        let capacity = min(max(bufferSize, minimumOutputBuffer), Int(uInt.max))
+        let buffer = UnsafeMutableRawPointer.allocate(byteCount: capacity, alignment: 16)
+        defer { buffer.deallocate() }
+
+        let input = source.bytes
+        var loaded = 0
+        var isFinished = false
+        while !isFinished {
+            if stream.avail_in == 0, loaded < input.count {
+                // avail_in is 32-bit; larger files are fed in uInt.max slices straight from the mapping
+                let inChunk = min(input.count - loaded, Int(uInt.max))
+                stream.next_in = UnsafeMutablePointer(
+                    mutating: input.baseAddress!.advanced(by: loaded).assumingMemoryBound(to: Bytef.self)
+                )
+                stream.avail_in = uInt(inChunk)
+                loaded += inChunk
+            }
+
+            stream.next_out = buffer.assumingMemoryBound(to: Bytef.self)
+            stream.avail_out = uInt(capacity)
+            isFinished = try step(&stream, loaded == input.count)
+
+            let produced = capacity - Int(stream.avail_out)
+            if produced > 0 {
+                let chunk = Data(bytesNoCopy: buffer, count: produced, deallocator: .none)
+                do {
+                    try output.write(contentsOf: chunk)
+                } catch {
+                    throw ZLibError.fileError(error)
+                }
+            }
+            if let progress, produced > 0 || isFinished {
+                progress(loaded - Int(stream.avail_in))
+            }
+        }
+    }
+}
@@ -14,12 +14,19 @@ public final class SimpleFileCompressor {
 
     public let bufferSize: Int
     public let compressionLevel: CompressionLevel
+    /// Store chunks that look incompressible instead of deflating them (see `Compressor.skipsIncompressible`, default: false)
+    public let skipsIncompressible: Bool
 
     // MARK: Lifecycle
 
-    public init(bufferSize: Int = 64 * 1024, compressionLevel: CompressionLevel = .defaultCompression) {
+    public init(
+        bufferSize: Int = 64 * 1024,
+        compressionLevel: CompressionLevel = .defaultCompression,
+        skipsIncompressible: Bool = false
+    ) {
         self.bufferSize = bufferSize
         self.compressionLevel = compressionLevel
+        self.skipsIncompressible = skipsIncompressible
     }
 
     // MARK: Functions
@@ -33,10 +40,12 @@ public final class SimpleFileCompressor {
         let gzipFile = try GzipFile(path: destinationPath, mode: "wb\(compressionLevel.zlibLevel)")
         defer { try? gzipFile.close() }
 
+        var isStoring = false
         var isFinished = false
         while !isFinished {
             let chunk = input.readData(ofLength: bufferSize)
             let isLast = chunk.count < bufferSize
+            try updateBypass(of: gzipFile, for: chunk, isStoring: &isStoring)
             try gzipFile.writeData(chunk)
             if isLast { isFinished = true }
         }
@@ -59,10 +68,12 @@ public final class SimpleFileCompressor {
         try input.seek(toOffset: 0)
         var processedBytes = 0
 
+        var isStoring = false
         var isFinished = false
         while !isFinished {
             let chunk = input.readData(ofLength: bufferSize)
             let isLast = chunk.count < bufferSize
+            try updateBypass(of: gzipFile, for: chunk, isStoring: &isStoring)
             try gzipFile.writeData(chunk)
 
             processedBytes += chunk.count
@@ -102,6 +113,22 @@ public final class SimpleFileCompressor {
         }
     }
 
+    // MARK: Private Functions
+
+    /// Switch the gzip stream to level 0 for chunks that look incompressible, and back for the rest
+    private func updateBypass(of gzipFile: GzipFile, for chunk: Data, isStoring: inout Bool) throws {
+        guard skipsIncompressible, compressionLevel != .noCompression, chunk.count >= ByteEntropy.minimumInputSize else {
+            return
+        }
+        let incompressible = ByteEntropy.isLikelyIncompressible(chunk)
+        guard incompressible != isStoring else {
+            return
+        }
+        // gzsetparams compresses the input buffered so far at the old level before switching
+        try gzipFile.setParams(level: incompressible ? .noCompression : compressionLevel, strategy: .defaultStrategy)
+        isStoring = incompressible
+    }
+
     @discardableResult
     private func wrapFileError<T>(_ operation: () throws -> T) throws -> T {
         do {
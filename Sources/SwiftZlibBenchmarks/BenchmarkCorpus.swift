@@ -0,0 +1,217 @@
+//
+//  BenchmarkCorpus.swift
+//  SwiftZlibBenchmarks
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import Foundation
+
+// MARK: - CorpusEntry
+
+/// One input of the benchmark corpus
+struct CorpusEntry {
+    let name: String
+    let data: Data
+}
+
+// MARK: - BenchmarkCorpus
+
+/// Deterministic synthetic corpus plus optional on-disk files
+///
+/// The synthetic entries approximate the shapes found in the Canterbury and Silesia corpora
+/// (prose, source code, structured binary, incompressible and sparse data) together with the
+/// JSON and log payloads our users compress most. Generation is seeded, so every run and
+/// every machine benchmarks byte-identical inputs. Real corpora can be added with
+/// `--corpus <dir>`: every regular file in the directory becomes an entry.
+enum BenchmarkCorpus {
+    // MARK: Static Properties
+
+    static let syntheticNames = ["text", "source", "json", "log", "binary", "random", "sparse"]
+
+    // MARK: Static Functions
+
+    /// Build the corpus
+    /// - Parameters:
+    ///   - size: Size of each synthetic entry in bytes
+    ///   - directory: Optional directory of additional files
+    /// - Returns: Corpus entries, synthetic ones first
+    static func load(size: Int, directory: String?) throws -> [CorpusEntry] {
+        var entries = syntheticNames.map { CorpusEntry(name: $0, data: generate($0, size: size)) }
+        if let directory {
+            let names = try FileManager.default.contentsOfDirectory(atPath: directory).sorted()
+            for name in names where !name.hasPrefix(".") {
+                let path = (directory as NSString).appendingPathComponent(name)
+                var isDirectory: ObjCBool = false
+                guard FileManager.default.fileExists(atPath: path, isDirectory: &isDirectory), !isDirectory.boolValue else {
+                    continue
+                }
+                entries.append(try CorpusEntry(name: "file:\(name)", data: Data(contentsOf: URL(fileURLWithPath: path))))
+            }
+        }
+        return entries
+    }
+
+    /// Generate one synthetic entry
+    static func generate(_ name: String, size: Int) -> Data {
+        var rng = SplitMix64(seed: UInt64(truncatingIfNeeded: name.utf8.reduce(5381) { ($0 &* 33) ^ Int($1) }))
+        var output = Data(capacity: size + 256)
+        switch name {
+            case "text":
+                while output.count < size { appendSentence(to: &output, rng: &rng) }
+            case "source":
+                while output.count < size { appendSourceLine(to: &output, rng: &rng) }
+            case "json":
+                output.append(contentsOf: Array("[\n".utf8))
+                var id = 0
+                while output.count < size {
+                    appendJSONRecord(id: id, to: &output, rng: &rng)
+                    id += 1
+                }
+            case "log":
+                var second = 0
+                while output.count < size {
+                    appendLogLine(second: second, to: &output, rng: &rng)
+                    second += Int(rng.next(below: 3))
+                }
+            case "binary":
+                appendBinaryRecords(to: &output, size: size, rng: &rng)
+            case "random":
+                while output.count < size {
+                    let word: UInt64 = rng.next()
+                    withUnsafeBytes(of: word.littleEndian) { output.append(contentsOf: $0) }
+                }
+            default:
+                // Sparse: long zero runs with scattered short bursts
+                output.append(Data(count: size))
+                output.withUnsafeMutableBytes { buffer in
+                    var position = 0
+                    while position < size {
+                        position += Int(rng.next(below: 4096))
+                        for offset in 0 ..< Int(rng.next(below: 16)) where position + offset < size {
+                            buffer[position + offset] = UInt8(truncatingIfNeeded: rng.next(below: 256))
+                        }
+                    }
+                }
+        }
+        return output.prefix(size)
+    }
+
+    // MARK: Private Static Functions
+
+    private static let words = """
+    the of and to in is was that for it with as his on be at by had not are but from or have an they which
+    one you were her all she there would their we him been has when who will more no if out so said what up
+    its about into than them can only other new some could time these two may then do first any my now such
+    like our over man me even most made after also did many before must through back years where much your
+    way well down should because each just those people how too little state good very make world still own
+    see men work long get here between both life being under never day same another know while last might us
+    great old year off come since against go came right used take three compression stream window deflate
+    """.split(whereSeparator: { $0 == " " || $0 == "\n" }).map(String.init)
+
+    private static func appendSentence(to output: inout Data, rng: inout SplitMix64) {
+        let count = 6 + Int(rng.next(below: 14))
+        var sentence = ""
+        for index in 0 ..< count {
+            // Squaring skews selection toward the front of the list, roughly Zipf-like
+            let pick = Double(rng.next(below: 10000)) / 10000
+            var word = words[Int(pick * pick * Double(words.count))]
+            if index == 0 { word = word.prefix(1).uppercased() + word.dropFirst() }
+            sentence += (index == 0 ? "" : " ") + word
+            if index < count - 1, rng.next(below: 12) == 0 { sentence += "," }
+        }
+        sentence += rng.next(below: 6) == 0 ? ".\n\n" : ". "
+        output.append(contentsOf: Array(sentence.utf8))
+    }
+
+    private static let identifiers = ["buffer", "stream", "length", "index", "state", "result", "window", "offset", "count", "value"]
+
+    private static func appendSourceLine(to output: inout Data, rng: inout SplitMix64) {
+        let a = identifiers[Int(rng.next(below: UInt64(identifiers.count)))]
+        let b = identifiers[Int(rng.next(below: UInt64(identifiers.count)))]
+        let indent = String(repeating: "    ", count: 1 + Int(rng.next(below: 3)))
+        let line: String
+        switch rng.next(below: 6) {
+            case 0: line = "\(indent)if (\(a) >= \(b)) {\n\(indent)    return Z_BUF_ERROR;\n\(indent)}\n"
+            case 1: line = "\(indent)\(a) += \(b) & 0x\(String(rng.next(below: 65536), radix: 16));\n"
+            case 2: line = "\(indent)for (\(a) = 0; \(a) < \(b); \(a)++)\n"
+            case 3: line = "\(indent)/* update the \(a) before touching \(b) */\n"
+            case 4: line = "\(indent)memcpy(\(a), \(b), sizeof(\(a)));\n"
+            default: line = "\(indent)\(a) = \(b)->\(a) + \(rng.next(below: 100));\n"
+        }
+        output.append(contentsOf: Array(line.utf8))
+    }
+
+    private static let tags = ["alpha", "beta", "prod", "staging", "eu-west", "us-east", "mobile", "web"]
+
+    private static func appendJSONRecord(id: Int, to output: inout Data, rng: inout SplitMix64) {
+        let tagA = tags[Int(rng.next(below: UInt64(tags.count)))]
+        let tagB = tags[Int(rng.next(below: UInt64(tags.count)))]
+        let score = Double(rng.next(below: 100_000)) / 100
+        let record = """
+          {"id": \(id), "user": "user_\(rng.next(below: 50000))", "email": "user\(rng.next(below: 50000))@example.com", \
+        "active": \(rng.next(below: 2) == 0), "score": \(score), "tags": ["\(tagA)", "\(tagB)"], \
+        "created": "2025-07-\(10 + rng.next(below: 20))T\(10 + rng.next(below: 14)):\(10 + rng.next(below: 50)):00Z"},
+
+        """
+        output.append(contentsOf: Array(record.utf8))
+    }
+
+    private static let paths = ["/api/v1/items", "/api/v1/users", "/static/app.js", "/static/style.css", "/health", "/api/v2/search"]
+    private static let agents = ["Mozilla/5.0 (Macintosh; Intel Mac OS X 14_5)", "curl/8.4.0", "SwiftZlib/1.0 CFNetwork", "Mozilla/5.0 (X11; Linux x86_64)"]
+
+    private static func appendLogLine(second: Int, to output: inout Data, rng: inout SplitMix64) {
+        let path = paths[Int(rng.next(below: UInt64(paths.count)))]
+        let agent = agents[Int(rng.next(below: UInt64(agents.count)))]
+        let status = [200, 200, 200, 200, 304, 404, 500][Int(rng.next(below: 7))]
+        let time = String(format: "%02d:%02d:%02d", (second / 3600) % 24, (second / 60) % 60, second % 60)
+        let line = "10.0.\(rng.next(below: 4)).\(rng.next(below: 256)) - - [13/Jul/2025:\(time) +0000] "
+            + "\"GET \(path)/\(rng.next(below: 10000)) HTTP/1.1\" \(status) \(rng.next(below: 20000)) \"-\" \"\(agent)\"\n"
+        output.append(contentsOf: Array(line.utf8))
+    }
+
+    /// Fixed-layout records with slowly drifting fields, like sensor dumps or object files
+    private static func appendBinaryRecords(to output: inout Data, size: Int, rng: inout SplitMix64) {
+        var timestamp: UInt64 = 1_752_400_000_000
+        var reading: Int32 = 0
+        while output.count < size {
+            timestamp += 10 + rng.next(below: 5)
+            reading += Int32(truncatingIfNeeded: Int64(rng.next(below: 33)) - 16)
+            let level = Float(reading) * 0.125
+            withUnsafeBytes(of: timestamp.littleEndian) { output.append(contentsOf: $0) }
+            withUnsafeBytes(of: reading.littleEndian) { output.append(contentsOf: $0) }
+            withUnsafeBytes(of: level.bitPattern.littleEndian) { output.append(contentsOf: $0) }
+            withUnsafeBytes(of: UInt16(rng.next(below: 8)).littleEndian) { output.append(contentsOf: $0) }
+            output.append(contentsOf: [0, 0, 0xFF, 0xFE, 0, 0])
+        }
+    }
+}
+
+// MARK: - SplitMix64
+
+/// Small seeded generator so the corpus is identical on every platform
+struct SplitMix64: RandomNumberGenerator {
+    // MARK: Properties
+
+    private var state: UInt64
+
+    // MARK: Lifecycle
+
+    init(seed: UInt64) {
+        state = seed
+    }
+
+    // MARK: Functions
+
+    mutating func next() -> UInt64 {
+        state &+= 0x9E37_79B9_7F4A_7C15
+        var z = state
+        z = (z ^ (z >> 30)) &* 0xBF58_476D_1CE4_E5B9
+        z = (z ^ (z >> 27)) &* 0x94D0_49BB_1331_11EB
+        return z ^ (z >> 31)
+    }
+
+    mutating func next(below bound: UInt64) -> UInt64 {
+        next() % bound
+    }
+}
@@ -0,0 +1,263 @@
+//
+//  BenchmarkHarness.swift
+//  SwiftZlibBenchmarks
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import CZLib
+import Foundation
+
+// MARK: - BenchmarkOptions
+
+/// Command-line options of the benchmark runner
+struct BenchmarkOptions {
+    // MARK: Properties
+
+    var warmupIterations = 3
+    var iterations = 15
+    var corpusSize = 4 * 1024 * 1024
+    var corpusDirectory: String?
+    var filter: String?
+    var outputPath: String?
+    var baselinePath: String?
+    var regressionThreshold = 5.0
+
+    // MARK: Static Functions
+
+    static let usage = """
+    Usage: SwiftZlibBenchmarks [options]
+
+      --iterations <n>      Measured iterations per benchmark (default: 15)
+      --warmup <n>          Unmeasured warmup iterations (default: 3)
+      --size <bytes>        Size of each synthetic corpus entry (default: 4194304)
+      --corpus <dir>        Also benchmark every file in <dir> (e.g. Silesia, Canterbury)
+      --filter <substring>  Only run benchmarks whose "name/corpus" contains <substring>
+      --output <file>       Write the JSON report to <file> (default: stdout only)
+      --baseline <file>     Compare against a previous JSON report
+      --threshold <pct>     Median throughput drop that counts as a regression (default: 5)
+      --quick               Shorthand for --iterations 5 --warmup 1 --size 1048576
+    """
+
+    static func parse(_ arguments: [String]) throws -> BenchmarkOptions {
+        var options = BenchmarkOptions()
+        var iterator = arguments.makeIterator()
+
+        func value(for flag: String) throws -> String {
+            guard let value = iterator.next() else {
+                throw BenchmarkError.invalidArgument("\(flag) needs a value")
+            }
+            return value
+        }
+
+        func number(for flag: String) throws -> Int {
+            guard let number = try Int(value(for: flag)), number > 0 else {
+                throw BenchmarkError.invalidArgument("\(flag) needs a positive integer")
+            }
+            return number
+        }
+
+        while let argument = iterator.next() {
+            switch argument {
+                case "--iterations": options.iterations = try number(for: argument)
+                case "--warmup": options.warmupIterations = try number(for: argument)
+                case "--size": options.corpusSize = try number(for: argument)
+                case "--corpus": options.corpusDirectory = try value(for: argument)
+                case "--filter": options.filter = try value(for: argument)
+                case "--output": options.outputPath = try value(for: argument)
+                case "--baseline": options.baselinePath = try value(for: argument)
+                case "--threshold":
+                    guard let threshold = try Double(value(for: argument)), threshold >= 0 else {
+                        throw BenchmarkError.invalidArgument("--threshold needs a non-negative number")
+                    }
+                    options.regressionThreshold = threshold
+                case "--quick":
+                    options.iterations = 5
+                    options.warmupIterations = 1
+                    options.corpusSize = 1024 * 1024
+                case "--help", "-h":
+                    throw BenchmarkError.helpRequested
+                default:
+                    throw BenchmarkError.invalidArgument("unknown option \(argument)")
+            }
+        }
+        return options
+    }
+}
+
+// MARK: - BenchmarkError
+
+enum BenchmarkError: Error, CustomStringConvertible {
+    case invalidArgument(String)
+    case helpRequested
+    case verificationFailed(String)
+
+    // MARK: Computed Properties
+
+    var description: String {
+        switch self {
+            case let .invalidArgument(message): "Invalid argument: \(message)"
+            case .helpRequested: BenchmarkOptions.usage
+            case let .verificationFailed(name): "Benchmark \(name) produced wrong output"
+        }
+    }
+}
+
+// MARK: - BenchmarkCase
+
+/// A single measurable operation over one corpus entry
+struct BenchmarkCase {
+    /// Operation name, e.g. `oneshot.compress.level6`
+    let name: String
+    /// Corpus entry the operation runs over
+    let corpus: String
+    /// Uncompressed bytes handled per iteration; the basis for MB/s
+    let bytesProcessed: Int
+    /// Runs the operation once and returns the size of what it produced
+    let body: () throws -> Int
+}
+
+// MARK: - TimingStatistics
+
+/// Summary of the measured iterations, in nanoseconds
+struct TimingStatistics: Codable {
+    // MARK: Properties
+
+    let min: Double
+    let max: Double
+    let mean: Double
+    let median: Double
+    let p90: Double
+    let p99: Double
+    let standardDeviation: Double
+
+    // MARK: Lifecycle
+
+    init(samples: [UInt64]) {
+        let sorted = samples.map(Double.init).sorted()
+        let count = Double(sorted.count)
+        min = sorted.first ?? 0
+        max = sorted.last ?? 0
+        let average = sorted.reduce(0, +) / Swift.max(count, 1)
+        mean = average
+        median = TimingStatistics.percentile(sorted, 0.5)
+        p90 = TimingStatistics.percentile(sorted, 0.9)
+        p99 = TimingStatistics.percentile(sorted, 0.99)
+        let variance = sorted.reduce(0) { $0 + ($1 - average) * ($1 - average) } / Swift.max(count - 1, 1)
+        standardDeviation = variance.squareRoot()
+    }
+
+    // MARK: Static Functions
+
+    /// Linear interpolation between closest ranks
+    static func percentile(_ sorted: [Double], _ fraction: Double) -> Double {
+        guard !sorted.isEmpty else { return 0 }
+        let rank = fraction * Double(sorted.count - 1)
+        let lower = Int(rank.rounded(.down))
+        let upper = Swift.min(lower + 1, sorted.count - 1)
+        let weight = rank - Double(lower)
+        return sorted[lower] + (sorted[upper] - sorted[lower]) * weight
+    }
+}
+
+// MARK: - BenchmarkResult
+
+struct BenchmarkResult: Codable {
+    let name: String
+    let corpus: String
+    let inputBytes: Int
+    let outputBytes: Int
+    let warmupIterations: Int
+    let iterations: Int
+    let nanoseconds: TimingStatistics
+    /// Throughput at the median iteration time (10^6 bytes per second)
+    let medianMBps: Double
+    /// Throughput at the fastest iteration time
+    let bestMBps: Double
+    /// Allocations made by zlib's default allocator per iteration (nil unless built with SWIFTZLIB_ALLOC_STATS)
+    let zlibAllocationsPerIteration: Double?
+    /// Bytes requested from zlib's default allocator per iteration (nil unless built with SWIFTZLIB_ALLOC_STATS)
+    let zlibAllocatedBytesPerIteration: Double?
+
+    // MARK: Computed Properties
+
+    var key: String { "\(name)/\(corpus)" }
+}
+
+// MARK: - BenchmarkHarness
+
+enum BenchmarkHarness {
+    // MARK: Static Functions
+
+    /// Run warmup iterations, then time each measured iteration individually
+    static func measure(_ benchmark: BenchmarkCase, options: BenchmarkOptions) throws -> BenchmarkResult {
+        var outputBytes = 0
+        for _ in 0 ..< options.warmupIterations {
+            outputBytes = try benchmark.body()
+        }
+
+        var samples: [UInt64] = []
+        samples.reserveCapacity(options.iterations)
+        let before = zlibAllocatorTotals()
+        for _ in 0 ..< options.iterations {
+            let start = DispatchTime.now().uptimeNanoseconds
+            outputBytes = try benchmark.body()
+            samples.append(Swift.max(DispatchTime.now().uptimeNanoseconds - start, 1))
+        }
+        let after = zlibAllocatorTotals()
+
+        let timing = TimingStatistics(samples: samples)
+        let iterations = Double(options.iterations)
+        var allocations: (calls: Double, bytes: Double)?
+        if let before, let after {
+            allocations = (Double(after.calls - before.calls) / iterations, Double(after.bytes - before.bytes) / iterations)
+        }
+        return BenchmarkResult(
+            name: benchmark.name,
+            corpus: benchmark.corpus,
+            inputBytes: benchmark.bytesProcessed,
+            outputBytes: outputBytes,
+            warmupIterations: options.warmupIterations,
+            iterations: options.iterations,
+            nanoseconds: timing,
+            medianMBps: throughput(bytes: benchmark.bytesProcessed, nanoseconds: timing.median),
+            bestMBps: throughput(bytes: benchmark.bytesProcessed, nanoseconds: timing.min),
+            zlibAllocationsPerIteration: allocations?.calls,
+            zlibAllocatedBytesPerIteration: allocations?.bytes
+        )
+    }
+
+    /// Peak resident set size of the process in bytes
+    static func peakResidentBytes() -> Int {
+        #if canImport(Darwin)
+            var usage = rusage()
+            guard getrusage(RUSAGE_SELF, &usage) == 0 else { return 0 }
+            return Int(usage.ru_maxrss)
+        #else
+            // VmHWM is the peak resident set size in kB
+            guard let status = try? String(contentsOfFile: "/proc/self/status", encoding: .utf8),
+                  let line = status.split(separator: "\n").first(where: { $0.hasPrefix("VmHWM:") }),
+                  let kilobytes = line.split(separator: " ").dropFirst().first.flatMap({ Int($0) })
+            else {
+                return 0
+            }
+            return kilobytes * 1024
+        #endif
+    }
+
+    // MARK: Private Static Functions
+
+    private static func throughput(bytes: Int, nanoseconds: Double) -> Double {
+        nanoseconds > 0 ? Double(bytes) / nanoseconds * 1000 : 0
+    }
+
+    /// Totals of zlib's default allocator, or nil if CZLib was built without the counters
+    private static func zlibAllocatorTotals() -> (calls: UInt64, bytes: UInt64)? {
+        var calls: UInt64 = 0
+        var bytes: UInt64 = 0
+        guard swift_zalloc_stats(&calls, &bytes) != 0 else {
+            return nil
+        }
+        return (calls, bytes)
+    }
+}
@@ -0,0 +1,127 @@
+//
+//  BenchmarkReport.swift
+//  SwiftZlibBenchmarks
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import Foundation
+import SwiftZlib
+
+// MARK: - BenchmarkReport
+
+/// Machine-readable output of one benchmark run
+///
+/// The schema is versioned; fields are only ever added, so reports from older releases
+/// remain valid baselines.
+struct BenchmarkReport: Codable {
+    // MARK: Nested Types
+
+    struct Host: Codable {
+        let operatingSystem: String
+        let architecture: String
+        let processorCount: Int
+        let physicalMemory: UInt64
+    }
+
+    struct Configuration: Codable {
+        let warmupIterations: Int
+        let iterations: Int
+        let corpusSize: Int
+        let filter: String?
+    }
+
+    // MARK: Static Properties
+
+    static let currentSchemaVersion = 1
+
+    // MARK: Properties
+
+    let schemaVersion: Int
+    let generatedAt: String
+    let zlibVersion: String
+    /// `ZLib.backend` summary; absent in reports from before it was recorded
+    let zlibBackend: String?
+    let host: Host
+    let configuration: Configuration
+    let peakResidentBytes: Int
+    let results: [BenchmarkResult]
+
+    // MARK: Lifecycle
+
+    init(options: BenchmarkOptions, results: [BenchmarkResult], peakResidentBytes: Int) {
+        schemaVersion = BenchmarkReport.currentSchemaVersion
+        generatedAt = ISO8601DateFormatter().string(from: Date())
+        zlibVersion = ZLib.version
+        zlibBackend = ZLib.backend.description
+        host = Host(
+            operatingSystem: ProcessInfo.processInfo.operatingSystemVersionString,
+            architecture: BenchmarkReport.architecture,
+            processorCount: ProcessInfo.processInfo.activeProcessorCount,
+            physicalMemory: ProcessInfo.processInfo.physicalMemory
+        )
+        configuration = Configuration(
+            warmupIterations: options.warmupIterations,
+            iterations: options.iterations,
+            corpusSize: options.corpusSize,
+            filter: options.filter
+        )
+        self.peakResidentBytes = peakResidentBytes
+        self.results = results
+    }
+
+    // MARK: Computed Properties
+
+    private static var architecture: String {
+        #if arch(arm64)
+            return "arm64"
+        #elseif arch(x86_64)
+            return "x86_64"
+        #else
+            return "unknown"
+        #endif
+    }
+
+    // MARK: Functions
+
+    func encoded() throws -> Data {
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+        return try encoder.encode(self)
+    }
+
+    static func load(from path: String) throws -> BenchmarkReport {
+        try JSONDecoder().decode(BenchmarkReport.self, from: Data(contentsOf: URL(fileURLWithPath: path)))
+    }
+}
+
+// MARK: - Regression
+
+/// A benchmark whose median throughput fell by more than the threshold
+struct Regression {
+    let key: String
+    let baselineMBps: Double
+    let currentMBps: Double
+
+    // MARK: Computed Properties
+
+    var changePercent: Double { (currentMBps / baselineMBps - 1) * 100 }
+
+    // MARK: Static Functions
+
+    /// Compare two reports by benchmark name and corpus
+    /// - Parameters:
+    ///   - current: Report of this run
+    ///   - baseline: Earlier report
+    ///   - threshold: Allowed median throughput drop in percent
+    /// - Returns: Benchmarks that regressed, worst first
+    static func find(current: BenchmarkReport, baseline: BenchmarkReport, threshold: Double) -> [Regression] {
+        let previous = Dictionary(baseline.results.map { ($0.key, $0) }, uniquingKeysWith: { first, _ in first })
+        return current.results.compactMap { result -> Regression? in
+            guard let old = previous[result.key], old.medianMBps > 0 else { return nil }
+            guard result.medianMBps < old.medianMBps * (1 - threshold / 100) else { return nil }
+            return Regression(key: result.key, baselineMBps: old.medianMBps, currentMBps: result.medianMBps)
+        }
+        .sorted { $0.changePercent < $1.changePercent }
+    }
+}
@@ -0,0 +1,141 @@
+//
+//  BenchmarkSuite.swift
+//  SwiftZlibBenchmarks
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import Foundation
+import SwiftZlib
+
+/// The benchmarked code paths, instantiated once per corpus entry
+///
+/// Every decompression benchmark is checked against the original input once before timing,
+/// so a fast-but-wrong regression fails the run instead of looking like a speedup.
+enum BenchmarkSuite {
+    // MARK: Static Properties
+
+    static let chunkSize = 64 * 1024
+
+    // MARK: Static Functions
+
+    static func cases(for entry: CorpusEntry, scratchDirectory: String) throws -> [BenchmarkCase] {
+        let data = entry.data
+        let corpus = entry.name
+        let zlibData = try ZLib.compress(data, level: .defaultCompression)
+        let rawData = try ZLib.compressRaw(data)
+        let gzipPath = (scratchDirectory as NSString).appendingPathComponent("\(corpus.replacingOccurrences(of: "/", with: "_")).gz")
+        let writePath = gzipPath + ".write"
+        try ZLib.compressGzip(data).write(to: URL(fileURLWithPath: gzipPath))
+
+        try verify("oneshot.decompress/\(corpus)", ZLib.decompress(zlibData), data)
+        try verify("inflateback.decompress/\(corpus)", inflateBack(rawData), data)
+        try verify("gzfile.read/\(corpus)", readGzipFile(gzipPath), data)
+
+        var cases: [BenchmarkCase] = []
+        let levels: [(String, CompressionLevel)] = [("level1", .bestSpeed), ("level6", .defaultCompression), ("level9", .bestCompression)]
+        for (label, level) in levels {
+            cases.append(BenchmarkCase(name: "oneshot.compress.\(label)", corpus: corpus, bytesProcessed: data.count) {
+                try ZLib.compress(data, level: level).count
+            })
+        }
+        // Built-in tuning profiles, read against level6 and level9 by output size and time;
+        // memory level 8 matches the level cases, which go through compress2
+        for (name, tuning) in DeflateTuning.profiles.sorted(by: { $0.key < $1.key }) {
+            let options = CompressionOptions(memoryLevel: .level8, tuning: tuning)
+            cases.append(BenchmarkCase(name: "oneshot.compress.profile.\(name)", corpus: corpus, bytesProcessed: data.count) {
+                try ZLib.compress(data, options: options).count
+            })
+        }
+        cases.append(BenchmarkCase(name: "oneshot.decompress", corpus: corpus, bytesProcessed: data.count) {
+            try ZLib.decompress(zlibData).count
+        })
+        cases.append(BenchmarkCase(name: "stream.compress", corpus: corpus, bytesProcessed: data.count) {
+            try streamCompress(data)
+        })
+        cases.append(BenchmarkCase(name: "stream.decompress", corpus: corpus, bytesProcessed: data.count) {
+            try streamDecompress(zlibData)
+        })
+        cases.append(BenchmarkCase(name: "inflateback.decompress", corpus: corpus, bytesProcessed: data.count) {
+            try inflateBack(rawData).count
+        })
+        cases.append(BenchmarkCase(name: "gzfile.write", corpus: corpus, bytesProcessed: data.count) {
+            try writeGzipFile(data, to: writePath)
+        })
+        cases.append(BenchmarkCase(name: "gzfile.read", corpus: corpus, bytesProcessed: data.count) {
+            try readGzipFile(gzipPath).count
+        })
+        cases.append(BenchmarkCase(name: "checksum.crc32", corpus: corpus, bytesProcessed: data.count) {
+            Int(ZLib.crc32(data) & 1)
+        })
+        cases.append(BenchmarkCase(name: "checksum.adler32", corpus: corpus, bytesProcessed: data.count) {
+            Int(ZLib.adler32(data) & 1)
+        })
+        return cases
+    }
+
+    // MARK: Private Static Functions
+
+    private static func verify(_ name: String, _ actual: Data, _ expected: Data) throws {
+        guard actual == expected else {
+            throw BenchmarkError.verificationFailed(name)
+        }
+    }
+
+    private static func streamCompress(_ data: Data) throws -> Int {
+        let compressor = Compressor()
+        try compressor.initialize(level: .defaultCompression)
+        var produced = 0
+        var offset = 0
+        repeat {
+            let end = min(offset + chunkSize, data.count)
+            let isLast = end == data.count
+            produced += try compressor.compress(data.subdata(in: offset ..< end), flush: isLast ? .finish : .noFlush).count
+            offset = end
+        } while offset < data.count
+        return produced
+    }
+
+    private static func streamDecompress(_ data: Data) throws -> Int {
+        let decompressor = Decompressor()
+        try decompressor.initialize()
+        var produced = 0
+        var offset = 0
+        repeat {
+            let end = min(offset + chunkSize, data.count)
+            produced += try decompressor.decompress(data.subdata(in: offset ..< end), flush: end == data.count ? .finish : .noFlush).count
+            offset = end
+        } while offset < data.count
+        return produced
+    }
+
+    private static func inflateBack(_ rawData: Data) throws -> Data {
+        let decompressor = InflateBackDecompressorCBridged(chunkSize: chunkSize)
+        try decompressor.initialize()
+        return try decompressor.processData(rawData)
+    }
+
+    private static func writeGzipFile(_ data: Data, to path: String) throws -> Int {
+        let file = try GzipFile(path: path, mode: "wb")
+        var offset = 0
+        while offset < data.count {
+            let end = min(offset + chunkSize, data.count)
+            try file.writeData(data.subdata(in: offset ..< end))
+            offset = end
+        }
+        try file.close()
+        return data.count
+    }
+
+    private static func readGzipFile(_ path: String) throws -> Data {
+        let file = try GzipFile(path: path, mode: "rb")
+        defer { try? file.close() }
+        var output = Data()
+        while true {
+            let chunk = try file.readData(count: chunkSize)
+            if chunk.isEmpty { break }
+            output.append(chunk)
+        }
+        return output
+    }
+}
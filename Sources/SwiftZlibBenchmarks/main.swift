@@ -0,0 +1,119 @@
+//
+//  main.swift
+//  SwiftZlibBenchmarks
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import Foundation
+import SwiftZlib
+
+// Benchmark runner: swift run -c release SwiftZlibBenchmarks [options]
+//
+// Progress and the summary table go to stderr; the JSON report goes to stdout (or --output),
+// so `SwiftZlibBenchmarks > report.json` captures only the report.
+
+func logLine(_ message: String) {
+    FileHandle.standardError.write(Data((message + "\n").utf8))
+}
+
+let options: BenchmarkOptions
+do {
+    options = try BenchmarkOptions.parse(Array(CommandLine.arguments.dropFirst()))
+} catch BenchmarkError.helpRequested {
+    print(BenchmarkOptions.usage)
+    exit(0)
+} catch {
+    logLine("\(error)\n\n\(BenchmarkOptions.usage)")
+    exit(64)
+}
+
+ZLibVerboseConfig.disableAll()
+
+#if DEBUG
+    logLine("⚠️  Debug build: numbers are not representative, use `swift run -c release`")
+#endif
+
+let scratchDirectory = (NSTemporaryDirectory() as NSString).appendingPathComponent("swiftzlib-bench-\(getpid())")
+var results: [BenchmarkResult] = []
+
+do {
+    try FileManager.default.createDirectory(atPath: scratchDirectory, withIntermediateDirectories: true)
+    defer { try? FileManager.default.removeItem(atPath: scratchDirectory) }
+
+    let corpus = try BenchmarkCorpus.load(size: options.corpusSize, directory: options.corpusDirectory)
+    logLine("zlib \(ZLib.version), \(corpus.count) corpus entries, \(options.warmupIterations) warmup + \(options.iterations) iterations")
+    logLine(ZLib.backend.description)
+    logLine("")
+    logLine("benchmark".padding(toLength: 40, withPad: " ", startingAt: 0)
+        + "median MB/s".leftPadded(12) + "p90 ms".leftPadded(10) + "stddev %".leftPadded(10)
+        + "ratio".leftPadded(8) + "zallocs".leftPadded(9))
+
+    for entry in corpus {
+        for benchmark in try BenchmarkSuite.cases(for: entry, scratchDirectory: scratchDirectory) {
+            let key = "\(benchmark.name)/\(benchmark.corpus)"
+            if let filter = options.filter, !key.contains(filter) {
+                continue
+            }
+            let result = try BenchmarkHarness.measure(benchmark, options: options)
+            results.append(result)
+
+            let timing = result.nanoseconds
+            let spread = timing.mean > 0 ? timing.standardDeviation / timing.mean * 100 : 0
+            let ratio = result.inputBytes > 0 ? Double(result.outputBytes) / Double(result.inputBytes) : 0
+            logLine(key.padding(toLength: 40, withPad: " ", startingAt: 0)
+                + String(format: "%.1f", result.medianMBps).leftPadded(12)
+                + String(format: "%.3f", timing.p90 / 1_000_000).leftPadded(10)
+                + String(format: "%.1f", spread).leftPadded(10)
+                + String(format: "%.3f", ratio).leftPadded(8)
+                + (result.zlibAllocationsPerIteration.map { String(format: "%.1f", $0) } ?? "-").leftPadded(9))
+        }
+    }
+} catch {
+    logLine("❌ Benchmark failed: \(error)")
+    exit(1)
+}
+
+let report = BenchmarkReport(options: options, results: results, peakResidentBytes: BenchmarkHarness.peakResidentBytes())
+
+do {
+    let json = try report.encoded()
+    if let outputPath = options.outputPath {
+        try json.write(to: URL(fileURLWithPath: outputPath))
+        logLine("\nReport written to \(outputPath)")
+    } else {
+        FileHandle.standardOutput.write(json)
+        FileHandle.standardOutput.write(Data("\n".utf8))
+    }
+} catch {
+    logLine("❌ Could not write report: \(error)")
+    exit(1)
+}
+
+if let baselinePath = options.baselinePath {
+    do {
+        let baseline = try BenchmarkReport.load(from: baselinePath)
+        let regressions = Regression.find(current: report, baseline: baseline, threshold: options.regressionThreshold)
+        if regressions.isEmpty {
+            logLine("\n✅ No regressions beyond \(options.regressionThreshold)% against \(baselinePath)")
+        } else {
+            logLine("\n❌ \(regressions.count) regression(s) beyond \(options.regressionThreshold)% against \(baselinePath):")
+            for regression in regressions {
+                logLine("  \(regression.key): \(String(format: "%.1f", regression.baselineMBps)) -> "
+                    + "\(String(format: "%.1f", regression.currentMBps)) MB/s (\(String(format: "%+.1f", regression.changePercent))%)")
+            }
+            exit(2)
+        }
+    } catch {
+        logLine("❌ Could not read baseline \(baselinePath): \(error)")
+        exit(1)
+    }
+}
+
+// MARK: - Helpers
+
+extension String {
+    func leftPadded(_ width: Int) -> String {
+        count >= width ? " " + self : String(repeating: " ", count: width - count) + self
+    }
+}
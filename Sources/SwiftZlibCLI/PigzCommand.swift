@@ -0,0 +1,364 @@
+//
+//  PigzCommand.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import Foundation
+import SwiftZlib
+
+// MARK: - PigzOptions
+
+/// Options of the pigz-compatible command
+struct PigzOptions {
+    // MARK: Properties
+
+    var decompress = false
+    var toStdout = false
+    var keep = false
+    var force = false
+    var verbose = false
+    var buildIndex = false
+    var level: CompressionLevel = .defaultCompression
+    var threadCount = ProcessInfo.processInfo.activeProcessorCount
+    var blockSize = ParallelCompressor.defaultBlockSize
+    var files: [String] = []
+}
+
+// MARK: - PigzError
+
+/// Failure of one file; the command reports it and moves on to the next file
+struct PigzError: Error {
+    let message: String
+}
+
+// MARK: - Command
+
+/// Bytes read from stdin or written to stdout per call when streaming
+private let pigzStreamChunkSize = 128 * 1024
+
+/// Run the pigz-compatible command
+///
+/// Compresses to gzip with the block-parallel engine, or decompresses with the parallel
+/// inflaters, file by file or from stdin to stdout with bounded memory. Follows gzip's
+/// conventions: `file` becomes `file.gz` and the input is removed unless `-k` or `-c` is given.
+/// Only diagnostics are written to stderr, so the command can sit in a pipeline.
+/// - Parameters:
+///   - args: Arguments after the command name
+///   - decompress: Decompress by default, as when invoked as `unpigz`
+/// - Returns: Exit status: 0 on success, 1 if any file failed
+func handlePigz(_ args: [String], decompress: Bool) -> Int32 {
+    var options: PigzOptions
+    do {
+        options = try parsePigzOptions(args)
+    } catch let error as PigzError {
+        pigzMessage(error.message)
+        printPigzUsage()
+        return 1
+    } catch {
+        pigzMessage("\(error)")
+        return 1
+    }
+    if decompress {
+        options.decompress = true
+    }
+
+    let inputs = options.files.isEmpty ? ["-"] : options.files
+    var status: Int32 = 0
+    for input in inputs {
+        do {
+            if input == "-" {
+                try pigzStandardStreams(options)
+            } else {
+                try pigzFile(input, options)
+            }
+        } catch let error as PigzError {
+            pigzMessage("\(input == "-" ? "stdin" : input): \(error.message)")
+            status = 1
+        } catch {
+            pigzMessage("\(input == "-" ? "stdin" : input): \(error.localizedDescription)")
+            status = 1
+        }
+    }
+    return status
+}
+
+/// Parse gzip-style flags; short flags may be grouped, as in `-dkc` or `-9p4`
+func parsePigzOptions(_ args: [String]) throws -> PigzOptions {
+    var options = PigzOptions()
+    var index = 0
+    var onlyFiles = false
+
+    func value(after flag: String, attached: Substring) throws -> Int {
+        var text = String(attached)
+        if text.isEmpty {
+            index += 1
+            guard index < args.count else {
+                throw PigzError(message: "option \(flag) requires a value")
+            }
+            text = args[index]
+        }
+        guard let number = Int(text), number > 0 else {
+            throw PigzError(message: "invalid value for \(flag): \(text)")
+        }
+        return number
+    }
+
+    while index < args.count {
+        let arg = args[index]
+        if onlyFiles || arg == "-" || !arg.hasPrefix("-") {
+            options.files.append(arg)
+        } else if arg == "--" {
+            onlyFiles = true
+        } else if arg.hasPrefix("--") {
+            switch arg {
+                case "--decompress": options.decompress = true
+                case "--stdout": options.toStdout = true
+                case "--keep": options.keep = true
+                case "--force": options.force = true
+                case "--verbose": options.verbose = true
+                case "--index": options.buildIndex = true
+                case "--fast": options.level = .bestSpeed
+                case "--best": options.level = .bestCompression
+                case "--processes": options.threadCount = try value(after: arg, attached: "")
+                case "--blocksize": options.blockSize = try value(after: arg, attached: "") * 1024
+                default: throw PigzError(message: "unknown option \(arg)")
+            }
+        } else {
+            var flags = arg.dropFirst()
+            while let flag = flags.first {
+                flags = flags.dropFirst()
+                switch flag {
+                    case "d": options.decompress = true
+                    case "c": options.toStdout = true
+                    case "k": options.keep = true
+                    case "f": options.force = true
+                    case "v": options.verbose = true
+                    case "0" ... "9": options.level = pigzLevel(Int(String(flag))!)
+                    case "p":
+                        options.threadCount = try value(after: "-p", attached: flags)
+                        flags = ""
+                    case "b":
+                        options.blockSize = try value(after: "-b", attached: flags) * 1024
+                        flags = ""
+                    default:
+                        throw PigzError(message: "unknown option -\(flag)")
+                }
+            }
+        }
+        index += 1
+    }
+    return options
+}
+
+/// Nearest supported level for gzip's `-0` ... `-9`
+func pigzLevel(_ digit: Int) -> CompressionLevel {
+    switch digit {
+        case 0: .noCompression
+        case 1 ... 3: .bestSpeed
+        case 9: .bestCompression
+        default: .defaultCompression
+    }
+}
+
+/// Output path for a file, or nil if it does not carry a gzip suffix when decompressing
+func pigzOutputPath(for path: String, decompress: Bool) -> String? {
+    guard decompress else {
+        return path + ".gz"
+    }
+    if path.hasSuffix(".tgz") {
+        return String(path.dropLast(4)) + ".tar"
+    }
+    for suffix in [".gz", ".z", "-gz", "_z"] where path.hasSuffix(suffix) && path.count > suffix.count {
+        return String(path.dropLast(suffix.count))
+    }
+    return nil
+}
+
+// MARK: - Private Functions
+
+/// Compress or decompress stdin to stdout
+private func pigzStandardStreams(_ options: PigzOptions) throws {
+    if !options.decompress, !options.force, isatty(STDOUT_FILENO) != 0 {
+        throw PigzError(message: "compressed data not written to a terminal. Use -f to force compression.")
+    }
+    if options.buildIndex {
+        pigzMessage("stdout: --index needs an output file; no index written")
+    }
+    let output = FileHandle.standardOutput
+    if options.decompress {
+        try pigzDecompressStream(path: "/dev/stdin", to: output)
+    } else {
+        try pigzCompress(from: FileHandle.standardInput, to: output, options)
+    }
+}
+
+/// Compress or decompress one file, gzip style
+private func pigzFile(_ input: String, _ options: PigzOptions) throws {
+    var isDirectory: ObjCBool = false
+    guard FileManager.default.fileExists(atPath: input, isDirectory: &isDirectory) else {
+        throw PigzError(message: "No such file or directory")
+    }
+    guard !isDirectory.boolValue else {
+        throw PigzError(message: "is a directory -- ignored")
+    }
+    if !options.decompress, !options.force, pigzOutputPath(for: input, decompress: true) != nil {
+        throw PigzError(message: "already has a gzip suffix -- unchanged")
+    }
+    guard let outputPath = pigzOutputPath(for: input, decompress: options.decompress) else {
+        throw PigzError(message: "unknown suffix -- ignored")
+    }
+
+    let start = Date()
+    if options.toStdout {
+        try pigzProcess(input, to: FileHandle.standardOutput, options)
+        return
+    }
+
+    if FileManager.default.fileExists(atPath: outputPath) {
+        guard options.force else {
+            throw PigzError(message: "\(outputPath) already exists; use -f to overwrite")
+        }
+        try FileManager.default.removeItem(atPath: outputPath)
+    }
+    guard FileManager.default.createFile(atPath: outputPath, contents: nil),
+          let output = FileHandle(forWritingAtPath: outputPath)
+    else {
+        throw PigzError(message: "cannot create \(outputPath)")
+    }
+    do {
+        defer { try? output.close() }
+        try pigzProcess(input, to: output, options)
+    } catch {
+        try? FileManager.default.removeItem(atPath: outputPath)
+        throw error
+    }
+
+    // Keep the input's timestamp and permissions, as gzip does
+    let attributes = try FileManager.default.attributesOfItem(atPath: input)
+    var preserved: [FileAttributeKey: Any] = [:]
+    preserved[.modificationDate] = attributes[.modificationDate]
+    preserved[.posixPermissions] = attributes[.posixPermissions]
+    try? FileManager.default.setAttributes(preserved, ofItemAtPath: outputPath)
+
+    if options.buildIndex {
+        if options.decompress {
+            pigzMessage("\(input): --index applies to compressed output; no index written")
+        } else {
+            try GzipIndex.build(forFileAt: outputPath).write(to: GzipIndex.sidecarPath(for: outputPath))
+        }
+    }
+    if options.verbose {
+        let inputSize = (attributes[.size] as? NSNumber)?.intValue ?? 0
+        let outputSize = ((try? FileManager.default.attributesOfItem(atPath: outputPath))?[.size] as? NSNumber)?.intValue ?? 0
+        let compressedSize = options.decompress ? inputSize : outputSize
+        let originalSize = options.decompress ? outputSize : inputSize
+        let saved = originalSize > 0 ? (1 - Double(compressedSize) / Double(originalSize)) * 100 : 0
+        let elapsed = Date().timeIntervalSince(start)
+        pigzMessage("\(input): \(String(format: "%.1f", saved))% in \(String(format: "%.2f", elapsed))s -- replaced with \(outputPath)")
+    }
+    if !options.keep {
+        try FileManager.default.removeItem(atPath: input)
+        if options.decompress {
+            // The sidecar index of a removed gzip file is stale
+            try? FileManager.default.removeItem(atPath: GzipIndex.sidecarPath(for: input))
+        }
+    }
+}
+
+/// Compress or decompress a file's contents into an open output
+private func pigzProcess(_ input: String, to output: FileHandle, _ options: PigzOptions) throws {
+    if options.decompress {
+        try pigzDecompressFile(input, to: output, threadCount: options.threadCount)
+    } else {
+        guard let handle = FileHandle(forReadingAtPath: input) else {
+            throw PigzError(message: "cannot open for reading")
+        }
+        defer { try? handle.close() }
+        try pigzCompress(from: handle, to: output, options)
+    }
+}
+
+/// Gzip a stream with the block-parallel engine; memory stays at about two blocks per thread
+private func pigzCompress(from input: FileHandle, to output: FileHandle, _ options: PigzOptions) throws {
+    let compressor = ParallelCompressor(
+        level: options.level,
+        windowBits: .gzip,
+        blockSize: options.blockSize,
+        threadCount: options.threadCount
+    )
+    try compressor.compress(
+        reader: { maxLength in try input.read(upToCount: maxLength) ?? Data() },
+        writer: { try output.write(contentsOf: $0) }
+    )
+}
+
+/// Decompress a gzip file, spreading members or chunks of a large member over threads
+///
+/// A smaller file with a single member has nothing to split, so it is streamed through the gz layer.
+private func pigzDecompressFile(_ input: String, to output: FileHandle, threadCount: Int) throws {
+    let source = try Data(contentsOf: URL(fileURLWithPath: input), options: .alwaysMapped)
+    guard source.count >= 2, source[source.startIndex] == 0x1F, source[source.startIndex + 1] == 0x8B else {
+        throw PigzError(message: "not in gzip format")
+    }
+    let write: (Data) throws -> Void = { try output.write(contentsOf: $0) }
+    let isStreamed = try source.withUnsafeBytes { bytes -> Bool in
+        if bytes.count >= ParallelInflater.recommendedMinimumInputSize {
+            try ParallelInflater(windowBits: .gzip, threadCount: threadCount).decompress(bytes, writer: write)
+        } else if ParallelGzipDecompressor.hasMemberCandidate(bytes, after: 0) {
+            try ParallelGzipDecompressor(threadCount: threadCount).decompress(bytes, writer: write)
+        } else {
+            return true
+        }
+        return false
+    }
+    if isStreamed {
+        try pigzDecompressStream(path: input, to: output)
+    }
+}
+
+/// Decompress a gzip stream that cannot be mapped, such as a pipe, through zlib's gz layer
+private func pigzDecompressStream(path: String, to output: FileHandle) throws {
+    let file = try GzipFile(path: path, mode: "rb")
+    defer { try? file.close() }
+    guard !file.isDirect else {
+        throw PigzError(message: "not in gzip format")
+    }
+    while true {
+        let chunk = try file.readData(count: pigzStreamChunkSize)
+        if chunk.isEmpty {
+            break
+        }
+        try output.write(contentsOf: chunk)
+    }
+    // gzread returns what it decoded from a truncated stream instead of failing
+    if file.getErrorInfo().code == ZLibErrorCode.bufferError.rawValue {
+        throw PigzError(message: "unexpected end of file")
+    }
+}
+
+private func pigzMessage(_ message: String) {
+    FileHandle.standardError.write(Data("pigz: \(message)\n".utf8))
+}
+
+private func printPigzUsage() {
+    FileHandle.standardError.write(Data("""
+    Usage: SwiftZlibCLI pigz [options] [files...]
+
+    Compresses each file to file.gz with parallel blocks, or stdin to stdout when no
+    file (or "-") is given. The same binary invoked as `pigz` or `unpigz` works directly.
+
+    Options:
+        -0 ... -9, --fast, --best   Compression level (mapped to 0, 1, 6 or 9)
+        -d, --decompress            Decompress
+        -c, --stdout                Write to stdout and keep the input files
+        -k, --keep                  Keep the input files
+        -f, --force                 Overwrite outputs; compress to a terminal
+        -p N, --processes N         Threads to use (default: all cores)
+        -b K, --blocksize K         Compression block size in KiB (default: 128)
+        --index                     Write a .gzidx random-access index next to each .gz
+        -v, --verbose               Report ratio and time per file
+
+    """.utf8))
+}
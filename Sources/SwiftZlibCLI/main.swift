@@ -9,11 +9,21 @@ import SwiftZlib
 
 // MARK: - Command Line Interface
 
+// Parse command line arguments
+let arguments = CommandLine.arguments
+
+// pigz-compatible mode writes data to stdout, so it runs before the banner
+let invokedAs = URL(fileURLWithPath: arguments[0]).lastPathComponent
+if invokedAs == "pigz" || invokedAs == "unpigz" {
+    exit(handlePigz(Array(arguments.dropFirst()), decompress: invokedAs == "unpigz"))
+}
+if arguments.count > 1, arguments[1] == "pigz" {
+    exit(handlePigz(Array(arguments.dropFirst(2)), decompress: false))
+}
+
 print("🚀 SwiftZlib Command Line Tool")
 print("================================")
 
-// Parse command line arguments
-let arguments = CommandLine.arguments
 guard arguments.count > 1 else {
     printUsage()
     exit(1)
@@ -539,6 +549,7 @@ func printUsage() {
         gzip <input> <output>               Gzip compression with headers
         large <input> <output> [level]      Large file compression with progress
         memory                               Show memory level information
+        pigz [options] [files...]            Parallel gzip/gunzip, pigz compatible
         help                                 Show this help message
 
     Examples:
@@ -551,6 +562,8 @@ func printUsage() {
         swift run SwiftZlibCLI gzip document.txt document.gz
         swift run SwiftZlibCLI large huge_file.dat compressed.zlib 9
         swift run SwiftZlibCLI memory
+        swift run SwiftZlibCLI pigz -p 8 -k big_file.dat
+        cat big_file.dat | swift run SwiftZlibCLI pigz -c > big_file.dat.gz
 
     Compression Levels:
         0 - No compression
@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+// Compresses inputs whose matches only come from strings that deflate inserts
+// outside INSERT_STRING: a preset dictionary, and the bytes left over between
+// flushes that fill_window inserts on the next call. Checks every round trip
+// and prints "<case> <compressed size>" to stdout. `make variants` compares
+// the sizes of the CRC hash build against the generic one, since that hash
+// changes the bytes but must find matches just as well.
+
+#define INPUT_SIZE (64 * 1024)
+
+static unsigned long long rng = 88172645463325252ULL;
+
+static unsigned next_random(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return (unsigned)(rng >> 32);
+}
+
+static void make_random(unsigned char *buf, size_t len) {
+    for (size_t i = 0; i < len; i++) buf[i] = (unsigned char)next_random();
+}
+
+// Compress in chunks of `chunk` bytes, sync flushing after each one when asked.
+// Returns the compressed size, or 0 on failure.
+static size_t compress_with(int level, int windowBits, const unsigned char *dict, size_t dict_len,
+                            const unsigned char *in, size_t len, size_t chunk, int flush,
+                            unsigned char *out, size_t out_size) {
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+    if (deflateInit2(&strm, level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        return 0;
+    if (dict_len && deflateSetDictionary(&strm, dict, (uInt)dict_len) != Z_OK) {
+        deflateEnd(&strm);
+        return 0;
+    }
+    strm.next_out = out;
+    strm.avail_out = (uInt)out_size;
+    size_t pos = 0;
+    int ret = Z_OK;
+    while (ret == Z_OK && pos < len) {
+        size_t n = len - pos < chunk ? len - pos : chunk;
+        strm.next_in = (Bytef *)(in + pos);
+        strm.avail_in = (uInt)n;
+        ret = deflate(&strm, flush);
+        if (strm.avail_in != 0) ret = Z_BUF_ERROR;
+        pos += n;
+    }
+    ret = ret == Z_OK ? deflate(&strm, Z_FINISH) : ret;
+    size_t produced = strm.total_out;
+    deflateEnd(&strm);
+    return ret == Z_STREAM_END ? produced : 0;
+}
+
+static int inflate_check(const unsigned char *comp, size_t comp_len, int windowBits,
+                         const unsigned char *dict, size_t dict_len,
+                         const unsigned char *expected, size_t len) {
+    unsigned char *out = malloc(len + 1);
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+    if (out == NULL || inflateInit2(&strm, windowBits) != Z_OK) {
+        free(out);
+        return 0;
+    }
+    // Raw streams take the dictionary up front, zlib streams ask for it
+    if (windowBits < 0 && dict_len) inflateSetDictionary(&strm, dict, (uInt)dict_len);
+    strm.next_in = (Bytef *)comp;
+    strm.avail_in = (uInt)comp_len;
+    strm.next_out = out;
+    strm.avail_out = (uInt)(len + 1);
+    int ret = inflate(&strm, Z_FINISH);
+    if (ret == Z_NEED_DICT && inflateSetDictionary(&strm, dict, (uInt)dict_len) == Z_OK)
+        ret = inflate(&strm, Z_FINISH);
+    int ok = ret == Z_STREAM_END && strm.total_out == len && memcmp(out, expected, len) == 0;
+    inflateEnd(&strm);
+    free(out);
+    return ok;
+}
+
+int main() {
+    static const int levels[] = {1, 6, 9};
+    size_t out_size = compressBound(2 * INPUT_SIZE) + 1024;
+    unsigned char *dict = malloc(INPUT_SIZE);
+    unsigned char *in = malloc(2 * INPUT_SIZE + 14);
+    unsigned char *out = malloc(out_size);
+    int failures = 0;
+    if (dict == NULL || in == NULL || out == NULL) return 1;
+
+    printf("=== Zlib Hash Dictionary Test ===\n");
+
+    // Random bytes only compress through the dictionary or earlier input
+    make_random(dict, 30000);
+    memcpy(in, dict, 30000);
+    // Short random pieces, each written twice, so that many matches start in
+    // the bytes that were held back at the previous flush
+    for (size_t i = 30000; i < 2 * INPUT_SIZE; i += 14) {
+        make_random(in + i, 7);
+        memcpy(in + i + 7, in + i, 7);
+    }
+
+    for (size_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+        int level = levels[l];
+        struct {
+            const char *name;
+            int windowBits;
+            size_t dict_len;
+            size_t len;
+            size_t chunk;
+            int flush;
+        } cases[] = {
+            {"zlib-dictionary", 15, 30000, 30000, 30000, Z_NO_FLUSH},
+            {"raw-dictionary", -15, 30000, 30000, 30000, Z_NO_FLUSH},
+            {"raw-dictionary-window-12", -12, 30000, 30000, 30000, Z_NO_FLUSH},
+            {"zlib-dictionary-chunked", 15, 30000, 30000, 1000, Z_NO_FLUSH},
+            {"raw-flushed-pieces", -15, 0, 2 * INPUT_SIZE - 30000, 61, Z_SYNC_FLUSH},
+        };
+        for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+            const unsigned char *data = cases[c].dict_len ? in : in + 30000;
+            size_t comp_len = compress_with(level, cases[c].windowBits, dict, cases[c].dict_len, data,
+                                            cases[c].len, cases[c].chunk, cases[c].flush, out, out_size);
+            int ok = comp_len != 0 && inflate_check(out, comp_len, cases[c].windowBits, dict,
+                                                     cases[c].dict_len, data, cases[c].len);
+            // The dictionary holds the whole input and fits the window, so deflate must find it
+            int fits = cases[c].windowBits == 15 || cases[c].windowBits == -15;
+            if (ok && cases[c].dict_len && fits && comp_len > cases[c].len / 20) {
+                fprintf(stderr, "level %d %s: dictionary not matched (%lu bytes)\n", level,
+                        cases[c].name, (unsigned long)comp_len);
+                ok = 0;
+            }
+            printf("level-%d-%s %lu%s\n", level, cases[c].name, (unsigned long)comp_len, ok ? "" : " FAILED");
+            if (!ok) failures++;
+        }
+    }
+
+    free(dict);
+    free(in);
+    free(out);
+    if (failures) {
+        printf("%d cases failed\n", failures);
+        return 1;
+    }
+    printf("All cases passed\n");
+    return 0;
+}
@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+#ifdef Z_DEFLATE_SPECIALIZE
+#include "deflate.h"
+#endif
+
+// Compresses a set of inputs with the configuration the specialized deflate is
+// built for (by default level 1, 32K window, memLevel 8) and with neighbouring
+// ones that must fall back to the generic code, checks every round trip, and
+// prints the CRC-32 of each compressed stream to stdout. `make variants` runs
+// this against the generic and the specialized vendored zlib and diffs the two.
+
+#define INPUT_SIZE (300 * 1024)
+
+typedef struct {
+    const char *name;
+    int level;
+    int windowBits;
+    int memLevel;
+    int strategy;
+} config;
+
+static const config configs[] = {
+    {"raw level 1", 1, -15, 8, Z_DEFAULT_STRATEGY},
+    {"zlib level 1", 1, 15, 8, Z_DEFAULT_STRATEGY},
+    {"gzip level 1", 1, 31, 8, Z_DEFAULT_STRATEGY},
+    {"raw level 1 filtered", 1, -15, 8, Z_FILTERED},
+    {"raw level 1 fixed", 1, -15, 8, Z_FIXED},
+    {"raw level 1 rle", 1, -15, 8, Z_RLE},
+    {"raw level 2", 2, -15, 8, Z_DEFAULT_STRATEGY},
+    {"raw level 3", 3, -15, 8, Z_DEFAULT_STRATEGY},
+    {"raw level 2 window 12", 2, -12, 8, Z_DEFAULT_STRATEGY},
+    {"raw level 6", 6, -15, 8, Z_DEFAULT_STRATEGY},
+    {"raw level 1 window 12", 1, -12, 8, Z_DEFAULT_STRATEGY},
+    {"raw level 1 memLevel 9", 1, -15, 9, Z_DEFAULT_STRATEGY},
+};
+
+static unsigned long long rng = 88172645463325252ULL;
+
+static unsigned next_random(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return (unsigned)(rng >> 32);
+}
+
+// Kind 0: words with random noise, 1: long repeats, 2: random bytes, 3: zeros
+static void make_input(unsigned char *buf, size_t len, int kind) {
+    static const char *words[] = {"alpha ", "beta ", "gamma ", "delta ", "GET /index.html ", "200 OK\n"};
+    size_t i = 0;
+    while (i < len) {
+        if (kind == 0) {
+            const char *w = words[next_random() % 6];
+            while (*w && i < len) buf[i++] = (unsigned char)*w++;
+            if (next_random() % 5 == 0 && i < len) buf[i++] = (unsigned char)next_random();
+        } else if (kind == 1) {
+            size_t run = 300 + next_random() % 2000;
+            size_t dist = 1 + next_random() % 30000;
+            for (; run && i < len; run--, i++)
+                buf[i] = i >= dist ? buf[i - dist] : (unsigned char)next_random();
+        } else if (kind == 2) {
+            buf[i++] = (unsigned char)next_random();
+        } else {
+            buf[i++] = 0;
+        }
+    }
+}
+
+static int inflate_check(const unsigned char *comp, size_t comp_len, int windowBits,
+                         const unsigned char *expected, size_t len) {
+    unsigned char *out = malloc(len + 1);
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+    if (out == NULL || inflateInit2(&strm, windowBits) != Z_OK) {
+        free(out);
+        return 0;
+    }
+    strm.next_in = (Bytef *)comp;
+    strm.avail_in = (uInt)comp_len;
+    strm.next_out = out;
+    strm.avail_out = (uInt)(len + 1);
+    int ret = inflate(&strm, Z_FINISH);
+    int ok = ret == Z_STREAM_END && strm.total_out == len && memcmp(out, expected, len) == 0;
+    inflateEnd(&strm);
+    free(out);
+    return ok;
+}
+
+// Compress in uneven chunks with an occasional sync flush, optionally changing
+// parameters halfway through. Returns the compressed size, or 0 on failure.
+static size_t compress_stream(const config *c, const unsigned char *in, size_t len,
+                              unsigned char *out, size_t out_size, int twist) {
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+    if (deflateInit2(&strm, c->level, Z_DEFLATED, c->windowBits, c->memLevel, c->strategy) != Z_OK)
+        return 0;
+
+#ifdef Z_DEFLATE_SPECIALIZE
+    int wbits = c->windowBits < 0 ? -c->windowBits : c->windowBits & 15;
+    int expected = c->level == Z_DEFLATE_SPEC_LEVEL && wbits == Z_DEFLATE_SPEC_WBITS &&
+                   c->memLevel == Z_DEFLATE_SPEC_MEMLEVEL &&
+                   c->strategy != Z_HUFFMAN_ONLY && c->strategy != Z_RLE;
+    if (DEFLATE_SPECIALIZED((deflate_state *)strm.state) != expected) {
+        fprintf(stderr, "%s: unexpected deflate path\n", c->name);
+        deflateEnd(&strm);
+        return 0;
+    }
+#endif
+
+    size_t pos = 0;
+    int chunk = 0;
+    strm.next_out = out;
+    strm.avail_out = (uInt)out_size;
+    while (pos < len) {
+        size_t n = 1000 + (size_t)(chunk * 7919) % 40000;
+        if (n > len - pos) n = len - pos;
+        if (twist == 1 && pos >= len / 2 && pos < len / 2 + n) {
+            // Switching to level 6 and back leaves the specialized path and returns to it
+            if (deflateParams(&strm, 6, c->strategy) != Z_OK) break;
+        } else if (twist == 1 && pos >= 3 * len / 4 && pos < 3 * len / 4 + n) {
+            if (deflateParams(&strm, c->level, c->strategy) != Z_OK) break;
+        } else if (twist == 2 && chunk == 3) {
+            // Tuned parameters differ from the table, so the generic code must run
+            if (deflateTune(&strm, 4, 4, 16, 4) != Z_OK) break;
+        }
+        strm.next_in = (Bytef *)(in + pos);
+        strm.avail_in = (uInt)n;
+        int ret = deflate(&strm, chunk % 5 == 4 ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+        if (ret != Z_OK || strm.avail_in != 0) break;
+        pos += n;
+        chunk++;
+    }
+    strm.avail_in = 0;
+    int ret = pos == len ? deflate(&strm, Z_FINISH) : Z_STREAM_ERROR;
+    size_t produced = strm.total_out;
+    deflateEnd(&strm);
+    return ret == Z_STREAM_END ? produced : 0;
+}
+
+int main() {
+    static const char *kinds[] = {"text", "repeats", "random", "zeros"};
+    static const size_t sizes[] = {0, 1, 3, 100, 65536, INPUT_SIZE};
+    size_t out_size = compressBound(INPUT_SIZE) + 1024;
+    unsigned char *in = malloc(INPUT_SIZE);
+    unsigned char *out = malloc(out_size);
+    int failures = 0;
+    if (in == NULL || out == NULL) return 1;
+
+    printf("=== Zlib Specialized Deflate Test ===\n");
+#ifdef Z_DEFLATE_SPECIALIZE
+    fprintf(stderr, "specialized for level %d, windowBits %d, memLevel %d\n",
+            Z_DEFLATE_SPEC_LEVEL, Z_DEFLATE_SPEC_WBITS, Z_DEFLATE_SPEC_MEMLEVEL);
+#else
+    fprintf(stderr, "generic deflate\n");
+#endif
+
+    for (size_t k = 0; k < sizeof(kinds) / sizeof(kinds[0]); k++) {
+        rng = 88172645463325252ULL + k;
+        make_input(in, INPUT_SIZE, (int)k);
+        for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+            for (size_t z = 0; z < sizeof(sizes) / sizeof(sizes[0]); z++) {
+                for (int twist = 0; twist < 3; twist++) {
+                    if (twist && sizes[z] != INPUT_SIZE) continue;
+                    size_t len = sizes[z];
+                    size_t comp_len = compress_stream(&configs[c], in, len, out, out_size, twist);
+                    int ok = (comp_len != 0 || len == 0) &&
+                             inflate_check(out, comp_len, configs[c].windowBits, in, len);
+                    printf("%-24s %-8s %7lu twist %d -> %7lu crc %08lx%s\n",
+                           configs[c].name, kinds[k], (unsigned long)len, twist,
+                           (unsigned long)comp_len, crc32(0L, out, (uInt)comp_len),
+                           ok ? "" : " FAILED");
+                    if (!ok) failures++;
+                }
+            }
+        }
+    }
+
+    free(in);
+    free(out);
+    if (failures) {
+        printf("%d round trips failed\n", failures);
+        return 1;
+    }
+    printf("All round trips passed\n");
+    return 0;
+}
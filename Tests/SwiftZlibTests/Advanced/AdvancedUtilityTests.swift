@@ -18,6 +18,7 @@ final class AdvancedUtilityTests: XCTestCase {
         ("testBufferSizeCalculation", testBufferSizeCalculation),
         ("testCompressionStatistics", testCompressionStatistics),
         ("testCompileFlags", testCompileFlags),
+        ("testBackendReport", testBackendReport),
     ]
 
     // MARK: Functions
@@ -100,4 +101,28 @@ final class AdvancedUtilityTests: XCTestCase {
         XCTAssertGreaterThanOrEqual(flagsInfo.sizeOfPointer, 0)
         XCTAssertGreaterThanOrEqual(flagsInfo.sizeOfZOffT, 0)
     }
+
+    func testBackendReport() throws {
+        let backend = ZLib.backend
+        XCTAssertEqual(backend.isVendored, ZLib.compileFlagsInfo.isVendored)
+        XCTAssertEqual(backend.version, ZLib.version)
+        XCTAssertTrue(backend.description.contains(backend.version))
+
+        if backend.isVendored {
+            XCTAssertTrue(["avx2", "sse2", "neon", "word", "bytewise"].contains(backend.matchKernel))
+            XCTAssertTrue(["rolling", "crc32c"].contains(backend.insertHash))
+            XCTAssertNotEqual(backend.adler32Kernel, "system")
+            XCTAssertNotEqual(backend.crc32Kernel, "system")
+            if backend.adler32Kernel == "avx2" {
+                XCTAssertTrue(backend.cpuFeatures.contains(.avx2))
+            }
+        } else {
+            XCTAssertEqual(backend.matchKernel, "system")
+            XCTAssertNil(backend.specializedDeflate)
+        }
+        if let specialized = backend.specializedDeflate {
+            XCTAssertTrue((1 ... 3).contains(specialized.level))
+            XCTAssertTrue((9 ... 15).contains(specialized.windowBits))
+        }
+    }
 }
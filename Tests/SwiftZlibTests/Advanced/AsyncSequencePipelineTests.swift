@@ -0,0 +1,293 @@
+//
+//  AsyncSequencePipelineTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class AsyncSequencePipelineTests: XCTestCase {
+    // MARK: Nested Types
+
+    private struct SourceError: Error {}
+
+    /// Counts how many chunks the pipeline pulled from the source
+    private final class PullCounter: @unchecked Sendable {
+        // MARK: Properties
+
+        private let lock = NSLock()
+        private var pulled = 0
+
+        // MARK: Computed Properties
+
+        var count: Int {
+            lock.lock()
+            defer { lock.unlock() }
+            return pulled
+        }
+
+        // MARK: Functions
+
+        func increment() {
+            lock.lock()
+            pulled += 1
+            lock.unlock()
+        }
+    }
+
+    /// Async source yielding fixed chunks, optionally failing after them
+    private struct ChunkSource: AsyncSequence {
+        typealias Element = Data
+
+        struct AsyncIterator: AsyncIteratorProtocol {
+            let chunks: [Data]
+            let counter: PullCounter?
+            let failAtEnd: Bool
+            var index = 0
+
+            mutating func next() async throws -> Data? {
+                guard index < chunks.count else {
+                    if failAtEnd { throw SourceError() }
+                    return nil
+                }
+                counter?.increment()
+                index += 1
+                return chunks[index - 1]
+            }
+        }
+
+        let chunks: [Data]
+        var counter: PullCounter?
+        var failAtEnd = false
+
+        func makeAsyncIterator() -> AsyncIterator {
+            AsyncIterator(chunks: chunks, counter: counter, failAtEnd: failAtEnd)
+        }
+    }
+
+    /// Async byte sequence, standing in for URLSession.AsyncBytes
+    private struct ByteSource: AsyncSequence {
+        typealias Element = UInt8
+
+        struct AsyncIterator: AsyncIteratorProtocol {
+            let bytes: [UInt8]
+            var index = 0
+
+            mutating func next() async -> UInt8? {
+                guard index < bytes.count else { return nil }
+                index += 1
+                return bytes[index - 1]
+            }
+        }
+
+        let bytes: [UInt8]
+
+        func makeAsyncIterator() -> AsyncIterator {
+            AsyncIterator(bytes: bytes)
+        }
+    }
+
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testDeflatedInflatedRoundTrip", testDeflatedInflatedRoundTrip),
+        ("testDeflatedMatchesOneShotDecompression", testDeflatedMatchesOneShotDecompression),
+        ("testOutputChunksRespectBufferSize", testOutputChunksRespectBufferSize),
+        ("testBackpressureBoundsReadAhead", testBackpressureBoundsReadAhead),
+        ("testCancellationStopsPipeline", testCancellationStopsPipeline),
+        ("testTruncatedInputThrows", testTruncatedInputThrows),
+        ("testInflatedStopsAtOutputLimit", testInflatedStopsAtOutputLimit),
+        ("testSourceErrorPropagates", testSourceErrorPropagates),
+        ("testByteSequenceRoundTrip", testByteSequenceRoundTrip),
+        ("testMultiMemberGzip", testMultiMemberGzip),
+        ("testBuilderPipeline", testBuilderPipeline),
+    ]
+
+    // MARK: Functions
+
+    func testDeflatedInflatedRoundTrip() async throws {
+        let original = makeData(count: 300_000)
+        let source = ChunkSource(chunks: split(original, size: 7000))
+
+        var output = Data()
+        for try await chunk in source.deflated(level: .bestSpeed, bufferSize: 4096).inflated(bufferSize: 8192) {
+            output.append(chunk)
+        }
+        XCTAssertEqual(output, original)
+    }
+
+    func testDeflatedMatchesOneShotDecompression() async throws {
+        let original = makeData(count: 100_000)
+        for format in [CompressionFormat.zlib, .gzip, .raw] {
+            var compressed = Data()
+            for try await chunk in ChunkSource(chunks: split(original, size: 3000)).deflated(format: format) {
+                compressed.append(chunk)
+            }
+            XCTAssertEqual(try ZLib.decompress(compressed, options: DecompressionOptions(format: format)), original, "format \(format)")
+        }
+    }
+
+    func testOutputChunksRespectBufferSize() async throws {
+        let original = makeData(count: 200_000)
+        let compressed = try ZLib.compress(original)
+
+        var sizes: [Int] = []
+        for try await chunk in ChunkSource(chunks: split(compressed, size: 50000)).inflated(bufferSize: 10000) {
+            sizes.append(chunk.count)
+        }
+        XCTAssertEqual(sizes.reduce(0, +), original.count)
+        XCTAssertTrue(sizes.allSatisfy { $0 > 0 && $0 <= 10000 })
+    }
+
+    func testBackpressureBoundsReadAhead() async throws {
+        let counter = PullCounter()
+        let chunks = split(Data((0 ..< 1024 * 1024).map { _ in UInt8.random(in: 0 ... 255) }), size: 1024)
+        let source = ChunkSource(chunks: chunks, counter: counter)
+
+        var iterator = source.deflated(level: .bestSpeed, bufferSize: 1024, maxBufferedChunks: 2).makeAsyncIterator()
+        _ = try await iterator.next()
+
+        // A stalled consumer must stall the source. Besides the few chunks queued in the channels,
+        // deflate holds up to one block (~32 KB of literals at memory level 9) before emitting it.
+        try await Task.sleep(nanoseconds: 200_000_000)
+        let pulledWhileStalled = counter.count
+        XCTAssertLessThan(pulledWhileStalled, 200)
+
+        var remaining = 0
+        while let chunk = try await iterator.next() {
+            remaining += chunk.count
+        }
+        XCTAssertGreaterThan(remaining, 0)
+        XCTAssertEqual(counter.count, chunks.count)
+    }
+
+    func testCancellationStopsPipeline() async throws {
+        let counter = PullCounter()
+        let chunks = Array(repeating: makeData(count: 4096), count: 10000)
+        let source = ChunkSource(chunks: chunks, counter: counter)
+
+        let consumer = Task {
+            var received = 0
+            for try await _ in source.deflated(bufferSize: 1024, maxBufferedChunks: 2) {
+                received += 1
+                try await Task.sleep(nanoseconds: 1_000_000)
+            }
+            return received
+        }
+        try await Task.sleep(nanoseconds: 50_000_000)
+        consumer.cancel()
+
+        do {
+            _ = try await consumer.value
+        } catch is CancellationError {
+            // Expected: the pending next() or sleep was cancelled
+        }
+        let pulledAtCancel = counter.count
+        try await Task.sleep(nanoseconds: 100_000_000)
+        XCTAssertLessThan(counter.count, chunks.count)
+        XCTAssertLessThanOrEqual(counter.count, pulledAtCancel + 1, "Source kept being read after cancellation")
+    }
+
+    func testTruncatedInputThrows() async throws {
+        let compressed = try ZLib.compress(makeData(count: 50000))
+        let source = ChunkSource(chunks: split(compressed.prefix(compressed.count / 2), size: 1000))
+
+        do {
+            for try await _ in source.inflated() {}
+            XCTFail("Expected truncated input to throw")
+        } catch {
+            guard case .decompressionFailed? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+    }
+
+    func testInflatedStopsAtOutputLimit() async throws {
+        let bomb = try ZLib.compress(Data(count: 2_000_000), level: .bestCompression)
+        let options = DecompressionOptions(format: .zlib, maxOutputSize: 100_000)
+
+        var received = 0
+        do {
+            for try await chunk in ChunkSource(chunks: split(bomb, size: 100)).inflated(options: options, bufferSize: 8192) {
+                received += chunk.count
+            }
+            XCTFail("Expected the output limit to stop inflation")
+        } catch {
+            guard case .outputLimitExceeded(limit: 100_000)? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+        XCTAssertLessThanOrEqual(received, 100_000)
+    }
+
+    func testSourceErrorPropagates() async throws {
+        var source = ChunkSource(chunks: split(makeData(count: 10000), size: 1000))
+        source.failAtEnd = true
+
+        do {
+            for try await _ in source.deflated() {}
+            XCTFail("Expected the source error to be rethrown")
+        } catch {
+            XCTAssertTrue(error is SourceError, "Unexpected error \(error)")
+        }
+    }
+
+    func testByteSequenceRoundTrip() async throws {
+        let original = makeData(count: 20000)
+        let compressed = try ZLib.compressGzip(original)
+
+        var output = Data()
+        for try await chunk in ByteSource(bytes: Array(compressed)).inflated(bufferSize: 4096) {
+            output.append(chunk)
+        }
+        XCTAssertEqual(output, original)
+
+        var recompressed = Data()
+        for try await chunk in ByteSource(bytes: Array(original)).deflated(format: .gzip, bufferSize: 4096) {
+            recompressed.append(chunk)
+        }
+        XCTAssertEqual(try ZLib.decompress(recompressed, options: DecompressionOptions(format: .gzip)), original)
+    }
+
+    func testMultiMemberGzip() async throws {
+        let first = makeData(count: 5000)
+        let second = Data("second member".utf8)
+        let members = try ZLib.compressGzip(first) + ZLib.compressGzip(second)
+
+        var output = Data()
+        for try await chunk in ChunkSource(chunks: split(members, size: 333)).inflated(format: .gzip) {
+            output.append(chunk)
+        }
+        XCTAssertEqual(output, first + second)
+    }
+
+    func testBuilderPipeline() async throws {
+        let original = makeData(count: 30000)
+        let compressed = try ZLib.compress(original)
+
+        let pipeline = ZLib.asyncStream()
+            .decompress()
+            .format(.zlib)
+            .bufferSize(2048)
+            .pipeline(over: ChunkSource(chunks: split(compressed, size: 500)))
+
+        var output = Data()
+        for try await chunk in pipeline {
+            XCTAssertLessThanOrEqual(chunk.count, 2048)
+            output.append(chunk)
+        }
+        XCTAssertEqual(output, original)
+    }
+
+    // MARK: Private Functions
+
+    private func makeData(count: Int) -> Data {
+        Data((0 ..< count).map { UInt8(truncatingIfNeeded: ($0 * 7) ^ ($0 >> 9) ^ ($0 % 251)) })
+    }
+
+    private func split(_ data: Data, size: Int) -> [Data] {
+        stride(from: 0, to: data.count, by: size).map { data.subdata(in: $0 ..< min($0 + size, data.count)) }
+    }
+}
@@ -0,0 +1,194 @@
+//
+//  DictionaryTrainerTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class DictionaryTrainerTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testTrainedDictionaryImprovesSmallMessages", testTrainedDictionaryImprovesSmallMessages),
+        ("testTrainerRespectsMaxSize", testTrainerRespectsMaxSize),
+        ("testHighestScoringSegmentIsPlacedLast", testHighestScoringSegmentIsPlacedLast),
+        ("testTrainerFallsBackWithoutSharedContent", testTrainerFallsBackWithoutSharedContent),
+        ("testTrainerWithNoSamples", testTrainerWithNoSamples),
+        ("testPreparedMatchesSetDictionary", testPreparedMatchesSetDictionary),
+        ("testPreparedRoundTrip", testPreparedRoundTrip),
+        ("testPreparedRawRoundTrip", testPreparedRawRoundTrip),
+        ("testPreparedCompressorStreaming", testPreparedCompressorStreaming),
+        ("testPreparedDictionaryIsSharedAcrossThreads", testPreparedDictionaryIsSharedAcrossThreads),
+        ("testWrongDictionaryIsRejected", testWrongDictionaryIsRejected),
+        ("testGzipIsRejected", testGzipIsRejected),
+        ("testInitializeWithPreparedTwiceThrows", testInitializeWithPreparedTwiceThrows),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testTrainedDictionaryImprovesSmallMessages() throws {
+        let dictionary = ZLib.trainDictionary(from: (0 ..< 500).map(makeMessage))
+        XCTAssertFalse(dictionary.isEmpty)
+        XCTAssertLessThanOrEqual(dictionary.count, DictionaryTrainer.maxDictionarySize)
+
+        let prepared = try ZLib.prepareDictionary(dictionary)
+        var plainSize = 0
+        var primedSize = 0
+        for index in 1000 ..< 1100 {
+            let message = makeMessage(index)
+            plainSize += try ZLib.compress(message).count
+            primedSize += try prepared.compress(message).count
+        }
+        XCTAssertLessThan(primedSize * 3, plainSize * 2, "plain \(plainSize) vs dictionary \(primedSize)")
+    }
+
+    func testTrainerRespectsMaxSize() {
+        let samples = (0 ..< 300).map(makeMessage)
+        let dictionary = DictionaryTrainer(maxSize: 1024, segmentLength: 32).train(samples)
+        XCTAssertGreaterThan(dictionary.count, 0)
+        XCTAssertLessThanOrEqual(dictionary.count, 1024)
+    }
+
+    func testHighestScoringSegmentIsPlacedLast() {
+        var state: UInt64 = 1
+        func randomBytes(_ count: Int) -> Data {
+            Data((0 ..< count).map { _ in
+                state = state &* 6_364_136_223_846_793_005 &+ 1_442_695_040_888_963_407
+                return UInt8(truncatingIfNeeded: state >> 56)
+            })
+        }
+        // Each group token is shared by five samples; the marker by the last 70, so the first
+        // epochs do not see it and it is picked in the middle of the selection
+        let marker = Data("most samples carry this marker..".utf8)
+        let groups = (0 ..< 20).map { _ in randomBytes(32) }
+        let samples = (0 ..< 100).map { index in
+            groups[index % 20] + randomBytes(40) + (index >= 30 ? marker : randomBytes(32)) + randomBytes(40)
+        }
+
+        let dictionary = DictionaryTrainer(maxSize: 256, segmentLength: 32).train(samples)
+        XCTAssertEqual(dictionary.count, 256)
+        XCTAssertEqual(dictionary.suffix(32), marker)
+    }
+
+    func testTrainerFallsBackWithoutSharedContent() {
+        let sample = Data((0 ..< 5000).map { UInt8(truncatingIfNeeded: $0 &* 31) })
+        let dictionary = DictionaryTrainer(maxSize: 2048).train([sample])
+        XCTAssertEqual(dictionary, sample.suffix(2048))
+    }
+
+    func testTrainerWithNoSamples() {
+        XCTAssertTrue(ZLib.trainDictionary(from: []).isEmpty)
+    }
+
+    func testPreparedMatchesSetDictionary() throws {
+        let dictionary = ZLib.trainDictionary(from: (0 ..< 200).map(makeMessage))
+        let message = makeMessage(4242)
+
+        let compressor = Compressor()
+        try compressor.initializeAdvanced(level: .defaultCompression)
+        try compressor.setDictionary(dictionary)
+        let expected = try compressor.compress(message, flush: .finish)
+
+        let prepared = try PreparedDictionary(dictionary)
+        XCTAssertEqual(try prepared.compress(message), expected)
+        XCTAssertEqual(prepared.dictionaryID, UInt32(ZLib.adler32(dictionary)))
+    }
+
+    func testPreparedRoundTrip() throws {
+        let prepared = try PreparedDictionary(ZLib.trainDictionary(from: (0 ..< 200).map(makeMessage)))
+        for index in [0, 7, 99, 12345] {
+            let message = makeMessage(index)
+            let compressed = try prepared.compress(message)
+            XCTAssertEqual(try prepared.decompress(compressed), message)
+
+            let decompressor = Decompressor()
+            try decompressor.initialize()
+            XCTAssertEqual(try decompressor.decompress(compressed, dictionary: prepared.dictionary), message)
+        }
+        XCTAssertEqual(try prepared.decompress(prepared.compress(Data())), Data())
+    }
+
+    func testPreparedRawRoundTrip() throws {
+        let dictionary = ZLib.trainDictionary(from: (0 ..< 200).map(makeMessage))
+        let prepared = try PreparedDictionary(dictionary, level: .bestCompression, windowBits: .raw)
+        let message = makeMessage(77)
+        let compressed = try prepared.compress(message)
+        XCTAssertEqual(try prepared.decompress(compressed), message)
+        XCTAssertEqual(try ZLib.decompress(compressed, options: DecompressionOptions(format: .raw, dictionary: dictionary)), message)
+    }
+
+    func testPreparedCompressorStreaming() throws {
+        let prepared = try PreparedDictionary(ZLib.trainDictionary(from: (0 ..< 200).map(makeMessage)))
+        let messages = (500 ..< 520).map(makeMessage)
+
+        let compressor = try prepared.makeCompressor()
+        var compressed = Data()
+        for message in messages {
+            compressed.append(try compressor.compress(message))
+        }
+        compressed.append(try compressor.finish())
+
+        XCTAssertEqual(try prepared.decompress(compressed), messages.reduce(Data(), +))
+    }
+
+    func testPreparedDictionaryIsSharedAcrossThreads() throws {
+        let prepared = try PreparedDictionary(ZLib.trainDictionary(from: (0 ..< 200).map(makeMessage)))
+        let count = 64
+        var results = [Bool](repeating: false, count: count)
+        results.withUnsafeMutableBufferPointer { buffer in
+            let slots = buffer
+            DispatchQueue.concurrentPerform(iterations: count) { index in
+                let message = makeMessage(index * 13)
+                let restored = try? prepared.decompress(prepared.compress(message))
+                slots[index] = restored == message
+            }
+        }
+        XCTAssertTrue(results.allSatisfy { $0 })
+    }
+
+    func testWrongDictionaryIsRejected() throws {
+        let prepared = try PreparedDictionary(ZLib.trainDictionary(from: (0 ..< 200).map(makeMessage)))
+        let other = try PreparedDictionary(Data(String(repeating: "unrelated dictionary ", count: 20).utf8))
+        let compressed = try prepared.compress(makeMessage(1))
+        XCTAssertThrowsError(try other.decompress(compressed)) { error in
+            guard case .decompressionFailed? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+    }
+
+    func testGzipIsRejected() {
+        XCTAssertThrowsError(try PreparedDictionary(Data("dictionary".utf8), windowBits: .gzip))
+        XCTAssertThrowsError(try PreparedDictionary(Data()))
+    }
+
+    func testInitializeWithPreparedTwiceThrows() throws {
+        let prepared = try PreparedDictionary(Data("some dictionary content".utf8))
+        let compressor = Compressor()
+        try compressor.initialize(with: prepared)
+        XCTAssertThrowsError(try compressor.initialize(with: prepared))
+    }
+
+    // MARK: Private Functions
+
+    /// Small JSON event resembling an API payload
+    private func makeMessage(_ index: Int) -> Data {
+        let kinds = ["click", "view", "purchase", "signup", "logout"]
+        let json = """
+        {"id":\(index * 7919 % 100_000),"type":"\(kinds[index % kinds.count])","user":{"id":"u\(index % 977)",\
+        "plan":"\(index % 3 == 0 ? "premium" : "free")","locale":"en_US"},"timestamp":"2025-07-\(10 + index % 20)T12:\
+        \(10 + index % 50):00Z","client":{"app":"ios","version":"3.\(index % 9).1"},"success":true}
+        """
+        return Data(json.utf8)
+    }
+}
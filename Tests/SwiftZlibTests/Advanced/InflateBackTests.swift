@@ -20,6 +20,11 @@ final class InflateBackTests: XCTestCase {
         ("testEnhancedInflateBackWithChunks", testEnhancedInflateBackWithChunks),
         ("testEnhancedInflateBackStreamInfo", testEnhancedInflateBackStreamInfo),
         ("testEnhancedInflateBackProcessData", testEnhancedInflateBackProcessData),
+        ("testBorrowedBufferProcess", testBorrowedBufferProcess),
+        ("testBorrowedBufferStopsAtEndOfStream", testBorrowedBufferStopsAtEndOfStream),
+        ("testBorrowedBufferTruncatedInput", testBorrowedBufferTruncatedInput),
+        ("testBorrowedBufferHandlerError", testBorrowedBufferHandlerError),
+        ("testProcessDataOutputLimit", testProcessDataOutputLimit),
     ]
 
     // MARK: Functions
@@ -229,4 +234,94 @@ final class InflateBackTests: XCTestCase {
         let result = try enhancedInflateBack.processData(compressedData)
         XCTAssertEqual(result, originalData)
     }
+
+    // MARK: Borrowed Buffer Tests
+
+    func testBorrowedBufferProcess() throws {
+        let originalData = Data((0 ..< 300_000).map { UInt8(truncatingIfNeeded: $0 * 7 ^ ($0 >> 9)) })
+        let compressedData = try ZLib.compressRaw(originalData)
+
+        let decompressor = InflateBackDecompressorCBridged()
+        try decompressor.initialize()
+
+        var output = Data()
+        var blocks = 0
+        let consumed = try decompressor.process(compressedData) { block in
+            XCTAssertLessThanOrEqual(block.count, 32 * 1024)
+            output.append(contentsOf: block)
+            blocks += 1
+        }
+        XCTAssertEqual(output, originalData)
+        XCTAssertEqual(consumed, compressedData.count)
+        XCTAssertGreaterThan(blocks, 1)
+
+        // The stream can be reused for the next input without re-initialising
+        XCTAssertEqual(try decompressor.processData(compressedData), originalData)
+    }
+
+    func testBorrowedBufferStopsAtEndOfStream() throws {
+        let originalData = "Borrowed buffer with trailing bytes".data(using: .utf8)!
+        let compressedData = try ZLib.compressRaw(originalData)
+
+        for chunkSize in [1, 7, InflateBackDecompressorCBridged.defaultChunkSize] {
+            let decompressor = InflateBackDecompressorCBridged(chunkSize: chunkSize)
+            try decompressor.initialize()
+
+            var output = Data()
+            let consumed = try decompressor.process(compressedData + Data("TRAILER".utf8)) { output.append(contentsOf: $0) }
+            XCTAssertEqual(output, originalData)
+            XCTAssertEqual(consumed, compressedData.count, "chunk size \(chunkSize)")
+        }
+    }
+
+    func testBorrowedBufferTruncatedInput() throws {
+        let originalData = Data(repeating: 0x41, count: 10000) + Data((0 ..< 10000).map { UInt8(truncatingIfNeeded: $0 * 31) })
+        let compressedData = try ZLib.compressRaw(originalData)
+
+        let decompressor = InflateBackDecompressorCBridged()
+        try decompressor.initialize()
+
+        XCTAssertThrowsError(try decompressor.process(compressedData.prefix(compressedData.count / 2)) { _ in }) { error in
+            guard case let .decompressionFailed(code)? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+            XCTAssertEqual(code, -3, "Expected Z_DATA_ERROR for truncated input")
+        }
+    }
+
+    func testBorrowedBufferHandlerError() throws {
+        struct StopError: Error {}
+        let originalData = Data((0 ..< 200_000).map { UInt8(truncatingIfNeeded: $0 * 13 ^ ($0 >> 7)) })
+        let compressedData = try ZLib.compressRaw(originalData)
+
+        let decompressor = InflateBackDecompressorCBridged()
+        try decompressor.initialize()
+
+        var blocks = 0
+        XCTAssertThrowsError(try decompressor.process(compressedData) { _ in
+            blocks += 1
+            throw StopError()
+        }) { error in
+            XCTAssertTrue(error is StopError)
+        }
+        XCTAssertEqual(blocks, 1)
+    }
+
+    func testProcessDataOutputLimit() throws {
+        let originalData = Data((0 ..< 100_000).map { UInt8(truncatingIfNeeded: $0 * 11 ^ ($0 >> 8)) })
+        let compressedData = try ZLib.compressRaw(originalData)
+
+        let decompressor = InflateBackDecompressorCBridged()
+        try decompressor.initialize()
+
+        XCTAssertThrowsError(try decompressor.processData(compressedData, maxOutputSize: 50000)) { error in
+            guard case let .outputLimitExceeded(limit)? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+            XCTAssertEqual(limit, 50000)
+        }
+        // An exact limit is allowed, and the stream is reusable after an aborted call
+        XCTAssertEqual(try decompressor.processData(compressedData, maxOutputSize: originalData.count), originalData)
+        XCTAssertEqual(try decompressor.processData(compressedData), originalData)
+    }
 }
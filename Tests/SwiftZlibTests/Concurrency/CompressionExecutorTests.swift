@@ -0,0 +1,172 @@
+//
+//  CompressionExecutorTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class CompressionExecutorTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testManyClientsRoundTrip", testManyClientsRoundTrip),
+        ("testIdleWorkerStealsQueuedJobs", testIdleWorkerStealsQueuedJobs),
+        ("testCancelledJobIsDropped", testCancelledJobIsDropped),
+        ("testShutdownRejectsNewJobs", testShutdownRejectsNewJobs),
+        ("testDictionaryAndHeaderOptions", testDictionaryAndHeaderOptions),
+        ("testErrorsReachTheCaller", testErrorsReachTheCaller),
+        ("testMemoryBudgetLimitsThreads", testMemoryBudgetLimitsThreads),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testManyClientsRoundTrip() async throws {
+        let executor = CompressionExecutor(threadCount: 4)
+        let formats: [CompressionFormat] = [.zlib, .gzip, .raw]
+        try await withThrowingTaskGroup(of: Void.self) { group in
+            for client in 0 ..< 120 {
+                group.addTask {
+                    let original = self.makeText(count: 2000 + client * 37, seed: UInt64(client))
+                    let format = formats[client % formats.count]
+                    let level: CompressionLevel = client % 2 == 0 ? .bestSpeed : .defaultCompression
+                    let compressed = try await executor.compress(original, options: CompressionOptions(format: format, level: level))
+                    let decoded = try await executor.decompress(compressed, options: DecompressionOptions(format: format))
+                    XCTAssertEqual(decoded, original, "client \(client)")
+                }
+            }
+            try await group.waitForAll()
+        }
+        let statistics = executor.statistics
+        XCTAssertEqual(statistics.submitted, 240)
+        XCTAssertEqual(statistics.executed, 240)
+        XCTAssertEqual(statistics.cancelled, 0)
+    }
+
+    func testIdleWorkerStealsQueuedJobs() async throws {
+        let executor = CompressionExecutor(threadCount: 2)
+        let gate = DispatchSemaphore(value: 0)
+        // The first job lands on worker 0 and holds it
+        let blocker = Task { try await executor.perform { gate.wait() } }
+        try await waitUntil { executor.statistics.executed == 1 }
+
+        // Half of these are queued behind the blocker; worker 1 has to steal them
+        let original = makeText(count: 10000, seed: 1)
+        for _ in 0 ..< 20 {
+            let compressed = try await executor.compress(original)
+            XCTAssertEqual(try ZLib.decompress(compressed), original)
+        }
+        gate.signal()
+        try await blocker.value
+        XCTAssertGreaterThan(executor.statistics.stolen, 0)
+    }
+
+    func testCancelledJobIsDropped() async throws {
+        let executor = CompressionExecutor(threadCount: 1)
+        let gate = DispatchSemaphore(value: 0)
+        let blocker = Task { try await executor.perform { gate.wait() } }
+        try await waitUntil { executor.statistics.executed == 1 }
+
+        let queued = Task { try await executor.compress(self.makeText(count: 1000, seed: 2)) }
+        try await waitUntil { executor.statistics.submitted == 2 }
+        queued.cancel()
+        do {
+            _ = try await queued.value
+            XCTFail("Expected CancellationError")
+        } catch {
+            XCTAssertTrue(error is CancellationError, "got \(error)")
+        }
+
+        gate.signal()
+        try await blocker.value
+        try await waitUntil { executor.statistics.cancelled == 1 }
+        XCTAssertEqual(executor.statistics.executed, 1)
+    }
+
+    func testShutdownRejectsNewJobs() async throws {
+        let executor = CompressionExecutor(threadCount: 2)
+        let original = makeText(count: 5000, seed: 3)
+        let compressed = try await executor.compress(original)
+        XCTAssertEqual(try ZLib.decompress(compressed), original)
+
+        executor.shutdown()
+        do {
+            _ = try await executor.compress(original)
+            XCTFail("Expected CancellationError")
+        } catch {
+            XCTAssertTrue(error is CancellationError, "got \(error)")
+        }
+    }
+
+    func testDictionaryAndHeaderOptions() async throws {
+        let executor = CompressionExecutor(threadCount: 2)
+        let dictionary = makeText(count: 4096, seed: 4)
+        let original = makeText(count: 3000, seed: 4)
+
+        let compressed = try await executor.compress(original, options: CompressionOptions(format: .raw, dictionary: dictionary))
+        let decoded = try await executor.decompress(compressed, options: DecompressionOptions(format: .raw, dictionary: dictionary))
+        XCTAssertEqual(decoded, original)
+
+        var header = GzipHeader()
+        header.name = "payload.txt"
+        let gzip = try await executor.compress(original, options: CompressionOptions(format: .gzip, gzipHeader: header))
+        let gunzipped = try await executor.decompress(gzip)
+        XCTAssertEqual(gunzipped, original)
+    }
+
+    func testErrorsReachTheCaller() async throws {
+        let executor = CompressionExecutor(threadCount: 1)
+        do {
+            _ = try await executor.decompress(Data("not compressed at all".utf8), options: DecompressionOptions(format: .zlib))
+            XCTFail("Expected an error")
+        } catch {
+            XCTAssertTrue(error is ZLibError, "got \(error)")
+        }
+
+        // The worker's stream is still usable afterwards
+        let original = makeText(count: 5000, seed: 5)
+        let compressed = try await executor.compress(original)
+        let decoded = try await executor.decompress(compressed, options: DecompressionOptions(format: .zlib))
+        XCTAssertEqual(decoded, original)
+    }
+
+    func testMemoryBudgetLimitsThreads() {
+        XCTAssertEqual(CompressionExecutor(dataSize: 1_000_000, availableMemory: 1).threadCount, 1)
+        let roomy = CompressionExecutor(dataSize: 1_000_000, availableMemory: 1 << 40)
+        XCTAssertEqual(roomy.threadCount, ProcessInfo.processInfo.activeProcessorCount)
+    }
+
+    // MARK: Private Functions
+
+    private func waitUntil(_ condition: () -> Bool) async throws {
+        let deadline = Date().addingTimeInterval(10)
+        while !condition() {
+            guard Date() < deadline else {
+                return XCTFail("Timed out waiting for the executor")
+            }
+            try await Task.sleep(nanoseconds: 1_000_000)
+        }
+    }
+
+    private func makeText(count: Int, seed: UInt64) -> Data {
+        let words = ["alpha", "beta", "gamma", "delta", "request", "GET", "/index.html", "200", "user", "session"]
+        var state = seed &+ 1
+        var bytes = [UInt8]()
+        bytes.reserveCapacity(count + 16)
+        while bytes.count < count {
+            state = state &* 6_364_136_223_846_793_005 &+ 1_442_695_040_888_963_407
+            bytes.append(contentsOf: words[Int(state >> 33) % words.count].utf8)
+            bytes.append(0x20)
+        }
+        return Data(bytes.prefix(count))
+    }
+}
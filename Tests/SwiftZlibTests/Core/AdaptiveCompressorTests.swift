@@ -0,0 +1,175 @@
+//
+//  AdaptiveCompressorTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class AdaptiveCompressorTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testRoundTripBothTargetsAndFormats", testRoundTripBothTargetsAndFormats),
+        ("testUnreachableThroughputFallsToFastestStep", testUnreachableThroughputFallsToFastestStep),
+        ("testLooseThroughputClimbsToStrongestLevel", testLooseThroughputClimbsToStrongestLevel),
+        ("testRatioTargets", testRatioTargets),
+        ("testIncompressibleBlocksAreStored", testIncompressibleBlocksAreStored),
+        ("testStreamingInOddPieces", testStreamingInOddPieces),
+        ("testByteEntropyEstimates", testByteEntropyEstimates),
+        ("testSetParametersNeedsBlockFlush", testSetParametersNeedsBlockFlush),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testRoundTripBothTargetsAndFormats() throws {
+        let original = makeMixedData(blocks: 12)
+        for target in [AdaptiveCompressor.Target.throughput(50), .ratio(0.3)] {
+            for (windowBits, format) in [(WindowBits.deflate, CompressionFormat.zlib), (.gzip, .gzip), (.raw, .raw)] {
+                let compressor = try AdaptiveCompressor(target: target, windowBits: windowBits, blockSize: 64 * 1024)
+                let compressed = try compressor.compressAll(original)
+                let decompressed = try ZLib.decompress(compressed, options: DecompressionOptions(format: format))
+                XCTAssertEqual(decompressed, original, "\(target) \(windowBits)")
+                XCTAssertEqual(compressor.metrics.bytesIn, original.count)
+            }
+        }
+    }
+
+    func testUnreachableThroughputFallsToFastestStep() throws {
+        let compressor = try AdaptiveCompressor(target: .throughput(1_000_000), blockSize: 32 * 1024)
+        let compressed = try compressor.compressAll(makeText(count: 1_000_000))
+        XCTAssertEqual(compressor.currentLevel, 1)
+        XCTAssertEqual(compressor.currentStrategy, .quick)
+        XCTAssertEqual(try ZLib.decompress(compressed), makeText(count: 1_000_000))
+    }
+
+    func testLooseThroughputClimbsToStrongestLevel() throws {
+        let compressor = try AdaptiveCompressor(target: .throughput(0.001), blockSize: 32 * 1024)
+        var levels: [Int] = []
+        compressor.blockHandler = { levels.append($0.level) }
+        _ = try compressor.compressAll(makeText(count: 1_000_000))
+        XCTAssertEqual(compressor.currentLevel, 9)
+        XCTAssertEqual(levels.first, 6)
+        XCTAssertEqual(levels, levels.sorted())
+    }
+
+    func testRatioTargets() throws {
+        let text = makeText(count: 1_000_000)
+
+        let loose = try AdaptiveCompressor(target: .ratio(0.99), blockSize: 32 * 1024)
+        _ = try loose.compressAll(text)
+        XCTAssertEqual(loose.currentLevel, 1)
+        XCTAssertEqual(loose.currentStrategy, .quick)
+
+        let strict = try AdaptiveCompressor(target: .ratio(0.0001), blockSize: 32 * 1024)
+        let compressed = try strict.compressAll(text)
+        XCTAssertEqual(strict.currentLevel, 9)
+        XCTAssertLessThan(compressed.count, text.count / 2)
+        XCTAssertEqual(try ZLib.decompress(compressed), text)
+    }
+
+    func testIncompressibleBlocksAreStored() throws {
+        let original = makeMixedData(blocks: 9)
+        var reports: [AdaptiveCompressor.BlockReport] = []
+        let compressor = try AdaptiveCompressor(target: .throughput(10), blockSize: 64 * 1024)
+        compressor.blockHandler = { reports.append($0) }
+        let compressed = try compressor.compressAll(original)
+        XCTAssertEqual(try ZLib.decompress(compressed), original)
+
+        // Every third block is random; the final call only flushes the trailer
+        let stored = reports.dropLast().map(\.isStored)
+        XCTAssertEqual(stored, (0 ..< 9).map { $0 % 3 == 1 })
+        for report in reports where report.isStored {
+            XCTAssertEqual(report.level, 0)
+            XCTAssertGreaterThanOrEqual(report.ratio, 0.99)
+        }
+
+        let deflating = try AdaptiveCompressor(target: .throughput(10), blockSize: 64 * 1024, skipsIncompressible: false)
+        var anyStored = false
+        deflating.blockHandler = { anyStored = anyStored || $0.isStored }
+        XCTAssertEqual(try ZLib.decompress(deflating.compressAll(original)), original)
+        XCTAssertFalse(anyStored)
+    }
+
+    func testStreamingInOddPieces() throws {
+        let original = makeMixedData(blocks: 6)
+        let compressor = try AdaptiveCompressor(target: .ratio(0.4), windowBits: .gzip, blockSize: 20000)
+        var compressed = Data()
+        var offset = 0
+        while offset < original.count {
+            let end = min(offset + 12345, original.count)
+            compressed.append(try compressor.compress(original.subdata(in: offset ..< end)))
+            offset = end
+        }
+        compressed.append(try compressor.finish())
+        XCTAssertEqual(try ZLib.decompress(compressed, options: DecompressionOptions(format: .gzip)), original)
+        XCTAssertEqual(compressor.lastBlock?.bytesIn, original.count % 20000)
+    }
+
+    func testByteEntropyEstimates() {
+        XCTAssertEqual(ByteEntropy.isLikelyIncompressible(Data()), false)
+        XCTAssertEqual(ByteEntropy.isLikelyIncompressible(Data(repeating: 0, count: 100_000)), false)
+        XCTAssertFalse(ByteEntropy.isLikelyIncompressible(makeText(count: 100_000)))
+        XCTAssertTrue(ByteEntropy.isLikelyIncompressible(makeRandom(count: 100_000)))
+        XCTAssertTrue(ByteEntropy.isLikelyIncompressible(makeRandom(count: 3000)))
+        XCTAssertTrue(ByteEntropy.isLikelyIncompressible(try ZLib.compress(makeText(count: 500_000), level: .bestCompression)))
+        makeText(count: 100_000).withUnsafeBytes { XCTAssertLessThan(ByteEntropy.bitsPerByte($0), 6) }
+    }
+
+    func testSetParametersNeedsBlockFlush() throws {
+        let compressor = Compressor()
+        try compressor.initialize(level: .defaultCompression)
+        var compressed = try compressor.compress(makeText(count: 10000))
+
+        // Input is still buffered, and level 1 uses another match finder
+        XCTAssertThrowsError(try compressor.setParameters(level: .bestSpeed, strategy: .defaultStrategy)) { error in
+            guard case let .compressionFailed(code)? = error as? ZLibError else {
+                return XCTFail("Expected compressionFailed, got \(error)")
+            }
+            XCTAssertEqual(code, ZLibErrorCode.bufferError.rawValue)
+        }
+
+        compressed.append(try compressor.compress(Data(), flush: .block))
+        try compressor.setParameters(level: .bestSpeed, strategy: .defaultStrategy)
+        compressed.append(try compressor.compress(makeText(count: 10000), flush: .finish))
+        XCTAssertEqual(try ZLib.decompress(compressed), makeText(count: 10000) + makeText(count: 10000))
+    }
+
+    // MARK: Private Functions
+
+    /// 64 KB blocks of text with every third block random
+    private func makeMixedData(blocks: Int) -> Data {
+        var data = Data()
+        for index in 0 ..< blocks {
+            data.append(index % 3 == 1 ? makeRandom(count: 64 * 1024) : makeText(count: 64 * 1024))
+        }
+        return data
+    }
+
+    private func makeText(count: Int) -> Data {
+        let words = ["alpha", "beta", "gamma", "delta", "request", "GET", "/index.html", "200", "user", "session"]
+        var state: UInt64 = 42
+        var bytes = [UInt8]()
+        bytes.reserveCapacity(count + 16)
+        while bytes.count < count {
+            state = state &* 6_364_136_223_846_793_005 &+ 1_442_695_040_888_963_407
+            bytes.append(contentsOf: words[Int(state >> 33) % words.count].utf8)
+            bytes.append(0x20)
+        }
+        return Data(bytes.prefix(count))
+    }
+
+    private func makeRandom(count: Int) -> Data {
+        var generator = SystemRandomNumberGenerator()
+        return Data((0 ..< count).map { _ in UInt8.random(in: 0 ... 255, using: &generator) })
+    }
+}
@@ -0,0 +1,149 @@
+//
+//  BatchAPITests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class BatchAPITests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testBatchRoundTrip", testBatchRoundTrip),
+        ("testBatchRecordsAreIndependentStreams", testBatchRecordsAreIndependentStreams),
+        ("testDecompressBatchOfSeparateItems", testDecompressBatchOfSeparateItems),
+        ("testBatchIsDeterministicAcrossWorkerCounts", testBatchIsDeterministicAcrossWorkerCounts),
+        ("testBatchWithDictionary", testBatchWithDictionary),
+        ("testBatchRawAndGzipFormats", testBatchRawAndGzipFormats),
+        ("testEmptyBatch", testEmptyBatch),
+        ("testBatchWithEmptyRecords", testBatchWithEmptyRecords),
+        ("testCorruptRecordThrows", testCorruptRecordThrows),
+        ("testDataBatchPacking", testDataBatchPacking),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testBatchRoundTrip() throws {
+        let records = makeRecords(count: 5000)
+        let compressed = try ZLib.compressBatch(records, level: .bestSpeed)
+        XCTAssertEqual(compressed.count, records.count)
+        XCTAssertEqual(compressed.offsets.count, records.count + 1)
+        XCTAssertEqual(compressed.offsets.last, compressed.storage.count)
+
+        let decompressed = try ZLib.decompressBatch(compressed)
+        XCTAssertEqual(decompressed.count, records.count)
+        for (index, record) in records.enumerated() {
+            XCTAssertEqual(decompressed[index], record, "record \(index)")
+        }
+    }
+
+    func testBatchRecordsAreIndependentStreams() throws {
+        let records = makeRecords(count: 300)
+        let compressed = try ZLib.compressBatch(records)
+        for index in stride(from: 0, to: records.count, by: 37) {
+            XCTAssertEqual(try ZLib.decompress(Data(compressed[index])), records[index])
+        }
+    }
+
+    func testDecompressBatchOfSeparateItems() throws {
+        let records = makeRecords(count: 500)
+        let items = try records.map { try ZLib.compress($0) }
+        let decompressed = try ZLib.decompressBatch(items, options: DecompressionOptions(format: .zlib))
+        XCTAssertEqual(Array(decompressed), records)
+    }
+
+    func testBatchIsDeterministicAcrossWorkerCounts() throws {
+        let records = makeRecords(count: 2000)
+        let single = try ZLib.compressBatch(records, maxConcurrency: 1)
+        let parallel = try ZLib.compressBatch(records, maxConcurrency: 8)
+        XCTAssertEqual(single.storage, parallel.storage)
+        XCTAssertEqual(single.offsets, parallel.offsets)
+    }
+
+    func testBatchWithDictionary() throws {
+        let dictionary = Data(#"{"id": , "user": "user_", "active": true, "tags": ["prod", "staging"]}"#.utf8)
+        let records = (0 ..< 400).map { Data(#"{"id": \#($0), "user": "user_\#($0 * 7)", "active": true, "tags": ["prod"]}"#.utf8) }
+
+        let plain = try ZLib.compressBatch(records)
+        let primed = try ZLib.compressBatch(records, options: CompressionOptions(dictionary: dictionary))
+        XCTAssertLessThan(primed.storage.count, plain.storage.count)
+
+        let decompressed = try ZLib.decompressBatch(primed, options: DecompressionOptions(format: .zlib, dictionary: dictionary))
+        XCTAssertEqual(Array(decompressed), records)
+
+        XCTAssertThrowsError(try ZLib.decompressBatch(primed)) { error in
+            guard case .decompressionFailed? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+    }
+
+    func testBatchRawAndGzipFormats() throws {
+        let records = makeRecords(count: 200)
+        for format in [CompressionFormat.raw, .gzip] {
+            let compressed = try ZLib.compressBatch(records, options: CompressionOptions(format: format))
+            let decompressed = try ZLib.decompressBatch(compressed, options: DecompressionOptions(format: format))
+            XCTAssertEqual(Array(decompressed), records, "format \(format)")
+        }
+    }
+
+    func testEmptyBatch() throws {
+        let compressed = try ZLib.compressBatch([Data]())
+        XCTAssertTrue(compressed.isEmpty)
+        XCTAssertEqual(compressed.offsets, [0])
+        XCTAssertTrue(try ZLib.decompressBatch(compressed).isEmpty)
+    }
+
+    func testBatchWithEmptyRecords() throws {
+        let records = [Data(), Data("x".utf8), Data(), Data(repeating: 7, count: 4096)]
+        let compressed = try ZLib.compressBatch(records)
+        XCTAssertTrue(compressed.allSatisfy { !$0.isEmpty }, "Empty records still produce a stream")
+        XCTAssertEqual(Array(try ZLib.decompressBatch(compressed)), records)
+    }
+
+    func testCorruptRecordThrows() throws {
+        var items = try makeRecords(count: 300).map { try ZLib.compress($0) }
+        items[150] = items[150].prefix(items[150].count / 2)
+        XCTAssertThrowsError(try ZLib.decompressBatch(items)) { error in
+            guard case .decompressionFailed? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+    }
+
+    func testDataBatchPacking() {
+        let records = [Data("alpha".utf8), Data(), Data("gamma".utf8)]
+        let batch = DataBatch(records)
+        XCTAssertEqual(batch.count, 3)
+        XCTAssertEqual(batch.offsets, [0, 5, 5, 10])
+        XCTAssertEqual(batch.range(at: 2), 5 ..< 10)
+        XCTAssertEqual(Array(batch), records)
+        batch.withUnsafeBytes(at: 2) { bytes in
+            XCTAssertEqual(Array(bytes), Array("gamma".utf8))
+        }
+    }
+
+    // MARK: Private Functions
+
+    /// JSON-like records between 200 bytes and 4 KB
+    private func makeRecords(count: Int) -> [Data] {
+        (0 ..< count).map { index in
+            let length = 200 + (index * 7919) % 3900
+            var text = ""
+            while text.utf8.count < length {
+                text += #"{"id": \#(index), "event": "page_view", "path": "/item/\#(index % 97)", "ms": \#(index % 1000)}, "#
+            }
+            return Data(text.utf8.prefix(length))
+        }
+    }
+}
@@ -0,0 +1,165 @@
+//
+//  BufferAPITests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class BufferAPITests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testCompressIntoBufferRoundTrip", testCompressIntoBufferRoundTrip),
+        ("testCompressIntoBufferMatchesOneShot", testCompressIntoBufferMatchesOneShot),
+        ("testCompressIntoGzipBuffer", testCompressIntoGzipBuffer),
+        ("testCompressIntoTooSmallBuffer", testCompressIntoTooSmallBuffer),
+        ("testDecompressIntoTooSmallBuffer", testDecompressIntoTooSmallBuffer),
+        ("testDecompressIntoReportsConsumedInput", testDecompressIntoReportsConsumedInput),
+        ("testDecompressIntoTruncatedInput", testDecompressIntoTruncatedInput),
+        ("testGrowingDecompressHighRatio", testGrowingDecompressHighRatio),
+        ("testGrowingDecompressLargeInput", testGrowingDecompressLargeInput),
+        ("testGrowingDecompressInvalidData", testGrowingDecompressInvalidData),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testCompressIntoBufferRoundTrip() throws {
+        let input = makeTestData(count: 100_000)
+        var compressed = [UInt8](repeating: 0, count: ZLib.compressBound(input.count))
+        let written = try input.withUnsafeBytes { source in
+            try compressed.withUnsafeMutableBytes { destination in
+                try ZLib.compress(source, into: destination, level: .bestCompression)
+            }
+        }
+        XCTAssertGreaterThan(written, 0)
+        XCTAssertLessThan(written, input.count)
+
+        var output = [UInt8](repeating: 0, count: input.count)
+        let result = try compressed.withUnsafeBytes { source in
+            try output.withUnsafeMutableBytes { destination in
+                try ZLib.decompress(UnsafeRawBufferPointer(rebasing: source[0 ..< written]), into: destination)
+            }
+        }
+        XCTAssertEqual(result.inputConsumed, written)
+        XCTAssertEqual(result.outputWritten, input.count)
+        XCTAssertEqual(Data(output), input)
+    }
+
+    func testCompressIntoBufferMatchesOneShot() throws {
+        let input = makeTestData(count: 20000)
+        var compressed = [UInt8](repeating: 0, count: ZLib.compressBound(input.count))
+        let written = try input.withUnsafeBytes { source in
+            try compressed.withUnsafeMutableBytes { try ZLib.compress(source, into: $0) }
+        }
+        XCTAssertEqual(Data(compressed.prefix(written)), try ZLib.compress(input))
+    }
+
+    func testCompressIntoGzipBuffer() throws {
+        let input = makeTestData(count: 5000)
+        var compressed = [UInt8](repeating: 0, count: ZLib.compressBound(input.count))
+        let written = try input.withUnsafeBytes { source in
+            try compressed.withUnsafeMutableBytes { try ZLib.compress(source, into: $0, windowBits: .gzip) }
+        }
+        let gzip = Data(compressed.prefix(written))
+        XCTAssertEqual(gzip.prefix(2), Data([0x1F, 0x8B]))
+        XCTAssertEqual(try ZLib.decompress(gzip, options: DecompressionOptions(format: .gzip)), input)
+    }
+
+    func testCompressIntoTooSmallBuffer() throws {
+        let input = Data((0 ..< 4096).map { _ in UInt8.random(in: 0 ... 255) })
+        var compressed = [UInt8](repeating: 0, count: 100)
+        XCTAssertThrowsError(try input.withUnsafeBytes { source in
+            try compressed.withUnsafeMutableBytes { try ZLib.compress(source, into: $0) }
+        }) { error in
+            guard case .bufferError? = error as? ZLibError else {
+                return XCTFail("Expected bufferError, got \(error)")
+            }
+        }
+    }
+
+    func testDecompressIntoTooSmallBuffer() throws {
+        let input = makeTestData(count: 10000)
+        let compressed = try ZLib.compress(input)
+        var output = [UInt8](repeating: 0, count: input.count - 1)
+        XCTAssertThrowsError(try compressed.withUnsafeBytes { source in
+            try output.withUnsafeMutableBytes { try ZLib.decompress(source, into: $0) }
+        }) { error in
+            guard case .bufferError? = error as? ZLibError else {
+                return XCTFail("Expected bufferError, got \(error)")
+            }
+        }
+    }
+
+    func testDecompressIntoReportsConsumedInput() throws {
+        let input = makeTestData(count: 3000)
+        var framed = try ZLib.compress(input)
+        let streamLength = framed.count
+        framed.append(contentsOf: [0xDE, 0xAD, 0xBE, 0xEF])
+
+        var output = [UInt8](repeating: 0, count: input.count + 100)
+        let result = try framed.withUnsafeBytes { source in
+            try output.withUnsafeMutableBytes { try ZLib.decompress(source, into: $0) }
+        }
+        XCTAssertEqual(result.inputConsumed, streamLength)
+        XCTAssertEqual(result.outputWritten, input.count)
+    }
+
+    func testDecompressIntoTruncatedInput() throws {
+        let compressed = try ZLib.compress(makeTestData(count: 10000))
+        let truncated = compressed.prefix(compressed.count / 2)
+        var output = [UInt8](repeating: 0, count: 20000)
+        XCTAssertThrowsError(try truncated.withUnsafeBytes { source in
+            try output.withUnsafeMutableBytes { try ZLib.decompress(source, into: $0) }
+        })
+    }
+
+    func testGrowingDecompressHighRatio() throws {
+        // Far beyond the initial 4x guess, so the buffer must grow several times
+        let input = Data(repeating: 0x41, count: 5_000_000)
+        let compressed = try ZLib.compress(input, level: .bestCompression)
+        XCTAssertGreaterThan(input.count, compressed.count * 512)
+        XCTAssertEqual(try ZLib.decompress(compressed), input)
+
+        let viaPointer = try compressed.withUnsafeBytes { try ZLib.decompress($0, initialCapacity: 16) }
+        XCTAssertEqual(viaPointer, input)
+    }
+
+    func testGrowingDecompressLargeInput() throws {
+        let input = makeTestData(count: 3_000_000)
+        let compressed = try ZLib.compress(input)
+        XCTAssertGreaterThan(compressed.count, 1_000_000 / 10)
+        XCTAssertEqual(try ZLib.decompress(compressed), input)
+    }
+
+    func testGrowingDecompressInvalidData() throws {
+        XCTAssertThrowsError(try ZLib.decompress(Data([0x00, 0x01, 0x02, 0x03])))
+        XCTAssertThrowsError(try ZLib.decompress(Data())) { error in
+            guard case let .decompressionFailed(code)? = error as? ZLibError else {
+                return XCTFail("Expected decompressionFailed, got \(error)")
+            }
+            XCTAssertEqual(code, -3, "Expected Z_DATA_ERROR for empty input")
+        }
+    }
+
+    // MARK: Private Functions
+
+    private func makeTestData(count: Int) -> Data {
+        var data = Data(capacity: count)
+        var seed: UInt32 = 7
+        while data.count < count {
+            seed = seed &* 1_103_515_245 &+ 12345
+            data.append(contentsOf: "record-\(seed >> 20);".utf8)
+        }
+        return data.prefix(count)
+    }
+}
@@ -0,0 +1,153 @@
+//
+//  DecompressionLimitTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class DecompressionLimitTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testOutputLimitFromOptions", testOutputLimitFromOptions),
+        ("testMaxOutputSizeStopsBomb", testMaxOutputSizeStopsBomb),
+        ("testMaxExpansionRatioStopsBomb", testMaxExpansionRatioStopsBomb),
+        ("testLimitsAllowOrdinaryData", testLimitsAllowOrdinaryData),
+        ("testDecompressorLimitSpansChunks", testDecompressorLimitSpansChunks),
+        ("testDecompressorResetClearsCounters", testDecompressorResetClearsCounters),
+        ("testBatchLimitAppliesPerRecord", testBatchLimitAppliesPerRecord),
+        ("testHTTPDecoderBodyLimit", testHTTPDecoderBodyLimit),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testOutputLimitFromOptions() {
+        XCTAssertNil(DecompressionOptions().outputLimit(forInputSize: 1000))
+        XCTAssertEqual(DecompressionOptions(maxOutputSize: 500).outputLimit(forInputSize: 1000), 500)
+        XCTAssertEqual(DecompressionOptions(maxExpansionRatio: 2.5).outputLimit(forInputSize: 1000), 2500)
+        XCTAssertEqual(DecompressionOptions(maxOutputSize: 2000, maxExpansionRatio: 2.5).outputLimit(forInputSize: 1000), 2000)
+        XCTAssertEqual(DecompressionOptions(maxExpansionRatio: .infinity).outputLimit(forInputSize: 1000), Int.max)
+        XCTAssertEqual(DecompressionOptions(maxOutputSize: -1).outputLimit(forInputSize: 1000), 0)
+    }
+
+    func testMaxOutputSizeStopsBomb() throws {
+        let bomb = try ZLib.compress(Data(count: 8_000_000), level: .bestCompression)
+        let options = DecompressionOptions(format: .zlib, maxOutputSize: 1_000_000)
+
+        XCTAssertThrowsError(try ZLib.decompress(bomb, options: options)) { error in
+            guard case .outputLimitExceeded(limit: 1_000_000)? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+        // A limit equal to the real size is not exceeded
+        let exact = DecompressionOptions(format: .zlib, maxOutputSize: 8_000_000)
+        XCTAssertEqual(try ZLib.decompress(bomb, options: exact).count, 8_000_000)
+    }
+
+    func testMaxExpansionRatioStopsBomb() throws {
+        let bomb = try ZLib.compress(Data(count: 4_000_000), level: .bestCompression)
+        let options = DecompressionOptions(format: .zlib, maxExpansionRatio: 100)
+
+        XCTAssertThrowsError(try ZLib.decompress(bomb, options: options)) { error in
+            guard case let .outputLimitExceeded(limit)? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+            XCTAssertEqual(limit, bomb.count * 100)
+        }
+        // Deflate cannot exceed about 1032:1
+        let loose = DecompressionOptions(format: .zlib, maxExpansionRatio: Double(ZLib.maxDeflateExpansion))
+        XCTAssertEqual(try ZLib.decompress(bomb, options: loose).count, 4_000_000)
+    }
+
+    func testLimitsAllowOrdinaryData() throws {
+        let input = makeTestData(count: 200_000)
+        let gzip = try ZLib.compressGzip(input)
+        let options = DecompressionOptions(format: .gzip, maxOutputSize: 200_000, maxExpansionRatio: 1000)
+        XCTAssertEqual(try ZLib.decompress(gzip, options: options), input)
+    }
+
+    func testDecompressorLimitSpansChunks() throws {
+        let bomb = try ZLib.compress(Data(count: 2_000_000), level: .bestCompression)
+        let decompressor = Decompressor()
+        try decompressor.initializeAdvanced(windowBits: .deflate)
+        decompressor.maxOutputSize = 300_000
+
+        var produced = 0
+        var thrown: Error?
+        var offset = 0
+        while offset < bomb.count, thrown == nil {
+            let piece = bomb[offset ..< min(offset + 64, bomb.count)]
+            offset += piece.count
+            do {
+                produced += try decompressor.decompress(piece).count
+            } catch {
+                thrown = error
+            }
+        }
+        guard case .outputLimitExceeded(limit: 300_000)? = thrown as? ZLibError else {
+            return XCTFail("Unexpected result \(String(describing: thrown))")
+        }
+        XCTAssertLessThanOrEqual(produced, 300_000)
+        XCTAssertLessThan(offset, bomb.count, "Inflation should stop before the input runs out")
+        XCTAssertLessThanOrEqual(Int(try decompressor.getStreamInfo().totalOut), 300_001)
+    }
+
+    func testDecompressorResetClearsCounters() throws {
+        let compressed = try ZLib.compress(Data(count: 50000))
+        let decompressor = Decompressor()
+        try decompressor.initializeAdvanced(windowBits: .deflate)
+        decompressor.maxOutputSize = 60000
+
+        XCTAssertEqual(try decompressor.decompress(compressed).count, 50000)
+        // The limit counts output since the last reset, so a second stream fits again
+        try decompressor.reset()
+        XCTAssertEqual(try decompressor.decompress(compressed).count, 50000)
+    }
+
+    func testBatchLimitAppliesPerRecord() throws {
+        let small = try ZLib.compress(makeTestData(count: 1000))
+        let bomb = try ZLib.compress(Data(count: 500_000), level: .bestCompression)
+        let options = DecompressionOptions(format: .zlib, maxOutputSize: 10000)
+
+        let batch = try ZLib.decompressBatch([small, small], options: options)
+        XCTAssertEqual(batch.map(\.count), [1000, 1000])
+        XCTAssertThrowsError(try ZLib.decompressBatch([small, bomb, small], options: options)) { error in
+            guard case .outputLimitExceeded(limit: 10000)? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+    }
+
+    func testHTTPDecoderBodyLimit() throws {
+        let body = try HTTPBodyEncoder(encoding: .gzip).encodeBody(Data(count: 1_000_000))
+        let configuration = HTTPCodecConfiguration(maxDecodedBodySize: 64 * 1024)
+        let decoder = HTTPBodyDecoder(encoding: .gzip, configuration: configuration)
+
+        XCTAssertThrowsError(try decoder.decode(body)) { error in
+            guard case .outputLimitExceeded(limit: 65536)? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+        // The next body starts with fresh counters
+        decoder.abort()
+        let small = try HTTPBodyEncoder(encoding: .gzip).encodeBody(Data(count: 1000))
+        XCTAssertEqual(try decoder.decode(small).count, 1000)
+        try decoder.finish()
+    }
+
+    // MARK: Private Functions
+
+    private func makeTestData(count: Int) -> Data {
+        Data((0 ..< count).map { UInt8(truncatingIfNeeded: $0 &* 31 &+ ($0 >> 7)) })
+    }
+}
@@ -0,0 +1,156 @@
+//
+//  DeflateTuningTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class DeflateTuningTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testZlibTableValues", testZlibTableValues),
+        ("testInitClampsValues", testInitClampsValues),
+        ("testProfilesByName", testProfilesByName),
+        ("testProfilesRoundTrip", testProfilesRoundTrip),
+        ("testTuningSurvivesReset", testTuningSurvivesReset),
+        ("testTuningSurvivesIncompressibleBypass", testTuningSurvivesIncompressibleBypass),
+        ("testOptionsTuningInBatchAndStream", testOptionsTuningInBatchAndStream),
+        ("testAutoTunerMeetsTarget", testAutoTunerMeetsTarget),
+        ("testAutoTunerRejectsEmptySamples", testAutoTunerRejectsEmptySamples),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testZlibTableValues() {
+        XCTAssertEqual(DeflateTuning.zlib(level: 1), DeflateTuning(level: 1, goodLength: 4, maxLazy: 4, niceLength: 8, maxChain: 4))
+        XCTAssertEqual(DeflateTuning.zlib(level: 6), DeflateTuning(level: 6, goodLength: 8, maxLazy: 16, niceLength: 128, maxChain: 128))
+        XCTAssertEqual(DeflateTuning.zlib(level: 9), DeflateTuning(level: 9, goodLength: 32, maxLazy: 258, niceLength: 258, maxChain: 4096))
+        XCTAssertEqual(DeflateTuning.zlib(level: -1), DeflateTuning.zlib(level: 6))
+        XCTAssertFalse(DeflateTuning.zlib(level: 3).isLazy)
+        XCTAssertTrue(DeflateTuning.zlib(level: 4).isLazy)
+    }
+
+    func testInitClampsValues() {
+        let tuning = DeflateTuning(level: 12, goodLength: -3, maxLazy: 300, niceLength: 1000, maxChain: 0)
+        XCTAssertEqual(tuning.level, 9)
+        XCTAssertEqual(tuning.goodLength, 0)
+        XCTAssertEqual(tuning.maxLazy, 258)
+        XCTAssertEqual(tuning.niceLength, 258)
+        XCTAssertEqual(tuning.maxChain, 1)
+    }
+
+    func testProfilesByName() {
+        XCTAssertEqual(DeflateTuning.profile(named: "json"), .json)
+        XCTAssertEqual(DeflateTuning.profile(named: "logs"), .logs)
+        XCTAssertEqual(DeflateTuning.profile(named: "binary"), .binary)
+        XCTAssertEqual(DeflateTuning.profile(named: "text-maxratio"), .textMaxRatio)
+        XCTAssertNil(DeflateTuning.profile(named: "unknown"))
+    }
+
+    func testProfilesRoundTrip() throws {
+        let input = makeLogData(lines: 4000)
+        let level6 = try ZLib.compress(input, options: CompressionOptions(format: .gzip))
+        for (name, tuning) in DeflateTuning.profiles {
+            let compressed = try ZLib.compress(input, options: CompressionOptions(format: .gzip, tuning: tuning))
+            XCTAssertEqual(try ZLib.decompress(compressed, options: DecompressionOptions(format: .gzip)), input, name)
+            XCTAssertLessThan(compressed.count, level6.count * 11 / 10, name)
+        }
+    }
+
+    func testTuningSurvivesReset() throws {
+        let input = makeLogData(lines: 3000)
+        // A single-entry chain finds fewer matches than level 9's table, so it shows in the size
+        let weak = DeflateTuning(level: 9, goodLength: 4, maxLazy: 4, niceLength: 8, maxChain: 1)
+        let compressor = Compressor()
+        try compressor.initializeAdvanced(level: .bestCompression)
+        try compressor.tune(weak)
+
+        let first = try compressor.compress(input, flush: .finish)
+        try compressor.reset()
+        let second = try compressor.compress(input, flush: .finish)
+        XCTAssertEqual(first, second)
+        XCTAssertGreaterThan(first.count, try ZLib.compress(input, level: .bestCompression).count)
+        XCTAssertEqual(try ZLib.decompress(second), input)
+    }
+
+    func testTuningSurvivesIncompressibleBypass() throws {
+        var generator = SystemRandomNumberGenerator()
+        let noise = Data((0 ..< 64 * 1024).map { _ in UInt8.random(in: 0 ... 255, using: &generator) })
+        let text = makeLogData(lines: 2000)
+        let weak = DeflateTuning(level: 6, goodLength: 4, maxLazy: 4, niceLength: 8, maxChain: 1)
+
+        func compress(_ tuning: DeflateTuning?) throws -> Data {
+            let compressor = Compressor()
+            compressor.skipsIncompressible = true
+            try compressor.initializeAdvanced(level: .defaultCompression)
+            if let tuning {
+                try compressor.tune(tuning)
+            }
+            var output = try compressor.compress(noise, flush: .block)
+            output += try compressor.compress(text, flush: .finish)
+            return output
+        }
+
+        // The stored noise chunk must not drop the tuning for the text behind it
+        let tuned = try compress(weak)
+        XCTAssertGreaterThan(tuned.count, try compress(nil).count)
+        XCTAssertEqual(try ZLib.decompress(tuned), noise + text)
+    }
+
+    func testOptionsTuningInBatchAndStream() throws {
+        let records = (0 ..< 8).map { makeLogData(lines: 200 + $0) }
+        let options = CompressionOptions(tuning: .logs)
+
+        let batch = try ZLib.compressBatch(records, options: options)
+        XCTAssertEqual(batch.map { try? ZLib.decompress($0) }, records.map { Optional($0) })
+        for (record, compressed) in zip(records, batch) {
+            XCTAssertEqual(compressed, try ZLib.compress(record, options: options))
+        }
+    }
+
+    func testAutoTunerMeetsTarget() throws {
+        let samples = (0 ..< 4).map { makeLogData(lines: 1500 + $0 * 100) }
+        let tuner = DeflateAutoTuner(baselineLevel: 6, tolerance: 0.01, repetitions: 1, maxEvaluations: 20)
+        let result = try tuner.tune(samples)
+
+        XCTAssertEqual(result.baseline.tuning, .zlib(level: 6))
+        XCTAssertTrue(result.meetsTarget)
+        XCTAssertLessThanOrEqual(result.best.compressedSize, result.targetSize)
+        XCTAssertLessThanOrEqual(result.measurements.count, 20)
+        XCTAssertEqual(Set(result.measurements.map(\.tuning)).count, result.measurements.count)
+
+        let options = CompressionOptions(tuning: result.best.tuning)
+        for sample in samples {
+            XCTAssertEqual(try ZLib.decompress(ZLib.compress(sample, options: options)), sample)
+        }
+    }
+
+    func testAutoTunerRejectsEmptySamples() {
+        XCTAssertThrowsError(try DeflateAutoTuner().tune([Data()])) { error in
+            guard case .invalidData? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+    }
+
+    // MARK: Private Functions
+
+    private func makeLogData(lines: Int) -> Data {
+        let levels = ["INFO", "WARN", "DEBUG", "ERROR"]
+        let text = (0 ..< lines).map { index in
+            "2025-07-13T12:\(index % 60):\(index % 59) \(levels[index % 4]) worker-\(index % 7) request \(index * 7919 % 100_003) took \(index % 250)ms\n"
+        }.joined()
+        return Data(text.utf8)
+    }
+}
@@ -0,0 +1,182 @@
+//
+//  IncompressibleBypassTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class IncompressibleBypassTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testOneShotStoresRandomData", testOneShotStoresRandomData),
+        ("testOneShotStillDeflatesText", testOneShotStillDeflatesText),
+        ("testBypassIsOffByDefault", testBypassIsOffByDefault),
+        ("testRepeatedRandomBlockStillCompresses", testRepeatedRandomBlockStillCompresses),
+        ("testCompressorSwitchesPerChunk", testCompressorSwitchesPerChunk),
+        ("testCompressorBypassIsOptIn", testCompressorBypassIsOptIn),
+        ("testSmallChunksKeepCurrentMode", testSmallChunksKeepCurrentMode),
+        ("testFileCompressorsRoundTripMixedData", testFileCompressorsRoundTripMixedData),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testOneShotStoresRandomData() throws {
+        let original = makeRandom(count: 300_000)
+        let zlib = try ZLib.compress(original, options: CompressionOptions(level: .bestCompression, skipsIncompressible: true))
+        // Stored blocks add 5 bytes each, plus the header and trailer
+        XCTAssertLessThanOrEqual(zlib.count, original.count + original.count / 1000)
+        XCTAssertEqual(try ZLib.decompress(zlib), original)
+
+        let gzip = try ZLib.compress(original, options: CompressionOptions(format: .gzip, skipsIncompressible: true))
+        XCTAssertLessThanOrEqual(gzip.count, original.count + original.count / 1000)
+        XCTAssertEqual(try ZLib.decompress(gzip, options: DecompressionOptions(format: .gzip)), original)
+    }
+
+    func testOneShotStillDeflatesText() throws {
+        let original = makeText(count: 300_000)
+        let compressed = try ZLib.compress(original, options: CompressionOptions(skipsIncompressible: true))
+        XCTAssertLessThan(compressed.count, original.count / 2)
+        XCTAssertEqual(try ZLib.decompress(compressed), original)
+    }
+
+    func testBypassIsOffByDefault() {
+        XCTAssertFalse(CompressionOptions().skipsIncompressible)
+        XCTAssertFalse(FileChunkedCompressor().skipsIncompressible)
+        XCTAssertFalse(SimpleFileCompressor().skipsIncompressible)
+        XCTAssertTrue(CompressionOptions(skipsIncompressible: true).skipsIncompressible)
+    }
+
+    func testRepeatedRandomBlockStillCompresses() throws {
+        // Every byte value is about equally common, but the block repeats well inside the window
+        let original = Data(repeatElement(makeRandom(count: 4096), count: 64).joined())
+        XCTAssertTrue(ByteEntropy.isLikelyIncompressible(original))
+
+        let oneShot = try ZLib.compress(original)
+        XCTAssertLessThan(oneShot.count, original.count / 10)
+        XCTAssertEqual(try ZLib.decompress(oneShot), original)
+
+        XCTAssertLessThan(try ZLib.compress(original, options: CompressionOptions()).count, original.count / 10)
+        XCTAssertLessThan(try ZLib.compressGzip(original).count, original.count / 10)
+
+        var compressed = [UInt8](repeating: 0, count: ZLib.compressBound(original.count))
+        let written = try original.withUnsafeBytes { source in
+            try compressed.withUnsafeMutableBytes { try ZLib.compress(source, into: $0) }
+        }
+        XCTAssertLessThan(written, original.count / 10)
+        XCTAssertEqual(try ZLib.decompress(Data(compressed.prefix(written))), original)
+    }
+
+    func testCompressorSwitchesPerChunk() throws {
+        for windowBits in [WindowBits.deflate, .gzip, .raw] {
+            let compressor = Compressor()
+            compressor.skipsIncompressible = true
+            try compressor.initializeAdvanced(level: .bestCompression, windowBits: windowBits)
+
+            var original = Data()
+            var compressed = Data()
+            for index in 0 ..< 8 {
+                let isRandom = [1, 2, 4, 7].contains(index)
+                let chunk = isRandom ? makeRandom(count: 64 * 1024) : makeText(count: 64 * 1024)
+                original.append(chunk)
+                compressed.append(try compressor.compress(chunk, flush: index == 7 ? .finish : .noFlush))
+                XCTAssertEqual(compressor.isBypassing, isRandom, "chunk \(index)")
+            }
+
+            let format: CompressionFormat = windowBits == .gzip ? .gzip : (windowBits == .raw ? .raw : .zlib)
+            XCTAssertEqual(try ZLib.decompress(compressed, options: DecompressionOptions(format: format)), original)
+            XCTAssertLessThan(compressed.count, 4 * 64 * 1024 + 4 * 64 * 1024 / 2)
+        }
+    }
+
+    func testCompressorBypassIsOptIn() throws {
+        let compressor = Compressor()
+        XCTAssertFalse(compressor.skipsIncompressible)
+        try compressor.initialize(level: .defaultCompression)
+        let original = makeRandom(count: 64 * 1024)
+        let compressed = try compressor.compress(original, flush: .finish)
+        XCTAssertFalse(compressor.isBypassing)
+        XCTAssertEqual(try ZLib.decompress(compressed), original)
+    }
+
+    func testSmallChunksKeepCurrentMode() throws {
+        let compressor = Compressor()
+        compressor.skipsIncompressible = true
+        try compressor.initialize(level: .defaultCompression)
+
+        let random = makeRandom(count: 16 * 1024)
+        let text = makeText(count: 100)
+        var compressed = try compressor.compress(random)
+        XCTAssertTrue(compressor.isBypassing)
+        // Too short to judge, so the stream keeps storing
+        compressed.append(try compressor.compress(text))
+        XCTAssertTrue(compressor.isBypassing)
+
+        // setParameters takes over from the bypass
+        compressed.append(try compressor.compress(Data(), flush: .block))
+        try compressor.setParameters(level: .bestSpeed, strategy: .defaultStrategy)
+        XCTAssertFalse(compressor.isBypassing)
+        compressed.append(try compressor.compress(text, flush: .finish))
+        XCTAssertEqual(try ZLib.decompress(compressed), random + text + text)
+    }
+
+    func testFileCompressorsRoundTripMixedData() throws {
+        var original = Data()
+        for index in 0 ..< 10 {
+            original.append(index % 2 == 0 ? makeRandom(count: 64 * 1024) : makeText(count: 64 * 1024))
+        }
+        let tempDir = FileManager.default.temporaryDirectory
+        let source = tempDir.appendingPathComponent("bypass_source_\(UUID().uuidString).bin")
+        let chunked = tempDir.appendingPathComponent("bypass_chunked_\(UUID().uuidString).zlib")
+        let mapped = tempDir.appendingPathComponent("bypass_mapped_\(UUID().uuidString).zlib")
+        let simple = tempDir.appendingPathComponent("bypass_simple_\(UUID().uuidString).gz")
+        defer {
+            for url in [source, chunked, mapped, simple] {
+                try? FileManager.default.removeItem(at: url)
+            }
+        }
+        try original.write(to: source)
+
+        try FileChunkedCompressor(skipsIncompressible: true).compressFile(from: source.path, to: chunked.path)
+        XCTAssertEqual(try ZLib.decompress(Data(contentsOf: chunked)), original)
+
+        try FileChunkedCompressor(useMemoryMapping: true, skipsIncompressible: true).compressFile(from: source.path, to: mapped.path)
+        XCTAssertEqual(try ZLib.decompress(Data(contentsOf: mapped)), original)
+
+        try SimpleFileCompressor(skipsIncompressible: true).compressFile(from: source.path, to: simple.path)
+        let gzip = try Data(contentsOf: simple)
+        XCTAssertEqual(try ZLib.decompress(gzip, options: DecompressionOptions(format: .gzip)), original)
+        // Random halves stored, text halves deflated
+        XCTAssertLessThan(gzip.count, 5 * 64 * 1024 + 5 * 64 * 1024 / 2)
+    }
+
+    // MARK: Private Functions
+
+    private func makeText(count: Int) -> Data {
+        let words = ["alpha", "beta", "gamma", "delta", "request", "GET", "/index.html", "200", "user", "session"]
+        var state: UInt64 = 7
+        var bytes = [UInt8]()
+        bytes.reserveCapacity(count + 16)
+        while bytes.count < count {
+            state = state &* 6_364_136_223_846_793_005 &+ 1_442_695_040_888_963_407
+            bytes.append(contentsOf: words[Int(state >> 33) % words.count].utf8)
+            bytes.append(0x20)
+        }
+        return Data(bytes.prefix(count))
+    }
+
+    private func makeRandom(count: Int) -> Data {
+        var generator = SystemRandomNumberGenerator()
+        return Data((0 ..< count).map { _ in UInt8.random(in: 0 ... 255, using: &generator) })
+    }
+}
@@ -0,0 +1,172 @@
+//
+//  LazyInflatedDataTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class LazyInflatedDataTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testPrefixInflatesOnlyWhatIsRead", testPrefixInflatesOnlyWhatIsRead),
+        ("testRangesMatchFullDecompression", testRangesMatchFullDecompression),
+        ("testRewindResumesFromCheckpoint", testRewindResumesFromCheckpoint),
+        ("testCheckpointsAreThinned", testCheckpointsAreThinned),
+        ("testGzipIndexServesFarReads", testGzipIndexServesFarReads),
+        ("testGzipIndexOfPaddedBlob", testGzipIndexOfPaddedBlob),
+        ("testConcatenatedGzipMembers", testConcatenatedGzipMembers),
+        ("testCountAndBounds", testCountAndBounds),
+        ("testTruncatedBlobThrows", testTruncatedBlobThrows),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testPrefixInflatesOnlyWhatIsRead() throws {
+        let input = makeTestData(count: 8 * 1024 * 1024)
+        let view = try ZLib.lazyDecompress(ZLib.compress(input))
+
+        XCTAssertEqual(try view.prefix(1024), input.prefix(1024))
+        XCTAssertEqual(view.decodedBytes, 1024)
+        XCTAssertLessThan(view.compressedBytesRead, 16 * 1024)
+        XCTAssertNil(view.knownCount)
+
+        // The next read continues where the first stopped
+        XCTAssertEqual(try view[1024 ..< 4096], input[1024 ..< 4096])
+        XCTAssertEqual(view.decodedBytes, 4096)
+    }
+
+    func testRangesMatchFullDecompression() throws {
+        let input = makeTestData(count: 1_500_000)
+        let view = try LazyInflatedData(ZLib.compress(input), checkpointInterval: 128 * 1024)
+
+        let ranges = [500_000 ..< 500_100, 10 ..< 70000, 1_499_990 ..< 1_600_000, 700_000 ..< 900_000, 0 ..< 1, 250_000 ..< 250_000]
+        for range in ranges {
+            let expected = input[range.clamped(to: 0 ..< input.count)]
+            XCTAssertEqual(try view.bytes(in: range), expected, "\(range)")
+        }
+        XCTAssertEqual(try view[123_456], input[123_456])
+    }
+
+    func testRewindResumesFromCheckpoint() throws {
+        let input = makeTestData(count: 4 * 1024 * 1024)
+        let interval = 256 * 1024
+        let view = try LazyInflatedData(ZLib.compress(input), checkpointInterval: interval)
+
+        XCTAssertEqual(try view.uncompressedCount(), input.count)
+        XCTAssertEqual(view.knownCount, input.count)
+        XCTAssertGreaterThan(view.checkpointCount, 8)
+
+        let decoded = view.decodedBytes
+        XCTAssertEqual(try view[3_000_000 ..< 3_000_100], input[3_000_000 ..< 3_000_100])
+        XCTAssertLessThanOrEqual(view.decodedBytes - decoded, interval + LazyInflatedData.stepSize)
+    }
+
+    func testCheckpointsAreThinned() throws {
+        let input = makeTestData(count: 2 * 1024 * 1024)
+        let view = try LazyInflatedData(ZLib.compress(input), checkpointInterval: 64 * 1024, maxCheckpoints: 4)
+
+        XCTAssertEqual(try view.prefix(input.count), input)
+        XCTAssertLessThanOrEqual(view.checkpointCount, 4)
+        XCTAssertGreaterThan(view.checkpointInterval, 64 * 1024)
+        XCTAssertEqual(try view[100_000 ..< 100_010], input[100_000 ..< 100_010])
+    }
+
+    func testGzipIndexServesFarReads() throws {
+        let input = makeTestData(count: 4 * 1024 * 1024)
+        let gzip = try ZLib.compressGzip(input)
+        let span = 256 * 1024
+        let view = try LazyInflatedData(gzip, index: GzipIndex.build(for: gzip, span: span))
+
+        XCTAssertEqual(view.windowBits, .gzip)
+        XCTAssertEqual(view.knownCount, input.count)
+        XCTAssertEqual(try view[3_500_000 ..< 3_501_000], input[3_500_000 ..< 3_501_000])
+        // Access points sit at the first block boundary past each span
+        XCTAssertLessThanOrEqual(view.decodedBytes, 2 * span)
+        // Back to the start, then to the end again through the index
+        XCTAssertEqual(try view.prefix(100), input.prefix(100))
+        XCTAssertEqual(try view[input.count - 10 ..< input.count + 10], input.suffix(10))
+
+        XCTAssertThrowsError(try LazyInflatedData(gzip.prefix(1000), index: GzipIndex.build(for: gzip, span: span))) { error in
+            guard case .invalidData? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+    }
+
+    func testGzipIndexOfPaddedBlob() throws {
+        let input = makeTestData(count: 1024 * 1024)
+        let gzip = try ZLib.compressGzip(input)
+        // More padding than the index build reads at a time
+        let padded = gzip + Data(count: 200_000)
+        let index = try GzipIndex.build(for: padded, span: 256 * 1024)
+        let view = try LazyInflatedData(padded, index: index)
+
+        XCTAssertEqual(view.knownCount, input.count)
+        XCTAssertEqual(try view[900_000 ..< 901_000], input[900_000 ..< 901_000])
+        XCTAssertEqual(try view[input.count - 10 ..< input.count + 10], input.suffix(10))
+        // The index describes the padded blob, not the bare stream
+        XCTAssertThrowsError(try LazyInflatedData(gzip, index: index))
+    }
+
+    func testConcatenatedGzipMembers() throws {
+        let first = makeTestData(count: 300_000)
+        let second = Data("second member".utf8)
+        let view = try LazyInflatedData(ZLib.compressGzip(first) + ZLib.compressGzip(second), windowBits: .gzip)
+
+        XCTAssertEqual(try view[299_990 ..< 300_013], first.suffix(10) + second)
+        XCTAssertEqual(try view.uncompressedCount(), first.count + second.count)
+    }
+
+    func testCountAndBounds() throws {
+        let view = try LazyInflatedData(ZLib.compressRaw(Data("hello".utf8)), windowBits: .raw)
+
+        XCTAssertEqual(try view.bytes(in: 3 ..< 100), Data("lo".utf8))
+        XCTAssertEqual(try view.uncompressedCount(), 5)
+        XCTAssertEqual(try view.bytes(in: 5 ..< 10), Data())
+        XCTAssertThrowsError(try view[5]) { error in
+            guard case .invalidData? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+        XCTAssertThrowsError(try view[-1])
+    }
+
+    func testTruncatedBlobThrows() throws {
+        let compressed = try ZLib.compress(makeTestData(count: 200_000))
+        let view = try LazyInflatedData(compressed.prefix(compressed.count / 2))
+
+        XCTAssertEqual(try view.prefix(1000).count, 1000)
+        XCTAssertThrowsError(try view.uncompressedCount()) { error in
+            // Z_DATA_ERROR: the blob ends inside the stream
+            guard case .decompressionFailed(-3)? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+        // The view starts over after an error and still serves what the blob holds
+        XCTAssertEqual(try view.prefix(10).count, 10)
+    }
+
+    // MARK: Private Functions
+
+    /// Text-like bytes that compress about 3:1
+    private func makeTestData(count: Int) -> Data {
+        var state: UInt32 = 12345
+        var bytes = [UInt8](repeating: 0, count: count)
+        for index in 0 ..< count {
+            state = state &* 1_103_515_245 &+ 12345
+            bytes[index] = index % 97 < 60 ? UInt8(97 + index % 26) : UInt8(65 + (state >> 24) % 16)
+        }
+        return Data(bytes)
+    }
+}
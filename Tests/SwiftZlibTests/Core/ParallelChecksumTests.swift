@@ -0,0 +1,134 @@
+//
+//  ParallelChecksumTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class ParallelChecksumTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testMatchesSerialChecksums", testMatchesSerialChecksums),
+        ("testUnevenLastSlice", testUnevenLastSlice),
+        ("testInitialValueContinuesRunningChecksum", testInitialValueContinuesRunningChecksum),
+        ("testSmallAndEmptyInput", testSmallAndEmptyInput),
+        ("testChecksumFile", testChecksumFile),
+        ("testMissingFileThrows", testMissingFileThrows),
+        ("testCombineWithLargeLengths", testCombineWithLargeLengths),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testMatchesSerialChecksums() {
+        let data = makeData(count: 3_000_000)
+        for threads in [1, 2, 4, 7] {
+            let crc = ParallelChecksum(algorithm: .crc32, threadCount: threads, sliceSize: ParallelChecksum.minimumSliceSize)
+            let adler = ParallelChecksum(algorithm: .adler32, threadCount: threads, sliceSize: ParallelChecksum.minimumSliceSize)
+            XCTAssertEqual(crc.checksum(data), ZLib.crc32(data), "threads \(threads)")
+            XCTAssertEqual(adler.checksum(data), ZLib.adler32(data), "threads \(threads)")
+        }
+    }
+
+    func testUnevenLastSlice() {
+        let sliceSize = ParallelChecksum.minimumSliceSize
+        for count in [sliceSize + 1, sliceSize * 3 - 1, sliceSize * 5 + 12345] {
+            let data = makeData(count: count)
+            XCTAssertEqual(ParallelChecksum(algorithm: .crc32, threadCount: 3, sliceSize: sliceSize).checksum(data), ZLib.crc32(data))
+            XCTAssertEqual(ParallelChecksum(algorithm: .adler32, threadCount: 3, sliceSize: sliceSize).checksum(data), ZLib.adler32(data))
+        }
+    }
+
+    func testInitialValueContinuesRunningChecksum() {
+        let head = makeData(count: 1000)
+        let tail = makeData(count: 2_000_000)
+        let crc = ParallelChecksum(algorithm: .crc32, threadCount: 4)
+        let adler = ParallelChecksum(algorithm: .adler32, threadCount: 4)
+        XCTAssertEqual(crc.checksum(tail, initialValue: ZLib.crc32(head)), ZLib.crc32(head + tail))
+        XCTAssertEqual(adler.checksum(tail, initialValue: ZLib.adler32(head)), ZLib.adler32(head + tail))
+    }
+
+    func testSmallAndEmptyInput() {
+        let crc = ParallelChecksum(algorithm: .crc32)
+        let adler = ParallelChecksum(algorithm: .adler32)
+        XCTAssertEqual(crc.checksum(Data()), 0)
+        XCTAssertEqual(adler.checksum(Data()), 1)
+        XCTAssertEqual(ZLib.crc32(Data()), 0)
+        XCTAssertEqual(ZLib.adler32(Data()), 1)
+
+        let small = Data("hello world".utf8)
+        XCTAssertEqual(crc.checksum(small), ZLib.crc32(small))
+        XCTAssertEqual(adler.checksum(small), ZLib.adler32(small))
+    }
+
+    func testChecksumFile() throws {
+        let data = makeData(count: 2_500_000)
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("parallel_checksum_\(UUID().uuidString).bin")
+        try data.write(to: url)
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        XCTAssertEqual(try ParallelChecksum(algorithm: .crc32, threadCount: 4).checksumFile(at: url.path), ZLib.crc32(data))
+        XCTAssertEqual(try ParallelChecksum(algorithm: .adler32, threadCount: 4).checksumFile(at: url.path), ZLib.adler32(data))
+
+        let empty = url.appendingPathExtension("empty")
+        try Data().write(to: empty)
+        defer { try? FileManager.default.removeItem(at: empty) }
+        XCTAssertEqual(try ParallelChecksum().checksumFile(at: empty.path), 0)
+    }
+
+    func testMissingFileThrows() {
+        XCTAssertThrowsError(try ParallelChecksum().checksumFile(at: "/nonexistent/parallel_checksum.bin")) { error in
+            guard case .fileError? = error as? ZLibError else {
+                return XCTFail("Expected fileError, got \(error)")
+            }
+        }
+    }
+
+    func testCombineWithLargeLengths() {
+        // Appending 5 GB of zeros: combine with the CRC of the zeros over a 64-bit length must
+        // match folding the zeros in 1 GB steps
+        let gigabyte = 1 << 30
+        let zeros = Data(count: 1 << 20)
+        var zerosCRC = ZLib.crc32(zeros)
+        var zerosAdler = ZLib.adler32(zeros)
+        var length = zeros.count
+        while length < gigabyte {
+            zerosCRC = ZLib.crc32Combine(zerosCRC, zerosCRC, len2: length)
+            zerosAdler = ZLib.adler32Combine(zerosAdler, zerosAdler, len2: length)
+            length *= 2
+        }
+
+        let head = Data("header".utf8)
+        var stepCRC = ZLib.crc32(head)
+        var stepAdler = ZLib.adler32(head)
+        for _ in 0 ..< 5 {
+            stepCRC = ZLib.crc32Combine(stepCRC, zerosCRC, len2: gigabyte)
+            stepAdler = ZLib.adler32Combine(stepAdler, zerosAdler, len2: gigabyte)
+        }
+
+        var fiveCRC = zerosCRC
+        var fiveAdler = zerosAdler
+        for _ in 0 ..< 4 {
+            fiveCRC = ZLib.crc32Combine(fiveCRC, zerosCRC, len2: gigabyte)
+            fiveAdler = ZLib.adler32Combine(fiveAdler, zerosAdler, len2: gigabyte)
+        }
+        XCTAssertEqual(ZLib.crc32Combine(ZLib.crc32(head), fiveCRC, len2: 5 * gigabyte), stepCRC)
+        XCTAssertEqual(ZLib.adler32Combine(ZLib.adler32(head), fiveAdler, len2: 5 * gigabyte), stepAdler)
+    }
+
+    // MARK: Private Functions
+
+    private func makeData(count: Int) -> Data {
+        Data((0 ..< count).map { UInt8(truncatingIfNeeded: ($0 * 31) ^ ($0 >> 7)) })
+    }
+}
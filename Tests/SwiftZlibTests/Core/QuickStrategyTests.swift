@@ -0,0 +1,121 @@
+//
+//  QuickStrategyTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class QuickStrategyTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testRoundTripAllFormats", testRoundTripAllFormats),
+        ("testInitializeAdvanced", testInitializeAdvanced),
+        ("testStreamingInSmallPieces", testStreamingInSmallPieces),
+        ("testSwitchingStrategyMidStream", testSwitchingStrategyMidStream),
+        ("testIncompressibleInputStaysBounded", testIncompressibleInputStaysBounded),
+        ("testRepetitiveInputCompresses", testRepetitiveInputCompresses),
+        ("testEmptyInput", testEmptyInput),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testRoundTripAllFormats() throws {
+        let original = makeText(count: 300_000, seed: 1)
+        for format in [CompressionFormat.zlib, .gzip, .raw] {
+            let compressed = try ZLib.compress(original, options: CompressionOptions(format: format, strategy: .quick))
+            XCTAssertLessThan(compressed.count, original.count, "format \(format)")
+            let decompressed = try ZLib.decompress(compressed, options: DecompressionOptions(format: format))
+            XCTAssertEqual(decompressed, original, "format \(format)")
+        }
+    }
+
+    func testInitializeAdvanced() throws {
+        let original = makeText(count: 100_000, seed: 2)
+        for level in [CompressionLevel.bestSpeed, .defaultCompression, .bestCompression] {
+            let compressor = Compressor()
+            try compressor.initializeAdvanced(level: level, windowBits: .deflate, strategy: .quick)
+            let compressed = try compressor.compress(original, flush: .finish)
+            XCTAssertEqual(try ZLib.decompress(compressed), original, "level \(level)")
+        }
+    }
+
+    func testStreamingInSmallPieces() throws {
+        let original = makeText(count: 200_000, seed: 3)
+        let compressor = Compressor()
+        try compressor.initializeAdvanced(level: .bestSpeed, strategy: .quick)
+        var compressed = Data()
+        var offset = 0
+        while offset < original.count {
+            let end = min(offset + 1777, original.count)
+            compressed.append(try compressor.compress(original.subdata(in: offset ..< end), flush: offset % 3 == 0 ? .syncFlush : .noFlush))
+            offset = end
+        }
+        compressed.append(try compressor.finish())
+
+        let decompressor = Decompressor()
+        try decompressor.initialize()
+        XCTAssertEqual(try decompressor.decompress(compressed), original)
+    }
+
+    func testSwitchingStrategyMidStream() throws {
+        let parts = (0 ..< 4).map { makeText(count: 50000, seed: 10 + UInt64($0)) }
+        let compressor = Compressor()
+        try compressor.initializeAdvanced(level: .defaultCompression)
+        var compressed = Data()
+        for (index, part) in parts.enumerated() {
+            compressed.append(try compressor.compress(part, flush: .syncFlush))
+            try compressor.setParameters(level: .defaultCompression, strategy: index % 2 == 0 ? .quick : .defaultStrategy)
+        }
+        compressed.append(try compressor.finish())
+        XCTAssertEqual(try ZLib.decompress(compressed), parts.reduce(Data(), +))
+    }
+
+    func testIncompressibleInputStaysBounded() throws {
+        var generator = SystemRandomNumberGenerator()
+        let original = Data((0 ..< 200_000).map { _ in UInt8.random(in: 0 ... 255, using: &generator) })
+        let compressed = try ZLib.compress(original, options: CompressionOptions(strategy: .quick))
+        // Blocks that would expand are stored
+        XCTAssertLessThanOrEqual(compressed.count, ZLib.estimateCompressedSize(original.count, level: .noCompression))
+        XCTAssertEqual(try ZLib.decompress(compressed), original)
+    }
+
+    func testRepetitiveInputCompresses() throws {
+        let original = Data(repeating: 0x61, count: 1_000_000)
+        let compressed = try ZLib.compress(original, options: CompressionOptions(strategy: .quick))
+        XCTAssertLessThan(compressed.count, original.count / 100)
+        XCTAssertEqual(try ZLib.decompress(compressed), original)
+    }
+
+    func testEmptyInput() throws {
+        let compressed = try ZLib.compress(Data(), options: CompressionOptions(strategy: .quick))
+        XCTAssertEqual(try ZLib.decompress(compressed), Data())
+    }
+
+    // MARK: Private Functions
+
+    /// Word-based text with plenty of short repeats
+    private func makeText(count: Int, seed: UInt64) -> Data {
+        let words = ["alpha", "beta", "gamma", "delta", "error", "request", "GET", "/index.html", "200", "user", "session"]
+        var state = seed &* 6_364_136_223_846_793_005 &+ 1_442_695_040_888_963_407
+        var bytes = [UInt8]()
+        bytes.reserveCapacity(count + 16)
+        while bytes.count < count {
+            state = state &* 6_364_136_223_846_793_005 &+ 1_442_695_040_888_963_407
+            let value = Int(truncatingIfNeeded: state >> 33)
+            bytes.append(contentsOf: words[value % words.count].utf8)
+            bytes.append(value % 13 == 0 ? 0x0A : 0x20)
+        }
+        return Data(bytes.prefix(count))
+    }
+}
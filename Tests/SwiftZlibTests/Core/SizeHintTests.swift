@@ -0,0 +1,96 @@
+//
+//  SizeHintTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class SizeHintTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testGzipUncompressedSizeReadsTrailer", testGzipUncompressedSizeReadsTrailer),
+        ("testGzipUncompressedSizeRejectsNonGzip", testGzipUncompressedSizeRejectsNonGzip),
+        ("testOutputSizeHintPrefersExpectedSize", testOutputSizeHintPrefersExpectedSize),
+        ("testOutputSizeHintCapsForgedTrailer", testOutputSizeHintCapsForgedTrailer),
+        ("testDecompressAutoUsesGzipTrailer", testDecompressAutoUsesGzipTrailer),
+        ("testExpectedSizeTooSmallStillDecompresses", testExpectedSizeTooSmallStillDecompresses),
+        ("testDecompressorExpectedSize", testDecompressorExpectedSize),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testGzipUncompressedSizeReadsTrailer() throws {
+        let input = makeTestData(count: 123_457)
+        let gzip = try ZLib.compressGzip(input)
+        XCTAssertEqual(ZLib.gzipUncompressedSize(gzip), input.count)
+        XCTAssertEqual(ZLib.gzipUncompressedSize(try ZLib.compressGzip(Data())), 0)
+    }
+
+    func testGzipUncompressedSizeRejectsNonGzip() throws {
+        let zlib = try ZLib.compress(makeTestData(count: 1000))
+        XCTAssertNil(ZLib.gzipUncompressedSize(zlib))
+        XCTAssertNil(ZLib.gzipUncompressedSize(Data([0x1F, 0x8B, 0x08])))
+        XCTAssertNil(ZLib.outputSizeHint(for: zlib, format: .zlib, expectedSize: nil))
+    }
+
+    func testOutputSizeHintPrefersExpectedSize() throws {
+        let gzip = try ZLib.compressGzip(makeTestData(count: 5000))
+        XCTAssertEqual(ZLib.outputSizeHint(for: gzip, format: .gzip, expectedSize: 42), 42)
+        XCTAssertEqual(ZLib.outputSizeHint(for: gzip, format: .auto, expectedSize: nil), 5000)
+        // Raw deflate data has no trailer to trust
+        XCTAssertNil(ZLib.outputSizeHint(for: gzip, format: .raw, expectedSize: nil))
+    }
+
+    func testOutputSizeHintCapsForgedTrailer() throws {
+        var gzip = try ZLib.compressGzip(Data("tiny".utf8))
+        gzip.replaceSubrange(gzip.count - 4 ..< gzip.count, with: [0xFF, 0xFF, 0xFF, 0xFF])
+        let hint = try XCTUnwrap(ZLib.outputSizeHint(for: gzip, format: .gzip, expectedSize: nil))
+        XCTAssertLessThanOrEqual(hint, gzip.count * ZLib.maxDeflateExpansion)
+    }
+
+    func testDecompressAutoUsesGzipTrailer() throws {
+        let input = makeTestData(count: 2_000_000)
+        let gzip = try ZLib.compressGzip(input)
+        XCTAssertEqual(try ZLib.decompressAuto(gzip), input)
+        XCTAssertEqual(try ZLib.decompress(gzip, options: DecompressionOptions(format: .gzip)), input)
+    }
+
+    func testExpectedSizeTooSmallStillDecompresses() throws {
+        let input = makeTestData(count: 300_000)
+        let zlib = try ZLib.compress(input)
+        XCTAssertEqual(try ZLib.decompress(zlib, expectedSize: 10), input)
+        XCTAssertEqual(try ZLib.decompress(zlib, expectedSize: input.count), input)
+        XCTAssertEqual(try ZLib.decompressAuto(zlib, expectedSize: 100), input)
+    }
+
+    func testDecompressorExpectedSize() throws {
+        let input = makeTestData(count: 400_000)
+        let compressed = try ZLib.compress(input)
+        let decompressor = Decompressor()
+        try decompressor.initialize()
+        XCTAssertEqual(try decompressor.decompress(compressed, expectedSize: input.count), input)
+    }
+
+    // MARK: Private Functions
+
+    private func makeTestData(count: Int) -> Data {
+        var data = Data(capacity: count)
+        var seed: UInt32 = 99
+        while data.count < count {
+            seed = seed &* 1_103_515_245 &+ 12345
+            data.append(contentsOf: "size-hint \(seed % 977)\n".utf8)
+        }
+        return data.prefix(count)
+    }
+}
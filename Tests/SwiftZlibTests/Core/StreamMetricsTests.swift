@@ -0,0 +1,148 @@
+//
+//  StreamMetricsTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class StreamMetricsTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testCompressorCounters", testCompressorCounters),
+        ("testDecompressorCounters", testDecompressorCounters),
+        ("testStateMemoryFollowsParameters", testStateMemoryFollowsParameters),
+        ("testBufferErrorsAreCounted", testBufferErrorsAreCounted),
+        ("testResetMetrics", testResetMetrics),
+        ("testReportHandlerAndSignposts", testReportHandlerAndSignposts),
+        ("testAsyncStreamMetrics", testAsyncStreamMetrics),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    override func tearDown() {
+        ZLibMetrics.reportHandler = nil
+        ZLibMetrics.signpostsEnabled = false
+        super.tearDown()
+    }
+
+    // MARK: Functions
+
+    func testCompressorCounters() throws {
+        let original = makeData(count: 200_000)
+        let compressor = Compressor()
+        try compressor.initialize(level: .defaultCompression)
+        XCTAssertEqual(compressor.metrics.calls, 0)
+
+        let compressed = try compressor.compress(original, flush: .finish)
+        let metrics = compressor.metrics
+        XCTAssertEqual(metrics.bytesIn, original.count)
+        XCTAssertEqual(metrics.bytesOut, compressed.count)
+        XCTAssertGreaterThan(metrics.calls, 0)
+        XCTAssertGreaterThan(metrics.callNanoseconds, 0)
+        XCTAssertGreaterThan(metrics.bufferReallocations, 0)
+        // 64 KB each for the window, prev, head and pending buffer at the defaults, plus the state
+        XCTAssertGreaterThan(metrics.peakStateMemory, 256 * 1024)
+        XCTAssertEqual(metrics.ratio, Double(compressed.count) / Double(original.count), accuracy: 1e-9)
+    }
+
+    func testDecompressorCounters() throws {
+        let original = makeData(count: 150_000)
+        let compressed = try ZLib.compress(original)
+        let decompressor = Decompressor()
+        try decompressor.initialize()
+        let beforeWindow = decompressor.metrics.peakStateMemory
+        XCTAssertGreaterThan(beforeWindow, 0)
+
+        XCTAssertEqual(try decompressor.decompress(compressed), original)
+        let metrics = decompressor.metrics
+        XCTAssertEqual(metrics.bytesIn, compressed.count)
+        XCTAssertEqual(metrics.bytesOut, original.count)
+        XCTAssertGreaterThan(metrics.calls, 1)
+        // The 32 KB window is allocated once a call returns output before the end
+        XCTAssertEqual(metrics.peakStateMemory, beforeWindow + 32768)
+    }
+
+    func testStateMemoryFollowsParameters() throws {
+        let large = Compressor()
+        try large.initializeAdvanced(memoryLevel: .maximum)
+        let small = Compressor()
+        try small.initializeAdvanced(memoryLevel: .minimum)
+        XCTAssertLessThan(small.metrics.peakStateMemory, large.metrics.peakStateMemory)
+
+        let copy = Compressor()
+        try large.copy(to: copy)
+        XCTAssertEqual(copy.metrics.peakStateMemory, large.metrics.peakStateMemory)
+        XCTAssertEqual(copy.metrics.calls, 0)
+    }
+
+    func testBufferErrorsAreCounted() throws {
+        let compressor = Compressor()
+        try compressor.initialize()
+        _ = try compressor.compress(makeData(count: 1000), flush: .syncFlush)
+        let metrics = compressor.metrics
+        XCTAssertEqual(metrics.bufferErrorRetries, 0)
+
+        // Nothing new to flush, so deflate reports that no progress is possible
+        XCTAssertEqual(try compressor.compress(Data(), flush: .syncFlush), Data())
+        XCTAssertEqual(compressor.metrics.calls, metrics.calls + 1)
+        XCTAssertEqual(compressor.metrics.bufferErrorRetries, 1)
+        XCTAssertEqual(compressor.metrics.bytesOut, Int(try compressor.getStreamInfo().totalOut))
+    }
+
+    func testResetMetrics() throws {
+        let compressor = Compressor()
+        try compressor.initialize()
+        _ = try compressor.compress(makeData(count: 50000), flush: .finish)
+        let peak = compressor.metrics.peakStateMemory
+        compressor.resetMetrics()
+        XCTAssertEqual(compressor.metrics.calls, 0)
+        XCTAssertEqual(compressor.metrics.bytesIn, 0)
+        XCTAssertEqual(compressor.metrics.peakStateMemory, peak)
+    }
+
+    func testReportHandlerAndSignposts() throws {
+        var reports: [(ZLibMetrics.Operation, StreamMetrics)] = []
+        ZLibMetrics.reportHandler = { reports.append(($0, $1)) }
+        ZLibMetrics.signpostsEnabled = true
+
+        let original = makeData(count: 80000)
+        let compressor = Compressor()
+        try compressor.initialize()
+        let compressed = try compressor.compress(original, flush: .finish)
+        let decompressor = Decompressor()
+        try decompressor.initialize()
+        XCTAssertEqual(try decompressor.decompress(compressed), original)
+
+        XCTAssertEqual(reports.map(\.0), [.deflate, .inflate])
+        XCTAssertEqual(reports[0].1.bytesIn, original.count)
+        XCTAssertEqual(reports[1].1.bytesOut, original.count)
+    }
+
+    func testAsyncStreamMetrics() async throws {
+        let original = makeData(count: 60000)
+        let stream = AsyncZLibStream(mode: .compress)
+        try await stream.initialize()
+        var compressed = try await stream.process(original)
+        compressed.append(try await stream.finalize())
+
+        let metrics = try await stream.getMetrics()
+        XCTAssertEqual(metrics.bytesIn, original.count)
+        XCTAssertEqual(metrics.bytesOut, compressed.count)
+        XCTAssertEqual(try ZLib.decompress(compressed), original)
+    }
+
+    // MARK: Private Functions
+
+    private func makeData(count: Int) -> Data {
+        Data((0 ..< count).map { UInt8(truncatingIfNeeded: ($0 * 7) ^ ($0 >> 5)) })
+    }
+}
@@ -0,0 +1,188 @@
+//
+//  StreamPoolTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class StreamPoolTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testCompressorPoolRoundTrip", testCompressorPoolRoundTrip),
+        ("testCompressorPoolReusesCompressors", testCompressorPoolReusesCompressors),
+        ("testCompressorPoolRestoresParameters", testCompressorPoolRestoresParameters),
+        ("testCompressorPoolRespectsMaxPooled", testCompressorPoolRespectsMaxPooled),
+        ("testDecompressorPoolRoundTrip", testDecompressorPoolRoundTrip),
+        ("testPoolsWithoutArena", testPoolsWithoutArena),
+        ("testDeflateArenaServesAllAllocations", testDeflateArenaServesAllAllocations),
+        ("testInflateArenaServesAllAllocations", testInflateArenaServesAllAllocations),
+        ("testConcurrentPoolUse", testConcurrentPoolUse),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testCompressorPoolRoundTrip() throws {
+        let pool = CompressorPool(level: .bestCompression)
+        for index in 0 ..< 20 {
+            let message = makeMessage(index)
+            let compressed = try pool.compress(message)
+            XCTAssertEqual(try ZLib.decompress(compressed), message)
+        }
+        XCTAssertEqual(pool.pooledCount, 1)
+    }
+
+    func testCompressorPoolReusesCompressors() throws {
+        let pool = CompressorPool()
+        let first = try pool.acquire()
+        pool.release(first)
+        XCTAssertEqual(pool.pooledCount, 1)
+
+        let second = try pool.acquire()
+        XCTAssertTrue(first === second)
+        XCTAssertEqual(pool.pooledCount, 0)
+        pool.release(second)
+
+        pool.drain()
+        XCTAssertEqual(pool.pooledCount, 0)
+    }
+
+    func testCompressorPoolRestoresParameters() throws {
+        let message = makeMessage(7)
+        let pool = CompressorPool(level: .bestCompression, windowBits: .gzip)
+        let expected = try pool.compress(message)
+
+        let compressor = try pool.acquire()
+        try compressor.setParameters(level: .noCompression, strategy: .huffmanOnly)
+        _ = try compressor.compress(message, flush: .finish)
+        pool.release(compressor)
+
+        // The returned compressor must behave like a fresh one from the pool's configuration
+        XCTAssertEqual(try pool.compress(message), expected)
+    }
+
+    func testCompressorPoolRespectsMaxPooled() throws {
+        let pool = CompressorPool(maxPooled: 2)
+        let compressors = try (0 ..< 4).map { _ in try pool.acquire() }
+        compressors.forEach { pool.release($0) }
+        XCTAssertEqual(pool.pooledCount, 2)
+    }
+
+    func testDecompressorPoolRoundTrip() throws {
+        let compressorPool = CompressorPool(windowBits: .gzip)
+        let decompressorPool = DecompressorPool(windowBits: .gzip)
+        for index in 0 ..< 20 {
+            let message = makeMessage(index)
+            let compressed = try compressorPool.compress(message)
+            XCTAssertEqual(try decompressorPool.decompress(compressed), message)
+        }
+        XCTAssertEqual(decompressorPool.pooledCount, 1)
+    }
+
+    func testPoolsWithoutArena() throws {
+        let compressorPool = CompressorPool(windowBits: .raw, usesArena: false)
+        let decompressorPool = DecompressorPool(windowBits: .raw, usesArena: false)
+        let message = makeMessage(3)
+        let compressed = try compressorPool.compress(message)
+        XCTAssertEqual(try decompressorPool.decompress(compressed), message)
+    }
+
+    func testDeflateArenaServesAllAllocations() throws {
+        for memoryLevel in [MemoryLevel.minimum, .level8, .maximum] {
+            let arena = try XCTUnwrap(ZStreamArena.forDeflate(windowBits: .deflate, memoryLevel: memoryLevel))
+            let compressor = Compressor()
+            compressor.attachArena(arena)
+            try compressor.initializeAdvanced(level: .bestCompression, memoryLevel: memoryLevel)
+            XCTAssertGreaterThan(arena.usedBytes, 0)
+
+            for index in 0 ..< 3 {
+                let message = makeMessage(index)
+                let compressed = try compressor.compress(message, flush: .finish)
+                XCTAssertEqual(try ZLib.decompress(compressed), message)
+                try compressor.prepareForReuse(level: .bestCompression, strategy: .defaultStrategy)
+            }
+            XCTAssertEqual(arena.fallbackCount, 0)
+            XCTAssertLessThanOrEqual(arena.peakBytes, arena.capacity)
+        }
+    }
+
+    func testInflateArenaServesAllAllocations() throws {
+        let message = makeMessage(11)
+        let compressed = try ZLib.compress(message)
+
+        let arena = try XCTUnwrap(ZStreamArena.forInflate(windowBits: .deflate))
+        let decompressor = Decompressor()
+        decompressor.attachArena(arena)
+        try decompressor.initializeAdvanced(windowBits: .deflate)
+        for _ in 0 ..< 3 {
+            XCTAssertEqual(try decompressor.decompress(compressed), message)
+            try decompressor.prepareForReuse()
+        }
+        XCTAssertEqual(arena.fallbackCount, 0)
+    }
+
+    func testConcurrentPoolUse() throws {
+        let compressorPool = CompressorPool(maxPooled: 4)
+        let decompressorPool = DecompressorPool(maxPooled: 4)
+        let failures = LockedCounter()
+
+        DispatchQueue.concurrentPerform(iterations: 64) { index in
+            let message = makeMessage(index)
+            do {
+                let compressed = try compressorPool.compress(message)
+                if try decompressorPool.decompress(compressed) != message {
+                    failures.increment()
+                }
+            } catch {
+                failures.increment()
+            }
+        }
+
+        XCTAssertEqual(failures.value, 0)
+        XCTAssertLessThanOrEqual(compressorPool.pooledCount, 4)
+        XCTAssertLessThanOrEqual(decompressorPool.pooledCount, 4)
+    }
+
+    // MARK: Private Functions
+
+    private func makeMessage(_ index: Int) -> Data {
+        // Small RPC-sized payloads with a little variation between messages
+        let body = String(repeating: "{\"id\":\(index),\"status\":\"ok\",\"items\":[1,2,3]}", count: 20 + index % 13)
+        return Data(body.utf8)
+    }
+}
+
+// MARK: - LockedCounter
+
+private final class LockedCounter {
+    // MARK: Properties
+
+    private let lock = NSLock()
+    private var count = 0
+
+    // MARK: Computed Properties
+
+    var value: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return count
+    }
+
+    // MARK: Functions
+
+    func increment() {
+        lock.lock()
+        count += 1
+        lock.unlock()
+    }
+}
@@ -15,6 +15,7 @@ final class FileChunkedCompressorTests: XCTestCase {
         ("testFileChunkedCompressorProgressStream", testFileChunkedCompressorProgressStream),
         ("testFileChunkedCompressorErrorHandling", testFileChunkedCompressorErrorHandling),
         ("testFileChunkedCompressorAsyncErrorHandling", testFileChunkedCompressorAsyncErrorHandling),
+        ("testFileChunkedCompressorReadAheadPipeline", testFileChunkedCompressorReadAheadPipeline),
     ]
 
     // MARK: Overridden Functions
@@ -196,4 +197,55 @@ final class FileChunkedCompressorTests: XCTestCase {
             assertNoDoubleWrappedZLibError(error)
         }
     }
+
+    func testFileChunkedCompressorReadAheadPipeline() async throws {
+        let chunk = 4096
+        var state: UInt32 = 12345
+        let pattern = Data((0 ..< chunk * 6).map { index -> UInt8 in
+            state = state &* 1_103_515_245 &+ 12345
+            return index % 3 == 0 ? UInt8(truncatingIfNeeded: state >> 16) : UInt8(index % 61)
+        })
+        let sourceURL = FileManager.default.temporaryDirectory.appendingPathComponent("test_pipeline_source.bin")
+        let destURL = FileManager.default.temporaryDirectory.appendingPathComponent("test_pipeline.gz")
+        let decompressDestURL = FileManager.default.temporaryDirectory.appendingPathComponent("test_pipeline_decompressed.bin")
+
+        defer {
+            try? FileManager.default.removeItem(at: sourceURL)
+            try? FileManager.default.removeItem(at: destURL)
+            try? FileManager.default.removeItem(at: decompressDestURL)
+        }
+
+        // Empty, a single short chunk, an exact multiple of the chunk size and a ragged tail
+        for size in [0, 100, chunk * 5, chunk * 6 - 123] {
+            for depth in [1, 3] {
+                let testData = pattern.prefix(size)
+                try testData.write(to: sourceURL)
+
+                let compressor = FileChunkedCompressor(bufferSize: chunk, readAheadDepth: depth)
+                var reports: [(Int, Int)] = []
+                try await compressor.compressFile(from: sourceURL.path, to: destURL.path) { processed, total in
+                    reports.append((processed, total))
+                }
+
+                XCTAssertEqual(reports.map(\.0), reports.map(\.0).sorted(), "size \(size), depth \(depth)")
+                XCTAssertEqual(reports.last?.0, size, "size \(size), depth \(depth)")
+                XCTAssertTrue(reports.allSatisfy { $0.1 == size }, "size \(size), depth \(depth)")
+
+                try FileChunkedDecompressor().decompressFile(from: destURL.path, to: decompressDestURL.path)
+                XCTAssertEqual(try Data(contentsOf: decompressDestURL), testData, "size \(size), depth \(depth)")
+            }
+        }
+
+        // The progress stream runs the same pipeline
+        try pattern.write(to: sourceURL)
+        let compressor = FileChunkedCompressor(bufferSize: chunk, readAheadDepth: 2)
+        var phases: [CompressionPhase] = []
+        for try await info in compressor.compressFileProgressStream(from: sourceURL.path, to: destURL.path, progressInterval: 0) {
+            phases.append(info.phase)
+        }
+        XCTAssertEqual(phases.first, .reading)
+        XCTAssertEqual(phases.last, .finished)
+        try FileChunkedDecompressor().decompressFile(from: destURL.path, to: decompressDestURL.path)
+        XCTAssertEqual(try Data(contentsOf: decompressDestURL), pattern)
+    }
 }
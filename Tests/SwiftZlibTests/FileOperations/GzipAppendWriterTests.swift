@@ -0,0 +1,161 @@
+//
+//  GzipAppendWriterTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class GzipAppendWriterTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testFileIsValidAfterEveryAppend", testFileIsValidAfterEveryAppend),
+        ("testResumeAcrossSessions", testResumeAcrossSessions),
+        ("testResumingBeatsNewMembers", testResumingBeatsNewMembers),
+        ("testMissingCheckpointStartsNewMember", testMissingCheckpointStartsNewMember),
+        ("testModifiedFileStartsNewMember", testModifiedFileStartsNewMember),
+        ("testEmptySessionAndClosedWriter", testEmptySessionAndClosedWriter),
+    ]
+
+    // MARK: Properties
+
+    private var path = ""
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+        path = NSTemporaryDirectory() + "gzip_append_\(UUID().uuidString).log.gz"
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(atPath: path)
+        try? FileManager.default.removeItem(atPath: GzipAppendWriter.checkpointPath(for: path))
+        super.tearDown()
+    }
+
+    // MARK: Functions
+
+    func testFileIsValidAfterEveryAppend() throws {
+        let writer = try GzipAppendWriter(path: path)
+        XCTAssertFalse(writer.isResumed)
+        var expected = Data()
+        for index in 0 ..< 20 {
+            let record = makeRecord(index)
+            try writer.append(record)
+            expected.append(record)
+            // Readers see a complete single-member gzip file between appends
+            XCTAssertEqual(try readFile(), expected, "after append \(index)")
+        }
+        XCTAssertEqual(writer.crc32, ZLib.crc32(expected))
+        XCTAssertEqual(writer.uncompressedSize, expected.count)
+        XCTAssertEqual(try ZLib.decompress(Data(contentsOf: URL(fileURLWithPath: path)), options: DecompressionOptions(format: .gzip)), expected)
+        try writer.close()
+    }
+
+    func testResumeAcrossSessions() throws {
+        var expected = Data()
+        for session in 0 ..< 5 {
+            let writer = try GzipAppendWriter(path: path, level: .bestCompression)
+            XCTAssertEqual(writer.isResumed, session > 0)
+            XCTAssertEqual(writer.uncompressedSize, expected.count)
+            for index in 0 ..< 10 {
+                let record = makeRecord(session * 10 + index)
+                try writer.append(record)
+                expected.append(record)
+            }
+            try writer.close()
+        }
+        XCTAssertTrue(FileManager.default.fileExists(atPath: GzipAppendWriter.checkpointPath(for: path)))
+        // Still one member: a plain gzip inflate reads everything
+        XCTAssertEqual(try ZLib.decompress(Data(contentsOf: URL(fileURLWithPath: path)), options: DecompressionOptions(format: .gzip)), expected)
+    }
+
+    func testResumingBeatsNewMembers() throws {
+        let otherPath = path + ".members"
+        defer { try? FileManager.default.removeItem(atPath: otherPath) }
+        for session in 0 ..< 30 {
+            let record = makeRecord(session)
+            let resumed = try GzipAppendWriter(path: path)
+            try resumed.append(record)
+            try resumed.close()
+
+            // Without its checkpoint every session starts a new member with an empty window
+            try? FileManager.default.removeItem(atPath: GzipAppendWriter.checkpointPath(for: otherPath))
+            let fresh = try GzipAppendWriter(path: otherPath)
+            try fresh.append(record)
+            try fresh.close()
+        }
+        XCTAssertEqual(try readFile(at: otherPath), try readFile())
+        let resumedSize = try FileManager.default.attributesOfItem(atPath: path)[.size] as! Int
+        let membersSize = try FileManager.default.attributesOfItem(atPath: otherPath)[.size] as! Int
+        XCTAssertLessThan(resumedSize * 2, membersSize)
+    }
+
+    func testMissingCheckpointStartsNewMember() throws {
+        let first = try GzipAppendWriter(path: path)
+        try first.append(makeRecord(1))
+        try first.close()
+        try FileManager.default.removeItem(atPath: GzipAppendWriter.checkpointPath(for: path))
+
+        let second = try GzipAppendWriter(path: path)
+        XCTAssertFalse(second.isResumed)
+        try second.append(makeRecord(2))
+        try second.close()
+        XCTAssertEqual(try readFile(), makeRecord(1) + makeRecord(2))
+    }
+
+    func testModifiedFileStartsNewMember() throws {
+        let writer = try GzipAppendWriter(path: path)
+        try writer.append(makeRecord(1))
+        try writer.close()
+
+        // Another tool appends a member behind the writer's back
+        let handle = try FileHandle(forWritingTo: URL(fileURLWithPath: path))
+        try handle.seekToEnd()
+        try handle.write(contentsOf: ZLib.compressGzip(makeRecord(2)))
+        try handle.close()
+
+        let resumed = try GzipAppendWriter(path: path)
+        XCTAssertFalse(resumed.isResumed)
+        try resumed.append(makeRecord(3))
+        try resumed.close()
+        XCTAssertEqual(try readFile(), makeRecord(1) + makeRecord(2) + makeRecord(3))
+    }
+
+    func testEmptySessionAndClosedWriter() throws {
+        let writer = try GzipAppendWriter(path: path)
+        try writer.append(Data())
+        try writer.close()
+        XCTAssertEqual(try readFile(), Data())
+
+        XCTAssertThrowsError(try writer.append(makeRecord(0))) { error in
+            guard case .writeFailed? = error as? GzipFileError else {
+                return XCTFail("Expected writeFailed, got \(error)")
+            }
+        }
+
+        let resumed = try GzipAppendWriter(path: path)
+        XCTAssertTrue(resumed.isResumed)
+        try resumed.append(makeRecord(0))
+        try resumed.close()
+        XCTAssertEqual(try readFile(), makeRecord(0))
+    }
+
+    // MARK: Private Functions
+
+    /// Reads all members, so new-member fallbacks are covered too
+    private func readFile(at filePath: String? = nil) throws -> Data {
+        let data = try Data(contentsOf: URL(fileURLWithPath: filePath ?? path))
+        return try ParallelGzipDecompressor(threadCount: 1).decompress(data)
+    }
+
+    private func makeRecord(_ index: Int) -> Data {
+        let line = "2025-07-13T12:00:\(index % 60)Z level=info service=api request=/v1/items/\(index % 17) status=200\n"
+        return Data(String(repeating: line, count: 3).utf8)
+    }
+}
@@ -0,0 +1,122 @@
+//
+//  GzipFileBufferTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class GzipFileBufferTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testDefaultBufferSize", testDefaultBufferSize),
+        ("testRoundTripAcrossBufferSizes", testRoundTripAcrossBufferSizes),
+        ("testReadIntoCallerBuffer", testReadIntoCallerBuffer),
+        ("testWriteContentsOfChunks", testWriteContentsOfChunks),
+        ("testReadingTruncatedFileReturnsDecodedPrefix", testReadingTruncatedFileReturnsDecodedPrefix),
+        ("testInvalidBufferSizeThrows", testInvalidBufferSizeThrows),
+    ]
+
+    // MARK: Properties
+
+    private var tempPath = ""
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+        tempPath = FileManager.default.temporaryDirectory.appendingPathComponent("gzbuf-\(UUID().uuidString).gz").path
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(atPath: tempPath)
+        super.tearDown()
+    }
+
+    // MARK: Functions
+
+    func testDefaultBufferSize() throws {
+        let file = try GzipFile(path: tempPath, mode: "wb")
+        XCTAssertEqual(file.bufferSize, GzipFile.defaultBufferSize)
+        XCTAssertEqual(GzipFile.defaultBufferSize, 128 * 1024)
+        try file.close()
+    }
+
+    func testRoundTripAcrossBufferSizes() throws {
+        let original = makeData(count: 700_000)
+        for size in [8, 8192, 128 * 1024, 1024 * 1024] {
+            let writer = try GzipFile(path: tempPath, mode: "wb6", bufferSize: size)
+            try writer.writeData(original)
+            try writer.close()
+
+            let reader = try GzipFile(path: tempPath, mode: "rb", bufferSize: size)
+            XCTAssertEqual(try reader.readData(count: original.count + 100), original, "bufferSize \(size)")
+            XCTAssertTrue(try reader.readData(count: 10).isEmpty)
+            try reader.close()
+
+            XCTAssertEqual(try ZLib.decompress(Data(contentsOf: URL(fileURLWithPath: tempPath)), options: DecompressionOptions(format: .gzip)), original)
+        }
+    }
+
+    func testReadIntoCallerBuffer() throws {
+        let original = makeData(count: 1_000_000)
+        try ZLib.compressGzip(original).write(to: URL(fileURLWithPath: tempPath))
+
+        let reader = try GzipFile(path: tempPath, mode: "rb", bufferSize: 64 * 1024)
+        var output = Data()
+        var buffer = [UInt8](repeating: 0, count: 300_000)
+        while true {
+            let count = try buffer.withUnsafeMutableBytes { try reader.read(into: $0) }
+            guard count > 0 else { break }
+            output.append(contentsOf: buffer[0 ..< count])
+        }
+        try reader.close()
+        XCTAssertEqual(output, original)
+    }
+
+    func testWriteContentsOfChunks() throws {
+        let chunks = (0 ..< 2000).map { Data("line \($0) of the log\n".utf8) }
+        let writer = try GzipFile(path: tempPath, mode: "wb")
+        try writer.writeData(contentsOf: chunks)
+        try joined(chunks).withUnsafeBytes { try writer.write($0) }
+        try writer.close()
+
+        let reader = try GzipFile(path: tempPath, mode: "rb")
+        let expected = joined(chunks)
+        XCTAssertEqual(try reader.readData(count: expected.count * 2 + 1), expected + expected)
+        try reader.close()
+    }
+
+    func testReadingTruncatedFileReturnsDecodedPrefix() throws {
+        let original = makeData(count: 200_000)
+        let compressed = try ZLib.compressGzip(original)
+        try compressed.prefix(compressed.count / 2).write(to: URL(fileURLWithPath: tempPath))
+
+        let reader = try GzipFile(path: tempPath, mode: "rb")
+        let data = try reader.readData(count: original.count)
+        // gzclose reports the unexpected end of file as Z_BUF_ERROR
+        XCTAssertThrowsError(try reader.close())
+        XCTAssertGreaterThan(data.count, 0)
+        XCTAssertLessThan(data.count, original.count)
+        XCTAssertEqual(data, original.prefix(data.count))
+    }
+
+    func testInvalidBufferSizeThrows() {
+        XCTAssertThrowsError(try GzipFile(path: tempPath, mode: "wb", bufferSize: 0))
+        XCTAssertThrowsError(try GzipFile(path: tempPath, mode: "wb", bufferSize: -1))
+    }
+
+    // MARK: Private Functions
+
+    private func makeData(count: Int) -> Data {
+        Data((0 ..< count).map { UInt8(truncatingIfNeeded: ($0 * 13) ^ ($0 >> 8) ^ ($0 % 241)) })
+    }
+
+    private func joined(_ chunks: [Data]) -> Data {
+        chunks.reduce(into: Data()) { $0.append($1) }
+    }
+}
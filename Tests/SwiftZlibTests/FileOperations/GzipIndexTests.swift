@@ -0,0 +1,295 @@
+//
+//  GzipIndexTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class GzipIndexTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testBuildRecordsCheckpoints", testBuildRecordsCheckpoints),
+        ("testRandomReadsFromFile", testRandomReadsFromFile),
+        ("testRandomReadsFromMemoryAllFormats", testRandomReadsFromMemoryAllFormats),
+        ("testMultiMemberGzip", testMultiMemberGzip),
+        ("testSidecarRoundTrip", testSidecarRoundTrip),
+        ("testStaleSidecarIsRebuilt", testStaleSidecarIsRebuilt),
+        ("testSameSizeRewriteIsStale", testSameSizeRewriteIsStale),
+        ("testTrailingPaddingCountsAsSource", testTrailingPaddingCountsAsSource),
+        ("testGzipFileSeekWithIndex", testGzipFileSeekWithIndex),
+        ("testGzipFileRejectsMismatchedIndex", testGzipFileRejectsMismatchedIndex),
+        ("testTruncatedInputFails", testTruncatedInputFails),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    override func tearDown() {
+        ZLibVerboseConfig.disableAll()
+        super.tearDown()
+    }
+
+    // MARK: Functions
+
+    func testBuildRecordsCheckpoints() throws {
+        let original = makeTestData(count: 2_000_000)
+        let index = try GzipIndex.build(for: ZLib.compressGzip(original), span: 128 * 1024)
+
+        XCTAssertEqual(index.uncompressedSize, original.count)
+        XCTAssertEqual(index.windowBits, .gzip)
+        XCTAssertEqual(index.span, 128 * 1024)
+        XCTAssertGreaterThan(index.checkpointCount, 5)
+        XCTAssertEqual(index.checkpointOffset(before: 0), 0)
+        XCTAssertLessThanOrEqual(index.checkpointOffset(before: 1_500_000), 1_500_000)
+    }
+
+    func testRandomReadsFromFile() throws {
+        let original = makeTestData(count: 2_000_000)
+        let path = tempFilePath("gzip_index_random.gz")
+        defer { try? FileManager.default.removeItem(atPath: path) }
+        try ZLib.compressGzip(original).write(to: URL(fileURLWithPath: path))
+
+        let index = try GzipIndex.build(forFileAt: path, span: 100_000)
+        XCTAssertTrue(index.matches(fileAt: path))
+
+        var generator = SystemRandomNumberGenerator()
+        for _ in 0 ..< 50 {
+            let offset = Int.random(in: 0 ..< original.count, using: &generator)
+            let count = Int.random(in: 1 ... 200_000, using: &generator)
+            let slice = try index.read(fromFileAt: path, offset: offset, count: count)
+            XCTAssertEqual(slice, original.subdata(in: offset ..< min(offset + count, original.count)))
+        }
+        XCTAssertTrue(try index.read(fromFileAt: path, offset: original.count + 10, count: 10).isEmpty)
+    }
+
+    func testRandomReadsFromMemoryAllFormats() throws {
+        let original = makeTestData(count: 1_000_000)
+        let formats: [(WindowBits, Data)] = try [
+            (.gzip, ZLib.compressGzip(original)),
+            (.deflate, ZLib.compress(original)),
+            (.raw, ZLib.compressRaw(original)),
+        ]
+
+        for (windowBits, compressed) in formats {
+            let index = try GzipIndex.build(for: compressed, span: 64 * 1024)
+            XCTAssertEqual(index.windowBits, windowBits)
+            XCTAssertEqual(index.uncompressedSize, original.count)
+            for offset in [0, 1, 65535, 300_001, original.count - 7] {
+                let slice = try index.read(from: compressed, offset: offset, count: 5000)
+                XCTAssertEqual(slice, original.subdata(in: offset ..< min(offset + 5000, original.count)), "\(windowBits) @ \(offset)")
+            }
+        }
+    }
+
+    func testMultiMemberGzip() throws {
+        let original = makeTestData(count: 900_000)
+        var compressed = Data()
+        for part in stride(from: 0, to: original.count, by: 300_000) {
+            compressed.append(try ZLib.compressGzip(original.subdata(in: part ..< part + 300_000)))
+        }
+
+        let index = try GzipIndex.build(for: compressed, span: 64 * 1024)
+        XCTAssertEqual(index.uncompressedSize, original.count)
+        // Spans a member boundary
+        let slice = try index.read(from: compressed, offset: 250_000, count: 400_000)
+        XCTAssertEqual(slice, original.subdata(in: 250_000 ..< 650_000))
+    }
+
+    func testSidecarRoundTrip() throws {
+        let original = makeTestData(count: 1_000_000)
+        let path = tempFilePath("gzip_index_sidecar.gz")
+        let sidecar = GzipIndex.sidecarPath(for: path)
+        defer {
+            try? FileManager.default.removeItem(atPath: path)
+            try? FileManager.default.removeItem(atPath: sidecar)
+        }
+        try ZLib.compressGzip(original).write(to: URL(fileURLWithPath: path))
+
+        XCTAssertNil(try GzipIndex.sidecar(forFileAt: path, buildIfMissing: false))
+        let built = try XCTUnwrap(GzipIndex.sidecar(forFileAt: path, span: 128 * 1024))
+        XCTAssertTrue(FileManager.default.fileExists(atPath: sidecar))
+
+        let loaded = try GzipIndex(contentsOf: sidecar)
+        XCTAssertEqual(loaded.checkpointCount, built.checkpointCount)
+        XCTAssertEqual(loaded.uncompressedSize, built.uncompressedSize)
+        XCTAssertEqual(loaded.compressedSize, built.compressedSize)
+        XCTAssertEqual(try loaded.read(fromFileAt: path, offset: 777_777, count: 1000), original.subdata(in: 777_777 ..< 778_777))
+
+        // Garbage in place of an index is rejected
+        try Data("not an index".utf8).write(to: URL(fileURLWithPath: sidecar))
+        XCTAssertThrowsError(try GzipIndex(contentsOf: sidecar))
+    }
+
+    func testStaleSidecarIsRebuilt() throws {
+        let path = tempFilePath("gzip_index_stale.gz")
+        let sidecar = GzipIndex.sidecarPath(for: path)
+        defer {
+            try? FileManager.default.removeItem(atPath: path)
+            try? FileManager.default.removeItem(atPath: sidecar)
+        }
+        try ZLib.compressGzip(makeTestData(count: 500_000)).write(to: URL(fileURLWithPath: path))
+        _ = try GzipIndex.sidecar(forFileAt: path)
+
+        let replacement = makeTestData(count: 800_000)
+        try ZLib.compressGzip(replacement).write(to: URL(fileURLWithPath: path))
+        XCTAssertNil(try GzipIndex.sidecar(forFileAt: path, buildIfMissing: false))
+
+        let rebuilt = try XCTUnwrap(GzipIndex.sidecar(forFileAt: path))
+        XCTAssertEqual(rebuilt.uncompressedSize, replacement.count)
+    }
+
+    func testSameSizeRewriteIsStale() throws {
+        let path = tempFilePath("gzip_index_rewrite.gz")
+        let sidecar = GzipIndex.sidecarPath(for: path)
+        defer {
+            try? FileManager.default.removeItem(atPath: path)
+            try? FileManager.default.removeItem(atPath: sidecar)
+        }
+        // Stored blocks make the compressed size depend on the length alone
+        let original = makeTestData(count: 300_000)
+        // A whole second survives setAttributes on every file system
+        let modified = Date(timeIntervalSince1970: 1_750_000_000)
+        try ZLib.compressGzip(original, level: .noCompression).write(to: URL(fileURLWithPath: path))
+        try FileManager.default.setAttributes([.modificationDate: modified], ofItemAtPath: path)
+        let index = try XCTUnwrap(GzipIndex.sidecar(forFileAt: path))
+
+        // Same size and modification time, other contents
+        var replacement = original
+        replacement[replacement.count - 1] ^= 0xFF
+        try ZLib.compressGzip(replacement, level: .noCompression).write(to: URL(fileURLWithPath: path))
+        try FileManager.default.setAttributes([.modificationDate: modified], ofItemAtPath: path)
+        XCTAssertEqual(index.compressedSize, try Data(contentsOf: URL(fileURLWithPath: path)).count)
+        XCTAssertFalse(index.matches(fileAt: path))
+        XCTAssertNil(try GzipIndex.sidecar(forFileAt: path, buildIfMissing: false))
+
+        // Same contents, touched later
+        try ZLib.compressGzip(original, level: .noCompression).write(to: URL(fileURLWithPath: path))
+        try FileManager.default.setAttributes([.modificationDate: modified], ofItemAtPath: path)
+        XCTAssertTrue(index.matches(fileAt: path))
+        try FileManager.default.setAttributes([.modificationDate: modified.addingTimeInterval(60)], ofItemAtPath: path)
+        XCTAssertFalse(index.matches(fileAt: path))
+
+        let rebuilt = try XCTUnwrap(GzipIndex.sidecar(forFileAt: path))
+        XCTAssertTrue(rebuilt.matches(fileAt: path))
+        XCTAssertEqual(try rebuilt.read(fromFileAt: path, offset: 299_990, count: 10), original.suffix(10))
+    }
+
+    func testTrailingPaddingCountsAsSource() throws {
+        let path = tempFilePath("gzip_index_padded.gz")
+        let sidecar = GzipIndex.sidecarPath(for: path)
+        defer {
+            try? FileManager.default.removeItem(atPath: path)
+            try? FileManager.default.removeItem(atPath: sidecar)
+        }
+        let original = makeTestData(count: 300_000)
+        let compressed = try ZLib.compressGzip(original)
+        // Padding well past one 64 KB read, as left by tape or block-device tools
+        var padded = compressed + Data(count: 200_000)
+        let modified = Date(timeIntervalSince1970: 1_750_000_000)
+        try padded.write(to: URL(fileURLWithPath: path))
+        try FileManager.default.setAttributes([.modificationDate: modified], ofItemAtPath: path)
+
+        let index = try XCTUnwrap(GzipIndex.sidecar(forFileAt: path))
+        XCTAssertEqual(index.compressedSize, compressed.count)
+        XCTAssertEqual(index.sourceSize, padded.count)
+        XCTAssertTrue(index.matches(fileAt: path))
+        let loaded = try XCTUnwrap(GzipIndex.sidecar(forFileAt: path, buildIfMissing: false))
+        XCTAssertEqual(loaded.sourceSize, padded.count)
+        XCTAssertEqual(try loaded.read(fromFileAt: path, offset: 299_990, count: 10), original.suffix(10))
+
+        let inMemory = try GzipIndex.build(for: padded)
+        XCTAssertEqual(inMemory.compressedSize, compressed.count)
+        XCTAssertEqual(inMemory.sourceSize, padded.count)
+
+        // The fingerprint covers the end of the file, not the end of the stream
+        padded[padded.count - 1] = 1
+        try padded.write(to: URL(fileURLWithPath: path))
+        try FileManager.default.setAttributes([.modificationDate: modified], ofItemAtPath: path)
+        XCTAssertFalse(index.matches(fileAt: path))
+    }
+
+    func testGzipFileSeekWithIndex() throws {
+        let original = makeTestData(count: 2_000_000)
+        let path = tempFilePath("gzip_index_seek.gz")
+        let sidecar = GzipIndex.sidecarPath(for: path)
+        defer {
+            try? FileManager.default.removeItem(atPath: path)
+            try? FileManager.default.removeItem(atPath: sidecar)
+        }
+        try ZLib.compressGzip(original).write(to: URL(fileURLWithPath: path))
+
+        let file = try GzipFile(path: path, mode: "rb")
+        defer { try? file.close() }
+        XCTAssertNotNil(try file.loadIndex(span: 128 * 1024))
+        XCTAssertNotNil(file.seekIndex)
+
+        for offset in [1_900_000, 10, 1_234_567, 400_000, 400_100] {
+            try file.seek(offset: offset)
+            XCTAssertEqual(try file.tell(), offset)
+            XCTAssertEqual(try file.readData(count: 4096), original.subdata(in: offset ..< offset + 4096))
+        }
+
+        try file.seek(offset: -100_000, whence: SEEK_CUR)
+        XCTAssertEqual(try file.tell(), 304_196)
+        XCTAssertEqual(try file.getByte(), original[304_196])
+
+        // Reading on to the end still verifies the trailer
+        try file.seek(offset: 1_000_000)
+        var total = 1_000_000
+        while true {
+            let chunk = try file.readData(count: 65536)
+            if chunk.isEmpty { break }
+            total += chunk.count
+        }
+        XCTAssertEqual(total, original.count)
+        XCTAssertTrue(file.isEOF())
+    }
+
+    func testGzipFileRejectsMismatchedIndex() throws {
+        let path = tempFilePath("gzip_index_mismatch.gz")
+        defer { try? FileManager.default.removeItem(atPath: path) }
+        try ZLib.compressGzip(makeTestData(count: 100_000)).write(to: URL(fileURLWithPath: path))
+
+        let other = try GzipIndex.build(for: ZLib.compressGzip(makeTestData(count: 300_000)))
+        let file = try GzipFile(path: path, mode: "rb")
+        defer { try? file.close() }
+        XCTAssertThrowsError(try file.useIndex(other))
+        XCTAssertNil(file.seekIndex)
+    }
+
+    func testTruncatedInputFails() throws {
+        let compressed = try ZLib.compressGzip(makeTestData(count: 500_000))
+        XCTAssertThrowsError(try GzipIndex.build(for: compressed.prefix(compressed.count / 2))) { error in
+            guard case .decompressionFailed? = error as? ZLibError else {
+                return XCTFail("Unexpected error: \(error)")
+            }
+        }
+        XCTAssertThrowsError(try GzipIndex.build(for: Data()))
+    }
+
+    // MARK: Private Functions
+
+    /// Mix of compressible text and noise so that deflate emits many blocks
+    private func makeTestData(count: Int) -> Data {
+        var state: UInt32 = 12345
+        var bytes = [UInt8](repeating: 0, count: count)
+        let text = Array("the quick brown fox jumps over the lazy dog ".utf8)
+        for i in 0 ..< count {
+            state = state &* 1_103_515_245 &+ 12345
+            bytes[i] = i % 8192 < 6144 ? text[i % text.count] : UInt8(truncatingIfNeeded: state >> 16)
+        }
+        return Data(bytes)
+    }
+
+    private func tempFilePath(_ filename: String) -> String {
+        NSTemporaryDirectory() + filename
+    }
+}
@@ -0,0 +1,174 @@
+//
+//  MappedFileTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class MappedFileTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testMappedFileExposesContents", testMappedFileExposesContents),
+        ("testChunkedCompressorMappedRoundTrip", testChunkedCompressorMappedRoundTrip),
+        ("testChunkedDecompressorMappedWithProgress", testChunkedDecompressorMappedWithProgress),
+        ("testParallelCompressorMapped", testParallelCompressorMapped),
+        ("testFileCompressorMappedConfig", testFileCompressorMappedConfig),
+        ("testMappedEmptyFile", testMappedEmptyFile),
+        ("testMappedTruncatedInputFails", testMappedTruncatedInputFails),
+        ("testMappedMissingFileFails", testMappedMissingFileFails),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    override func tearDown() {
+        ZLibVerboseConfig.disableAll()
+        super.tearDown()
+    }
+
+    // MARK: Functions
+
+    func testMappedFileExposesContents() throws {
+        let data = makeTestData(count: 100_000)
+        let path = try writeTemp(data, name: "mapped_contents.bin")
+        defer { try? FileManager.default.removeItem(atPath: path) }
+
+        let mapped = try MappedFile(path: path)
+        XCTAssertEqual(mapped.bytes.count, data.count)
+        XCTAssertEqual(Data(mapped.bytes), data)
+    }
+
+    func testChunkedCompressorMappedRoundTrip() throws {
+        let data = makeTestData(count: 1_500_000)
+        let source = try writeTemp(data, name: "mapped_source.bin")
+        let compressed = tempFilePath("mapped_source.gz")
+        let restored = tempFilePath("mapped_restored.bin")
+        defer { removeItems(source, compressed, restored) }
+
+        let compressor = FileChunkedCompressor(bufferSize: 32 * 1024, windowBits: .gzip, useMemoryMapping: true)
+        try compressor.compressFile(from: source, to: compressed)
+        let compressedData = try Data(contentsOf: URL(fileURLWithPath: compressed))
+        XCTAssertEqual(try ZLib.decompressAuto(compressedData), data)
+
+        let decompressor = FileChunkedDecompressor(bufferSize: 32 * 1024, windowBits: .gzip, useMemoryMapping: true)
+        try decompressor.decompressFile(from: compressed, to: restored)
+        XCTAssertEqual(try Data(contentsOf: URL(fileURLWithPath: restored)), data)
+    }
+
+    func testChunkedDecompressorMappedWithProgress() throws {
+        let data = makeTestData(count: 800_000)
+        let compressed = try writeTemp(ZLib.compress(data), name: "mapped_progress.z")
+        let restored = tempFilePath("mapped_progress.bin")
+        defer { removeItems(compressed, restored) }
+
+        var reports: [(Int, Int)] = []
+        let decompressor = FileChunkedDecompressor(useMemoryMapping: true)
+        try decompressor.decompressFile(from: compressed, to: restored) { processed, total in
+            reports.append((processed, total))
+        }
+        XCTAssertEqual(try Data(contentsOf: URL(fileURLWithPath: restored)), data)
+        XCTAssertFalse(reports.isEmpty)
+        XCTAssertEqual(reports.last?.0, reports.last?.1)
+        XCTAssertEqual(reports.map(\.0), reports.map(\.0).sorted())
+    }
+
+    func testParallelCompressorMapped() throws {
+        let data = makeTestData(count: 1_000_000)
+        let source = try writeTemp(data, name: "mapped_parallel.bin")
+        let compressed = tempFilePath("mapped_parallel.gz")
+        defer { removeItems(source, compressed) }
+
+        let compressor = FileChunkedCompressor(
+            windowBits: .gzip,
+            parallelism: 4,
+            parallelBlockSize: 128 * 1024,
+            useMemoryMapping: true
+        )
+        try compressor.compressFile(from: source, to: compressed)
+        let compressedData = try Data(contentsOf: URL(fileURLWithPath: compressed))
+        XCTAssertEqual(try ZLib.decompressAuto(compressedData), data)
+    }
+
+    func testFileCompressorMappedConfig() throws {
+        let data = makeTestData(count: 600_000)
+        let source = try writeTemp(data, name: "mapped_config.bin")
+        let compressed = tempFilePath("mapped_config.z")
+        let restored = tempFilePath("mapped_config_restored.bin")
+        defer { removeItems(source, compressed, restored) }
+
+        let config = StreamingConfig(useMemoryMapping: true)
+        try FileCompressor(config: config).compressFile(from: source, to: compressed)
+        let compressedData = try Data(contentsOf: URL(fileURLWithPath: compressed))
+        XCTAssertEqual(compressedData, try ZLib.compress(data, level: .defaultCompression))
+
+        try FileDecompressor(config: config).decompressFile(from: compressed, to: restored)
+        XCTAssertEqual(try Data(contentsOf: URL(fileURLWithPath: restored)), data)
+    }
+
+    func testMappedEmptyFile() throws {
+        let source = try writeTemp(Data(), name: "mapped_empty.bin")
+        let compressed = tempFilePath("mapped_empty.gz")
+        let restored = tempFilePath("mapped_empty_restored.bin")
+        defer { removeItems(source, compressed, restored) }
+
+        try FileChunkedCompressor(windowBits: .gzip, useMemoryMapping: true).compressFile(from: source, to: compressed)
+        try FileChunkedDecompressor(windowBits: .gzip, useMemoryMapping: true).decompressFile(from: compressed, to: restored)
+        XCTAssertEqual(try Data(contentsOf: URL(fileURLWithPath: restored)), Data())
+    }
+
+    func testMappedTruncatedInputFails() throws {
+        let compressedData = try ZLib.compress(makeTestData(count: 300_000))
+        let compressed = try writeTemp(compressedData.prefix(compressedData.count / 2), name: "mapped_truncated.z")
+        let restored = tempFilePath("mapped_truncated.bin")
+        defer { removeItems(compressed, restored) }
+
+        XCTAssertThrowsError(try FileChunkedDecompressor(useMemoryMapping: true).decompressFile(from: compressed, to: restored)) { error in
+            guard case .decompressionFailed? = error as? ZLibError else {
+                return XCTFail("Unexpected error: \(error)")
+            }
+        }
+    }
+
+    func testMappedMissingFileFails() {
+        XCTAssertThrowsError(try MappedFile(path: tempFilePath("mapped_does_not_exist.bin"))) { error in
+            guard case .fileError? = error as? ZLibError else {
+                return XCTFail("Unexpected error: \(error)")
+            }
+        }
+    }
+
+    // MARK: Private Functions
+
+    private func makeTestData(count: Int) -> Data {
+        var state: UInt32 = 2024
+        let text = Array("memory mapped input feeds zlib in place ".utf8)
+        return Data((0 ..< count).map { i -> UInt8 in
+            state = state &* 1_103_515_245 &+ 12345
+            return i % 4096 < 3072 ? text[i % text.count] : UInt8(truncatingIfNeeded: state >> 16)
+        })
+    }
+
+    private func writeTemp(_ data: Data, name: String) throws -> String {
+        let path = tempFilePath(name)
+        try data.write(to: URL(fileURLWithPath: path))
+        return path
+    }
+
+    private func removeItems(_ paths: String...) {
+        for path in paths {
+            try? FileManager.default.removeItem(atPath: path)
+        }
+    }
+
+    private func tempFilePath(_ filename: String) -> String {
+        NSTemporaryDirectory() + filename
+    }
+}
@@ -0,0 +1,125 @@
+//
+//  ParallelCompressorTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class ParallelCompressorTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testParallelZlibRoundTrip", testParallelZlibRoundTrip),
+        ("testParallelGzipRoundTrip", testParallelGzipRoundTrip),
+        ("testParallelRawRoundTrip", testParallelRawRoundTrip),
+        ("testParallelEmptyInput", testParallelEmptyInput),
+        ("testParallelBlockBoundaryInput", testParallelBlockBoundaryInput),
+        ("testParallelMatchesCrossBlockHistory", testParallelMatchesCrossBlockHistory),
+        ("testFileChunkedCompressorParallelism", testFileChunkedCompressorParallelism),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testParallelZlibRoundTrip() throws {
+        let input = makeTestData(count: 700_000)
+        let engine = ParallelCompressor(level: .defaultCompression, windowBits: .deflate, blockSize: 64 * 1024, threadCount: 4)
+        let compressed = try engine.compress(input)
+        XCTAssertLessThan(compressed.count, input.count)
+        XCTAssertEqual(try ZLib.decompress(compressed), input)
+    }
+
+    func testParallelGzipRoundTrip() throws {
+        let input = makeTestData(count: 300_001)
+        let engine = ParallelCompressor(level: .bestCompression, windowBits: .gzip, blockSize: 32 * 1024, threadCount: 3)
+        let compressed = try engine.compress(input)
+        XCTAssertEqual(compressed.prefix(2), Data([0x1F, 0x8B]))
+        let decompressed = try ZLib.decompress(compressed, options: DecompressionOptions(format: .gzip))
+        XCTAssertEqual(decompressed, input)
+    }
+
+    func testParallelRawRoundTrip() throws {
+        let input = makeTestData(count: 200_000)
+        let engine = ParallelCompressor(level: .bestSpeed, windowBits: .raw, blockSize: 40000, threadCount: 2)
+        let compressed = try engine.compress(input)
+        let decompressed = try ZLib.decompress(compressed, options: DecompressionOptions(format: .raw))
+        XCTAssertEqual(decompressed, input)
+    }
+
+    func testParallelEmptyInput() throws {
+        for windowBits in [WindowBits.deflate, .gzip] {
+            let engine = ParallelCompressor(windowBits: windowBits, threadCount: 2)
+            let compressed = try engine.compress(Data())
+            XCTAssertFalse(compressed.isEmpty)
+            let format: CompressionFormat = windowBits == .gzip ? .gzip : .zlib
+            let decompressed = try ZLib.decompress(compressed, options: DecompressionOptions(format: format))
+            XCTAssertTrue(decompressed.isEmpty)
+        }
+    }
+
+    func testParallelBlockBoundaryInput() throws {
+        // Input that ends exactly on a block boundary must still produce a final block
+        let input = makeTestData(count: 4 * 32 * 1024)
+        let engine = ParallelCompressor(windowBits: .deflate, blockSize: 32 * 1024, threadCount: 2)
+        let compressed = try engine.compress(input)
+        XCTAssertEqual(try ZLib.decompress(compressed), input)
+    }
+
+    func testParallelMatchesCrossBlockHistory() throws {
+        // Each block repeats the previous one, so priming with history should compress well
+        let unit = Data((0 ..< 32 * 1024).map { _ in UInt8.random(in: 0 ... 255) })
+        var input = Data()
+        for _ in 0 ..< 8 { input.append(unit) }
+        let engine = ParallelCompressor(windowBits: .deflate, blockSize: 32 * 1024, threadCount: 4)
+        let compressed = try engine.compress(input)
+        XCTAssertLessThan(compressed.count, unit.count * 2)
+        XCTAssertEqual(try ZLib.decompress(compressed), input)
+    }
+
+    func testFileChunkedCompressorParallelism() throws {
+        let input = makeTestData(count: 500_000)
+        let tempDir = FileManager.default.temporaryDirectory
+        let sourceURL = tempDir.appendingPathComponent("parallel_source_\(UUID().uuidString).txt")
+        let destURL = tempDir.appendingPathComponent("parallel_dest_\(UUID().uuidString).gz")
+        let outURL = tempDir.appendingPathComponent("parallel_out_\(UUID().uuidString).txt")
+        defer {
+            try? FileManager.default.removeItem(at: sourceURL)
+            try? FileManager.default.removeItem(at: destURL)
+            try? FileManager.default.removeItem(at: outURL)
+        }
+        try input.write(to: sourceURL)
+
+        let compressor = FileChunkedCompressor(windowBits: .gzip, parallelism: 4, parallelBlockSize: 64 * 1024)
+        var lastProgress = 0
+        try compressor.compressFile(from: sourceURL.path, to: destURL.path) { processed, _ in
+            lastProgress = processed
+        }
+        XCTAssertEqual(lastProgress, input.count)
+
+        let decompressor = FileChunkedDecompressor(windowBits: .gzip)
+        try decompressor.decompressFile(from: destURL.path, to: outURL.path)
+        XCTAssertEqual(try Data(contentsOf: outURL), input)
+    }
+
+    // MARK: Private Functions
+
+    private func makeTestData(count: Int) -> Data {
+        let words = ["alpha ", "beta ", "gamma ", "delta ", "epsilon ", "zeta ", "eta ", "theta\n"]
+        var data = Data(capacity: count)
+        var seed: UInt32 = 42
+        while data.count < count {
+            seed = seed &* 1_103_515_245 &+ 12345
+            data.append(contentsOf: words[Int(seed >> 16) % words.count].utf8)
+        }
+        return data.prefix(count)
+    }
+}
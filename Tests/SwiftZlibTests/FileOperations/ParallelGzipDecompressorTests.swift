@@ -0,0 +1,183 @@
+//
+//  ParallelGzipDecompressorTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class ParallelGzipDecompressorTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testManyMembersRoundTrip", testManyMembersRoundTrip),
+        ("testSingleMember", testSingleMember),
+        ("testEmbeddedGzipIsNotMistakenForMember", testEmbeddedGzipIsNotMistakenForMember),
+        ("testSmallInFlightWindow", testSmallInFlightWindow),
+        ("testSingleMemberIsStreamed", testSingleMemberIsStreamed),
+        ("testOversizedMembersAreStreamed", testOversizedMembersAreStreamed),
+        ("testCorruptChecksumThrows", testCorruptChecksumThrows),
+        ("testTruncatedMemberThrows", testTruncatedMemberThrows),
+        ("testTrailingGarbageIsIgnored", testTrailingGarbageIsIgnored),
+        ("testNonGzipInputThrows", testNonGzipInputThrows),
+        ("testEmptyInput", testEmptyInput),
+        ("testFileDecompression", testFileDecompression),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testManyMembersRoundTrip() throws {
+        let parts = (0 ..< 60).map { makeData(count: 1000 + $0 * 997, seed: $0) }
+        let archive = try parts.reduce(into: Data()) { $0.append(try ZLib.compressGzip($1)) }
+
+        var members = 0
+        var output = Data()
+        let decompressor = ParallelGzipDecompressor(threadCount: 4)
+        try archive.withUnsafeBytes { bytes in
+            members = try decompressor.decompress(bytes) { output.append($0) }
+        }
+        XCTAssertEqual(members, parts.count)
+        XCTAssertEqual(output, parts.reduce(Data(), +))
+    }
+
+    func testSingleMember() throws {
+        let original = makeData(count: 300_000, seed: 1)
+        let decompressed = try ParallelGzipDecompressor().decompress(ZLib.compressGzip(original))
+        XCTAssertEqual(decompressed, original)
+    }
+
+    func testEmbeddedGzipIsNotMistakenForMember() throws {
+        // Stored blocks copy the payload verbatim, so the outer member contains a complete,
+        // valid gzip member that the scanner finds and decodes speculatively
+        let inner = try ZLib.compressGzip(makeData(count: 5000, seed: 2))
+        let outerPayload = Data("prefix".utf8) + inner + Data("suffix".utf8)
+        let second = makeData(count: 4000, seed: 3)
+        let archive = try ZLib.compressGzip(outerPayload, level: .noCompression) + ZLib.compressGzip(second)
+
+        XCTAssertEqual(try ParallelGzipDecompressor(threadCount: 4).decompress(archive), outerPayload + second)
+    }
+
+    func testSmallInFlightWindow() throws {
+        let parts = (0 ..< 10).map { makeData(count: 3000, seed: $0) }
+        let archive = try parts.reduce(into: Data()) { $0.append(try ZLib.compressGzip($1)) }
+        let decompressor = ParallelGzipDecompressor(threadCount: 1, maxMembersInFlight: 1)
+        XCTAssertEqual(try decompressor.decompress(archive), parts.reduce(Data(), +))
+    }
+
+    func testSingleMemberIsStreamed() throws {
+        let original = makeData(count: 1_000_000, seed: 8)
+        let compressed = try ZLib.compressGzip(original)
+        compressed.withUnsafeBytes { XCTAssertFalse(ParallelGzipDecompressor.hasMemberCandidate($0, after: 0)) }
+
+        var chunks: [Data] = []
+        try compressed.withUnsafeBytes { bytes in
+            XCTAssertEqual(try ParallelGzipDecompressor(threadCount: 4).decompress(bytes) { chunks.append($0) }, 1)
+        }
+        XCTAssertGreaterThan(chunks.count, 1)
+        XCTAssertLessThanOrEqual(chunks.map(\.count).max() ?? 0, 64 * 1024)
+        XCTAssertEqual(chunks.reduce(Data(), +), original)
+    }
+
+    func testOversizedMembersAreStreamed() throws {
+        // A large member, a highly compressible one, and small ones decoded ahead around them
+        let parts = [
+            makeData(count: 5000, seed: 9),
+            makeData(count: 600_000, seed: 10),
+            makeData(count: 4000, seed: 11),
+            Data(count: 2_000_000),
+            makeData(count: 3000, seed: 12),
+        ]
+        let archive = try parts.reduce(into: Data()) { $0.append(try ZLib.compressGzip($1)) }
+        archive.withUnsafeBytes { XCTAssertTrue(ParallelGzipDecompressor.hasMemberCandidate($0, after: 0)) }
+
+        var chunks: [Data] = []
+        let decompressor = ParallelGzipDecompressor(threadCount: 4, maxBufferedMemberSize: 100_000)
+        try archive.withUnsafeBytes { bytes in
+            XCTAssertEqual(try decompressor.decompress(bytes) { chunks.append($0) }, parts.count)
+        }
+        XCTAssertLessThanOrEqual(chunks.map(\.count).max() ?? 0, 100_000)
+        XCTAssertEqual(chunks.reduce(Data(), +), parts.reduce(Data(), +))
+    }
+
+    func testCorruptChecksumThrows() throws {
+        let parts = (0 ..< 8).map { makeData(count: 2000, seed: $0) }
+        let members = try parts.map { try ZLib.compressGzip($0) }
+        var archive = members.reduce(Data(), +)
+        // Flip a bit in the CRC-32 of the fourth member
+        let crcOffset = members[0 ..< 4].reduce(0) { $0 + $1.count } - 8
+        archive[crcOffset] ^= 0x01
+
+        XCTAssertThrowsError(try ParallelGzipDecompressor(threadCount: 4).decompress(archive)) { error in
+            guard case .decompressionFailed? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+    }
+
+    func testTruncatedMemberThrows() throws {
+        let archive = try ZLib.compressGzip(makeData(count: 5000, seed: 4)) + ZLib.compressGzip(makeData(count: 50000, seed: 5))
+        XCTAssertThrowsError(try ParallelGzipDecompressor().decompress(archive.prefix(archive.count - 10))) { error in
+            guard case .decompressionFailed? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+    }
+
+    func testTrailingGarbageIsIgnored() throws {
+        let original = makeData(count: 10000, seed: 6)
+        let compressed = try ZLib.compressGzip(original)
+        let decompressor = ParallelGzipDecompressor()
+        XCTAssertEqual(try decompressor.decompress(compressed + Data(count: 512)), original)
+        XCTAssertEqual(try decompressor.decompress(compressed + Data("trailer".utf8)), original)
+    }
+
+    func testNonGzipInputThrows() throws {
+        XCTAssertThrowsError(try ParallelGzipDecompressor().decompress(ZLib.compress(makeData(count: 1000, seed: 7))))
+    }
+
+    func testEmptyInput() throws {
+        XCTAssertEqual(try ParallelGzipDecompressor().decompress(Data()), Data())
+    }
+
+    func testFileDecompression() throws {
+        let directory = FileManager.default.temporaryDirectory
+        let source = directory.appendingPathComponent("members-\(UUID().uuidString).gz").path
+        let destination = directory.appendingPathComponent("members-\(UUID().uuidString).out").path
+        defer {
+            try? FileManager.default.removeItem(atPath: source)
+            try? FileManager.default.removeItem(atPath: destination)
+        }
+
+        let parts = (0 ..< 20).map { makeData(count: 20000, seed: $0) }
+        try parts.reduce(into: Data()) { $0.append(try ZLib.compressGzip($1)) }.write(to: URL(fileURLWithPath: source))
+        let expected = parts.reduce(Data(), +)
+
+        XCTAssertEqual(try ParallelGzipDecompressor(threadCount: 4).decompressFile(from: source, to: destination), parts.count)
+        XCTAssertEqual(try Data(contentsOf: URL(fileURLWithPath: destination)), expected)
+
+        try FileManager.default.removeItem(atPath: destination)
+        try FileChunkedDecompressor(windowBits: .gzip, parallelism: 4).decompressFile(from: source, to: destination)
+        XCTAssertEqual(try Data(contentsOf: URL(fileURLWithPath: destination)), expected)
+
+        // A single-member file takes the streaming path
+        let single = makeData(count: 500_000, seed: 13)
+        try ZLib.compressGzip(single).write(to: URL(fileURLWithPath: source))
+        try FileChunkedDecompressor(windowBits: .gzip, parallelism: 4).decompressFile(from: source, to: destination)
+        XCTAssertEqual(try Data(contentsOf: URL(fileURLWithPath: destination)), single)
+    }
+
+    // MARK: Private Functions
+
+    private func makeData(count: Int, seed: Int) -> Data {
+        Data((0 ..< count).map { UInt8(truncatingIfNeeded: ($0 &* (seed + 3)) ^ ($0 >> 7) ^ seed) })
+    }
+}
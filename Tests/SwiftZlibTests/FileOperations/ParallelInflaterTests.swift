@@ -0,0 +1,185 @@
+//
+//  ParallelInflaterTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class ParallelInflaterTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testGzipRoundTripAcrossChunks", testGzipRoundTripAcrossChunks),
+        ("testZlibAndRawStreams", testZlibAndRawStreams),
+        ("testAutoDetection", testAutoDetection),
+        ("testCompressionLevelsAndStrategies", testCompressionLevelsAndStrategies),
+        ("testHighlyCompressibleInput", testHighlyCompressibleInput),
+        ("testIncompressibleInput", testIncompressibleInput),
+        ("testSingleThread", testSingleThread),
+        ("testEmptyStream", testEmptyStream),
+        ("testConcatenatedMembers", testConcatenatedMembers),
+        ("testTrailingGarbageIsIgnored", testTrailingGarbageIsIgnored),
+        ("testCorruptChecksumThrows", testCorruptChecksumThrows),
+        ("testTruncatedStreamThrows", testTruncatedStreamThrows),
+        ("testFileDecompression", testFileDecompression),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testGzipRoundTripAcrossChunks() throws {
+        let original = makeText(count: 3_000_000, seed: 1)
+        let compressed = try ZLib.compressGzip(original)
+        let inflater = ParallelInflater(threadCount: 4, chunkSize: 64 * 1024)
+
+        var pieces = 0
+        var output = Data()
+        let produced = try compressed.withUnsafeBytes { bytes in
+            try inflater.decompress(bytes) { chunk in
+                pieces += 1
+                output.append(chunk)
+            }
+        }
+        XCTAssertEqual(produced, original.count)
+        XCTAssertEqual(output, original)
+        XCTAssertGreaterThan(pieces, 1)
+    }
+
+    func testZlibAndRawStreams() throws {
+        let original = makeText(count: 1_500_000, seed: 2)
+        let zlib = try ZLib.compress(original)
+        XCTAssertEqual(try ParallelInflater(windowBits: .deflate, threadCount: 3, chunkSize: 64 * 1024).decompress(zlib), original)
+
+        let raw = try ZLib.compress(original, options: CompressionOptions(format: .raw, level: .bestCompression))
+        XCTAssertEqual(try ParallelInflater(windowBits: .raw, threadCount: 3, chunkSize: 64 * 1024).decompress(raw), original)
+    }
+
+    func testAutoDetection() throws {
+        let original = makeText(count: 500_000, seed: 3)
+        let inflater = ParallelInflater(windowBits: .auto, threadCount: 2, chunkSize: 64 * 1024)
+        XCTAssertEqual(try inflater.decompress(ZLib.compress(original)), original)
+        XCTAssertEqual(try inflater.decompress(ZLib.compressGzip(original)), original)
+    }
+
+    func testCompressionLevelsAndStrategies() throws {
+        let original = makeText(count: 800_000, seed: 4)
+        let inflater = ParallelInflater(windowBits: .deflate, threadCount: 4, chunkSize: 64 * 1024)
+        for level in [CompressionLevel.bestSpeed, .defaultCompression, .bestCompression] {
+            for strategy in [CompressionStrategy.defaultStrategy, .filtered, .huffmanOnly, .rle, .fixed] {
+                let compressor = Compressor()
+                try compressor.initializeAdvanced(level: level, strategy: strategy)
+                let compressed = try compressor.compress(original, flush: .finish)
+                XCTAssertEqual(try inflater.decompress(compressed), original, "level \(level) strategy \(strategy)")
+            }
+        }
+    }
+
+    func testHighlyCompressibleInput() throws {
+        // Far beyond the per-chunk expansion limit, so rounds are decoded serially
+        let original = Data(repeating: 0x41, count: 12_000_000) + makeText(count: 400_000, seed: 5)
+        let compressed = try ZLib.compressGzip(original)
+        XCTAssertEqual(try ParallelInflater(threadCount: 4, chunkSize: 64 * 1024).decompress(compressed), original)
+    }
+
+    func testIncompressibleInput() throws {
+        // Stored blocks carry no Huffman header to synchronize on
+        var generator = SystemRandomNumberGenerator()
+        let original = Data((0 ..< 1_000_000).map { _ in UInt8.random(in: 0 ... 255, using: &generator) })
+        let compressed = try ZLib.compressGzip(original)
+        XCTAssertEqual(try ParallelInflater(threadCount: 4, chunkSize: 64 * 1024).decompress(compressed), original)
+    }
+
+    func testSingleThread() throws {
+        let original = makeText(count: 600_000, seed: 6)
+        let compressed = try ZLib.compressGzip(original)
+        XCTAssertEqual(try ParallelInflater(threadCount: 1, chunkSize: 64 * 1024).decompress(compressed), original)
+    }
+
+    func testEmptyStream() throws {
+        XCTAssertEqual(try ParallelInflater().decompress(ZLib.compressGzip(Data())), Data())
+        XCTAssertEqual(try ParallelInflater(windowBits: .deflate).decompress(ZLib.compress(Data())), Data())
+    }
+
+    func testConcatenatedMembers() throws {
+        let large = makeText(count: 1_200_000, seed: 7)
+        let small = (0 ..< 12).map { makeText(count: 3000, seed: 10 + $0) }
+        var archive = try ZLib.compressGzip(large) + ZLib.compressGzip(large)
+        for part in small {
+            archive.append(try ZLib.compressGzip(part))
+        }
+        let expected = small.reduce(large + large, +)
+        XCTAssertEqual(try ParallelInflater(threadCount: 4, chunkSize: 64 * 1024).decompress(archive), expected)
+    }
+
+    func testTrailingGarbageIsIgnored() throws {
+        let original = makeText(count: 200_000, seed: 8)
+        let compressed = try ZLib.compressGzip(original)
+        XCTAssertEqual(try ParallelInflater(threadCount: 2, chunkSize: 64 * 1024).decompress(compressed + Data(count: 100)), original)
+    }
+
+    func testCorruptChecksumThrows() throws {
+        var compressed = try ZLib.compressGzip(makeText(count: 700_000, seed: 9))
+        compressed[compressed.count - 6] ^= 0x10
+        XCTAssertThrowsError(try ParallelInflater(threadCount: 4, chunkSize: 64 * 1024).decompress(compressed)) { error in
+            guard case .decompressionFailed? = error as? ZLibError else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+    }
+
+    func testTruncatedStreamThrows() throws {
+        let compressed = try ZLib.compressGzip(makeText(count: 700_000, seed: 10))
+        for cut in [4, compressed.count / 2] {
+            XCTAssertThrowsError(try ParallelInflater(threadCount: 4, chunkSize: 64 * 1024).decompress(compressed.dropLast(cut))) { error in
+                guard case .decompressionFailed? = error as? ZLibError else {
+                    return XCTFail("Unexpected error \(error)")
+                }
+            }
+        }
+    }
+
+    func testFileDecompression() throws {
+        let directory = FileManager.default.temporaryDirectory
+        let source = directory.appendingPathComponent("pinflate-\(UUID().uuidString).gz").path
+        let destination = directory.appendingPathComponent("pinflate-\(UUID().uuidString).out").path
+        defer {
+            try? FileManager.default.removeItem(atPath: source)
+            try? FileManager.default.removeItem(atPath: destination)
+        }
+
+        let original = makeText(count: 2_000_000, seed: 11)
+        try ZLib.compressGzip(original).write(to: URL(fileURLWithPath: source))
+        let written = try ParallelInflater(threadCount: 4, chunkSize: 64 * 1024).decompressFile(from: source, to: destination)
+        XCTAssertEqual(written, original.count)
+        XCTAssertEqual(try Data(contentsOf: URL(fileURLWithPath: destination)), original)
+    }
+
+    // MARK: Private Functions
+
+    /// Word-based text that compresses with dynamic Huffman blocks, like typical log dumps
+    private func makeText(count: Int, seed: UInt64) -> Data {
+        let words = ["alpha", "beta", "gamma", "delta", "error", "request", "GET", "/index.html", "200", "user", "session"]
+        var state = seed &* 6_364_136_223_846_793_005 &+ 1_442_695_040_888_963_407
+        var bytes = [UInt8]()
+        bytes.reserveCapacity(count + 16)
+        while bytes.count < count {
+            state = state &* 6_364_136_223_846_793_005 &+ 1_442_695_040_888_963_407
+            let value = Int(truncatingIfNeeded: state >> 33)
+            bytes.append(contentsOf: words[value % words.count].utf8)
+            bytes.append(value % 13 == 0 ? 0x0A : 0x20)
+            if value % 5 == 0 {
+                bytes.append(contentsOf: String(value % 100_000).utf8)
+            }
+        }
+        return Data(bytes.prefix(count))
+    }
+}
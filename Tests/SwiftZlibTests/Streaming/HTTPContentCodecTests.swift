@@ -0,0 +1,288 @@
+//
+//  HTTPContentCodecTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class HTTPContentCodecTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testSyncFlushedChunksDecodeOnArrival", testSyncFlushedChunksDecodeOnArrival),
+        ("testEncodedBodiesMatchTheirFormat", testEncodedBodiesMatchTheirFormat),
+        ("testConnectionReusesStateAcrossBodies", testConnectionReusesStateAcrossBodies),
+        ("testManyInterleavedConnections", testManyInterleavedConnections),
+        ("testDecoderAcceptsRawDeflateByteByByte", testDecoderAcceptsRawDeflateByteByByte),
+        ("testTruncatedAndTrailingDataAreRejected", testTruncatedAndTrailingDataAreRejected),
+        ("testMultiMemberGzipBody", testMultiMemberGzipBody),
+        ("testLowMemoryConfiguration", testLowMemoryConfiguration),
+        ("testAcceptEncodingNegotiation", testAcceptEncodingNegotiation),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testSyncFlushedChunksDecodeOnArrival() throws {
+        for encoding in HTTPContentEncoding.allCases {
+            for flush in [FlushMode.syncFlush, .fullFlush] {
+                let encoder = HTTPBodyEncoder(encoding: encoding)
+                let decoder = HTTPBodyDecoder(encoding: encoding)
+                for index in 0 ..< 10 {
+                    let chunk = makeText(count: 3000 + index * 500, seed: UInt64(index))
+                    let encoded = try encoder.encode(chunk, flush: flush)
+                    // Both flushes end with an empty stored block
+                    XCTAssertEqual([UInt8](encoded.suffix(4)), [0x00, 0x00, 0xFF, 0xFF])
+                    XCTAssertEqual(try decoder.decode(encoded), chunk, "\(encoding) \(flush) chunk \(index)")
+                }
+                XCTAssertFalse(decoder.isComplete)
+                XCTAssertEqual(try decoder.decode(encoder.finish()), Data())
+                XCTAssertTrue(decoder.isComplete)
+                try decoder.finish()
+                XCTAssertEqual(decoder.bodyCount, 1)
+            }
+        }
+    }
+
+    func testEncodedBodiesMatchTheirFormat() throws {
+        let original = makeText(count: 200_000, seed: 1)
+        let gzip = try HTTPBodyEncoder(encoding: .gzip).encodeBody(original)
+        XCTAssertEqual(Array(gzip.prefix(2)), [0x1F, 0x8B])
+        XCTAssertEqual(try ZLib.decompress(gzip, options: DecompressionOptions(format: .gzip)), original)
+
+        let deflate = try HTTPBodyEncoder(encoding: .deflate).encodeBody(original)
+        XCTAssertEqual(try ZLib.decompress(deflate), original)
+        // A 4 KB window still finds the repeats in text
+        XCTAssertLessThan(deflate.count, original.count / 2)
+    }
+
+    func testConnectionReusesStateAcrossBodies() throws {
+        let encoder = HTTPBodyEncoder(encoding: .gzip)
+        let decoder = HTTPBodyDecoder(encoding: .gzip)
+        XCTAssertFalse(encoder.isHoldingState)
+        XCTAssertFalse(decoder.isHoldingState)
+
+        for body in 0 ..< 4 {
+            let original = makeText(count: 20000, seed: UInt64(body))
+            var encoded = try encoder.encode(original.prefix(7000))
+            XCTAssertTrue(encoder.isInBody)
+            encoded.append(try encoder.encode(original.dropFirst(7000)))
+            encoded.append(try encoder.finish())
+            XCTAssertFalse(encoder.isInBody)
+            XCTAssertEqual(try ZLib.decompress(encoded, options: DecompressionOptions(format: .gzip)), original)
+            XCTAssertEqual(try decoder.decode(encoded), original)
+            try decoder.finish()
+
+            if body == 1 {
+                // An idle connection gives its memory back and gets it again on the next body
+                encoder.release()
+                decoder.release()
+                XCTAssertFalse(encoder.isHoldingState)
+                XCTAssertFalse(decoder.isHoldingState)
+            } else {
+                XCTAssertTrue(encoder.isHoldingState)
+                XCTAssertTrue(decoder.isHoldingState)
+            }
+        }
+        XCTAssertEqual(encoder.bodyCount, 4)
+        XCTAssertEqual(decoder.bodyCount, 4)
+
+        // An aborted body leaves the stream ready for the next one
+        _ = try encoder.encode(makeText(count: 5000, seed: 9))
+        encoder.abort()
+        XCTAssertEqual(try ZLib.decompress(encoder.encodeBody(Data("next".utf8)), options: DecompressionOptions(format: .gzip)), Data("next".utf8))
+    }
+
+    func testManyInterleavedConnections() throws {
+        let connections = (0 ..< 500).map { index in
+            (
+                encoder: HTTPBodyEncoder(encoding: index % 2 == 0 ? .gzip : .deflate),
+                decoder: HTTPBodyDecoder(encoding: index % 2 == 0 ? .gzip : .deflate)
+            )
+        }
+        var originals = [Data](repeating: Data(), count: connections.count)
+        var decoded = [Data](repeating: Data(), count: connections.count)
+        for round in 0 ..< 3 {
+            for (index, connection) in connections.enumerated() {
+                let chunk = makeText(count: 600 + index, seed: UInt64(round * 1000 + index))
+                originals[index].append(chunk)
+                decoded[index].append(try connection.decoder.decode(connection.encoder.encode(chunk)))
+            }
+        }
+        for (index, connection) in connections.enumerated() {
+            decoded[index].append(try connection.decoder.decode(connection.encoder.finish()))
+            try connection.decoder.finish()
+            XCTAssertEqual(decoded[index], originals[index], "connection \(index)")
+        }
+    }
+
+    func testDecoderAcceptsRawDeflateByteByByte() throws {
+        let original = makeText(count: 30000, seed: 2)
+        let raw = try ZLib.compress(original, options: CompressionOptions(format: .raw))
+        let zlib = try ZLib.compress(original)
+
+        let decoder = HTTPBodyDecoder(encoding: .deflate)
+        for body in [raw, zlib, raw] {
+            var decoded = Data()
+            for byte in body {
+                decoded.append(try decoder.decode(Data([byte])))
+            }
+            XCTAssertEqual(decoded, original)
+            try decoder.finish()
+        }
+        XCTAssertEqual(decoder.bodyCount, 3)
+    }
+
+    func testTruncatedAndTrailingDataAreRejected() throws {
+        let original = makeText(count: 10000, seed: 3)
+        let encoded = try HTTPBodyEncoder(encoding: .gzip).encodeBody(original)
+        let decoder = HTTPBodyDecoder(encoding: .gzip)
+
+        _ = try decoder.decode(encoded.prefix(encoded.count - 4))
+        XCTAssertThrowsError(try decoder.finish()) { error in
+            guard case let .decompressionFailed(code)? = error as? ZLibError else {
+                return XCTFail("Expected decompressionFailed, got \(error)")
+            }
+            XCTAssertEqual(code, ZLibErrorCode.bufferError.rawValue)
+        }
+        XCTAssertEqual(decoder.bodyCount, 0)
+
+        XCTAssertEqual(try decoder.decode(encoded), original)
+        XCTAssertThrowsError(try decoder.decode(Data("extra".utf8)))
+        try decoder.finish()
+
+        // Trailing bytes in the same chunk as the end of the body
+        for encoding in HTTPContentEncoding.allCases {
+            let body = try HTTPBodyEncoder(encoding: encoding).encodeBody(original)
+            let trailing = HTTPBodyDecoder(encoding: encoding)
+            XCTAssertThrowsError(try trailing.decode(body + Data("extra".utf8)), "\(encoding)") { error in
+                guard case let .decompressionFailed(code)? = error as? ZLibError else {
+                    return XCTFail("Expected decompressionFailed, got \(error)")
+                }
+                XCTAssertEqual(code, ZLibErrorCode.dataError.rawValue)
+            }
+            trailing.abort()
+            XCTAssertEqual(trailing.bodyCount, 0)
+            XCTAssertEqual(try trailing.decode(body), original)
+            try trailing.finish()
+            XCTAssertEqual(trailing.bodyCount, 1)
+        }
+
+        XCTAssertThrowsError(try decoder.decode(Data("not gzip at all".utf8)))
+        decoder.abort()
+        XCTAssertEqual(try decoder.decode(encoded), original)
+        try decoder.finish()
+        XCTAssertEqual(decoder.bodyCount, 2)
+    }
+
+    func testMultiMemberGzipBody() throws {
+        let first = makeText(count: 10000, seed: 5)
+        let second = makeText(count: 7000, seed: 6)
+        let encoder = HTTPBodyEncoder(encoding: .gzip)
+        let firstMember = try encoder.encodeBody(first)
+        let body = try firstMember + encoder.encodeBody(second)
+        let decoder = HTTPBodyDecoder(encoding: .gzip)
+
+        XCTAssertEqual(try decoder.decode(body), first + second)
+        XCTAssertTrue(decoder.isComplete)
+        try decoder.finish()
+
+        // Member boundaries and magic bytes split across chunks
+        var decoded = Data()
+        for index in body.indices {
+            decoded += try decoder.decode(body[index ... index])
+        }
+        XCTAssertEqual(decoded, first + second)
+        try decoder.finish()
+        XCTAssertEqual(decoder.bodyCount, 2)
+
+        // A second member cut short leaves the body incomplete
+        _ = try decoder.decode(body.prefix(body.count - 4))
+        XCTAssertFalse(decoder.isComplete)
+        XCTAssertThrowsError(try decoder.finish())
+        // Only the first magic byte of the second member
+        XCTAssertEqual(try decoder.decode(body.prefix(firstMember.count + 1)), first)
+        XCTAssertFalse(decoder.isComplete)
+        decoder.abort()
+
+        // Bytes after a member that do not start another one
+        XCTAssertThrowsError(try decoder.decode(body + Data([0x1F, 0x00])))
+        decoder.abort()
+        _ = try decoder.decode(body)
+        XCTAssertThrowsError(try decoder.decode(Data([0x1F, 0x8C])))
+        try decoder.finish()
+        XCTAssertEqual(decoder.bodyCount, 3)
+
+        // The size limit covers the body, not each member
+        let limited = HTTPBodyDecoder(
+            encoding: .gzip,
+            configuration: HTTPCodecConfiguration(maxDecodedBodySize: first.count + second.count - 1)
+        )
+        XCTAssertThrowsError(try limited.decode(body)) { error in
+            guard case .outputLimitExceeded? = error as? ZLibError else {
+                return XCTFail("Expected outputLimitExceeded, got \(error)")
+            }
+        }
+    }
+
+    func testLowMemoryConfiguration() throws {
+        let lowMemory = HTTPCodecConfiguration.lowMemory
+        XCTAssertEqual(lowMemory.windowLog, 12)
+        XCTAssertEqual(lowMemory.decoderWindowLog, 15)
+        XCTAssertLessThan(lowMemory.encoderStateBytes * 5, HTTPCodecConfiguration.standard.encoderStateBytes)
+        XCTAssertLessThan(lowMemory.encoderStateBytes, 40 * 1024)
+
+        let clamped = HTTPCodecConfiguration(windowLog: 4, decoderWindowLog: 20)
+        XCTAssertEqual(clamped.windowLog, HTTPCodecConfiguration.minimumWindowLog)
+        XCTAssertEqual(clamped.decoderWindowLog, HTTPCodecConfiguration.maximumWindowLog)
+
+        // Smallest window on both ends, without arenas
+        let tiny = HTTPCodecConfiguration(windowLog: 9, memoryLevel: .minimum, decoderWindowLog: 9, usesArena: false)
+        let original = makeText(count: 50000, seed: 4)
+        for encoding in HTTPContentEncoding.allCases {
+            let encoded = try HTTPBodyEncoder(encoding: encoding, configuration: tiny).encodeBody(original)
+            let decoder = HTTPBodyDecoder(encoding: encoding, configuration: tiny)
+            XCTAssertEqual(try decoder.decode(encoded), original)
+            try decoder.finish()
+        }
+    }
+
+    func testAcceptEncodingNegotiation() {
+        XCTAssertEqual(HTTPContentEncoding(headerValue: " X-GZIP "), .gzip)
+        XCTAssertEqual(HTTPContentEncoding(headerValue: "Deflate"), .deflate)
+        XCTAssertNil(HTTPContentEncoding(headerValue: "br"))
+
+        XCTAssertEqual(HTTPContentEncoding.preferred(acceptEncoding: "gzip, deflate, br"), .gzip)
+        XCTAssertEqual(HTTPContentEncoding.preferred(acceptEncoding: "deflate, gzip"), .gzip)
+        XCTAssertEqual(HTTPContentEncoding.preferred(acceptEncoding: "gzip;q=0.5, deflate;q=0.8"), .deflate)
+        XCTAssertEqual(HTTPContentEncoding.preferred(acceptEncoding: "gzip;q=0, *"), .deflate)
+        XCTAssertEqual(HTTPContentEncoding.preferred(acceptEncoding: "br, *;q=0.1"), .gzip)
+        XCTAssertNil(HTTPContentEncoding.preferred(acceptEncoding: "br, identity"))
+        XCTAssertNil(HTTPContentEncoding.preferred(acceptEncoding: "gzip;q=0, deflate;q=0"))
+        XCTAssertNil(HTTPContentEncoding.preferred(acceptEncoding: ""))
+    }
+
+    // MARK: Private Functions
+
+    private func makeText(count: Int, seed: UInt64) -> Data {
+        let words = ["alpha", "beta", "gamma", "delta", "request", "GET", "/index.html", "200", "user", "session"]
+        var state = seed &+ 1
+        var bytes = [UInt8]()
+        bytes.reserveCapacity(count + 16)
+        while bytes.count < count {
+            state = state &* 6_364_136_223_846_793_005 &+ 1_442_695_040_888_963_407
+            bytes.append(contentsOf: words[Int(state >> 33) % words.count].utf8)
+            bytes.append(0x20)
+        }
+        return Data(bytes.prefix(count))
+    }
+}
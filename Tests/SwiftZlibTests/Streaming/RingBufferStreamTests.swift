@@ -0,0 +1,195 @@
+//
+//  RingBufferStreamTests.swift
+//  SwiftZlib
+//
+//  Created by Mateusz Kosikowski on 13/07/2025.
+//
+
+import XCTest
+@testable import SwiftZlib
+
+final class RingBufferStreamTests: XCTestCase {
+    // MARK: Static Properties
+
+    static var allTests = [
+        ("testRingBufferWrapsAround", testRingBufferWrapsAround),
+        ("testRoundTripThroughTinyRings", testRoundTripThroughTinyRings),
+        ("testSyncFlushMakesInputDecodable", testSyncFlushMakesInputDecodable),
+        ("testFinishResumesWhenOutputIsFull", testFinishResumesWhenOutputIsFull),
+        ("testTrailingInputStaysInRing", testTrailingInputStaysInRing),
+        ("testInvalidDataThrows", testInvalidDataThrows),
+    ]
+
+    // MARK: Overridden Functions
+
+    override func setUp() {
+        super.setUp()
+        ZLibVerboseConfig.disableAll()
+    }
+
+    // MARK: Functions
+
+    func testRingBufferWrapsAround() {
+        let ring = ByteRingBuffer(capacity: 8)
+        XCTAssertEqual(ring.write(Data([1, 2, 3, 4, 5, 6])), 6)
+        XCTAssertEqual(ring.readData(maxLength: 4), Data([1, 2, 3, 4]))
+
+        // Two bytes fit before the end of the storage, the rest wraps to the front
+        XCTAssertEqual(ring.writableRegion.count, 2)
+        XCTAssertEqual(ring.write(Data([7, 8, 9, 10, 11, 12, 13])), 6)
+        XCTAssertTrue(ring.isFull)
+        XCTAssertEqual(ring.writableRegion.count, 0)
+        XCTAssertEqual(ring.readableRegion.count, 4)
+        XCTAssertEqual(ring.readData(), Data([5, 6, 7, 8, 9, 10, 11, 12]))
+
+        // Draining rewinds the cursors, so the whole storage is one region again
+        XCTAssertTrue(ring.isEmpty)
+        XCTAssertEqual(ring.writableRegion.count, 8)
+
+        ring.write(Data([1, 2, 3]))
+        let region = ring.writableRegion
+        region.baseAddress!.storeBytes(of: 4, as: UInt8.self)
+        ring.commitWrite(1)
+        XCTAssertEqual(ring.count, 4)
+        XCTAssertEqual(ring.readableRegion.first, 1)
+        ring.consume(2)
+        XCTAssertEqual(ring.readData(), Data([3, 4]))
+        ring.write(Data([9]))
+        ring.removeAll()
+        XCTAssertEqual(ring.freeCount, 8)
+    }
+
+    func testRoundTripThroughTinyRings() throws {
+        let original = makeMixedData(count: 200_000)
+        for (windowBits, format) in [(WindowBits.deflate, CompressionFormat.zlib), (.gzip, .gzip), (.raw, .raw)] {
+            for (inputCapacity, outputCapacity) in [(7, 5), (4096, 13), (65536, 65536)] {
+                let plain = ByteRingBuffer(capacity: inputCapacity)
+                let packed = ByteRingBuffer(capacity: outputCapacity)
+                let transfer = ByteRingBuffer(capacity: outputCapacity + 3)
+                let unpacked = ByteRingBuffer(capacity: inputCapacity + 11)
+                let compressor = try RingBufferStream(compressingFrom: plain, into: packed, windowBits: windowBits)
+                let decompressor = try RingBufferStream(decompressingFrom: transfer, into: unpacked, windowBits: windowBits)
+
+                var compressed = Data()
+                var decoded = Data()
+                var fed = 0
+                var rounds = 0
+                while !decompressor.isStreamEnd {
+                    rounds += 1
+                    guard rounds < 10_000_000 else {
+                        return XCTFail("No progress with \(inputCapacity)/\(outputCapacity)")
+                    }
+                    fed += original.withUnsafeBytes { plain.write(UnsafeRawBufferPointer(rebasing: $0[fed...])) }
+                    if !compressor.isStreamEnd {
+                        try compressor.process(flush: fed == original.count ? .finish : .noFlush)
+                    }
+                    // Hand compressed bytes over through a second copy of the data
+                    let moved = packed.readData(maxLength: transfer.freeCount)
+                    compressed.append(moved)
+                    transfer.write(moved)
+                    try decompressor.process()
+                    decoded.append(unpacked.readData())
+                }
+                XCTAssertEqual(decoded, original, "\(windowBits) \(inputCapacity)/\(outputCapacity)")
+                XCTAssertEqual(try ZLib.decompress(compressed, options: DecompressionOptions(format: format)), original)
+                XCTAssertEqual(compressor.metrics.bytesIn, original.count)
+                XCTAssertTrue(transfer.isEmpty)
+            }
+        }
+    }
+
+    func testSyncFlushMakesInputDecodable() throws {
+        let plain = ByteRingBuffer(capacity: 32 * 1024)
+        let packed = ByteRingBuffer(capacity: 32 * 1024)
+        let stream = try RingBufferStream(compressingFrom: plain, into: packed, level: .bestSpeed)
+        let decompressor = Decompressor()
+        try decompressor.initialize()
+
+        var expected = Data()
+        for index in 0 ..< 5 {
+            let chunk = makeMixedData(count: 5000 + index * 100)
+            expected.append(chunk)
+            XCTAssertEqual(plain.write(chunk), chunk.count)
+            let progress = try stream.process(flush: .syncFlush)
+            XCTAssertEqual(progress.bytesConsumed, chunk.count)
+            XCTAssertFalse(progress.isStreamEnd)
+            XCTAssertEqual(try decompressor.decompress(packed.readData()), chunk)
+        }
+        XCTAssertTrue(try stream.process(flush: .finish).isStreamEnd)
+        _ = try decompressor.decompress(packed.readData())
+
+        // A reset starts a fresh stream on the same rings
+        try stream.reset()
+        XCTAssertFalse(stream.isStreamEnd)
+        XCTAssertEqual(plain.write(expected), expected.count)
+        XCTAssertTrue(try stream.process(flush: .finish).isStreamEnd)
+        XCTAssertEqual(try ZLib.decompress(packed.readData()), expected)
+    }
+
+    func testFinishResumesWhenOutputIsFull() throws {
+        let original = makeMixedData(count: 50000)
+        let plain = ByteRingBuffer(capacity: original.count)
+        let packed = ByteRingBuffer(capacity: 100)
+        let stream = try RingBufferStream(compressingFrom: plain, into: packed, windowBits: .gzip)
+        plain.write(original)
+
+        var compressed = Data()
+        var calls = 0
+        repeat {
+            calls += 1
+            let progress = try stream.process(flush: .finish)
+            XCTAssertLessThanOrEqual(progress.bytesProduced, packed.capacity)
+            compressed.append(packed.readData())
+        } while !stream.isStreamEnd
+        XCTAssertGreaterThan(calls, 1)
+        XCTAssertTrue(plain.isEmpty)
+        XCTAssertEqual(try ZLib.decompress(compressed, options: DecompressionOptions(format: .gzip)), original)
+    }
+
+    func testTrailingInputStaysInRing() throws {
+        let original = makeMixedData(count: 10000)
+        let trailing = Data("next message".utf8)
+        let packed = ByteRingBuffer(capacity: 32 * 1024)
+        let plain = ByteRingBuffer(capacity: 32 * 1024)
+        let stream = try RingBufferStream(decompressingFrom: packed, into: plain)
+
+        packed.write(try ZLib.compress(original) + trailing)
+        XCTAssertTrue(try stream.process().isStreamEnd)
+        XCTAssertEqual(plain.readData(), original)
+        XCTAssertEqual(packed.readData(), trailing)
+
+        try stream.reset()
+        packed.write(try ZLib.compress(trailing))
+        try stream.process()
+        XCTAssertTrue(stream.isStreamEnd)
+        XCTAssertEqual(plain.readData(), trailing)
+    }
+
+    func testInvalidDataThrows() throws {
+        let packed = ByteRingBuffer(capacity: 1024)
+        let plain = ByteRingBuffer(capacity: 1024)
+        let stream = try RingBufferStream(decompressingFrom: packed, into: plain)
+        packed.write(Data("definitely not zlib".utf8))
+        XCTAssertThrowsError(try stream.process()) { error in
+            guard case let .decompressionFailed(code)? = error as? ZLibError else {
+                return XCTFail("Expected decompressionFailed, got \(error)")
+            }
+            XCTAssertEqual(code, ZLibErrorCode.dataError.rawValue)
+        }
+    }
+
+    // MARK: Private Functions
+
+    /// Text with every seventh byte random, so deflate both matches and emits literals
+    private func makeMixedData(count: Int) -> Data {
+        let text = Array("The quick brown fox jumps over the lazy dog. ".utf8)
+        var state: UInt64 = 11
+        return Data((0 ..< count).map { index in
+            guard index % 7 == 0 else {
+                return text[index % text.count]
+            }
+            state = state &* 6_364_136_223_846_793_005 &+ 1_442_695_040_888_963_407
+            return UInt8(truncatingIfNeeded: state >> 33)
+        })
+    }
+}